@@ -15,10 +15,9 @@ JanuszG@enter.net.pl
 #include <stdio.h>
 #include "colors.h"
 #include "targa.h"
-
-// wskanik na funkcj glWindowPos2i
-
-PFNGLWINDOWPOS2IPROC glWindowPos2i = NULL;
+#include "extensions.h"
+#include "text.h"
+#include "redraw.h"
 
 // stae do obsugi menu podrcznego
 
@@ -70,76 +69,51 @@ GLuint texture;
 
 GLint texture_compression_hint = GL_DONT_CARE;
 
-// funkcja rysujca napis w wybranym miejscu
-// (wersja korzystajca z funkcji glWindowPos2i)
-
-void DrawString(GLint x, GLint y, char *string)
-{
-	// pooenie napisu
-	glWindowPos2i(x, y);
-
-	// wywietlenie napisu
-	int len = strlen(string);
-	for (int i = 0; i < len; i++)
-		glutBitmapCharacter(GLUT_BITMAP_9_BY_15, string[i]);
-}
-
-// funkcja generujca scen 3D
+// napisy z informacjami o biecej teksturze i obsugiwanych formatach
+// kompresji; zapytania glGet* wymuszaj synchronizacj z potokiem OpenGL,
+// wic napisy s tworzone tylko po zmianie tekstury lub ich utworzeniu
 
-void DisplayScene()
+struct InfoString
 {
-	// kolor ta - zawarto bufora koloru
-	glClearColor(1.0, 1.0, 1.0, 1.0);
-
-	// czyszczenie bufora koloru
-	glClear(GL_COLOR_BUFFER_BIT);
-
-	// wybr macierzy modelowania
-	glMatrixMode(GL_MODELVIEW);
-
-	// macierz modelowania = macierz jednostkowa
-	glLoadIdentity();
-
-	// przesunicie ukadu wsprzdnych obiektw do rodka bryy odcinania
-	glTranslatef(0.0, 0.0, -(near + far) / 2);
+	GLint x, y;
+	char text[80];
+};
 
-	// przesunicie obiektu z tekstur do gry okna
-	glTranslatef(0.0, 1.0, 0.0);
+InfoString info_strings[4 + 256];
+int info_count = 0;
 
-	// wczenie teksturowania dwuwymiarowego
-	glEnable(GL_TEXTURE_2D);
+// tekstura, dla ktrej utworzono napisy (0 - napisy do odtworzenia)
 
-	// ustawienie parametw rodowiska tekstur
-	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+GLuint info_texture = 0;
 
-	// dowizanie stanu tekstury
-	glBindTexture(GL_TEXTURE_2D, texture);
+// funkcja rysujca napis w wybranym miejscu
+// (napisy s zbierane i rysowane razem z atlasu znakw w TextFlush)
 
-	// filtr powi?kszajcy
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+void DrawString(GLint x, GLint y, char *string)
+{
+	TextAdd(x, y, string);
+}
 
-	// filtr pomniejszajcy
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+// zapamitanie napisu do wywietlenia
 
-	// narysowanie kwadratu z tekstur
-	glBegin(GL_QUADS);
-	glTexCoord2f(0.0, 0.0);
-	glVertex2f(-1.5, -1.5);
-	glTexCoord2f(0.0, 1.0);
-	glVertex2f(-1.5, 1.5);
-	glTexCoord2f(1.0, 1.0);
-	glVertex2f(1.5, 1.5);
-	glTexCoord2f(1.0, 0.0);
-	glVertex2f(1.5, -1.5);
-	glEnd();
+void AddInfoString(GLint x, GLint y, const char *string)
+{
+	InfoString &info = info_strings[info_count++];
+	info.x = x;
+	info.y = y;
+	strncpy(info.text, string, sizeof(info.text) - 1);
+	info.text[sizeof(info.text) - 1] = '\0';
+}
 
-	// wyczenie teksturowania dwuwymiarowego
-	glDisable(GL_TEXTURE_2D);
+// utworzenie napisw z informacjami o biecej teksturze (dowizanej
+// do GL_TEXTURE_2D) i obsugiwanych formatach kompresji
 
-	// wywietlenie wybranych informacji
+void UpdateInfoStrings()
+{
 	char string[200];
 	GLint var;
-	glColor3fv(Black);
+	info_texture = texture;
+	info_count = 0;
 
 	// informacja czy tekstura jest skompresowana
 	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &var);
@@ -147,12 +121,12 @@ void DisplayScene()
 		sprintf(string, "GL_TEXTURE_COMPRESSED = GL_FALSE");
 	else
 		sprintf(string, "GL_TEXTURE_COMPRESSED = GL_TRUE");
-	DrawString(2, 2, string);
+	AddInfoString(2, 2, string);
 
 	// rozmiar danych tekstury
 	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &var);
 	sprintf(string, "GL_TEXTURE_COMPRESSED_IMAGE_SIZE = %i", var);
-	DrawString(2, 16, string);
+	AddInfoString(2, 16, string);
 
 	// wewntrzny format tekstury
 	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &var);
@@ -216,7 +190,7 @@ void DisplayScene()
 		sprintf(string, "GL_TEXTURE_INTERNAL_FORMAT = nieznany");
 		break;
 	}
-	DrawString(2, 30, string);
+	AddInfoString(2, 30, string);
 
 	// informacja o wskazwkach do kompresji tekstur
 	glGetIntegerv(GL_TEXTURE_COMPRESSION_HINT, &var);
@@ -232,7 +206,7 @@ void DisplayScene()
 		sprintf(string, "GL_TEXTURE_COMPRESSION_HINT = GL_NICEST");
 		break;
 	}
-	DrawString(2, 44, string);
+	AddInfoString(2, 44, string);
 
 	// ilo obsugiwanych formatw kompresji tekstur
 	glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &var);
@@ -278,8 +252,71 @@ void DisplayScene()
 			sprintf(string, "Format nieznany (0x%X)", formats[i]);
 			break;
 		}
-		DrawString(2, 70 + 14 * i, string);
+		AddInfoString(2, 70 + 14 * i, string);
 	}
+}
+
+// funkcja generujca scen 3D
+
+void DisplayScene()
+{
+	// kolor ta - zawarto bufora koloru
+	glClearColor(1.0, 1.0, 1.0, 1.0);
+
+	// czyszczenie bufora koloru
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	// wybr macierzy modelowania
+	glMatrixMode(GL_MODELVIEW);
+
+	// macierz modelowania = macierz jednostkowa
+	glLoadIdentity();
+
+	// przesunicie ukadu wsprzdnych obiektw do rodka bryy odcinania
+	glTranslatef(0.0, 0.0, -(near + far) / 2);
+
+	// przesunicie obiektu z tekstur do gry okna
+	glTranslatef(0.0, 1.0, 0.0);
+
+	// wczenie teksturowania dwuwymiarowego
+	glEnable(GL_TEXTURE_2D);
+
+	// ustawienie parametw rodowiska tekstur
+	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+	// dowizanie stanu tekstury
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	// filtr powi?kszajcy
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// filtr pomniejszajcy
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+	// narysowanie kwadratu z tekstur
+	glBegin(GL_QUADS);
+	glTexCoord2f(0.0, 0.0);
+	glVertex2f(-1.5, -1.5);
+	glTexCoord2f(0.0, 1.0);
+	glVertex2f(-1.5, 1.5);
+	glTexCoord2f(1.0, 1.0);
+	glVertex2f(1.5, 1.5);
+	glTexCoord2f(1.0, 0.0);
+	glVertex2f(1.5, -1.5);
+	glEnd();
+
+	// wyczenie teksturowania dwuwymiarowego
+	glDisable(GL_TEXTURE_2D);
+
+	// wywietlenie wybranych informacji
+	if (info_texture != texture)
+		UpdateInfoStrings();
+	TextColor(Black);
+	for (int i = 0; i < info_count; i++)
+		DrawString(info_strings[i].x, info_strings[i].y, info_strings[i].text);
+
+	// narysowanie napisw
+	TextFlush(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 
 	// skierowanie polece do wykonania
 	glFlush();
@@ -317,7 +354,7 @@ void Reshape(int width, int height)
 		glFrustum(left, right, bottom, top, near, far);
 
 	// generowanie sceny 3D
-	DisplayScene();
+	RedrawRequest();
 }
 
 // utworzenie list wywietlania
@@ -399,6 +436,9 @@ void GenerateTextures()
 
 	// wybr biecej tekstury
 	texture = LENA;
+
+	// tekstury utworzone ponownie - napisy do odtworzenia
+	info_texture = 0;
 }
 
 // obsuga menu podrcznego
@@ -415,7 +455,7 @@ void Menu(int value)
 		tmp_texture = texture;
 		GenerateTextures();
 		texture = tmp_texture;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -426,7 +466,7 @@ void Menu(int value)
 		tmp_texture = texture;
 		GenerateTextures();
 		texture = tmp_texture;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -437,7 +477,7 @@ void Menu(int value)
 		tmp_texture = texture;
 		GenerateTextures();
 		texture = tmp_texture;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -445,7 +485,7 @@ void Menu(int value)
 	case TEXTURE_LENA:
 	{
 		texture = LENA;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -453,7 +493,7 @@ void Menu(int value)
 	case TEXTURE_LENA_UNC:
 	{
 		texture = LENA_UNC;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -461,7 +501,7 @@ void Menu(int value)
 	case TEXTURE_LENA_GRAY:
 	{
 		texture = LENA_GRAY;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -469,7 +509,7 @@ void Menu(int value)
 	case TEXTURE_LENA_GRAY_UNC:
 	{
 		texture = LENA_GRAY_UNC;
-		DisplayScene();
+		RedrawRequest();
 	}
 	break;
 
@@ -516,26 +556,6 @@ void ExtensionSetup()
 		exit(0);
 	}
 
-	// sprawdzenie czy jest co najmniej wersja 1.4
-	if (major > 1 || minor >= 4)
-	{
-		// pobranie wskanika wybranej funkcji OpenGL 1.4
-		glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress("glWindowPos2i");
-	}
-	else
-		// sprawdzenie czy jest obsugiwane rozszerzenie ARB_window_pos
-		if (glutExtensionSupported("GL_ARB_window_pos"))
-		{
-			// pobranie wskanika wybranej funkcji rozszerzenia ARB_window_pos
-			glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress
-				("glWindowPos2iARB");
-		}
-		else
-		{
-			printf("Brak rozszerzenia ARB_window_pos!\n");
-			exit(0);
-		}
-
 	// sprawdzenie czy jest co najmniej wersja 1.3 OpenGL lub
 	// czy jest obsugiwane rozszerzenie ARB_texture_compression
 	if (!(major > 1 || minor >= 3) &&
@@ -561,7 +581,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Kompresja tekstur");
 
 	// doczenie funkcji generujcej scen 3D
-	glutDisplayFunc(DisplayScene);
+	RedrawInit(DisplayScene, 60);
 
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -614,6 +634,9 @@ int main(int argc, char *argv[])
 	// sprawdzenie i przygotowanie obsugi wybranych rozszerze
 	ExtensionSetup();
 
+	// obiekty buforowe dla napisw
+	ExtensionFunctionsSetup();
+
 	// wprowadzenie programu do obsugi ptli komunikatw
 	glutMainLoop();
 	return 0;
@@ -0,0 +1,42 @@
+#ifndef __REDRAW__H__
+#define __REDRAW__H__
+
+#include <GL/glut.h>
+
+// planowanie rysowania ramek: zmiana sceny (klawiatura, myszka, menu,
+// zmiana rozmiaru okna) tylko oznacza scen do narysowania, a wiele takich
+// zgosze przed najblisz ramk daje jedno rysowanie; ramki nie s
+// rysowane czciej ni pozwala ograniczenie liczby ramek na sekund,
+// a bez animacji i zgosze program czeka na zdarzenia (nie zajmuje
+// procesora)
+
+// doczenie funkcji generujcej scen (zamiast glutDisplayFunc)
+// fps_cap - najwiksza liczba ramek na sekund (0 - bez ograniczenia)
+
+void RedrawInit(void(*display)(), int fps_cap);
+
+// scena zmieniona - narysowanie w najbliszej ramce
+
+void RedrawRequest();
+
+// animacja: funkcja wywoywana przed kad ramk z czasem [s], ktry
+// upyn od poprzedniego kroku; dopki animacja jest doczona, kolejne
+// ramki s rysowane bez zgosze; NULL - zatrzymanie animacji
+
+void RedrawAnimation(void(*step)(float dt));
+
+// zmiana ograniczenia liczby ramek na sekund (0 - bez ograniczenia)
+
+void RedrawFpsCap(int fps_cap);
+
+// liczba zgosze i narysowanych ramek (od uruchomienia programu)
+
+struct RedrawStats
+{
+	int requests = 0;
+	int frames = 0;
+};
+
+const RedrawStats &RedrawGetStats();
+
+#endif // __REDRAW__H__
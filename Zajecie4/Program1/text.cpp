@@ -0,0 +1,302 @@
+#include "text.h"
+#include "extensions.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+// czcionka 9x15 (-misc-fixed-medium-r-normal--15-, jak GLUT_BITMAP_9_BY_15)
+// dla znakw ASCII 32-126; 16 wierszy od dou, najstarszy bit to lewa
+// kolumna znaku; linia bazowa przebiega nad czwartym wierszem
+
+static const unsigned short font_9x15[95][16] =
+{
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // spacja
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0800, 0x0000, 0x0000, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0000 }, // '!'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1200, 0x1200, 0x1200, 0x0000, 0x0000 }, // '"'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x2400, 0x2400, 0x7E00, 0x2400, 0x2400, 0x7E00, 0x2400, 0x2400, 0x0000, 0x0000, 0x0000 }, // '#'
+	{ 0x0000, 0x0000, 0x0000, 0x0800, 0x3E00, 0x4900, 0x0900, 0x0900, 0x0A00, 0x1C00, 0x2800, 0x4800, 0x4900, 0x3E00, 0x0800, 0x0000 }, // '$'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4200, 0x2500, 0x2500, 0x1200, 0x0800, 0x0800, 0x2400, 0x5200, 0x5200, 0x2100, 0x0000, 0x0000 }, // '%'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3100, 0x4A00, 0x4400, 0x4A00, 0x3100, 0x3000, 0x4800, 0x4800, 0x4800, 0x3000, 0x0000, 0x0000 }, // '&'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1000, 0x0800, 0x0400, 0x0600, 0x0000, 0x0000 }, // '''
+	{ 0x0000, 0x0000, 0x0000, 0x0400, 0x0800, 0x0800, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0800, 0x0800, 0x0400, 0x0000 }, // '('
+	{ 0x0000, 0x0000, 0x0000, 0x1000, 0x0800, 0x0800, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0800, 0x0800, 0x1000, 0x0000 }, // ')'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x4900, 0x2A00, 0x1C00, 0x2A00, 0x4900, 0x0800, 0x0000, 0x0000, 0x0000, 0x0000 }, // '*'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0800, 0x0800, 0x7F00, 0x0800, 0x0800, 0x0800, 0x0000, 0x0000, 0x0000, 0x0000 }, // '+'
+	{ 0x0000, 0x0800, 0x0400, 0x0400, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // ','
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // '-'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // '.'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4000, 0x2000, 0x2000, 0x1000, 0x0800, 0x0800, 0x0400, 0x0200, 0x0200, 0x0100, 0x0000, 0x0000 }, // '/'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x1C00, 0x2200, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x2200, 0x1C00, 0x0000, 0x0000 }, // '0'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x4800, 0x2800, 0x1800, 0x0800, 0x0000, 0x0000 }, // '1'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // '2'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x0100, 0x0100, 0x0100, 0x0E00, 0x0400, 0x0200, 0x0100, 0x7F00, 0x0000, 0x0000 }, // '3'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0200, 0x0200, 0x0200, 0x7F00, 0x4200, 0x2200, 0x1200, 0x0A00, 0x0600, 0x0200, 0x0000, 0x0000 }, // '4'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x0100, 0x0100, 0x0100, 0x6100, 0x5E00, 0x4000, 0x4000, 0x7F00, 0x0000, 0x0000 }, // '5'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4100, 0x4100, 0x6100, 0x5E00, 0x4000, 0x4000, 0x2000, 0x1E00, 0x0000, 0x0000 }, // '6'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x2000, 0x2000, 0x1000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100, 0x0100, 0x7F00, 0x0000, 0x0000 }, // '7'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x1C00, 0x2200, 0x4100, 0x4100, 0x2200, 0x1C00, 0x2200, 0x4100, 0x2200, 0x1C00, 0x0000, 0x0000 }, // '8'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3C00, 0x0200, 0x0100, 0x0100, 0x3D00, 0x4300, 0x4100, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // '9'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // ':'
+	{ 0x0000, 0x0800, 0x0400, 0x0400, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // ';'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0000, 0x0000 }, // '<'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x0000, 0x0000, 0x7F00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // '='
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x0000, 0x0000 }, // '>'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0000, 0x0800, 0x0800, 0x0400, 0x0200, 0x0100, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // '?'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4000, 0x4000, 0x4D00, 0x5300, 0x5100, 0x4F00, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // '@'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4100, 0x7F00, 0x4100, 0x4100, 0x4100, 0x2200, 0x1400, 0x0800, 0x0000, 0x0000 }, // 'A'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7E00, 0x2100, 0x2100, 0x2100, 0x2100, 0x7E00, 0x2100, 0x2100, 0x2100, 0x7E00, 0x0000, 0x0000 }, // 'B'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4100, 0x3E00, 0x0000, 0x0000 }, // 'C'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7E00, 0x2100, 0x2100, 0x2100, 0x2100, 0x2100, 0x2100, 0x2100, 0x2100, 0x7E00, 0x0000, 0x0000 }, // 'D'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x2000, 0x2000, 0x2000, 0x2000, 0x3C00, 0x2000, 0x2000, 0x2000, 0x7F00, 0x0000, 0x0000 }, // 'E'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x3C00, 0x2000, 0x2000, 0x2000, 0x7F00, 0x0000, 0x0000 }, // 'F'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4100, 0x4100, 0x4700, 0x4000, 0x4000, 0x4000, 0x4100, 0x3E00, 0x0000, 0x0000 }, // 'G'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x7F00, 0x4100, 0x4100, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'H'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x3E00, 0x0000, 0x0000 }, // 'I'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3C00, 0x4200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0F80, 0x0000, 0x0000 }, // 'J'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4200, 0x4400, 0x4800, 0x5000, 0x7000, 0x4800, 0x4400, 0x4200, 0x4100, 0x0000, 0x0000 }, // 'K'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000 }, // 'L'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4100, 0x4900, 0x4900, 0x5500, 0x5500, 0x6300, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'M'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4100, 0x4300, 0x4500, 0x4900, 0x5100, 0x6100, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'N'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // 'O'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x7E00, 0x4100, 0x4100, 0x4100, 0x7E00, 0x0000, 0x0000 }, // 'P'
+	{ 0x0000, 0x0000, 0x0300, 0x0400, 0x3E00, 0x4900, 0x5100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // 'Q'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4200, 0x4400, 0x4800, 0x7E00, 0x4100, 0x4100, 0x4100, 0x7E00, 0x0000, 0x0000 }, // 'R'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4100, 0x0100, 0x0600, 0x3800, 0x4000, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000 }, // 'S'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x7F00, 0x0000, 0x0000 }, // 'T'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'U'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x1400, 0x1400, 0x1400, 0x2200, 0x2200, 0x2200, 0x4100, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'V'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x2200, 0x5500, 0x4900, 0x4900, 0x4900, 0x4900, 0x4100, 0x4100, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'W'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x2200, 0x1400, 0x0800, 0x0800, 0x1400, 0x2200, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'X'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x1400, 0x2200, 0x4100, 0x4100, 0x0000, 0x0000 }, // 'Y'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x4000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100, 0x7F00, 0x0000, 0x0000 }, // 'Z'
+	{ 0x0000, 0x0000, 0x0000, 0x1E00, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1E00, 0x0000 }, // '['
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0100, 0x0200, 0x0200, 0x0400, 0x0800, 0x0800, 0x1000, 0x2000, 0x2000, 0x4000, 0x0000, 0x0000 }, // 'backslash'
+	{ 0x0000, 0x0000, 0x0000, 0x3C00, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x3C00, 0x0000 }, // ']'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x2200, 0x1400, 0x0800, 0x0000, 0x0000 }, // '^'
+	{ 0x0000, 0x0000, 0x0000, 0xFF00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // '_'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0400, 0x0800, 0x1000, 0x3000, 0x0000 }, // '`'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3D00, 0x4300, 0x4100, 0x3F00, 0x0100, 0x0100, 0x3E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'a'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x5E00, 0x6100, 0x4100, 0x4100, 0x4100, 0x6100, 0x5E00, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000 }, // 'b'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4000, 0x4000, 0x4000, 0x4100, 0x3E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'c'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3D00, 0x4300, 0x4100, 0x4100, 0x4100, 0x4300, 0x3D00, 0x0100, 0x0100, 0x0100, 0x0000, 0x0000 }, // 'd'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4000, 0x4000, 0x7F00, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'e'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x1000, 0x1000, 0x1000, 0x1000, 0x7C00, 0x1000, 0x1000, 0x1100, 0x1100, 0x0E00, 0x0000, 0x0000 }, // 'f'
+	{ 0x0000, 0x3E00, 0x4100, 0x4100, 0x3E00, 0x4000, 0x3C00, 0x4200, 0x4200, 0x4200, 0x3D00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'g'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x6100, 0x5E00, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000 }, // 'h'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x3800, 0x0000, 0x0000, 0x1800, 0x0000, 0x0000 }, // 'i'
+	{ 0x0000, 0x3C00, 0x4200, 0x4200, 0x4200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0E00, 0x0000, 0x0000, 0x0600, 0x0000, 0x0000 }, // 'j'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4600, 0x5800, 0x6000, 0x5800, 0x4600, 0x4100, 0x4000, 0x4000, 0x4000, 0x0000, 0x0000 }, // 'k'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x3800, 0x0000, 0x0000 }, // 'l'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4900, 0x4900, 0x4900, 0x4900, 0x4900, 0x7600, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'm'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x6100, 0x5E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'n'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x4100, 0x4100, 0x4100, 0x4100, 0x3E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'o'
+	{ 0x0000, 0x4000, 0x4000, 0x4000, 0x5E00, 0x6100, 0x4100, 0x4100, 0x4100, 0x6100, 0x5E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'p'
+	{ 0x0000, 0x0100, 0x0100, 0x0100, 0x3D00, 0x4300, 0x4100, 0x4100, 0x4100, 0x4300, 0x3D00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'q'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2100, 0x3100, 0x4E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'r'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3E00, 0x4100, 0x0100, 0x3E00, 0x4000, 0x4100, 0x3E00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 's'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0E00, 0x1100, 0x1000, 0x1000, 0x1000, 0x1000, 0x7E00, 0x1000, 0x1000, 0x0000, 0x0000, 0x0000 }, // 't'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x3D00, 0x4200, 0x4200, 0x4200, 0x4200, 0x4200, 0x4200, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'u'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x1400, 0x1400, 0x2200, 0x2200, 0x4100, 0x4100, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'v'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x2200, 0x5500, 0x4900, 0x4900, 0x4900, 0x4100, 0x4100, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'w'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x4100, 0x2200, 0x1400, 0x0800, 0x1400, 0x2200, 0x4100, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'x'
+	{ 0x0000, 0x3C00, 0x4200, 0x0200, 0x3A00, 0x4600, 0x4200, 0x4200, 0x4200, 0x4200, 0x4200, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'y'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x7F00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 }, // 'z'
+	{ 0x0000, 0x0000, 0x0000, 0x0700, 0x0800, 0x0800, 0x0800, 0x0400, 0x1800, 0x1800, 0x0400, 0x0800, 0x0800, 0x0800, 0x0700, 0x0000 }, // '{'
+	{ 0x0000, 0x0000, 0x0000, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0000 }, // '|'
+	{ 0x0000, 0x0000, 0x0000, 0x7000, 0x0800, 0x0800, 0x0800, 0x1000, 0x0C00, 0x0C00, 0x1000, 0x0800, 0x0800, 0x0800, 0x7000, 0x0000 }, // '}'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x4600, 0x4900, 0x3100, 0x0000, 0x0000 } // '~'
+};
+
+const int GLYPH_WIDTH = 9;
+const int GLYPH_HEIGHT = 16;
+const int GLYPH_BASELINE = 4;
+
+// atlas - 16 x 6 komrek 16 x 16 pikseli
+
+const int ATLAS_WIDTH = 256;
+const int ATLAS_HEIGHT = 128;
+const int ATLAS_COLUMNS = 16;
+const int ATLAS_CELL = 16;
+
+// wierzchoek czworokta: x, y, s, t, r, g, b
+
+const int TEXT_STRIDE = 7;
+
+static GLuint atlas = 0;
+static GLuint vertex_buffer = 0;
+static GLfloat color[3] = { 0.0f, 0.0f, 0.0f };
+
+// opis napisw biecej ramki i napisw, z ktrych utworzono tablic
+// czworoktw (pooenie, kolor, znaki)
+
+static std::string pending, cached;
+
+static std::vector<GLfloat> vertices;
+static int vertex_count = 0;
+static int rebuilds = 0;
+
+void TextColor(const GLfloat *rgb)
+{
+	memcpy(color, rgb, sizeof(color));
+}
+
+void TextAdd(GLint x, GLint y, const char *string)
+{
+	pending.append((const char*)&x, sizeof(x));
+	pending.append((const char*)&y, sizeof(y));
+	pending.append((const char*)color, sizeof(color));
+	pending.append(string, strlen(string) + 1);
+}
+
+// utworzenie tekstury atlasu (GL_ALPHA) ze znakw czcionki
+
+static void CreateAtlas()
+{
+	std::vector<GLubyte> pixels(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+	for (int c = 0; c < 95; c++)
+	{
+		const int x0 = (c % ATLAS_COLUMNS) * ATLAS_CELL, y0 = (c / ATLAS_COLUMNS) * ATLAS_CELL;
+		for (int row = 0; row < GLYPH_HEIGHT; row++)
+			for (int column = 0; column < GLYPH_WIDTH; column++)
+				if (font_9x15[c][row] & (0x8000 >> column))
+					pixels[(y0 + row) * ATLAS_WIDTH + x0 + column] = 255;
+	}
+
+	glGenTextures(1, &atlas);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_ALPHA, GL_UNSIGNED_BYTE, &pixels[0]);
+}
+
+// utworzenie tablicy czworoktw z opisu napisw
+
+static void BuildVertices()
+{
+	vertices.clear();
+	const char *p = cached.data(), *end = p + cached.size();
+	while (p < end)
+	{
+		GLint x, y;
+		GLfloat rgb[3];
+		memcpy(&x, p, sizeof(x));
+		p += sizeof(x);
+		memcpy(&y, p, sizeof(y));
+		p += sizeof(y);
+		memcpy(rgb, p, sizeof(rgb));
+		p += sizeof(rgb);
+
+		for (; *p; p++, x += GLYPH_WIDTH)
+		{
+			const int c = (unsigned char)*p - 32;
+			if (c <= 0 || c >= 95)
+				continue;
+
+			// naroniki w oknie i w atlasie
+			const GLfloat x0 = (GLfloat)x, y0 = (GLfloat)(y - GLYPH_BASELINE);
+			const GLfloat x1 = x0 + GLYPH_WIDTH, y1 = y0 + GLYPH_HEIGHT;
+			const GLfloat s0 = (GLfloat)((c % ATLAS_COLUMNS) * ATLAS_CELL) / ATLAS_WIDTH;
+			const GLfloat t0 = (GLfloat)((c / ATLAS_COLUMNS) * ATLAS_CELL) / ATLAS_HEIGHT;
+			const GLfloat s1 = s0 + (GLfloat)GLYPH_WIDTH / ATLAS_WIDTH;
+			const GLfloat t1 = t0 + (GLfloat)GLYPH_HEIGHT / ATLAS_HEIGHT;
+			const GLfloat quad[4][4] = { { x0, y0, s0, t0 }, { x1, y0, s1, t0 }, { x1, y1, s1, t1 }, { x0, y1, s0, t1 } };
+			for (int i = 0; i < 4; i++)
+			{
+				vertices.insert(vertices.end(), quad[i], quad[i] + 4);
+				vertices.insert(vertices.end(), rgb, rgb + 3);
+			}
+		}
+		p++;
+	}
+	vertex_count = (int)vertices.size() / TEXT_STRIDE;
+	rebuilds++;
+
+	if (buffer_objects && vertex_count > 0)
+	{
+		if (vertex_buffer == 0)
+			glGenBuffers(1, &vertex_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), &vertices[0], GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+}
+
+void TextFlush(int width, int height)
+{
+	// napisy inne ni w poprzedniej ramce - nowa tablica czworoktw
+	if (pending != cached)
+	{
+		cached.swap(pending);
+		BuildVertices();
+	}
+	pending.clear();
+	if (vertex_count == 0)
+		return;
+
+	glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT | GL_CLIENT_PIXEL_STORE_BIT);
+	if (atlas == 0)
+		CreateAtlas();
+
+	// piksele znakw - test alfa, kolor wierzchoka
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_FOG);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+	glEnable(GL_ALPHA_TEST);
+	glAlphaFunc(GL_GREATER, 0.5f);
+
+	// wsprzdne okna
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0.0, width, 0.0, height, -1.0, 1.0);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	const GLfloat *data = &vertices[0];
+	if (vertex_buffer)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+		data = NULL;
+	}
+	const GLsizei stride = TEXT_STRIDE * sizeof(GLfloat);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, stride, data);
+	glTexCoordPointer(2, GL_FLOAT, stride, data + 2);
+	glColorPointer(3, GL_FLOAT, stride, data + 4);
+	glDrawArrays(GL_QUADS, 0, vertex_count);
+	if (vertex_buffer)
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopClientAttrib();
+	glPopAttrib();
+}
+
+int TextRebuilds()
+{
+	return rebuilds;
+}
+
+void TextFree()
+{
+	if (atlas)
+		glDeleteTextures(1, &atlas);
+	if (vertex_buffer)
+		glDeleteBuffers(1, &vertex_buffer);
+	atlas = vertex_buffer = 0;
+	cached.clear();
+	vertex_count = 0;
+}
@@ -13,20 +13,26 @@ JanuszG@enter.net.pl
 #endif
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "colors.h"
 #include "targa.h"
-
-// wskanik na funkcj glWindowPos2i
-
-PFNGLWINDOWPOS2IPROC glWindowPos2i = NULL;
+#include "gl_state.h"
+#include "extensions.h"
+#include "text.h"
+#include "redraw.h"
+#include "profiler.h"
+#include "headless.h"
+#include "transform.h"
+#include "dynamic_resolution.h"
 
 // stae do obsugi menu podrcznego
 
 enum
 {
-	FULL_WINDOW,    // aspekt obrazu - cae okno
-	ASPECT_1_1,     // aspekt obrazu 1:1
-	EXIT            // wyjcie
+	FULL_WINDOW,            // aspekt obrazu - cae okno
+	ASPECT_1_1,             // aspekt obrazu 1:1
+	DYNAMIC_RESOLUTION,     // dynamiczna rozdzielczo: wcz/wycz
+	EXIT                    // wyjcie
 };
 
 // aspekt obrazu
@@ -76,6 +82,16 @@ GLuint GRASS, TREE;
 
 GLint GRASS_LIST, TREE_LIST;
 
+// liczba wierzchokw w listach wywietlania (do licznika wydajnoci)
+
+const int GRASS_VERTICES = 4, TREE_VERTICES = 6;
+
+// hierarchia przeksztace: kamera -> trawa i las (zmniejszony o poow)
+// -> trzy drzewa przesunite wzgldem siebie
+
+TransformHierarchy transforms;
+int CAMERA_NODE, GRASS_NODE, FOREST_NODE, TREE_NODES[3];
+
 // wczenie/wyczenie
 
 bool alpha_test = true;
@@ -83,23 +99,21 @@ bool alpha_test = true;
 bool blend = false;
 
 // funkcja rysujca napis w wybranym miejscu
-// (wersja korzystajca z funkcji glWindowPos2i)
+// (napisy s zbierane i rysowane razem z atlasu znakw w TextFlush)
 
 void DrawString(GLint x, GLint y, char *string)
 {
-	// poo?enie napisu
-	glWindowPos2i(x, y);
-
-	// wywietlenie napisu
-	int len = strlen(string);
-	for (int i = 0; i < len; i++)
-		glutBitmapCharacter(GLUT_BITMAP_9_BY_15, string[i]);
+	TextAdd(x, y, string);
 }
 
 // funkcja generujca scen 3D
 
 void DisplayScene()
 {
+	// scena 3D w rozdzielczoci dobranej do budetu czasu (przy wyczonej
+	// dynamicznej rozdzielczoci - bezporednio w oknie)
+	DynamicResolutionBegin();
+
 	// kolor ta - zawarto? bufora koloru
 	glClearColor(1.0, 1.0, 1.0, 1.0);
 
@@ -109,103 +123,133 @@ void DisplayScene()
 	// wybr macierzy modelowania
 	glMatrixMode(GL_MODELVIEW);
 
-	// macierz modelowania = macierz jednostkowa
-	glLoadIdentity();
-
-	// przesunicie ukadu wsprzdnych obiektw do rodka bryy odcinania
-	glTranslatef(0.0, 0.0, -(near + far) / 2);
-
-	// obroty obiektu
-	glRotatef(rotatex, 1.0, 0.0, 0.0);
-	glRotatef(rotatey, 0.0, 1.0, 0.0);
-
-	// skalowanie obiektu - klawisze "+" i "-"
-	glScalef(scale, scale, scale);
+	// macierz kamery: przesunicie ukadu wsprzdnych obiektw do rodka
+	// bryy odcinania, obroty obiektu i skalowanie - klawisze "+" i "-";
+	// macierze trawy i drzew s przeliczane tylko po zmianie kamery
+	Matrix camera = MatrixTranslation(0.0, 0.0, -(near + far) / 2);
+	camera = MatrixMultiply(camera, MatrixRotation(rotatex, 1.0, 0.0, 0.0));
+	camera = MatrixMultiply(camera, MatrixRotation(rotatey, 0.0, 1.0, 0.0));
+	camera = MatrixMultiply(camera, MatrixScaling(scale, scale, scale));
+	TransformSet(transforms, CAMERA_NODE, camera);
+	TransformUpdate(transforms);
 
 	// wczenie testu bufora gbokoci
-	glEnable(GL_DEPTH_TEST);
+	StateEnable(GL_DEPTH_TEST);
 
 	// wczenie teksturowania dwuwymiarowego
-	glEnable(GL_TEXTURE_2D);
+	StateEnable(GL_TEXTURE_2D);
 
 	// filtr powikszajcy
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	StateTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 	// filtr pomniejszajcy
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	StateTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 
 	// wskazwki do korekcji perspektywy przy renderingu tekstur
-	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+	StateHintMode(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 
 	// ustawienie parametw rodowiska tekstur
-	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+	StateTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
 
 	// wczenie/wyczenie testowania kanau alfa
 	if (alpha_test == GL_TRUE)
 	{
-		glEnable(GL_ALPHA_TEST);
-		glAlphaFunc(GL_GREATER, 0.5);
+		StateEnable(GL_ALPHA_TEST);
+		StateAlphaFunc(GL_GREATER, 0.5);
 	}
 	else
-		glDisable(GL_ALPHA_TEST);
+		StateDisable(GL_ALPHA_TEST);
 
 	// wczenie/wyczenie mieszania kolorw
 	if (blend == GL_TRUE)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		StateEnable(GL_BLEND);
+		StateBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 	else
-		glDisable(GL_BLEND);
+		StateDisable(GL_BLEND);
 
 	// rysowanie trawy
-	glBindTexture(GL_TEXTURE_2D, GRASS);
-	glPushMatrix();
-	glTranslatef(0.0, -0.5, 0.0);
+	StateBindTexture(GL_TEXTURE_2D, GRASS);
+	TransformLoad(transforms, GRASS_NODE);
 	glCallList(GRASS_LIST);
-	glPopMatrix();
+	ProfilerDraw(GRASS_VERTICES);
 
 	// rysowanie trzech drzew
-	glBindTexture(GL_TEXTURE_2D, TREE);
-	glPushMatrix();
-	glTranslatef(-0.5, 0.0, 0.0);
-	glScalef(0.5, 0.5, 0.5);
-	glCallList(TREE_LIST);
-	glTranslatef(1.0, 0.0, 0.5);
-	glCallList(TREE_LIST);
-	glTranslatef(1.0, 0.0, 0.5);
-	glCallList(TREE_LIST);
-	glPopMatrix();
+	StateBindTexture(GL_TEXTURE_2D, TREE);
+	for (int i = 0; i < 3; i++)
+	{
+		TransformLoad(transforms, TREE_NODES[i]);
+		glCallList(TREE_LIST);
+		ProfilerDraw(TREE_VERTICES);
+	}
 
 	// wyczenie teksturowania dwuwymiarowego
-	glDisable(GL_TEXTURE_2D);
+	StateDisable(GL_TEXTURE_2D);
+
+	// powikszenie sceny do rozmiarw okna - napisy i wykres maj pen
+	// rozdzielczo okna
+	DynamicResolutionEnd();
 
 	// wywietlenie wybranych informacje
 	char string[200];
-	GLboolean var;
-	glColor3fv(Black);
+	TextColor(Black);
 
-	// pobranie inforacji o wczeniu testowania kanau alfa
-	glGetBooleanv(GL_ALPHA_TEST, &var);
-	if (var == GL_TRUE)
+	// wczenie testowania kanau alfa (z pamici podrcznej stanu)
+	if (StateIsEnabled(GL_ALPHA_TEST) == GL_TRUE)
 		strcpy(string, "GL_ALPHA_TEST = GL_TRUE");
 	else
 		strcpy(string, "GL_ALPHA_TEST = GL_FALSE");
-	DrawString(2, glutGet(GLUT_WINDOW_HEIGHT) - 17, string);
+	DrawString(2, WindowHeight() - 17, string);
 
-	// pobranie informacji o wczeniu mieszania kolorw
-	glGetBooleanv(GL_BLEND, &var);
-	if (var == GL_TRUE)
+	// wczenie mieszania kolorw (z pamici podrcznej stanu)
+	if (StateIsEnabled(GL_BLEND) == GL_TRUE)
 		strcpy(string, "GL_BLEND = GL_TRUE");
 	else
 		strcpy(string, "GL_BLEND = GL_FALSE");
-	DrawString(2, glutGet(GLUT_WINDOW_HEIGHT) - 33, string);
+	DrawString(2, WindowHeight() - 33, string);
+
+	// wywoania zmieniajce stan w poprzedniej ramce - wysane i pominite
+	sprintf(string, "Stan OpenGL: %d wyslanych, %d pominietych", StateLastFrame().issued, StateLastFrame().filtered);
+	DrawString(2, WindowHeight() - 49, string);
+
+	// macierze w poprzedniej ramce - przeliczone i wzite z pamici
+	// podrcznej oraz zaadowane (glLoadMatrixf) i pominite
+	const TransformStats &transform_stats = TransformLastFrame(transforms);
+	sprintf(string, "Macierze: %d nowe, %d gotowe, %d wyslane, %d pominiete", transform_stats.updated,
+		transform_stats.cached, transform_stats.loads, transform_stats.skipped);
+	DrawString(2, WindowHeight() - 65, string);
+
+	// skala rozdzielczoci sceny w nastpnej ramce (w procentach)
+	if (DynamicResolutionEnabled())
+	{
+		sprintf(string, "Rozdzielczosc sceny: %d%%", (int)(100.0f * DynamicResolutionScale() + 0.5f));
+		DrawString(2, WindowHeight() - 81, string);
+	}
+
+	// zakoczenie ramki w liczniku wywoa zmieniajcych stan i w liczniku
+	// przeksztace
+	StateFrameEnd();
+	TransformFrameEnd(transforms);
+
+	// zmiany stanu (w tym zaadowane macierze) i dowizania tekstur w tej
+	// ramce - do licznika wydajnoci
+	ProfilerStateChanges(StateLastFrame().issued + TransformLastFrame(transforms).loads);
+	ProfilerTextureBind(StateLastFrame().texture_binds);
+
+	// wykres czasw ramek (bez okna pomijany - zapisywane ramki nie zale
+	// od wynikw pomiarw)
+	if (!Headless())
+		ProfilerOverlay(WindowWidth(), WindowHeight());
+
+	// narysowanie napisw
+	TextFlush(WindowWidth(), WindowHeight());
 
 	// skierowanie polece do wykonania
 	glFlush();
 
 	// zamiana buforw koloru
-	glutSwapBuffers();
+	WindowSwapBuffers();
 }
 
 // zmiana wielkoci okna
@@ -215,6 +259,9 @@ void Reshape(int width, int height)
 	// obszar renderingu - cae okno
 	glViewport(0, 0, width, height);
 
+	// rozmiary bufora ramki dynamicznej rozdzielczoci
+	DynamicResolutionReshape(width, height);
+
 	// wybr macierzy rzutowania
 	glMatrixMode(GL_PROJECTION);
 
@@ -237,7 +284,7 @@ void Reshape(int width, int height)
 		glFrustum(left, right, bottom, top, near, far);
 
 	// generowanie sceny 3D
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga klawiatury
@@ -254,7 +301,7 @@ void Keyboard(unsigned char key, int x, int y)
 			scale -= 0.05;
 
 	// narysowanie sceny
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga przyciskw myszki
@@ -285,7 +332,7 @@ void MouseMotion(int x, int y)
 		button_x = x;
 		rotatex -= 30 * (top - bottom) / glutGet(GLUT_WINDOW_HEIGHT) * (button_y - y);
 		button_y = y;
-		glutPostRedisplay();
+		RedrawRequest();
 	}
 }
 
@@ -361,13 +408,13 @@ void Menu(int value)
 		// test kanau alfa: wcz/wycz
 	case GL_ALPHA_TEST:
 		alpha_test = !alpha_test;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// mieszanie kolorw: wcz/wycz
 	case GL_BLEND:
 		blend = !blend;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// obszar renderingu - cae okno
@@ -382,6 +429,12 @@ void Menu(int value)
 		Reshape(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 		break;
 
+		// dynamiczna rozdzielczo: wcz/wycz
+	case DYNAMIC_RESOLUTION:
+		DynamicResolutionEnable(!DynamicResolutionEnabled());
+		RedrawRequest();
+		break;
+
 		// wyjcie
 	case EXIT:
 		exit(0);
@@ -439,6 +492,23 @@ void GenerateDisplayLists()
 	glEndList();
 }
 
+// utworzenie hierarchii przeksztace; macierz kamery jest ustawiana
+// w kadej ramce w funkcji DisplayScene
+
+void GenerateTransforms()
+{
+	CAMERA_NODE = TransformAdd(transforms, -1, MatrixIdentity());
+
+	// trawa
+	GRASS_NODE = TransformAdd(transforms, CAMERA_NODE, MatrixTranslation(0.0, -0.5, 0.0));
+
+	// las zmniejszony o poow, a w nim drzewa przesunite kolejno o (1, 0, 0.5)
+	FOREST_NODE = TransformAdd(transforms, CAMERA_NODE,
+		MatrixMultiply(MatrixTranslation(-0.5, 0.0, 0.0), MatrixScaling(0.5, 0.5, 0.5)));
+	for (int i = 0; i < 3; i++)
+		TREE_NODES[i] = TransformAdd(transforms, FOREST_NODE, MatrixTranslation(1.0 * i, 0.0, 0.5 * i));
+}
+
 // sprawdzenie i przygotowanie obsugi wybranych rozszerze
 
 void ExtensionSetup()
@@ -468,29 +538,18 @@ void ExtensionSetup()
 		printf("Brak rozszerzenia GL_SGIS_generate_mipmap!\n");
 		exit(0);
 	}
+}
 
-	// sprawdzenie czy jest co najmniej wersja 1.4
-	if (major > 1 || minor >= 4)
-	{
-		// pobranie wskanika wybranej funkcji OpenGL 1.4
-		glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress("glWindowPos2i");
-	}
-	else
-		// sprawdzenie czy jest obsugiwane rozszerzenie ARB_window_pos
-		if (glutExtensionSupported("GL_ARB_window_pos"))
-		{
-			// pobranie wskanika wybranej funkcji rozszerzenia ARB_window_pos
-			glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress
-				("glWindowPos2iARB");
-		}
-		else
-		{
-			printf("Brak rozszerzenia ARB_window_pos!\n");
-			exit(0);
-		}
+// scenariusz kamery w trybie bez okna - peny obrt sceny wok osi Y
+
+void HeadlessScript(int frame, int frames)
+{
+	rotatey = 360.0f * frame / frames;
 }
 
-int main(int argc, char *argv[])
+// utworzenie okna GLUT i menu podrcznego oraz doczenie funkcji obsugi zdarze
+
+void WindowSetup(int &argc, char *argv[])
 {
 	// inicjalizacja biblioteki GLUT
 	glutInit(&argc, argv);
@@ -505,7 +564,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Tekstura alfa");
 
 	// doczenie funkcji generujcej scen 3D
-	glutDisplayFunc(DisplayScene);
+	RedrawInit(ProfilerWrap(DisplayScene), 60);
 
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -539,17 +598,30 @@ int main(int argc, char *argv[])
 	glutAddMenuEntry("Test kanau alfa: wcz/wycz", GL_ALPHA_TEST);
 	glutAddMenuEntry("Mieszanie kolorw: wcz/wycz", GL_BLEND);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
+	glutAddMenuEntry("Dynamiczna rozdzielczo: wcz/wycz", DYNAMIC_RESOLUTION);
 	glutAddMenuEntry("Wyjcie", EXIT);
 #else
 
 	glutAddMenuEntry("Test kanalu alfa: wlacz/wylacz", GL_ALPHA_TEST);
 	glutAddMenuEntry("Mieszanie kolorow: wlacz/wylacz", GL_BLEND);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
+	glutAddMenuEntry("Dynamiczna rozdzielczosc: wlacz/wylacz", DYNAMIC_RESOLUTION);
 	glutAddMenuEntry("Wyjscie", EXIT);
 #endif
 
 	// okrelenie przycisku myszki obsugujcego menu podrczne
 	glutAttachMenu(GLUT_RIGHT_BUTTON);
+}
+
+int main(int argc, char *argv[])
+{
+	// tryb bez okna (opcja --headless) - kontekst w buforze pozaekranowym
+	const bool headless = HeadlessInit(argc, argv, 500, 500);
+
+	// opcja --frame-budget=MS - dynamiczna rozdzielczo od uruchomienia
+	DynamicResolutionOptions(argc, argv);
+	if (!headless)
+		WindowSetup(argc, argv);
 
 	// utworzenie tekstur
 	GenerateTextures();
@@ -557,9 +629,22 @@ int main(int argc, char *argv[])
 	// sprawdzenie i przygotowanie obsugi wybranych rozszerze
 	ExtensionSetup();
 
+	// obiekty buforowe dla napisw i zapytania o czas GPU
+	ExtensionFunctionsSetup();
+
+	// pomiar czasw ramek, dane ramek w pliku Program2_profile.csv
+	ProfilerInit("Program2_profile.csv");
+
 	// utworzenie list wywietlania
 	GenerateDisplayLists();
 
+	// utworzenie hierarchii przeksztace
+	GenerateTransforms();
+
+	// bez okna - narysowanie ramek wedug scenariusza kamery
+	if (headless)
+		return HeadlessRun(ProfilerWrap(DisplayScene), Reshape, HeadlessScript);
+
 	// wprowadzenie programu do obsugi ptli komunikatw
 	glutMainLoop();
 	return 0;
@@ -0,0 +1,232 @@
+#include "gl_state.h"
+#include <string.h>
+#include <unordered_map>
+
+// rodzaje zapamitywanych wartoci (najstarszy bajt klucza)
+
+enum
+{
+	STATE_ENABLE = 1,
+	STATE_BIND_TEXTURE,
+	STATE_TEX_PARAMETER,
+	STATE_TEX_ENV,
+	STATE_HINT,
+	STATE_BLEND_FUNC,
+	STATE_ALPHA_FUNC,
+	STATE_FOG,
+	STATE_LIGHT
+};
+
+// zapamitana warto (do 4 skadowych)
+
+struct StateValue
+{
+	GLfloat value[4];
+};
+
+static std::unordered_map<unsigned long long, StateValue> shadow;
+
+static StateStats frame_stats, last_frame_stats;
+
+// klucz: rodzaj (8 bitw), dwa wyliczenia OpenGL (po 16 bitw) i obiekt (24 bity)
+
+static unsigned long long Key(int kind, GLenum a, GLenum b = 0, GLuint object = 0)
+{
+	return (unsigned long long)kind << 56 | (unsigned long long)(a & 0xFFFF) << 40 |
+		(unsigned long long)(b & 0xFFFF) << 24 | (object & 0xFFFFFF);
+}
+
+// porwnanie z zapamitan wartoci i jej aktualizacja; zwraca true,
+// gdy wywoanie musi by przekazane do OpenGL
+
+static bool Changed(unsigned long long key, const GLfloat *value, int count)
+{
+	std::unordered_map<unsigned long long, StateValue>::iterator it = shadow.find(key);
+	if (it != shadow.end() && memcmp(it->second.value, value, count * sizeof(GLfloat)) == 0)
+	{
+		frame_stats.filtered++;
+		return false;
+	}
+	StateValue &state = shadow[key];
+	memcpy(state.value, value, count * sizeof(GLfloat));
+	frame_stats.issued++;
+	return true;
+}
+
+static bool Changed(unsigned long long key, GLfloat value)
+{
+	return Changed(key, &value, 1);
+}
+
+void StateEnable(GLenum cap)
+{
+	if (Changed(Key(STATE_ENABLE, cap), 1.0f))
+		glEnable(cap);
+}
+
+void StateDisable(GLenum cap)
+{
+	if (Changed(Key(STATE_ENABLE, cap), 0.0f))
+		glDisable(cap);
+}
+
+void StateBindTexture(GLenum target, GLuint texture)
+{
+	// nazwa tekstury zapisana bez utraty dokadnoci
+	GLfloat name;
+	memcpy(&name, &texture, sizeof(name));
+	if (Changed(Key(STATE_BIND_TEXTURE, target), name))
+	{
+		frame_stats.texture_binds++;
+		glBindTexture(target, texture);
+	}
+}
+
+void StateTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	// bez znanej tekstury dowizanej do celu nie ma z czym porwna
+	std::unordered_map<unsigned long long, StateValue>::iterator bound = shadow.find(Key(STATE_BIND_TEXTURE, target));
+	if (bound == shadow.end())
+	{
+		frame_stats.issued++;
+		glTexParameteri(target, pname, param);
+		return;
+	}
+	GLuint texture;
+	memcpy(&texture, bound->second.value, sizeof(texture));
+	if (Changed(Key(STATE_TEX_PARAMETER, target, pname, texture), (GLfloat)param))
+		glTexParameteri(target, pname, param);
+}
+
+void StateTexEnvi(GLenum target, GLenum pname, GLint param)
+{
+	if (Changed(Key(STATE_TEX_ENV, target, pname), (GLfloat)param))
+		glTexEnvi(target, pname, param);
+}
+
+void StateHintMode(GLenum target, GLenum mode)
+{
+	if (Changed(Key(STATE_HINT, target), (GLfloat)mode))
+		glHint(target, mode);
+}
+
+void StateBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	const GLfloat value[] = { (GLfloat)sfactor, (GLfloat)dfactor };
+	if (Changed(Key(STATE_BLEND_FUNC, 0), value, 2))
+		glBlendFunc(sfactor, dfactor);
+}
+
+void StateAlphaFunc(GLenum func, GLclampf ref)
+{
+	const GLfloat value[] = { (GLfloat)func, ref };
+	if (Changed(Key(STATE_ALPHA_FUNC, 0), value, 2))
+		glAlphaFunc(func, ref);
+}
+
+void StateFogf(GLenum pname, GLfloat param)
+{
+	if (Changed(Key(STATE_FOG, pname), param))
+		glFogf(pname, param);
+}
+
+void StateFogfv(GLenum pname, const GLfloat *params)
+{
+	// GL_FOG_COLOR - 4 skadowe, pozostae parametry - 1
+	if (Changed(Key(STATE_FOG, pname), params, pname == GL_FOG_COLOR ? 4 : 1))
+		glFogfv(pname, params);
+}
+
+void StateLightf(GLenum light, GLenum pname, GLfloat param)
+{
+	if (Changed(Key(STATE_LIGHT, light, pname), param))
+		glLightf(light, pname, param);
+}
+
+void StateLightfv(GLenum light, GLenum pname, const GLfloat *params)
+{
+	if (pname == GL_POSITION || pname == GL_SPOT_DIRECTION)
+	{
+		frame_stats.issued++;
+		glLightfv(light, pname, params);
+		return;
+	}
+
+	// GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR - 4 skadowe, pozostae - 1
+	const int count = (pname == GL_AMBIENT || pname == GL_DIFFUSE || pname == GL_SPECULAR) ? 4 : 1;
+	if (Changed(Key(STATE_LIGHT, light, pname), params, count))
+		glLightfv(light, pname, params);
+}
+
+// warto z pamici podrcznej lub NULL
+
+static const GLfloat *Cached(unsigned long long key)
+{
+	std::unordered_map<unsigned long long, StateValue>::iterator it = shadow.find(key);
+	return it == shadow.end() ? NULL : it->second.value;
+}
+
+// zapamitanie wartoci pobranej z OpenGL
+
+static void Store(unsigned long long key, GLfloat value)
+{
+	frame_stats.queried++;
+	shadow[key].value[0] = value;
+}
+
+GLboolean StateIsEnabled(GLenum cap)
+{
+	const unsigned long long key = Key(STATE_ENABLE, cap);
+	if (const GLfloat *value = Cached(key))
+		return *value != 0.0f ? GL_TRUE : GL_FALSE;
+	const GLboolean enabled = glIsEnabled(cap);
+	Store(key, enabled ? 1.0f : 0.0f);
+	return enabled;
+}
+
+GLint StateGetTexParameteri(GLenum target, GLenum pname)
+{
+	GLint param;
+	const GLfloat *bound = Cached(Key(STATE_BIND_TEXTURE, target));
+	if (bound == NULL)
+	{
+		frame_stats.queried++;
+		glGetTexParameteriv(target, pname, &param);
+		return param;
+	}
+	GLuint texture;
+	memcpy(&texture, bound, sizeof(texture));
+	const unsigned long long key = Key(STATE_TEX_PARAMETER, target, pname, texture);
+	if (const GLfloat *value = Cached(key))
+		return (GLint)*value;
+	glGetTexParameteriv(target, pname, &param);
+	Store(key, (GLfloat)param);
+	return param;
+}
+
+GLint StateGetHint(GLenum target)
+{
+	const unsigned long long key = Key(STATE_HINT, target);
+	if (const GLfloat *value = Cached(key))
+		return (GLint)*value;
+	GLint mode;
+	glGetIntegerv(target, &mode);
+	Store(key, (GLfloat)mode);
+	return mode;
+}
+
+void StateInvalidate()
+{
+	shadow.clear();
+}
+
+void StateFrameEnd()
+{
+	last_frame_stats = frame_stats;
+	frame_stats = StateStats();
+}
+
+const StateStats &StateLastFrame()
+{
+	return last_frame_stats;
+}
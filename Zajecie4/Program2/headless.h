@@ -0,0 +1,50 @@
+#ifndef __HEADLESS__H__
+#define __HEADLESS__H__
+
+#include <GL/glut.h>
+
+// tryb bez okna: z opcj --headless program zamiast okna GLUT tworzy
+// kontekst OpenGL w buforze pozaekranowym (EGL pbuffer, bez serwera X -
+// platforma "surfaceless" Mesa; OSMesa po zdefiniowaniu HEADLESS_OSMESA),
+// rysuje zadan liczb ramek wedug scenariusza kamery i zapisuje je
+// w plikach TGA; wymaga biblioteki libEGL (lub libOSMesa), w systemie
+// Windows tryb jest niedostpny; w programie skompilowanym z programow
+// implementacj OpenGL (SOFT_GL, soft_gl.h) tryb bez okna jest wczony
+// zawsze i dziaa rwnie w systemie Windows
+//
+// opcje (usuwane z argv, pozostae argumenty programu bez zmian):
+// --headless          tryb bez okna
+// --frames=N          liczba ramek (domylnie 60)
+// --size=SZERxWYS     rozmiary bufora ramki (domylnie rozmiary okna)
+// --output=PREFIKS    prefiks nazw plikw TGA (domylnie "frame")
+// --save-every=N      zapis co N-tej ramki (domylnie 1, 0 - bez zapisu)
+// --threads=N         liczba wtkw rasteryzacji (tylko SOFT_GL; domylnie
+//                     liczba rdzeni procesora)
+
+// odczyt opcji i utworzenie kontekstu w trybie bez okna; zwraca true,
+// gdy program ma dziaa bez okna (bez wywoa glutInit i glutCreateWindow);
+// width, height - rozmiary okna programu
+
+bool HeadlessInit(int &argc, char *argv[], int width, int height);
+
+// true - program dziaa w trybie bez okna
+
+bool Headless();
+
+// narysowanie ramek w trybie bez okna: reshape jest wywoywana raz
+// z rozmiarami bufora, przed kad ramk script ustawia kamer i stan
+// animacji dla ramki frame z frames (deterministycznie - bez zegara);
+// zwraca kod zakoczenia programu
+
+int HeadlessRun(void(*display)(), void(*reshape)(int width, int height),
+	void(*script)(int frame, int frames));
+
+// rozmiary okna (w trybie bez okna - bufora ramki) i zamiana buforw;
+// zastpuj glutGet(GLUT_WINDOW_WIDTH/HEIGHT) i glutSwapBuffers
+// w funkcjach wywoywanych w obu trybach
+
+int WindowWidth();
+int WindowHeight();
+void WindowSwapBuffers();
+
+#endif // __HEADLESS__H__
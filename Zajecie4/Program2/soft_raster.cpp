@@ -0,0 +1,1136 @@
+#include "soft_raster.h"
+#include <GL/glext.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_SSE
+#endif
+
+// 4 wartoci float dla 4 ssiednich pikseli wiersza; operacje bez FMA,
+// wic wersja SSE i skalarna daj identyczne wyniki
+
+#ifdef RASTER_SSE
+
+struct Float4
+{
+	__m128 v;
+};
+
+static inline Float4 Set1(float a) { Float4 r = { _mm_set1_ps(a) }; return r; }
+static inline Float4 Ramp(float a) { Float4 r = { _mm_add_ps(_mm_set1_ps(a), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)) }; return r; }
+static inline Float4 Load(const float *p) { Float4 r = { _mm_loadu_ps(p) }; return r; }
+static inline void Store(float *p, Float4 a) { _mm_storeu_ps(p, a.v); }
+static inline Float4 Add(Float4 a, Float4 b) { Float4 r = { _mm_add_ps(a.v, b.v) }; return r; }
+static inline Float4 Sub(Float4 a, Float4 b) { Float4 r = { _mm_sub_ps(a.v, b.v) }; return r; }
+static inline Float4 Mul(Float4 a, Float4 b) { Float4 r = { _mm_mul_ps(a.v, b.v) }; return r; }
+static inline Float4 Div(Float4 a, Float4 b) { Float4 r = { _mm_div_ps(a.v, b.v) }; return r; }
+static inline Float4 Min(Float4 a, Float4 b) { Float4 r = { _mm_min_ps(a.v, b.v) }; return r; }
+static inline Float4 Max(Float4 a, Float4 b) { Float4 r = { _mm_max_ps(a.v, b.v) }; return r; }
+
+// maski bitowe pikseli (bit k - piksel k), dla ktrych a > b i a == b
+
+static inline int Greater(Float4 a, Float4 b) { return _mm_movemask_ps(_mm_cmpgt_ps(a.v, b.v)); }
+static inline int Equal(Float4 a, Float4 b) { return _mm_movemask_ps(_mm_cmpeq_ps(a.v, b.v)); }
+
+// cz cakowita (w d) 4 wartoci
+
+static inline void StoreFloor(int *p, Float4 a)
+{
+	const __m128i i = _mm_cvttps_epi32(a.v);
+	const __m128 below = _mm_cmplt_ps(a.v, _mm_cvtepi32_ps(i));
+	_mm_storeu_si128((__m128i*)p, _mm_add_epi32(i, _mm_castps_si128(below)));
+}
+
+// interpolacja liniowa 4 par tekseli RGBA8: (a * (256 - w) + b * w) / 256
+// dla kadej skadowej, w z przedziau [0, 256] (osobno dla kadej pary)
+
+static inline void Lerp4(const GLuint *a, const GLuint *b, const int *w, GLuint *out)
+{
+	const __m128i zero = _mm_setzero_si128(), full = _mm_set1_epi16(256);
+	const __m128i A = _mm_loadu_si128((const __m128i*)a), B = _mm_loadu_si128((const __m128i*)b);
+	__m128i W = _mm_loadu_si128((const __m128i*)w);
+	W = _mm_or_si128(W, _mm_slli_epi32(W, 16));
+	const __m128i W0 = _mm_unpacklo_epi32(W, W), W1 = _mm_unpackhi_epi32(W, W);
+	const __m128i R0 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(A, zero), _mm_sub_epi16(full, W0)),
+		_mm_mullo_epi16(_mm_unpacklo_epi8(B, zero), W0)), 8);
+	const __m128i R1 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(A, zero), _mm_sub_epi16(full, W1)),
+		_mm_mullo_epi16(_mm_unpackhi_epi8(B, zero), W1)), 8);
+	_mm_storeu_si128((__m128i*)out, _mm_packus_epi16(R0, R1));
+}
+
+#else
+
+struct Float4
+{
+	float v[4];
+};
+
+static inline Float4 Set1(float a) { Float4 r = { { a, a, a, a } }; return r; }
+static inline Float4 Ramp(float a) { Float4 r = { { a, a + 1.0f, a + 2.0f, a + 3.0f } }; return r; }
+static inline Float4 Load(const float *p) { Float4 r = { { p[0], p[1], p[2], p[3] } }; return r; }
+static inline void Store(float *p, Float4 a) { memcpy(p, a.v, sizeof(a.v)); }
+
+#define FLOAT4_OP(name, expr) \
+	static inline Float4 name(Float4 a, Float4 b) \
+	{ \
+		Float4 r; \
+		for (int k = 0; k < 4; k++) \
+			r.v[k] = expr; \
+		return r; \
+	}
+
+FLOAT4_OP(Add, a.v[k] + b.v[k])
+FLOAT4_OP(Sub, a.v[k] - b.v[k])
+FLOAT4_OP(Mul, a.v[k] * b.v[k])
+FLOAT4_OP(Div, a.v[k] / b.v[k])
+FLOAT4_OP(Min, b.v[k] < a.v[k] ? b.v[k] : a.v[k])
+FLOAT4_OP(Max, b.v[k] > a.v[k] ? b.v[k] : a.v[k])
+
+static inline int Greater(Float4 a, Float4 b)
+{
+	int mask = 0;
+	for (int k = 0; k < 4; k++)
+		mask |= (a.v[k] > b.v[k]) << k;
+	return mask;
+}
+
+static inline int Equal(Float4 a, Float4 b)
+{
+	int mask = 0;
+	for (int k = 0; k < 4; k++)
+		mask |= (a.v[k] == b.v[k]) << k;
+	return mask;
+}
+
+static inline void StoreFloor(int *p, Float4 a)
+{
+	for (int k = 0; k < 4; k++)
+	{
+		const int i = (int)a.v[k];
+		p[k] = i - (a.v[k] < (float)i);
+	}
+}
+
+// dwie skadowe (R i B, G i A) w jednym mnoeniu 32-bitowym
+
+static inline void Lerp4(const GLuint *a, const GLuint *b, const int *w, GLuint *out)
+{
+	for (int k = 0; k < 4; k++)
+	{
+		const GLuint rb = ((a[k] & 0x00FF00FF) * (256 - w[k]) + (b[k] & 0x00FF00FF) * w[k]) >> 8 & 0x00FF00FF;
+		const GLuint ga = ((a[k] >> 8 & 0x00FF00FF) * (256 - w[k]) + (b[k] >> 8 & 0x00FF00FF) * w[k]) & 0xFF00FF00;
+		out[k] = rb | ga;
+	}
+}
+
+#endif
+
+// paszczyzna wartoci w oknie: a * x + b * y + c
+
+struct Plane
+{
+	GLfloat a, b, c;
+};
+
+// wartoci paszczyzny w 4 pikselach wiersza: X - rodki pikseli,
+// row - b * y + c dla wiersza
+
+static inline Float4 Evaluate(const Plane &p, Float4 X, float row)
+{
+	return Add(Mul(Set1(p.a), X), Set1(row));
+}
+
+// atrybuty interpolowane w trjkcie (pomnoone przez q)
+
+enum
+{
+	ATTRIBUTE_R,
+	ATTRIBUTE_G,
+	ATTRIBUTE_B,
+	ATTRIBUTE_A,
+	ATTRIBUTE_S,
+	ATTRIBUTE_T,
+	ATTRIBUTE_FOG,
+	ATTRIBUTE_COUNT
+};
+
+// trjkt po przygotowaniu: prostokt otaczajcy (piksele, x1 i y1
+// poza prostoktem), funkcje krawdzi (dodatnie wewntrz) i paszczyzny
+// gbi, q i atrybutw
+
+struct TriangleSetup
+{
+	int x0, y0, x1, y1;
+	Plane edge[3];
+	int top_left;                 // bit i - krawd i grna lub lewa
+	Plane z, q;
+	Plane attribute[ATTRIBUTE_COUNT];
+};
+
+// punkt - kwadrat pikseli o staych atrybutach
+
+struct PointSetup
+{
+	int x0, y0, x1, y1;
+	GLfloat z;
+	GLfloat color[4];
+	GLfloat s, t, fog;
+};
+
+struct ClearSetup
+{
+	bool color, depth;
+	GLuint color_value;
+	GLfloat depth_value;
+};
+
+// polecenie w kolejce: rodzaj, stan i numer danych w tablicy rodzaju
+
+enum
+{
+	COMMAND_TRIANGLE,
+	COMMAND_POINT,
+	COMMAND_CLEAR
+};
+
+struct Command
+{
+	int type;
+	int state;
+	int index;
+};
+
+// bufor ramki; wiersz ma stride pikseli (szeroko zaokrglona do
+// wielokrotnoci 4), wiersz 0 - d obrazu
+
+static int width = 0, height = 0, stride = 0;
+static std::vector<GLuint> color_buffer;
+static std::vector<GLfloat> depth_buffer;
+
+// kafelki i listy polece kafelkw (numery polece w kolejnoci przekazania)
+
+static int tile_columns = 0, tile_rows = 0, tile_count = 0;
+static std::vector<std::vector<int> > bins;
+
+// kolejka polece do najbliszego RasterFlush
+
+static std::vector<Command> commands;
+static std::vector<TriangleSetup> triangles;
+static std::vector<PointSetup> points;
+static std::vector<ClearSetup> clears;
+static std::vector<RasterState> states;
+static RasterState current;
+static int current_index = -1;    // -1 - stan current nie jest jeszcze w states
+
+// pula wtkw: wtki pomocnicze czekaj na kolejne pokolenie pracy,
+// kafelki s pobierane ze wsplnego licznika
+
+static std::vector<std::thread> workers;
+static std::mutex pool_mutex;
+static std::condition_variable pool_start, pool_done;
+static int pool_generation = 0, pool_busy = 0;
+static bool pool_quit = false;
+static std::atomic<int> next_tile(0);
+
+// najmniejsza rnica wartoci bufora gbokoci (jak przy buforze 24-bitowym)
+// - jednostka przesunicia glPolygonOffset
+
+const GLfloat DEPTH_UNIT = 1.0f / 16777215.0f;
+
+static inline GLfloat Clamp(GLfloat value)
+{
+	return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+}
+
+static inline GLuint Pack(const GLfloat *color)
+{
+	return (GLuint)(Clamp(color[0]) * 255.0f + 0.5f) | (GLuint)(Clamp(color[1]) * 255.0f + 0.5f) << 8 |
+		(GLuint)(Clamp(color[2]) * 255.0f + 0.5f) << 16 | 0xFF000000u;
+}
+
+static inline void Unpack(GLuint texel, GLfloat *color)
+{
+	const GLfloat scale = 1.0f / 255.0f;
+	color[0] = (texel & 0xFF) * scale;
+	color[1] = (texel >> 8 & 0xFF) * scale;
+	color[2] = (texel >> 16 & 0xFF) * scale;
+	color[3] = (texel >> 24) * scale;
+}
+
+// porwnanie (test alfa i test gbokoci)
+
+static inline bool Compare(GLenum func, GLfloat value, GLfloat reference)
+{
+	switch (func)
+	{
+	case GL_NEVER:
+		return false;
+	case GL_LESS:
+		return value < reference;
+	case GL_EQUAL:
+		return value == reference;
+	case GL_LEQUAL:
+		return value <= reference;
+	case GL_GREATER:
+		return value > reference;
+	case GL_NOTEQUAL:
+		return value != reference;
+	case GL_GEQUAL:
+		return value >= reference;
+	default:
+		return true;
+	}
+}
+
+// maska pikseli, ktre przechodz test gbokoci (Z - nowe wartoci,
+// D - bufor)
+
+static inline int DepthTest(GLenum func, Float4 Z, Float4 D)
+{
+	switch (func)
+	{
+	case GL_NEVER:
+		return 0;
+	case GL_LESS:
+		return Greater(D, Z);
+	case GL_EQUAL:
+		return Equal(Z, D);
+	case GL_LEQUAL:
+		return ~Greater(Z, D) & 15;
+	case GL_GREATER:
+		return Greater(Z, D);
+	case GL_NOTEQUAL:
+		return ~Equal(Z, D) & 15;
+	case GL_GEQUAL:
+		return ~Greater(D, Z) & 15;
+	default:
+		return 15;
+	}
+}
+
+// prbkowanie tekstur - 4 piksele grupy naraz, ze wsplnym poziomem
+// szczegowoci (jak przy obliczaniu pochodnych dla blokw pikseli);
+// wsprzdne w tekselach w staym przecinku (8 bitw czci uamkowej),
+// interpolacja liniowa na tekselach RGBA8
+
+static inline int Wrap(int i, int size, GLenum mode)
+{
+	if (mode == GL_REPEAT)
+	{
+		if ((size & (size - 1)) == 0)
+			return i & (size - 1);
+		i %= size;
+		return i < 0 ? i + size : i;
+	}
+	return i < 0 ? 0 : (i >= size ? size - 1 : i);
+}
+
+// zawinicie 4 indeksw tekseli (jak Wrap); GL_REPEAT przy rozmiarze
+// innym ni potga 2 - reszta z dzielenia liczona na liczbach float
+// z korekt ilorazu o 1 (dokadnie dla |i| < 2^23; wiksze indeksy, np.
+// pikseli spoza trjkta, zawija Wrap)
+
+#ifdef RASTER_SSE
+
+static inline void Wrap4(int *i, int size, GLenum mode)
+{
+	__m128i I = _mm_loadu_si128((const __m128i*)i);
+	if (mode == GL_REPEAT && (size & (size - 1)) == 0)
+		I = _mm_and_si128(I, _mm_set1_epi32(size - 1));
+	else if (mode == GL_REPEAT)
+	{
+		const __m128i limit = _mm_set1_epi32(1 << 23);
+		if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi32(I, limit),
+			_mm_cmplt_epi32(I, _mm_sub_epi32(_mm_setzero_si128(), limit)))))
+		{
+			for (int k = 0; k < 4; k++)
+				i[k] = Wrap(i[k], size, mode);
+			return;
+		}
+		const __m128 S = _mm_set1_ps((GLfloat)size), F = _mm_cvtepi32_ps(I);
+		const __m128 Q = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(F, _mm_set1_ps(1.0f / size))));
+		__m128 R = _mm_sub_ps(F, _mm_mul_ps(Q, S));
+		R = _mm_add_ps(R, _mm_and_ps(_mm_cmplt_ps(R, _mm_setzero_ps()), S));
+		R = _mm_sub_ps(R, _mm_and_ps(_mm_cmpge_ps(R, S), S));
+		I = _mm_cvttps_epi32(R);
+	}
+	else
+	{
+		const __m128i last = _mm_set1_epi32(size - 1);
+		I = _mm_andnot_si128(_mm_cmplt_epi32(I, _mm_setzero_si128()), I);
+		const __m128i above = _mm_cmpgt_epi32(I, last);
+		I = _mm_or_si128(_mm_and_si128(above, last), _mm_andnot_si128(above, I));
+	}
+	_mm_storeu_si128((__m128i*)i, I);
+}
+
+#else
+
+static inline void Wrap4(int *i, int size, GLenum mode)
+{
+	for (int k = 0; k < 4; k++)
+		i[k] = Wrap(i[k], size, mode);
+}
+
+#endif
+
+// prbki poziomu level dla pikseli z maski mask (pozostae - 0); indeksy
+// tekseli s liczone dla wszystkich 4 pikseli (po zawiniciu zawsze
+// wskazuj teksele poziomu)
+
+static void SampleLevel(const RasterTexture &texture, int level_index, bool linear, Float4 s, Float4 t, int mask,
+	GLuint *out)
+{
+	const RasterLevel &level = texture.levels[level_index];
+	const GLuint *texels = level.texels.data();
+	const bool two_dimensional = texture.dimensions == 2;
+	const Float4 width = Set1((GLfloat)level.width), height = Set1((GLfloat)level.height);
+	int u[4], v[4] = { 0, 0, 0, 0 };
+	if (!linear)
+	{
+		StoreFloor(u, Mul(s, width));
+		if (two_dimensional)
+			StoreFloor(v, Mul(t, height));
+		Wrap4(u, level.width, texture.wrap_s);
+		Wrap4(v, level.height, texture.wrap_t);
+		for (int k = 0; k < 4; k++)
+			out[k] = texels[v[k] * level.width + u[k]];
+	}
+	else
+	{
+		const Float4 half = Set1(0.5f), scale = Set1(256.0f);
+		StoreFloor(u, Mul(Sub(Mul(s, width), half), scale));
+		if (two_dimensional)
+			StoreFloor(v, Mul(Sub(Mul(t, height), half), scale));
+		int a[4], b[4], i0[4], i1[4], j0[4], j1[4];
+		for (int k = 0; k < 4; k++)
+		{
+			a[k] = u[k] & 0xFF;
+			b[k] = v[k] & 0xFF;
+			i0[k] = u[k] >> 8;
+			i1[k] = i0[k] + 1;
+			j0[k] = v[k] >> 8;
+			j1[k] = j0[k] + two_dimensional;
+		}
+		Wrap4(i0, level.width, texture.wrap_s);
+		Wrap4(j0, level.height, texture.wrap_t);
+		if (texture.wrap_s == GL_REPEAT)
+			for (int k = 0; k < 4; k++)
+				i1[k] = i0[k] + 1 == level.width ? 0 : i0[k] + 1;
+		else
+			Wrap4(i1, level.width, texture.wrap_s);
+		if (texture.wrap_t == GL_REPEAT)
+			for (int k = 0; k < 4; k++)
+				j1[k] = j0[k] + two_dimensional == level.height ? 0 : j0[k] + two_dimensional;
+		else
+			Wrap4(j1, level.height, texture.wrap_t);
+		GLuint t00[4], t10[4], t01[4], t11[4];
+		for (int k = 0; k < 4; k++)
+		{
+			const GLuint *row0 = &texels[j0[k] * level.width], *row1 = &texels[j1[k] * level.width];
+			t00[k] = row0[i0[k]];
+			t10[k] = row0[i1[k]];
+			t01[k] = row1[i0[k]];
+			t11[k] = row1[i1[k]];
+		}
+		GLuint top[4], bottom[4];
+		Lerp4(t00, t10, a, top);
+		Lerp4(t01, t11, a, bottom);
+		Lerp4(top, bottom, b, out);
+	}
+	if (mask != 15)
+		for (int k = 0; k < 4; k++)
+			if (!(mask >> k & 1))
+				out[k] = 0;
+}
+
+// prbki tekstury dla wspczynnika poziomu szczegowoci lambda
+// (log2 rozmiaru piksela w tekselach)
+
+static void Sample(const RasterTexture &texture, Float4 s, Float4 t, GLfloat lambda, int mask, GLuint *out)
+{
+	// granica powikszenia i pomniejszenia
+	const GLenum min = texture.min_filter;
+	const GLfloat c = texture.mag_filter == GL_LINEAR &&
+		(min == GL_NEAREST_MIPMAP_NEAREST || min == GL_NEAREST_MIPMAP_LINEAR) ? 0.5f : 0.0f;
+	if (lambda <= c)
+	{
+		SampleLevel(texture, 0, texture.mag_filter == GL_LINEAR, s, t, mask, out);
+		return;
+	}
+
+	const int last = (int)texture.levels.size() - 1;
+	switch (min)
+	{
+	case GL_NEAREST:
+	case GL_LINEAR:
+		SampleLevel(texture, 0, min == GL_LINEAR, s, t, mask, out);
+		break;
+
+	case GL_NEAREST_MIPMAP_NEAREST:
+	case GL_LINEAR_MIPMAP_NEAREST:
+	{
+		const int level = lambda <= 0.5f ? 0 : (int)ceilf(lambda + 0.5f) - 1;
+		SampleLevel(texture, std::min(level, last), min == GL_LINEAR_MIPMAP_NEAREST, s, t, mask, out);
+		break;
+	}
+
+	default:
+	{
+		const bool linear = min == GL_LINEAR_MIPMAP_LINEAR;
+		if (lambda >= last)
+		{
+			SampleLevel(texture, last, linear, s, t, mask, out);
+			break;
+		}
+		const int level = (int)lambda;
+		const int f = (int)((lambda - level) * 256.0f);
+		const int weights[4] = { f, f, f, f };
+		GLuint next[4];
+		SampleLevel(texture, level, linear, s, t, mask, out);
+		SampleLevel(texture, level + 1, linear, s, t, mask, next);
+		Lerp4(out, next, weights, out);
+		break;
+	}
+	}
+}
+
+// przyblienie log2 (wykadnik i wielomian 2. stopnia dla mantysy,
+// bd poniej 0,01 - wystarcza do wyboru poziomw mipmap)
+
+static inline GLfloat Log2(GLfloat value)
+{
+	GLuint bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const int exponent = (int)(bits >> 23 & 0xFF) - 127;
+	bits = (bits & 0x007FFFFF) | 0x3F800000;
+	GLfloat m;
+	memcpy(&m, &bits, sizeof(m));
+	m -= 1.0f;
+	return exponent + m * (1.3465553f - 0.3465553f * m);
+}
+
+// wspczynnik mieszania kolorw (bufor bez kanau alfa - alfa celu rwna 1)
+
+static inline void BlendFactor(GLenum factor, const GLfloat *src, const GLfloat *dst, GLfloat *out)
+{
+	switch (factor)
+	{
+	case GL_ZERO:
+		out[0] = out[1] = out[2] = 0.0f;
+		break;
+	case GL_SRC_COLOR:
+		out[0] = src[0], out[1] = src[1], out[2] = src[2];
+		break;
+	case GL_ONE_MINUS_SRC_COLOR:
+		out[0] = 1.0f - src[0], out[1] = 1.0f - src[1], out[2] = 1.0f - src[2];
+		break;
+	case GL_DST_COLOR:
+		out[0] = dst[0], out[1] = dst[1], out[2] = dst[2];
+		break;
+	case GL_ONE_MINUS_DST_COLOR:
+		out[0] = 1.0f - dst[0], out[1] = 1.0f - dst[1], out[2] = 1.0f - dst[2];
+		break;
+	case GL_SRC_ALPHA:
+		out[0] = out[1] = out[2] = src[3];
+		break;
+	case GL_ONE_MINUS_SRC_ALPHA:
+		out[0] = out[1] = out[2] = 1.0f - src[3];
+		break;
+	case GL_ONE_MINUS_DST_ALPHA:
+		out[0] = out[1] = out[2] = 0.0f;
+		break;
+	default: // GL_ONE, GL_DST_ALPHA
+		out[0] = out[1] = out[2] = 1.0f;
+		break;
+	}
+}
+
+// operacje na fragmencie od teksturowania do zapisu w buforach; color -
+// kolor interpolowany, sample - prbka tekstury (przy teksturowaniu)
+
+static inline void Fragment(const RasterState &state, GLfloat *color, GLuint sample, GLfloat fog, GLfloat z,
+	GLuint *pixel, GLfloat *depth)
+{
+	if (state.texture)
+	{
+		const RasterTexture &texture = *state.texture;
+		GLfloat texel[4];
+		Unpack(sample, texel);
+		if (state.texture_env == GL_REPLACE)
+		{
+			if (texture.has_color)
+				color[0] = texel[0], color[1] = texel[1], color[2] = texel[2];
+			if (texture.has_alpha)
+				color[3] = texel[3];
+		}
+		else
+			for (int k = 0; k < 4; k++)
+				color[k] *= texel[k];
+	}
+
+	if (state.fog)
+	{
+		GLfloat f;
+		if (state.fog_mode == GL_LINEAR)
+			f = (state.fog_end - fog) / (state.fog_end - state.fog_start);
+		else if (state.fog_mode == GL_EXP)
+			f = expf(-state.fog_density * fog);
+		else
+			f = expf(-(state.fog_density * fog) * (state.fog_density * fog));
+		f = Clamp(f);
+		for (int k = 0; k < 3; k++)
+			color[k] = f * color[k] + (1.0f - f) * state.fog_color[k];
+	}
+
+	if (state.alpha_test && !Compare(state.alpha_func, color[3], state.alpha_ref))
+		return;
+
+	// test gbokoci wykonany wczeniej (dla 4 pikseli naraz)
+	if (state.depth_test && state.depth_mask)
+		*depth = z;
+
+	if (state.blend)
+	{
+		GLfloat dst[4], src_factor[3], dst_factor[3];
+		Unpack(*pixel, dst);
+		BlendFactor(state.blend_src, color, dst, src_factor);
+		BlendFactor(state.blend_dst, color, dst, dst_factor);
+		for (int k = 0; k < 3; k++)
+			color[k] = color[k] * src_factor[k] + dst[k] * dst_factor[k];
+	}
+	*pixel = Pack(color);
+}
+
+// trjkt w kafelku [tx0, tx1) x [ty0, ty1)
+
+static void DrawTriangle(const TriangleSetup &triangle, const RasterState &state, int tx0, int ty0, int tx1, int ty1)
+{
+	const int x0 = std::max(triangle.x0, tx0), x1 = std::min(triangle.x1, tx1);
+	const int y0 = std::max(triangle.y0, ty0), y1 = std::min(triangle.y1, ty1);
+	if (x0 >= x1 || y0 >= y1)
+		return;
+
+	const RasterTexture *texture = state.texture;
+	const bool mipmap = texture && texture->min_filter != texture->mag_filter;
+
+	// tekstura zastpujca kolor bez mgy i mieszania - teksel trafia wprost
+	// do bufora (wynik identyczny z pen ciek); alfa fragmentu do testu
+	// alfa - z teksela lub (tekstura bez kanau alfa) z koloru wierzchokw
+	const bool replace = texture && state.texture_env == GL_REPLACE && texture->has_color && !state.fog &&
+		!state.blend;
+	const bool depth_write = state.depth_test && state.depth_mask;
+
+	const Float4 zero = Set1(0.0f), one = Set1(1.0f);
+	Float4 texture_width = zero, texture_height = zero;
+	if (texture)
+	{
+		texture_width = Set1((GLfloat)texture->levels[0].width);
+		if (texture->dimensions == 2)
+			texture_height = Set1((GLfloat)texture->levels[0].height);
+	}
+	const Plane &S = triangle.attribute[ATTRIBUTE_S], &T = triangle.attribute[ATTRIBUTE_T];
+	const Float4 Sa = Set1(S.a), Sb = Set1(S.b), Ta = Set1(T.a), Tb = Set1(T.b);
+	const Float4 Qa = Set1(triangle.q.a), Qb = Set1(triangle.q.b);
+	const Plane edge[3] = { triangle.edge[0], triangle.edge[1], triangle.edge[2] };
+	const int top_left = triangle.top_left;
+
+	for (int y = y0; y < y1; y++)
+	{
+		const GLfloat py = y + 0.5f;
+		float edge_row[3];
+		for (int i = 0; i < 3; i++)
+			edge_row[i] = triangle.edge[i].b * py + triangle.edge[i].c;
+		const float z_row = triangle.z.b * py + triangle.z.c;
+		const float q_row = triangle.q.b * py + triangle.q.c;
+		float attribute_row[ATTRIBUTE_COUNT];
+		for (int a = 0; a < ATTRIBUTE_COUNT; a++)
+			attribute_row[a] = triangle.attribute[a].b * py + triangle.attribute[a].c;
+		GLuint *color_row = &color_buffer[y * stride];
+		GLfloat *depth_row = &depth_buffer[y * stride];
+
+		// zakres pikseli wiersza, w ktrym mog lee piksele trjkta
+		// (miejsca zerowe funkcji krawdzi z zapasem 1 piksela na bdy
+		// zaokrgle - o przynalenoci pikseli decyduje nadal maska)
+		int xa = x0, xb = x1;
+		for (int i = 0; i < 3; i++)
+		{
+			const GLfloat a = edge[i].a;
+			if (a == 0.0f)
+			{
+				if (edge_row[i] < 0.0f)
+					xb = xa;
+				continue;
+			}
+			const GLfloat root = std::min(std::max(-edge_row[i] / a - 0.5f, (GLfloat)x0 - 1.0f), (GLfloat)x1);
+			if (a > 0.0f)
+				xa = std::max(xa, (int)root - 1);
+			else
+				xb = std::min(xb, (int)root + 2);
+		}
+
+		// grupy 4 pikseli wyrwnane wzgldem kafelka (nie wychodz poza kafelek)
+		for (int x = tx0 + ((std::max(xa, x0) - tx0) & ~3); x < xb; x += 4)
+		{
+			const Float4 X = Ramp(x + 0.5f);
+
+			// piksele wewntrz trjkta (na krawdzi - tylko dla krawdzi
+			// grnych i lewych) i w zakresie [x0, x1)
+			int mask = 15;
+			if (x < x0)
+				mask &= 15 << (x0 - x);
+			if (x + 4 > x1)
+				mask &= 15 >> (x + 4 - x1);
+			for (int i = 0; i < 3 && mask; i++)
+			{
+				const Float4 E = Evaluate(edge[i], X, edge_row[i]);
+				mask &= top_left >> i & 1 ? ~Greater(zero, E) : Greater(E, zero);
+			}
+			if (mask == 0)
+				continue;
+
+			const Float4 Z = Min(Max(Evaluate(triangle.z, X, z_row), zero), one);
+			if (state.depth_test)
+			{
+				mask &= DepthTest(state.depth_func, Z, Load(&depth_row[x]));
+				if (mask == 0)
+					continue;
+			}
+			float z[4];
+			Store(z, Z);
+
+			// atrybuty z korekcj perspektywy: warto / q
+			const Float4 inverse = Div(one, Evaluate(triangle.q, X, q_row));
+			GLuint samples[4] = { 0, 0, 0, 0 };
+			if (texture)
+			{
+				const Float4 s = Mul(Evaluate(S, X, attribute_row[ATTRIBUTE_S]), inverse);
+				const Float4 t = Mul(Evaluate(T, X, attribute_row[ATTRIBUTE_T]), inverse);
+				GLfloat lambda = 0.0f;
+
+				// pochodne wsprzdnych tekstury w pikselach okna
+				// (s = S / q => ds/dx = (dS/dx - s * dq/dx) / q), poziom
+				// szczegowoci wedug najwikszej zmiany w grupie
+				if (mipmap)
+				{
+					const Float4 dsdx = Mul(Mul(Sub(Sa, Mul(s, Qa)), inverse), texture_width);
+					const Float4 dtdx = Mul(Mul(Sub(Ta, Mul(t, Qa)), inverse), texture_height);
+					const Float4 dsdy = Mul(Mul(Sub(Sb, Mul(s, Qb)), inverse), texture_width);
+					const Float4 dtdy = Mul(Mul(Sub(Tb, Mul(t, Qb)), inverse), texture_height);
+					float rho2[4];
+					Store(rho2, Max(Add(Mul(dsdx, dsdx), Mul(dtdx, dtdx)), Add(Mul(dsdy, dsdy), Mul(dtdy, dtdy))));
+					GLfloat rho = 0.0f;
+					for (int k = 0; k < 4; k++)
+						if (mask >> k & 1)
+							rho = std::max(rho, rho2[k]);
+					lambda = rho > 0.0f ? 0.5f * Log2(rho) : -1000.0f;
+				}
+				Sample(*texture, s, t, lambda, mask, samples);
+			}
+
+			if (replace && state.alpha_test)
+			{
+				float alpha[4];
+				if (texture->has_alpha)
+					for (int k = 0; k < 4; k++)
+						alpha[k] = (samples[k] >> 24) * (1.0f / 255.0f);
+				else
+					Store(alpha, Min(Max(Mul(Evaluate(triangle.attribute[ATTRIBUTE_A], X, attribute_row[ATTRIBUTE_A]),
+						inverse), zero), one));
+				for (int k = 0; k < 4; k++)
+					if (mask >> k & 1 && !Compare(state.alpha_func, alpha[k], state.alpha_ref))
+						mask &= ~(1 << k);
+				if (mask == 0)
+					continue;
+			}
+			if (replace && mask == 15)
+			{
+				for (int k = 0; k < 4; k++)
+					color_row[x + k] = samples[k] | 0xFF000000u;
+				if (depth_write)
+					Store(&depth_row[x], Z);
+				continue;
+			}
+			if (replace)
+			{
+				for (int k = 0; k < 4; k++)
+					if (mask >> k & 1)
+					{
+						color_row[x + k] = samples[k] | 0xFF000000u;
+						if (depth_write)
+							depth_row[x + k] = z[k];
+					}
+				continue;
+			}
+
+			float colors[4][4], fog[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (int a = 0; a < 4; a++)
+				Store(colors[a], Min(Max(Mul(Evaluate(triangle.attribute[ATTRIBUTE_R + a], X,
+					attribute_row[ATTRIBUTE_R + a]), inverse), zero), one));
+			if (state.fog)
+				Store(fog, Mul(Evaluate(triangle.attribute[ATTRIBUTE_FOG], X, attribute_row[ATTRIBUTE_FOG]), inverse));
+			for (int k = 0; k < 4; k++)
+			{
+				if (!(mask >> k & 1))
+					continue;
+				GLfloat color[4] = { colors[0][k], colors[1][k], colors[2][k], colors[3][k] };
+				Fragment(state, color, samples[k], fog[k], z[k], &color_row[x + k], &depth_row[x + k]);
+			}
+		}
+	}
+}
+
+static void DrawPoint(const PointSetup &point, const RasterState &state, int tx0, int ty0, int tx1, int ty1)
+{
+	const int x0 = std::max(point.x0, tx0), x1 = std::min(point.x1, tx1);
+	const int y0 = std::max(point.y0, ty0), y1 = std::min(point.y1, ty1);
+	GLuint sample[4] = { 0, 0, 0, 0 };
+	if (state.texture)
+		Sample(*state.texture, Set1(point.s), Set1(point.t), 0.0f, 1, sample);
+	for (int y = y0; y < y1; y++)
+		for (int x = x0; x < x1; x++)
+		{
+			GLfloat *depth = &depth_buffer[y * stride + x];
+			if (state.depth_test && !Compare(state.depth_func, point.z, *depth))
+				continue;
+			GLfloat color[4] = { point.color[0], point.color[1], point.color[2], point.color[3] };
+			Fragment(state, color, sample[0], point.fog, point.z, &color_buffer[y * stride + x], depth);
+		}
+}
+
+static void DrawClear(const ClearSetup &clear, int tx0, int ty0, int tx1, int ty1)
+{
+	for (int y = ty0; y < ty1; y++)
+	{
+		if (clear.color)
+			std::fill(color_buffer.begin() + y * stride + tx0, color_buffer.begin() + y * stride + tx1,
+				clear.color_value);
+		if (clear.depth)
+			std::fill(depth_buffer.begin() + y * stride + tx0, depth_buffer.begin() + y * stride + tx1,
+				clear.depth_value);
+	}
+}
+
+// wykonanie polece jednego kafelka (zawsze w caoci przez jeden wtek)
+
+static void RenderTile(int tile)
+{
+	const std::vector<int> &bin = bins[tile];
+	if (bin.empty())
+		return;
+	const int tx0 = tile % tile_columns * RASTER_TILE, ty0 = tile / tile_columns * RASTER_TILE;
+	const int tx1 = std::min(tx0 + RASTER_TILE, stride), ty1 = std::min(ty0 + RASTER_TILE, height);
+	for (size_t i = 0; i < bin.size(); i++)
+	{
+		const Command &command = commands[bin[i]];
+		switch (command.type)
+		{
+		case COMMAND_TRIANGLE:
+			DrawTriangle(triangles[command.index], states[command.state], tx0, ty0, tx1, ty1);
+			break;
+		case COMMAND_POINT:
+			DrawPoint(points[command.index], states[command.state], tx0, ty0, tx1, ty1);
+			break;
+		case COMMAND_CLEAR:
+			DrawClear(clears[command.index], tx0, ty0, tx1, ty1);
+			break;
+		}
+	}
+}
+
+static void RenderTiles()
+{
+	for (int tile = next_tile++; tile < tile_count; tile = next_tile++)
+		RenderTile(tile);
+}
+
+// generation - pokolenie pracy w chwili utworzenia wtku
+
+static void Worker(int generation)
+{
+	std::unique_lock<std::mutex> lock(pool_mutex);
+	for (;;)
+	{
+		pool_start.wait(lock, [&]() { return pool_quit || pool_generation != generation; });
+		if (pool_quit)
+			return;
+		generation = pool_generation;
+		lock.unlock();
+		RenderTiles();
+		lock.lock();
+		if (--pool_busy == 0)
+			pool_done.notify_one();
+	}
+}
+
+bool RasterInit(int buffer_width, int buffer_height, int threads)
+{
+	if (buffer_width < 1 || buffer_height < 1)
+		return false;
+	RasterFree();
+	width = buffer_width;
+	height = buffer_height;
+	stride = (width + 3) & ~3;
+	color_buffer.assign(stride * height, 0xFF000000u);
+	depth_buffer.assign(stride * height, 1.0f);
+	tile_columns = (stride + RASTER_TILE - 1) / RASTER_TILE;
+	tile_rows = (height + RASTER_TILE - 1) / RASTER_TILE;
+	tile_count = tile_columns * tile_rows;
+	bins.assign(tile_count, std::vector<int>());
+
+	if (threads <= 0)
+		threads = std::max(1, (int)std::thread::hardware_concurrency());
+	pool_quit = false;
+	for (int i = 1; i < threads; i++)
+		workers.push_back(std::thread(Worker, pool_generation));
+	return true;
+}
+
+void RasterFree()
+{
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		pool_quit = true;
+	}
+	pool_start.notify_all();
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+	workers.clear();
+	commands.clear();
+	triangles.clear();
+	points.clear();
+	clears.clear();
+	states.clear();
+	current_index = -1;
+}
+
+int RasterThreads()
+{
+	return (int)workers.size() + 1;
+}
+
+void RasterSetState(const RasterState &state)
+{
+	current = state;
+	current_index = -1;
+}
+
+// dodanie polecenia (z biecym stanem) do kolejki
+
+static int AddCommand(int type, int index)
+{
+	if (current_index < 0)
+	{
+		states.push_back(current);
+		current_index = (int)states.size() - 1;
+	}
+	const Command command = { type, current_index, index };
+	commands.push_back(command);
+	return (int)commands.size() - 1;
+}
+
+void RasterClear(bool color, const GLfloat *clear_color, bool depth, GLfloat clear_depth)
+{
+	if (!color && !depth)
+		return;
+	ClearSetup clear;
+	clear.color = color;
+	clear.depth = depth;
+	clear.color_value = Pack(clear_color);
+	clear.depth_value = Clamp(clear_depth);
+	clears.push_back(clear);
+	const int command = AddCommand(COMMAND_CLEAR, (int)clears.size() - 1);
+	for (int tile = 0; tile < tile_count; tile++)
+		bins[tile].push_back(command);
+}
+
+// paszczyzna przez wartoci f w wierzchokach (x, y); inverse_area -
+// odwrotno podwojonego pola trjkta
+
+static Plane MakePlane(const GLfloat *x, const GLfloat *y, GLfloat f0, GLfloat f1, GLfloat f2, GLfloat inverse_area)
+{
+	const GLfloat dx1 = x[1] - x[0], dy1 = y[1] - y[0], dx2 = x[2] - x[0], dy2 = y[2] - y[0];
+	const GLfloat df1 = f1 - f0, df2 = f2 - f0;
+	Plane plane;
+	plane.a = (df1 * dy2 - df2 * dy1) * inverse_area;
+	plane.b = (df2 * dx1 - df1 * dx2) * inverse_area;
+	plane.c = f0 - plane.a * x[0] - plane.b * y[0];
+	return plane;
+}
+
+// pooenie wierzchoka zaokrglone do 1/256 piksela - krawdzie
+// wsplne dla dwch trjktw maj identyczne rwnania
+
+static inline GLfloat Snap(GLfloat value)
+{
+	return floorf(value * 256.0f + 0.5f) * (1.0f / 256.0f);
+}
+
+void RasterTriangle(const RasterVertex &a, const RasterVertex &b, const RasterVertex &c)
+{
+	const RasterVertex *v[3] = { &a, &b, &c };
+	GLfloat x[3], y[3];
+	for (int i = 0; i < 3; i++)
+	{
+		x[i] = Snap(v[i]->x);
+		y[i] = Snap(v[i]->y);
+	}
+	GLfloat area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0.0f)
+		return;
+
+	// kolejno przeciwna do ruchu wskazwek zegara (wntrze po lewej
+	// stronie krawdzi)
+	if (area < 0.0f)
+	{
+		std::swap(v[1], v[2]);
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		area = -area;
+	}
+
+	TriangleSetup triangle;
+	triangle.x0 = std::max(0, (int)ceilf(std::min(x[0], std::min(x[1], x[2])) - 0.5f));
+	triangle.x1 = std::min(width, (int)floorf(std::max(x[0], std::max(x[1], x[2])) - 0.5f) + 1);
+	triangle.y0 = std::max(0, (int)ceilf(std::min(y[0], std::min(y[1], y[2])) - 0.5f));
+	triangle.y1 = std::min(height, (int)floorf(std::max(y[0], std::max(y[1], y[2])) - 0.5f) + 1);
+	if (triangle.x0 >= triangle.x1 || triangle.y0 >= triangle.y1)
+		return;
+
+	triangle.top_left = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		const int j = (i + 1) % 3;
+		const GLfloat dx = x[j] - x[i], dy = y[j] - y[i];
+		triangle.edge[i].a = -dy;
+		triangle.edge[i].b = dx;
+		triangle.edge[i].c = dy * x[i] - dx * y[i];
+		if (dy < 0.0f || (dy == 0.0f && dx < 0.0f))
+			triangle.top_left |= 1 << i;
+	}
+
+	const GLfloat inverse_area = 1.0f / area;
+	triangle.z = MakePlane(x, y, v[0]->z, v[1]->z, v[2]->z, inverse_area);
+	if (current.polygon_offset)
+	{
+		const GLfloat slope = std::max(fabsf(triangle.z.a), fabsf(triangle.z.b));
+		triangle.z.c += current.offset_factor * slope + current.offset_units * DEPTH_UNIT;
+	}
+	triangle.q = MakePlane(x, y, v[0]->q, v[1]->q, v[2]->q, inverse_area);
+	GLfloat values[3][ATTRIBUTE_COUNT];
+	for (int i = 0; i < 3; i++)
+	{
+		const GLfloat q = v[i]->q;
+		for (int k = 0; k < 4; k++)
+			values[i][ATTRIBUTE_R + k] = v[i]->color[k] * q;
+		values[i][ATTRIBUTE_S] = v[i]->s * q;
+		values[i][ATTRIBUTE_T] = v[i]->t * q;
+		values[i][ATTRIBUTE_FOG] = v[i]->fog * q;
+	}
+	for (int k = 0; k < ATTRIBUTE_COUNT; k++)
+		triangle.attribute[k] = MakePlane(x, y, values[0][k], values[1][k], values[2][k], inverse_area);
+
+	triangles.push_back(triangle);
+	const int command = AddCommand(COMMAND_TRIANGLE, (int)triangles.size() - 1);
+
+	// kafelki z prostokta otaczajcego, z pominiciem kafelkw w caoci
+	// po zewntrznej stronie ktrej krawdzi (sprawdzany naronik kafelka
+	// o najwikszej wartoci funkcji krawdzi)
+	for (int ty = triangle.y0 / RASTER_TILE; ty <= (triangle.y1 - 1) / RASTER_TILE; ty++)
+		for (int tx = triangle.x0 / RASTER_TILE; tx <= (triangle.x1 - 1) / RASTER_TILE; tx++)
+		{
+			const GLfloat left = tx * RASTER_TILE + 0.5f, right = (tx + 1) * RASTER_TILE - 0.5f;
+			const GLfloat bottom = ty * RASTER_TILE + 0.5f, top = (ty + 1) * RASTER_TILE - 0.5f;
+			bool outside = false;
+			for (int i = 0; i < 3 && !outside; i++)
+			{
+				const Plane &e = triangle.edge[i];
+				outside = e.a * (e.a > 0.0f ? right : left) + e.b * (e.b > 0.0f ? top : bottom) + e.c < 0.0f;
+			}
+			if (!outside)
+				bins[ty * tile_columns + tx].push_back(command);
+		}
+}
+
+void RasterPoint(const RasterVertex &v, GLfloat size)
+{
+	const int side = std::max(1, (int)floorf(size + 0.5f));
+	PointSetup point;
+	point.x0 = (int)floorf(v.x - (side - 1) * 0.5f);
+	point.y0 = (int)floorf(v.y - (side - 1) * 0.5f);
+	point.x1 = std::min(width, point.x0 + side);
+	point.y1 = std::min(height, point.y0 + side);
+	point.x0 = std::max(0, point.x0);
+	point.y0 = std::max(0, point.y0);
+	if (point.x0 >= point.x1 || point.y0 >= point.y1)
+		return;
+	point.z = Clamp(v.z);
+	memcpy(point.color, v.color, sizeof(point.color));
+	point.s = v.s;
+	point.t = v.t;
+	point.fog = v.fog;
+	points.push_back(point);
+	const int command = AddCommand(COMMAND_POINT, (int)points.size() - 1);
+	for (int ty = point.y0 / RASTER_TILE; ty <= (point.y1 - 1) / RASTER_TILE; ty++)
+		for (int tx = point.x0 / RASTER_TILE; tx <= (point.x1 - 1) / RASTER_TILE; tx++)
+			bins[ty * tile_columns + tx].push_back(command);
+}
+
+void RasterFlush()
+{
+	if (commands.empty())
+		return;
+
+	// kafelki rysuj wtki pomocnicze i wtek wywoujcy
+	next_tile = 0;
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		pool_busy = (int)workers.size();
+		pool_generation++;
+	}
+	pool_start.notify_all();
+	RenderTiles();
+	{
+		std::unique_lock<std::mutex> lock(pool_mutex);
+		pool_done.wait(lock, []() { return pool_busy == 0; });
+	}
+
+	for (int tile = 0; tile < tile_count; tile++)
+		bins[tile].clear();
+	commands.clear();
+	triangles.clear();
+	points.clear();
+	clears.clear();
+	states.clear();
+	current_index = -1;
+}
+
+void RasterReadPixels(int x, int y, int read_width, int read_height, GLenum format, int alignment, GLubyte *pixels)
+{
+	const int components = format == GL_RGBA || format == GL_BGRA ? 4 : 3;
+	const bool bgr = format == GL_BGR || format == GL_BGRA;
+	const int row_size = (read_width * components + alignment - 1) / alignment * alignment;
+	for (int j = 0; j < read_height; j++)
+	{
+		GLubyte *out = pixels + j * row_size;
+		for (int i = 0; i < read_width; i++, out += components)
+		{
+			const int px = x + i, py = y + j;
+			if (px < 0 || py < 0 || px >= width || py >= height)
+				continue;
+			const GLuint pixel = color_buffer[py * stride + px];
+			const GLubyte r = pixel & 0xFF, g = pixel >> 8 & 0xFF, b = pixel >> 16 & 0xFF;
+			out[0] = bgr ? b : r;
+			out[1] = g;
+			out[2] = bgr ? r : b;
+			if (components == 4)
+				out[3] = 0xFF;
+		}
+	}
+}
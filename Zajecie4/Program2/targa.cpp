@@ -3,7 +3,9 @@
 http://www.januszg.hg.pl
 JanuszG@enter.net.pl
 */
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include "targa.h"
 #include <GL/glext.h>
 #include <stdio.h>
@@ -0,0 +1,37 @@
+#ifndef __TEXT__H__
+#define __TEXT__H__
+
+#include <GL/glut.h>
+
+// napisy rysowane z atlasu znakw zamiast glutBitmapCharacter: znaki
+// czcionki 9x15 (jak GLUT_BITMAP_9_BY_15) s raz umieszczane w teksturze,
+// a wszystkie napisy ramki trafiaj do jednej tablicy czworoktw
+// rysowanej jednym wywoaniem glDrawArrays; tablica (w obiekcie
+// buforowym, jeeli jest dostpny) jest tworzona ponownie tylko po
+// zmianie napisw, ich pooenia lub koloru
+
+// kolor kolejnych napisw (RGB)
+
+void TextColor(const GLfloat *color);
+
+// dodanie napisu; (x, y) - pooenie w oknie jak w glWindowPos2i
+// (lewy dolny rg okna to (0, 0)), znaki spoza zakresu ASCII 32-126
+// s pomijane
+
+void TextAdd(GLint x, GLint y, const char *string);
+
+// narysowanie napisw dodanych od poprzedniego wywoania w oknie (obszarze
+// renderingu) o podanych rozmiarach; stan OpenGL jest przywracany
+// (glPushAttrib), a biec macierz pozostaje macierz modelowania
+
+void TextFlush(int width, int height);
+
+// liczba utworze tablicy czworoktw (od uruchomienia programu)
+
+int TextRebuilds();
+
+// usunicie tekstury atlasu i obiektu buforowego
+
+void TextFree();
+
+#endif // __TEXT__H__
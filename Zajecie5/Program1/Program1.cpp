@@ -3,13 +3,28 @@
 #include "GL/glext.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "materials.h"
-#include <array>
+#include <vector>
 #include "colors.h"
+#include "mesh_normals.h"
+#include "mesh.h"
+#include "extensions.h"
+#include "pyramid.h"
+#include "mesh_import.h"
+#include "mesh_optimize.h"
+#include "mesh_simplify.h"
+#include "primitives.h"
+#include "render_queue.h"
+#include "profiler.h"
+#include "headless.h"
+#include <thread>
+#include <atomic>
 
 #define wglGetProcAddress glXGetProcAddress
 
 #include "gltools_extracted.h"
+#include "vector_simd.h"
 #include <math.h>
 
 // Adds two vectors together
@@ -138,7 +153,21 @@ enum
 
 	LIGHT_DIRECTIONAL,
 	LIGHT_AMBIENT,
-	LIGHT_SPOT
+	LIGHT_SPOT,
+
+	SOLID_PYRAMID,        // ostrosup o podstawie 9-kta
+	SOLID_PRISM,          // graniastosup o podstawie 9-kta
+	SOLID_STRESS_1M,      // ostrosup z ok. milionem trjktw
+	SOLID_STRESS_4M,      // ostrosup z ok. czterema milionami trjktw
+	SOLID_SCENE,          // scena z 4096 bry o 19 materiaach
+
+	LOD_AUTO,             // poziom szczegowoci wg wielkoci bryy na ekranie
+	LOD_0,                // pena siatka
+	LOD_1,                // kolejne poziomy - 1/2, 1/4, ... trjktw
+	LOD_2,
+	LOD_3,
+	LOD_4,
+	LOD_5
 };
 
 int aspect = FULL_WINDOW;
@@ -151,7 +180,8 @@ int aspect = FULL_WINDOW;
 #endif
 
 
-const int N = 9;
+// parametry wywietlanej bryy (o bryy - o Z)
+PyramidParams pyramid;
 
 const GLdouble left = -1.0;
 const GLdouble right = 1.0;
@@ -198,8 +228,71 @@ GLfloat constant_attenuation = 1.0;
 GLfloat linear_attenuation = 0.0;
 GLfloat quadratic_attenuation = 0.0;
 
-std::array<GLfloat, 3 * (N + 2)> vertices;
-std::array<int, (N + 1) * 2 * 3> triangles;
+std::vector<GLfloat> vertices;
+std::vector<int> triangles;
+
+// zapamitane wektory normalne wierzchokw
+MeshNormals mesh_normals;
+
+// siatka wywietlanej bryy i znacznik koniecznoci jej przebudowy
+Mesh mesh;
+bool mesh_dirty = true;
+
+// kolejka rysowania sortowana wg stanu (materia, tekstura, mieszanie, siatka)
+RenderQueue queue;
+
+// wypisanie statystyk kolejki po narysowaniu najbliszej ramki
+bool queue_report = false;
+
+// materiay z materials.h uywane w scenie wielu bry
+
+const RenderMaterial material_presets[] =
+{
+	{ BrassAmbient, BrassDiffuse, BrassSpecular, BrassShininess },
+	{ BronzeAmbient, BronzeDiffuse, BronzeSpecular, BronzeShininess },
+	{ PolishedBronzeAmbient, PolishedBronzeDiffuse, PolishedBronzeSpecular, PolishedBronzeShininess },
+	{ ChromeAmbient, ChromeDiffuse, ChromeSpecular, ChromeShininess },
+	{ CopperAmbient, CopperDiffuse, CopperSpecular, CopperShininess },
+	{ PolishedCopperAmbient, PolishedCopperDiffuse, PolishedCopperSpecular, PolishedCopperShininess },
+	{ GoldAmbient, GoldDiffuse, GoldSpecular, GoldShininess },
+	{ PolishedGoldAmbient, PolishedGoldDiffuse, PolishedGoldSpecular, PolishedGoldShininess },
+	{ PewterAmbient, PewterDiffuse, PewterSpecular, PewterShininess },
+	{ SilverAmbient, SilverDiffuse, SilverSpecular, SilverShininess },
+	{ PolishedSilverAmbient, PolishedSilverDiffuse, PolishedSilverSpecular, PolishedSilverShininess },
+	{ EmeraldAmbient, EmeraldDiffuse, EmeraldSpecular, EmeraldShininess },
+	{ JadeAmbient, JadeDiffuse, JadeSpecular, JadeShininess },
+	{ ObsidianAmbient, ObsidianDiffuse, ObsidianSpecular, ObsidianShininess },
+	{ PearlAmbient, PearlDiffuse, PearlSpecular, PearlShininess },
+	{ RubyAmbient, RubyDiffuse, RubySpecular, RubyShininess },
+	{ TurquoiseAmbient, TurquoiseDiffuse, TurquoiseSpecular, TurquoiseShininess },
+	{ BlackPlasticAmbient, BlackPlasticDiffuse, BlackPlasticSpecular, BlackPlasticShininess },
+	{ BlackRubberAmbient, BlackRubberDiffuse, BlackRubberSpecular, BlackRubberShininess }
+};
+
+// brya sceny - brya z biblioteki, materia i macierz modelowania
+
+struct SceneObject
+{
+	int mesh = 0;
+	int count = 0;
+	int material = 0;
+	int blend = BLEND_OPAQUE;
+	GLfloat center[3];
+	GLfloat matrix[16];
+};
+
+// scena wielu bry wywietlana zamiast pojedynczej bryy
+std::vector<SceneObject> scene;
+bool scene_visible = false;
+
+// poziomy szczegowoci bryy (bez poziomw - tylko pena siatka);
+// budowane w tle, wynik wtku jest przekazywany przez lod_ready
+MeshLod lod;
+int lod_mode = LOD_AUTO;
+int lod_level = 0;
+std::atomic<MeshLod*> lod_ready(nullptr);
+bool lod_running = false;
+bool lod_pending = false;
 
 void Normalize(GLfloat *v)
 {
@@ -231,6 +324,273 @@ void Normal(GLfloat *n, int i)
 	n[2] = v1[0] * v2[1] - v1[1] * v2[0];
 }
 
+// zmiana kolejnoci trjktw i wierzchokw pod ktem pamici podrcznej
+// przetworzonych wierzchokw; wypisuje ACMR i ATVR przed i po optymalizacji
+
+void OptimizeModel()
+{
+	const int start = glutGet(GLUT_ELAPSED_TIME);
+	const int vertex_count = (int)vertices.size() / 3, triangle_count = (int)triangles.size() / 3;
+	const VertexCacheStats before = AnalyzeVertexCache(triangles.data(), triangle_count, vertex_count);
+	OptimizeVertexCache(triangles.data(), triangle_count, vertex_count);
+	vertices.resize(3 * OptimizeVertexFetch(vertices.data(), vertex_count, triangles.data(), triangle_count));
+	const VertexCacheStats after = AnalyzeVertexCache(triangles.data(), triangle_count, (int)vertices.size() / 3);
+	printf("Kolejnosc trojkatow: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%d ms)\n",
+		before.acmr, after.acmr, before.atvr, after.atvr, glutGet(GLUT_ELAPSED_TIME) - start);
+}
+
+void StartLod();
+
+// sprawdzanie co 100 ms, czy wtek zakoczy budow poziomw szczegowoci
+
+void LodTimer(int value)
+{
+	MeshLod *result = lod_ready.exchange(nullptr);
+	if (result == nullptr)
+	{
+		glutTimerFunc(100, LodTimer, value);
+		return;
+	}
+	lod_running = false;
+
+	// geometria zmieniona w trakcie budowy - wynik jest nieaktualny
+	if (lod_pending)
+	{
+		delete result;
+		StartLod();
+		return;
+	}
+
+	lod.triangles.swap(result->triangles);
+	lod.first.swap(result->first);
+	lod.count.swap(result->count);
+	lod.error.swap(result->error);
+	delete result;
+	printf("Poziomy szczegolowosci (%d ms):", glutGet(GLUT_ELAPSED_TIME) - value);
+	for (int i = 0; i < LodLevels(lod); i++)
+		printf(" %d", lod.count[i] / 3);
+	printf("\n");
+	mesh_dirty = true;
+	if (!Headless())
+		glutPostRedisplay();
+}
+
+// budowa poziomw szczegowoci biecej bryy w osobnym wtku;
+// do czasu jej zakoczenia wywietlana jest pena siatka
+
+void StartLod()
+{
+	lod = MeshLod();
+	lod_level = 0;
+	if (lod_running)
+	{
+		lod_pending = true;
+		return;
+	}
+	lod_running = true;
+	lod_pending = false;
+
+	// wtek pracuje na kopiach tablic, kolejno trjktw kadego
+	// poziomu jest optymalizowana pod ktem pamici podrcznej wierzchokw
+	std::vector<GLfloat> lod_vertices(vertices);
+	std::vector<int> lod_triangles(triangles);
+	std::thread worker([lod_vertices, lod_triangles]()
+	{
+		const int vertex_count = (int)lod_vertices.size() / 3;
+		MeshLod *result = new MeshLod;
+		BuildLod(lod_vertices.data(), vertex_count, lod_triangles.data(), (int)lod_triangles.size() / 3, *result);
+		for (int i = 1; i < LodLevels(*result); i++)
+			OptimizeVertexCache(&result->triangles[result->first[i]], result->count[i] / 3, vertex_count);
+		lod_ready = result;
+	});
+
+	// bez okna (brak zegara GLUT) - oczekiwanie na wynik, dziki czemu
+	// poziom szczegowoci w zapisywanych ramkach nie zaley od czasu budowy
+	if (Headless())
+	{
+		const int start = glutGet(GLUT_ELAPSED_TIME);
+		worker.join();
+		LodTimer(start);
+		return;
+	}
+	worker.detach();
+	glutTimerFunc(100, LodTimer, glutGet(GLUT_ELAPSED_TIME));
+}
+
+// generowanie bryy o biecych parametrach
+
+void BuildPyramid()
+{
+	const int start = glutGet(GLUT_ELAPSED_TIME);
+	PyramidMesh solid;
+	GeneratePyramid(pyramid, solid);
+	vertices.swap(solid.vertices);
+	triangles.swap(solid.triangles);
+	printf("Bryla: %d bokow, podzial %d x %d, %d wierzcholkow, %d trojkatow (%d ms)\n",
+		pyramid.sides, pyramid.rings, pyramid.stacks, (int)vertices.size() / 3, (int)triangles.size() / 3,
+		glutGet(GLUT_ELAPSED_TIME) - start);
+	OptimizeModel();
+
+	// nowa geometria - normalne, siatka i poziomy szczegowoci do przeliczenia
+	InvalidateNormals(mesh_normals);
+	mesh_dirty = true;
+	StartLod();
+}
+
+// wczytanie modelu z pliku OBJ lub PLY; model jest przesuwany i skalowany
+// tak, aby mieci si w kuli o promieniu 1 wok pocztku ukadu
+
+bool LoadModel(const char *filename)
+{
+	const int start = glutGet(GLUT_ELAPSED_TIME);
+	std::vector<float> model_vertices;
+	std::vector<int> model_triangles;
+	if (!ImportMesh(filename, model_vertices, model_triangles))
+		return false;
+
+	// rodek prostopadocianu otaczajcego i najwiksza odlego od niego
+	GLfloat min[3] = { model_vertices[0], model_vertices[1], model_vertices[2] };
+	GLfloat max[3] = { model_vertices[0], model_vertices[1], model_vertices[2] };
+	for (size_t i = 0; i < model_vertices.size(); i++)
+	{
+		if (model_vertices[i] < min[i % 3])
+			min[i % 3] = model_vertices[i];
+		if (model_vertices[i] > max[i % 3])
+			max[i % 3] = model_vertices[i];
+	}
+	const GLfloat center[3] = { (min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2 };
+	GLfloat radius = 0.0f;
+	for (size_t i = 0; i < model_vertices.size(); i += 3)
+	{
+		const GLfloat dx = model_vertices[i] - center[0], dy = model_vertices[i + 1] - center[1], dz = model_vertices[i + 2] - center[2];
+		if (dx * dx + dy * dy + dz * dz > radius)
+			radius = dx * dx + dy * dy + dz * dz;
+	}
+	const GLfloat scale = radius > 0.0f ? 1.0f / sqrtf(radius) : 1.0f;
+	for (size_t i = 0; i < model_vertices.size(); i++)
+		model_vertices[i] = (model_vertices[i] - center[i % 3]) * scale;
+
+	vertices.swap(model_vertices);
+	triangles.swap(model_triangles);
+	printf("Model %s: %d wierzcholkow, %d trojkatow (%d ms)\n", filename,
+		(int)vertices.size() / 3, (int)triangles.size() / 3, glutGet(GLUT_ELAPSED_TIME) - start);
+	OptimizeModel();
+
+	InvalidateNormals(mesh_normals);
+	mesh_dirty = true;
+	StartLod();
+	return true;
+}
+
+// budowa siatki z tablic vertices i triangles (lub trjktw wszystkich
+// poziomw szczegowoci, zapisanych kolejno): przy normalnych wierzchokw
+// wierzchoki s wsplne dla cian, przy normalnych cian kady trjkt
+// ma wasne trzy wierzchoki z normaln ciany
+
+void BuildMesh()
+{
+	const std::vector<int> &drawn = LodLevels(lod) > 0 ? lod.triangles : triangles;
+	const int triangle_count = (int)drawn.size() / 3;
+	if (normals == NORMALS_SMOOTH)
+	{
+		// normalne z penej siatki - uproszczone poziomy s cieniowane jak orygina
+		const GLfloat *n = SmoothNormals(mesh_normals, vertices.data(), (int)vertices.size() / 3,
+			triangles.data(), (int)triangles.size() / 3);
+		MeshSet(mesh, vertices.data(), n, NULL, (int)vertices.size() / 3, drawn.data(), (int)drawn.size());
+	}
+	else
+	{
+		std::vector<GLfloat> positions(9 * triangle_count), face_normals(9 * triangle_count);
+		std::vector<int> indices(3 * triangle_count);
+		std::vector<GLfloat> n(3 * triangle_count);
+		FaceNormals(vertices.data(), drawn.data(), triangle_count, n.data());
+		for (int i = 0; i < triangle_count; i++)
+			for (int j = 0; j < 3; j++)
+			{
+				gltCopyVector(&vertices[3 * drawn[3 * i + j]], &positions[9 * i + 3 * j]);
+				gltCopyVector(&n[3 * i], &face_normals[9 * i + 3 * j]);
+				indices[3 * i + j] = 3 * i + j;
+			}
+		MeshSet(mesh, positions.data(), face_normals.data(), NULL, 3 * triangle_count, indices.data(), 3 * triangle_count);
+	}
+	mesh_dirty = false;
+}
+
+// liczba pikseli okna na jednostk wsprzdnych bryy w rodku sceny
+
+GLfloat PixelsPerUnit()
+{
+	const int width = WindowWidth(), height = WindowHeight();
+	int size = width > height ? width : height;
+	if (aspect == ASPECT_1_1)
+		size = width < height ? width : height;
+	return scale * near / ((near + far) / 2) * size / (right - left);
+}
+
+// budowa sceny 16 x 16 x 16 bry z biblioteki bry o materiaach
+// wybieranych pseudolosowo (bryy ssiednie maj zwykle rne materiay);
+// materiay o skadowej alfa mniejszej od 1 s pprzezroczyste
+
+void BuildScene()
+{
+	const int size = 16;
+	Primitive *primitives[] =
+	{
+		&Sphere(1.0f, 16, 12),
+		&Icosphere(1.0f, 1),
+		&Torus(0.35f, 0.65f, 8, 16),
+		&Cylinder(0.8f, 0.8f, 1.6f, 12, 1),
+		&Cone(1.0f, 1.6f, 12, 1)
+	};
+	const int primitive_count = sizeof(primitives) / sizeof(primitives[0]);
+	const int material_count = sizeof(material_presets) / sizeof(material_presets[0]);
+
+	scene.clear();
+	unsigned int random = 12345;
+	for (int i = 0; i < size * size * size; i++)
+	{
+		random = random * 1103515245 + 12345;
+		const int primitive = (random >> 16) % primitive_count;
+		random = random * 1103515245 + 12345;
+		const RenderMaterial &m = material_presets[(random >> 16) % material_count];
+
+		SceneObject object;
+		object.mesh = RenderQueueMesh(queue, &primitives[primitive]->mesh);
+		object.count = primitives[primitive]->triangle_indices;
+		object.material = RenderQueueMaterial(queue, m.ambient, m.diffuse, m.specular, m.shininess);
+		// bryy o materiale z alfa < 1 s mieszane i rysowane po
+		// nieprzezroczystych, od najdalszych
+		object.blend = m.diffuse[3] < 1.0f ? BLEND_ALPHA : BLEND_OPAQUE;
+
+		// rodek w siatce wypeniajcej szecian [-0.9, 0.9]; walec i
+		// stoek s przesuwane tak, aby ich rodek lea w rodku komrki
+		const GLfloat step = 1.8f / (size - 1), radius = 0.4f * step;
+		object.center[0] = -0.9f + step * (i % size);
+		object.center[1] = -0.9f + step * (i / size % size);
+		object.center[2] = -0.9f + step * (i / (size * size));
+		memset(object.matrix, 0, sizeof(object.matrix));
+		object.matrix[0] = object.matrix[5] = object.matrix[10] = radius;
+		object.matrix[12] = object.center[0];
+		object.matrix[13] = object.center[1];
+		object.matrix[14] = object.center[2] - (primitive >= 3 ? 0.8f * radius : 0.0f);
+		object.matrix[15] = 1.0f;
+		scene.push_back(object);
+	}
+	printf("Scena: %d bryl, %d materialow\n", (int)scene.size(), material_count);
+}
+
+// odlego punktu bryy od obserwatora przeskalowana do zakresu [0, 1]
+// (near - far); przeksztacenia jak w macierzy modelowania w Display
+
+GLfloat ViewDepth(const GLfloat *point)
+{
+	const GLfloat ax = rotatex * 3.14159265f / 180.0f, ay = rotatey * 3.14159265f / 180.0f;
+	const GLfloat x = scale * point[0], y = scale * point[1], z = scale * point[2];
+	const GLfloat z1 = -x * sinf(ay) + z * cosf(ay);
+	const GLfloat z2 = y * sinf(ax) + z1 * cosf(ax);
+	return (GLfloat)((-(z2 - (near + far) / 2) - near) / (far - near));
+}
+
 void DrawString(GLint x, GLint y, char *string)
 {
 	// pooenie napisu
@@ -286,7 +646,8 @@ void Display()
 		glPushAttrib(GL_LIGHTING_BIT);
 		glDisable(GL_LIGHT0);
 		glMaterialfv(GL_FRONT, GL_EMISSION, Red);
-		glutSolidSphere(0.1, 30, 20);
+		PrimitiveDrawSolid(Sphere(0.1f, 30, 20));
+		ProfilerDraw(Sphere(0.1f, 30, 20).triangle_indices);
 		glPopAttrib();
 		glPopMatrix();
 		break;
@@ -303,119 +664,69 @@ void Display()
 	}
 
 
-	glMaterialfv(GL_FRONT, GL_AMBIENT, ambient);
-	glMaterialfv(GL_FRONT, GL_DIFFUSE, diffuse);
-	glMaterialfv(GL_FRONT, GL_SPECULAR, specular);
-	glMaterialf(GL_FRONT, GL_SHININESS, shininess);
-
-
 	glEnable(rescale_normal ? GL_RESCALE_NORMAL : GL_NORMALIZE);
 
-	glBegin(GL_TRIANGLES);
-
-	if (normals == NORMALS_SMOOTH)
+	// obiekty trafiaj do kolejki, ktra rysuje je posortowane wg stanu
+	// i ustawia tylko zmieniajce si materiay, tekstury i siatki
+	if (scene_visible)
 	{
-		for (int i = 0; i < triangles.size() / 3; i++)
+		for (size_t i = 0; i < scene.size(); i++)
 		{
-			// obliczanie wektora normalnego dla pierwszego wierzchoka
-			GLfloat n[3];
-			n[0] = n[1] = n[2] = 0.0;
-
-			// wyszukanie wszystkich cian posiadajcych bie?cy wierzchoek
-			for (int j = 0; j < triangles.size() / 3; j++)
-				if (3 * triangles[3 * i + 0] == 3 * triangles[3 * j + 0] ||
-					3 * triangles[3 * i + 0] == 3 * triangles[3 * j + 1] ||
-					3 * triangles[3 * i + 0] == 3 * triangles[3 * j + 2])
-				{
-					// dodawanie wektorw normalnych poszczeglnych cian
-					GLfloat nv[3];
-					Normal(nv, j);
-					n[0] += nv[0];
-					n[1] += nv[1];
-					n[2] += nv[2];
-				}
-
-			// uredniony wektor normalny jest normalizowany tylko, gdy biblioteka
-			// obsuguje automatyczne skalowania jednostkowych wektorw normalnych
-			if (rescale_normal == true)
-				Normalize(n);
-			glNormal3fv(n);
-			glVertex3fv(&vertices[3 * triangles[3 * i + 0]]);
-
-			// obliczanie wektora normalnego dla drugiego wierzchoka
-			n[0] = n[1] = n[2] = 0.0;
-
-			// wyszukanie wszystkich cian posiadajcych bie?cy wierzchoek
-			for (int j = 0; j < triangles.size() / 3; j++)
-				if (3 * triangles[3 * i + 1] == 3 * triangles[3 * j + 0] ||
-					3 * triangles[3 * i + 1] == 3 * triangles[3 * j + 1] ||
-					3 * triangles[3 * i + 1] == 3 * triangles[3 * j + 2])
-				{
-					// dodawanie wektorw normalnych poszczeglnych cian
-					GLfloat nv[3];
-					Normal(nv, j);
-					n[0] += nv[0];
-					n[1] += nv[1];
-					n[2] += nv[2];
-				}
-
-			// uredniony wektor normalny jest normalizowany tylko, gdy biblioteka
-			// obsuguje automatyczne skalowania jednostkowych wektorw normalnych
-			if (rescale_normal == true)
-				Normalize(n);
-			glNormal3fv(n);
-			glVertex3fv(&vertices[3 * triangles[3 * i + 1]]);
-
-			// obliczanie wektora normalnego dla trzeciego wierzchoka
-			n[0] = n[1] = n[2] = 0.0;
-
-			// wyszukanie wszystkich cian posiadajcych bie?cy wierzchoek
-			for (int j = 0; j < triangles.size() / 3; j++)
-				if (3 * triangles[3 * i + 2] == 3 * triangles[3 * j + 0] ||
-					3 * triangles[3 * i + 2] == 3 * triangles[3 * j + 1] ||
-					3 * triangles[3 * i + 2] == 3 * triangles[3 * j + 2])
-				{
-					// dodawanie wektorw normalnych poszczeglnych cian
-					GLfloat nv[3];
-					Normal(nv, j);
-					n[0] += nv[0];
-					n[1] += nv[1];
-					n[2] += nv[2];
-				}
-
-			// uredniony wektor normalny jest normalizowany tylko, gdy biblioteka
-			// obsuguje automatyczne skalowania jednostkowych wektorw normalnych
-			if (rescale_normal == true)
-				Normalize(n);
-			glNormal3fv(n);
-			glVertex3fv(&vertices[3 * triangles[3 * i + 2]]);
+			const SceneObject &object = scene[i];
+			RenderQueueAdd(queue, object.mesh, 0, object.count, object.material, 0, object.blend,
+				ViewDepth(object.center), object.matrix);
 		}
 	}
 	else
 	{
-		// generowanie obiektu "paskiego" - jeden wektor normalny na cian
-		for (int i = 0; i < triangles.size() / 3; i++)
+		// siatka budowana i wysyana do bufora tylko po zmianie geometrii
+		// lub rodzaju wektorw normalnych
+		if (mesh_dirty)
+			BuildMesh();
+
+		const int material = RenderQueueMaterial(queue, ambient, diffuse, specular, shininess);
+		// program nie wcza mieszania kolorw - materiay z alfa < 1 s
+		// rysowane jak nieprzezroczyste
+		const int blend = BLEND_OPAQUE;
+
+		// poziom szczegowoci - automatycznie najprostszy o bdzie w rzucie
+		// na ekran nie wikszym ni piksel
+		if (LodLevels(lod) > 0)
 		{
-			GLfloat* a = &vertices[3 * triangles[3 * i + 0]];
-			GLfloat* b = &vertices[3 * triangles[3 * i + 1]];
-			GLfloat* c = &vertices[3 * triangles[3 * i + 2]];
-
-			GLTVector3 n;
-			gltGetNormalVector(a, b, c, n);
+			int level = lod_mode == LOD_AUTO ? SelectLod(lod, PixelsPerUnit()) : lod_mode - LOD_0;
+			if (level >= LodLevels(lod))
+				level = LodLevels(lod) - 1;
+			if (level != lod_level)
+				printf("Poziom szczegolowosci %d: %d trojkatow\n", level, lod.count[level] / 3);
+			lod_level = level;
+			RenderQueueAdd(queue, RenderQueueMesh(queue, &mesh), lod.first[level], lod.count[level], material, 0, blend, 0.5f);
+		}
+		else
+			RenderQueueAdd(queue, RenderQueueMesh(queue, &mesh), 0, mesh.index_count, material, 0, blend, 0.5f);
+	}
+	RenderQueueFlush(queue);
 
-			if (rescale_normal == true)
-				Normalize(n);
+	// wywoania rysujce i zmiany stanu kolejki - do licznika wydajnoci
+	ProfilerDraw(queue.stats.indices, queue.stats.items);
+	ProfilerTextureBind(queue.stats.texture_binds);
+	ProfilerStateChanges(queue.stats.material_changes + queue.stats.blend_changes + queue.stats.mesh_changes);
 
-			glNormal3fv(n);
-			glVertex3fv(a);
-			glVertex3fv(b);
-			glVertex3fv(c);
-		}
+	if (queue_report)
+	{
+		const RenderQueueStats &stats = queue.stats;
+		printf("Kolejka: %d obiektow, zmiany stanu: materialy %d, tekstury %d, mieszanie %d, siatki %d "
+			"(bez sortowania %d)\n", stats.items, stats.material_changes, stats.texture_changes, stats.blend_changes,
+			stats.mesh_changes, stats.unsorted_changes);
+		queue_report = false;
 	}
 
-	glEnd();
+	// wykres czasw ramek (bez okna pomijany - zapisywane ramki nie zale
+	// od wynikw pomiarw)
+	if (!Headless())
+		ProfilerOverlay(WindowWidth(), WindowHeight());
+
 	glFlush();
-	glutSwapBuffers();
+	WindowSwapBuffers();
 }
 
 // zmiana wielkoci okna
@@ -547,6 +858,48 @@ void Keyboard(unsigned char key, int x, int y)
 		if (quadratic_attenuation > 0)
 			quadratic_attenuation -= 0.1;
 		break;
+
+		// liczba bokw podstawy
+	case 'N':
+		pyramid.sides++;
+		BuildPyramid();
+		break;
+
+	case 'n':
+		if (pyramid.sides > 3)
+		{
+			pyramid.sides--;
+			BuildPyramid();
+		}
+		break;
+
+		// podzia pionowy cian bocznych
+	case 'H':
+		pyramid.stacks *= 2;
+		BuildPyramid();
+		break;
+
+	case 'h':
+		if (pyramid.stacks > 1)
+		{
+			pyramid.stacks /= 2;
+			BuildPyramid();
+		}
+		break;
+
+		// podzia radialny podstaw
+	case 'D':
+		pyramid.rings *= 2;
+		BuildPyramid();
+		break;
+
+	case 'd':
+		if (pyramid.rings > 1)
+		{
+			pyramid.rings /= 2;
+			BuildPyramid();
+		}
+		break;
 	}
 
 	// narysowanie sceny
@@ -637,12 +990,14 @@ void Menu(int value)
 		// wektory normalne - GLU_SMOOTH
 	case NORMALS_SMOOTH:
 		normals = NORMALS_SMOOTH;
+		mesh_dirty = true;
 		Display();
 		break;
 
 		// wektory normalne - GLU_FLAT
 	case NORMALS_FLAT:
 		normals = NORMALS_FLAT;
+		mesh_dirty = true;
 		Display();
 		break;
 
@@ -664,6 +1019,55 @@ void Menu(int value)
 		light = value;
 		Display();
 		break;
+
+		// rodzaj bryy
+	case SOLID_PYRAMID:
+	case SOLID_PRISM:
+	case SOLID_STRESS_1M:
+	case SOLID_STRESS_4M:
+		pyramid = PyramidParams();
+		pyramid.radius = 0.5f;
+		pyramid.z_up = true;
+		if (value == SOLID_PRISM)
+			pyramid.top_radius = 0.5f;
+		if (value == SOLID_STRESS_1M)
+		{
+			pyramid.sides = 512;
+			pyramid.rings = 256;
+			pyramid.stacks = 768;
+		}
+		if (value == SOLID_STRESS_4M)
+		{
+			pyramid.sides = 1024;
+			pyramid.rings = 512;
+			pyramid.stacks = 1536;
+		}
+		scene_visible = false;
+		BuildPyramid();
+		Display();
+		break;
+
+		// scena wielu bry
+	case SOLID_SCENE:
+		if (scene.empty())
+			BuildScene();
+		scene_visible = true;
+		queue_report = true;
+		Display();
+		break;
+
+		// poziom szczegowoci
+	case LOD_AUTO:
+	case LOD_0:
+	case LOD_1:
+	case LOD_2:
+	case LOD_3:
+	case LOD_4:
+	case LOD_5:
+		lod_mode = value;
+		Display();
+		break;
+
 		// wyjcie
 	case EXIT:
 		exit(0);
@@ -686,6 +1090,9 @@ void ExtensionSetup()
 		exit(0);
 	}
 
+	// obiekty buforowe i zapytania
+	ExtensionFunctionsSetup();
+
 	// sprawdzenie czy jest co najmniej wersja 1.2
 	if (major > 1 || minor >= 2)
 		rescale_normal = true;
@@ -710,43 +1117,19 @@ void ExtensionSetup()
 	}
 }
 
-void BuildPyramid()
-{
-	vertices[3 * N + 0] = 0.0f;
-	vertices[3 * N + 1] = 0.0f;
-	vertices[3 * N + 2] = 0.0f;
-	vertices[3 * (N + 1) + 0] = 0.0f;
-	vertices[3 * (N + 1) + 1] = 0.0f;
-	vertices[3 * (N + 1) + 2] = 1.0f;
-
-	// podstawa
-	for (int i = 0; i < N; ++i)
-	{
-		const GLfloat x = 0.5f * std::sin(2.0f * 3.1415f * ((GLfloat)i / N));
-		const GLfloat y = 0.5f * std::cos(2.0f * 3.1415f * ((GLfloat)i / N));
-
-		vertices[3 * i + 0] = x;
-		vertices[3 * i + 1] = y;
-		vertices[3 * i + 2] = 0.0f;
-	}
+// scenariusz kamery w trybie bez okna - brya pochylona o 60 stopni
+// i peny obrt wok osi Y przy staym pooeniu wiata
 
-	// grne ciany boczne
-	for (int i = 0; i <= N; ++i)
-	{
-		triangles[3 * i + 0] = N;
-		triangles[3 * i + 1] = i % N;
-		triangles[3 * i + 2] = (i + 1) % N;
-
-		triangles[3 * (i + N + 1) + 0] = (i + 1) % N;
-		triangles[3 * (i + N + 1) + 1] = i % N;
-		triangles[3 * (i + N + 1) + 2] = N + 1;
-	}
+void HeadlessScript(int frame, int frames)
+{
+	rotatex = -60.0f;
+	rotatey = 360.0f * frame / frames;
 }
 
-int main(int argc, char *argv[])
-{
-	BuildPyramid();
+// utworzenie okna GLUT i menu podrcznego oraz doczenie funkcji obsugi zdarze
 
+void WindowSetup(int &argc, char *argv[])
+{
 	// inicjalizacja biblioteki GLUT
 	glutInit(&argc, argv);
 
@@ -760,7 +1143,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Wektory normalne");
 
 	// doczenie funkcji generujcej scen 3D
-	glutDisplayFunc(Display);
+	glutDisplayFunc(ProfilerWrap(Display));
 
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -800,8 +1183,26 @@ int main(int argc, char *argv[])
 	glutAddMenuEntry("Otaczajace", LIGHT_AMBIENT);
 	glutAddMenuEntry("Reflektor", LIGHT_SPOT);
 
+	int MenuSolid = glutCreateMenu(Menu);
+	glutAddMenuEntry("Ostroslup", SOLID_PYRAMID);
+	glutAddMenuEntry("Graniastoslup", SOLID_PRISM);
+	glutAddMenuEntry("Test obciazenia - 1 mln trojkatow", SOLID_STRESS_1M);
+	glutAddMenuEntry("Test obciazenia - 4 mln trojkatow", SOLID_STRESS_4M);
+	glutAddMenuEntry("Scena - 4096 bryl, 19 materialow", SOLID_SCENE);
+
+	int MenuLod = glutCreateMenu(Menu);
+	glutAddMenuEntry("Automatyczny", LOD_AUTO);
+	glutAddMenuEntry("Pelna siatka", LOD_0);
+	glutAddMenuEntry("1/2 trojkatow", LOD_1);
+	glutAddMenuEntry("1/4 trojkatow", LOD_2);
+	glutAddMenuEntry("1/8 trojkatow", LOD_3);
+	glutAddMenuEntry("1/16 trojkatow", LOD_4);
+	glutAddMenuEntry("1/32 trojkatow", LOD_5);
+
 	glutCreateMenu(Menu);
 
+	glutAddSubMenu("Bryla", MenuSolid);
+	glutAddSubMenu("Poziom szczegolowosci", MenuLod);
 	glutAddSubMenu("Material", MenuMaterial);
 	glutAddSubMenu("Swiatlo", MenuLight);
 	glutAddSubMenu("Wektory normalne", MenuNormals);
@@ -809,9 +1210,32 @@ int main(int argc, char *argv[])
 	glutAddMenuEntry("Wyjscie", EXIT);
 
 	glutAttachMenu(GLUT_RIGHT_BUTTON);
+}
+
+int main(int argc, char *argv[])
+{
+	pyramid.radius = 0.5f;
+	pyramid.z_up = true;
+
+	// tryb bez okna (opcja --headless) - kontekst w buforze pozaekranowym
+	const bool headless = HeadlessInit(argc, argv, 500, 500);
+	if (!headless)
+		WindowSetup(argc, argv);
+
+	// brya budowana po utworzeniu okna lub kontekstu (pomiar czasu przez GLUT);
+	// pierwszy argument - plik OBJ lub PLY z modelem wywietlanym zamiast bryy
+	if (argc < 2 || !LoadModel(argv[1]))
+		BuildPyramid();
 
 	ExtensionSetup();
 
+	// pomiar czasw ramek, dane ramek w pliku Program1_profile.csv
+	ProfilerInit("Program1_profile.csv");
+
+	// bez okna - narysowanie ramek wedug scenariusza kamery
+	if (headless)
+		return HeadlessRun(ProfilerWrap(Display), Reshape, HeadlessScript);
+
 	glutMainLoop();
 	return 0;
 }
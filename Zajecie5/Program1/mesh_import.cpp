@@ -0,0 +1,813 @@
+#include "mesh_import.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// plik odwzorowany w pamici
+
+struct MappedFile
+{
+	const char *data = NULL;
+	size_t size = 0;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = NULL;
+#else
+	int file = -1;
+#endif
+};
+
+static bool MapFile(const char *filename, MappedFile &map)
+{
+#ifdef _WIN32
+	map.file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (map.file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	GetFileSizeEx(map.file, &size);
+	map.size = (size_t)size.QuadPart;
+	if (map.size == 0)
+		return true;
+	map.mapping = CreateFileMappingA(map.file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (map.mapping == NULL)
+		return false;
+	map.data = (const char*)MapViewOfFile(map.mapping, FILE_MAP_READ, 0, 0, 0);
+	return map.data != NULL;
+#else
+	map.file = open(filename, O_RDONLY);
+	if (map.file < 0)
+		return false;
+	struct stat st;
+	if (fstat(map.file, &st) != 0)
+		return false;
+	map.size = (size_t)st.st_size;
+	if (map.size == 0)
+		return true;
+	void *data = mmap(NULL, map.size, PROT_READ, MAP_PRIVATE, map.file, 0);
+	if (data == MAP_FAILED)
+		return false;
+	madvise(data, map.size, MADV_SEQUENTIAL);
+	map.data = (const char*)data;
+	return true;
+#endif
+}
+
+static void UnmapFile(MappedFile &map)
+{
+#ifdef _WIN32
+	if (map.data)
+		UnmapViewOfFile(map.data);
+	if (map.mapping)
+		CloseHandle(map.mapping);
+	if (map.file != INVALID_HANDLE_VALUE)
+		CloseHandle(map.file);
+#else
+	if (map.data)
+		munmap((void*)map.data, map.size);
+	if (map.file >= 0)
+		close(map.file);
+#endif
+	map = MappedFile();
+}
+
+// liczba wtkw roboczych
+
+static int ThreadCount()
+{
+	int threads = (int)std::thread::hardware_concurrency();
+	return threads < 1 ? 1 : threads;
+}
+
+// wykonanie job(i) dla i = 0 ... count - 1, kade w osobnym wtku
+
+template<typename Job>
+static void Parallel(int count, Job job)
+{
+	std::vector<std::thread> threads;
+	for (int i = 1; i < count; i++)
+		threads.push_back(std::thread(job, i));
+	job(0);
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
+
+// odczyt liczb z tekstu - bez locale i strumieni; p wskazuje na pierwszy
+// znak, zwracany jest wskanik za liczb (p, gdy liczby nie odczytano)
+
+static inline bool IsSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char *ParseInt(const char *p, const char *end, long long &value)
+{
+	const char *start = p;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = *p++ == '-';
+	long long v = 0;
+	const char *digits = p;
+	while (p < end && *p >= '0' && *p <= '9')
+		v = 10 * v + (*p++ - '0');
+	if (p == digits)
+		return start;
+	value = negative ? -v : v;
+	return p;
+}
+
+static const char *ParseFloat(const char *p, const char *end, float &value)
+{
+	static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	const char *start = p;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = *p++ == '-';
+
+	// cz cakowita i uamkowa jako jedna liczba cakowita z wykadnikiem
+	unsigned long long mantissa = 0;
+	int exponent = 0, digits = 0;
+	while (p < end && *p >= '0' && *p <= '9')
+	{
+		if (mantissa < 100000000000000000ULL)
+			mantissa = 10 * mantissa + (*p - '0');
+		else
+			exponent++;
+		p++;
+		digits++;
+	}
+	if (p < end && *p == '.')
+	{
+		p++;
+		while (p < end && *p >= '0' && *p <= '9')
+		{
+			if (mantissa < 100000000000000000ULL)
+			{
+				mantissa = 10 * mantissa + (*p - '0');
+				exponent--;
+			}
+			p++;
+			digits++;
+		}
+	}
+	if (digits == 0)
+		return start;
+
+	// wykadnik dziesitny
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		long long e;
+		const char *q = ParseInt(p + 1, end, e);
+		if (q != p + 1)
+		{
+			exponent += (int)e;
+			p = q;
+		}
+	}
+
+	double v = (double)mantissa;
+	if (exponent < 0)
+		v = -exponent <= 22 ? v / powers[-exponent] : v * pow(10.0, exponent);
+	else if (exponent > 0)
+		v = exponent <= 22 ? v * powers[exponent] : v * pow(10.0, exponent);
+	value = (float)(negative ? -v : v);
+	return p;
+}
+
+static const char *SkipSpaces(const char *p, const char *end)
+{
+	while (p < end && IsSpace(*p))
+		p++;
+	return p;
+}
+
+static const char *NextLine(const char *p, const char *end)
+{
+	const char *q = (const char*)memchr(p, '\n', end - p);
+	return q ? q + 1 : end;
+}
+
+// podzia pliku na fragmenty zaczynajce si od pocztku wiersza
+
+static std::vector<const char*> SplitLines(const char *begin, const char *end, int parts)
+{
+	std::vector<const char*> bounds(1, begin);
+	for (int i = 1; i < parts; i++)
+	{
+		const char *p = begin + (end - begin) * i / parts;
+		if (p < bounds.back())
+			p = bounds.back();
+		bounds.push_back(p > begin ? NextLine(p - 1, end) : begin);
+	}
+	bounds.push_back(end);
+	return bounds;
+}
+
+// OBJ: wiersze "v x y z" i "f a[/b[/c]] ..." (indeksy od 1 lub ujemne - wzgldne;
+// indeks 0 jest bdny)
+
+static inline bool IsObjVertex(const char *p, const char *end)
+{
+	return end - p > 1 && p[0] == 'v' && IsSpace(p[1]);
+}
+
+static inline bool IsObjFace(const char *p, const char *end)
+{
+	return end - p > 1 && p[0] == 'f' && IsSpace(p[1]);
+}
+
+static bool ImportObj(const MappedFile &map, std::vector<float> &vertices, std::vector<int> &triangles)
+{
+	const char *begin = map.data, *end = map.data + map.size;
+	const int parts = ThreadCount();
+	std::vector<const char*> bounds = SplitLines(begin, end, parts);
+
+	// pierwszy przebieg: liczba wierzchokw w kadym fragmencie
+	std::vector<long long> counts(parts, 0);
+	Parallel(parts, [&](int part)
+	{
+		long long count = 0;
+		for (const char *p = bounds[part]; p < bounds[part + 1]; p = NextLine(p, bounds[part + 1]))
+		{
+			p = SkipSpaces(p, bounds[part + 1]);
+			if (IsObjVertex(p, bounds[part + 1]))
+				count++;
+		}
+		counts[part] = count;
+	});
+	std::vector<long long> first(parts + 1, 0);
+	for (int i = 0; i < parts; i++)
+		first[i + 1] = first[i] + counts[i];
+	const long long vertex_count = first[parts];
+	vertices.resize(3 * vertex_count);
+
+	// drugi przebieg: wsprzdne zapisywane bezporednio na swoje miejsca,
+	// trjkty do tablic poszczeglnych fragmentw
+	std::vector<std::vector<int> > faces(parts);
+	std::vector<long long> errors(parts, 0);
+	Parallel(parts, [&](int part)
+	{
+		const char *stop = bounds[part + 1];
+		long long index = first[part];
+		std::vector<int> polygon;
+		for (const char *p = bounds[part]; p < stop; p = NextLine(p, stop))
+		{
+			p = SkipSpaces(p, stop);
+			if (IsObjVertex(p, stop))
+			{
+				float *v = &vertices[3 * index++];
+				p += 1;
+				for (int k = 0; k < 3; k++)
+				{
+					p = SkipSpaces(p, stop);
+					const char *q = ParseFloat(p, stop, v[k]);
+					if (q == p)
+					{
+						v[k] = 0.0f;
+						errors[part]++;
+					}
+					p = q;
+				}
+			}
+			else if (IsObjFace(p, stop))
+			{
+				polygon.clear();
+				p += 1;
+				for (;;)
+				{
+					p = SkipSpaces(p, stop);
+					long long i;
+					const char *q = ParseInt(p, stop, i);
+					if (q == p)
+						break;
+					// indeks wierzchoka; pozostae (/vt/vn) s pomijane
+					i = i > 0 ? i - 1 : i < 0 ? index + i : -1;
+					if (i < 0 || i >= vertex_count)
+						errors[part]++;
+					polygon.push_back((int)i);
+					p = q;
+					while (p < stop && !IsSpace(*p) && *p != '\n')
+						p++;
+				}
+				// podzia wielokta na trjkty (wachlarz)
+				bool valid = true;
+				for (size_t k = 0; k < polygon.size(); k++)
+					valid = valid && polygon[k] >= 0 && polygon[k] < vertex_count;
+				for (size_t k = 2; valid && k < polygon.size(); k++)
+				{
+					faces[part].push_back(polygon[0]);
+					faces[part].push_back(polygon[k - 1]);
+					faces[part].push_back(polygon[k]);
+				}
+			}
+		}
+	});
+
+	long long error_count = 0;
+	size_t total = 0;
+	for (int i = 0; i < parts; i++)
+	{
+		error_count += errors[i];
+		total += faces[i].size();
+	}
+	if (error_count)
+		printf("OBJ: %lld blednych wartosci lub indeksow pominieto\n", error_count);
+	triangles.clear();
+	triangles.reserve(total);
+	for (int i = 0; i < parts; i++)
+		triangles.insert(triangles.end(), faces[i].begin(), faces[i].end());
+	return true;
+}
+
+// PLY binarny
+
+enum PlyType { PLY_NONE, PLY_INT8, PLY_UINT8, PLY_INT16, PLY_UINT16, PLY_INT32, PLY_UINT32, PLY_FLOAT32, PLY_FLOAT64 };
+
+static PlyType PlyTypeByName(const std::string &name)
+{
+	if (name == "char" || name == "int8") return PLY_INT8;
+	if (name == "uchar" || name == "uint8") return PLY_UINT8;
+	if (name == "short" || name == "int16") return PLY_INT16;
+	if (name == "ushort" || name == "uint16") return PLY_UINT16;
+	if (name == "int" || name == "int32") return PLY_INT32;
+	if (name == "uint" || name == "uint32") return PLY_UINT32;
+	if (name == "float" || name == "float32") return PLY_FLOAT32;
+	if (name == "double" || name == "float64") return PLY_FLOAT64;
+	return PLY_NONE;
+}
+
+static int PlySize(PlyType type)
+{
+	static const int sizes[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+	return sizes[type];
+}
+
+static double PlyRead(const unsigned char *p, PlyType type, bool swap)
+{
+	unsigned char b[8];
+	const int size = PlySize(type);
+	for (int i = 0; i < size; i++)
+		b[i] = swap ? p[size - 1 - i] : p[i];
+	switch (type)
+	{
+	case PLY_INT8: return (signed char)b[0];
+	case PLY_UINT8: return b[0];
+	case PLY_INT16: { short v; memcpy(&v, b, 2); return v; }
+	case PLY_UINT16: { unsigned short v; memcpy(&v, b, 2); return v; }
+	case PLY_INT32: { int v; memcpy(&v, b, 4); return v; }
+	case PLY_UINT32: { unsigned int v; memcpy(&v, b, 4); return v; }
+	case PLY_FLOAT32: { float v; memcpy(&v, b, 4); return v; }
+	case PLY_FLOAT64: { double v; memcpy(&v, b, 8); return v; }
+	default: return 0.0;
+	}
+}
+
+struct PlyProperty
+{
+	std::string name;
+	PlyType type = PLY_NONE; // typ wartoci (elementw listy)
+	PlyType count_type = PLY_NONE; // typ liczby elementw listy (PLY_NONE - warto skalarna)
+};
+
+struct PlyElement
+{
+	std::string name;
+	long long count = 0;
+	std::vector<PlyProperty> properties;
+};
+
+static bool ImportPly(const MappedFile &map, std::vector<float> &vertices, std::vector<int> &triangles)
+{
+	const char *end = map.data + map.size;
+	const char *p = map.data;
+	std::vector<PlyElement> elements;
+	bool swap = false;
+
+	// nagwek
+	for (;;)
+	{
+		if (p >= end)
+		{
+			printf("PLY: brak konca naglowka\n");
+			return false;
+		}
+		const char *line_end = NextLine(p, end);
+		std::string line(p, line_end);
+		p = line_end;
+		while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+			line.pop_back();
+		char word[64] = "", a[64] = "", b[64] = "", c[64] = "", d[64] = "";
+		sscanf(line.c_str(), "%63s %63s %63s %63s %63s", word, a, b, c, d);
+		if (strcmp(word, "end_header") == 0)
+			break;
+		if (strcmp(word, "format") == 0)
+		{
+			if (strcmp(a, "binary_little_endian") == 0 || strcmp(a, "binary_big_endian") == 0)
+			{
+				const unsigned short probe = 1;
+				const bool little = *(const unsigned char*)&probe == 1;
+				swap = (strcmp(a, "binary_little_endian") == 0) != little;
+			}
+			else
+			{
+				printf("PLY: obslugiwany jest tylko format binarny (%s)\n", a);
+				return false;
+			}
+		}
+		else if (strcmp(word, "element") == 0)
+		{
+			PlyElement element;
+			element.name = a;
+			element.count = atoll(b);
+			elements.push_back(element);
+		}
+		else if (strcmp(word, "property") == 0 && !elements.empty())
+		{
+			PlyProperty property;
+			if (strcmp(a, "list") == 0)
+			{
+				property.count_type = PlyTypeByName(b);
+				property.type = PlyTypeByName(c);
+				property.name = d;
+				if (property.count_type == PLY_NONE)
+					property.type = PLY_NONE;
+			}
+			else
+			{
+				property.type = PlyTypeByName(a);
+				property.name = b;
+			}
+			if (property.type == PLY_NONE)
+			{
+				printf("PLY: nieznany typ wlasnosci %s\n", line.c_str());
+				return false;
+			}
+			elements.back().properties.push_back(property);
+		}
+	}
+
+	const unsigned char *data = (const unsigned char*)p;
+	const unsigned char *data_end = (const unsigned char*)end;
+	const int parts = ThreadCount();
+	vertices.clear();
+	triangles.clear();
+
+	for (size_t e = 0; e < elements.size(); e++)
+	{
+		const PlyElement &element = elements[e];
+
+		// rozmiar elementu zoonego wycznie z wartoci skalarnych
+		int stride = 0;
+		bool fixed = true;
+		for (size_t i = 0; i < element.properties.size(); i++)
+		{
+			fixed = fixed && element.properties[i].count_type == PLY_NONE;
+			stride += PlySize(element.properties[i].type);
+		}
+
+		if (element.name == "vertex")
+		{
+			if (!fixed)
+			{
+				printf("PLY: wierzcholki z listami nie sa obslugiwane\n");
+				return false;
+			}
+			if (data + stride * element.count > data_end)
+			{
+				printf("PLY: plik jest za krotki\n");
+				return false;
+			}
+			int offset[3] = { -1, -1, -1 };
+			PlyType type[3] = { PLY_NONE, PLY_NONE, PLY_NONE };
+			int position = 0;
+			for (size_t i = 0; i < element.properties.size(); i++)
+			{
+				const int axis = element.properties[i].name == "x" ? 0 : element.properties[i].name == "y" ? 1 :
+					element.properties[i].name == "z" ? 2 : -1;
+				if (axis >= 0)
+				{
+					offset[axis] = position;
+					type[axis] = element.properties[i].type;
+				}
+				position += PlySize(element.properties[i].type);
+			}
+			if (offset[0] < 0 || offset[1] < 0 || offset[2] < 0)
+			{
+				printf("PLY: brak wspolrzednych x, y, z wierzcholkow\n");
+				return false;
+			}
+
+			// wierzchoki maj stay rozmiar - rwnolegy odczyt przedziaw
+			vertices.resize(3 * element.count);
+			const long long count = element.count;
+			const bool fast = !swap && type[0] == PLY_FLOAT32 && type[1] == PLY_FLOAT32 && type[2] == PLY_FLOAT32;
+			Parallel(parts, [&](int part)
+			{
+				const long long from = count * part / parts, to = count * (part + 1) / parts;
+				for (long long i = from; i < to; i++)
+				{
+					const unsigned char *v = data + stride * i;
+					for (int k = 0; k < 3; k++)
+						if (fast)
+							memcpy(&vertices[3 * i + k], v + offset[k], 4);
+						else
+							vertices[3 * i + k] = (float)PlyRead(v + offset[k], type[k], swap);
+				}
+			});
+			data += stride * element.count;
+		}
+		else if (element.name == "face")
+		{
+			// indeks wasnoci z list wierzchokw
+			int list = -1;
+			for (size_t i = 0; i < element.properties.size(); i++)
+				if (element.properties[i].count_type != PLY_NONE &&
+					(element.properties[i].name == "vertex_indices" || element.properties[i].name == "vertex_index"))
+					list = (int)i;
+			if (list < 0)
+			{
+				printf("PLY: brak listy vertex_indices scian\n");
+				return false;
+			}
+			const PlyProperty &indices = element.properties[list];
+			const int count_size = PlySize(indices.count_type);
+			const int index_size = PlySize(indices.type);
+			const long long vertex_count = (long long)vertices.size() / 3;
+
+			// typowy przypadek - same trjkty bez innych wasnoci: stay
+			// rozmiar ciany, wic take rwnolegy odczyt przedziaw
+			const int face_size = count_size + 3 * index_size;
+			bool triangles_only = element.properties.size() == 1 && data + face_size * element.count <= data_end;
+			if (triangles_only)
+			{
+				std::vector<char> valid(parts, 1);
+				const long long count = element.count;
+				triangles.resize(3 * count);
+				Parallel(parts, [&](int part)
+				{
+					const long long from = count * part / parts, to = count * (part + 1) / parts;
+					for (long long i = from; i < to && valid[part]; i++)
+					{
+						const unsigned char *f = data + face_size * i;
+						if (PlyRead(f, indices.count_type, swap) != 3)
+						{
+							valid[part] = 0;
+							break;
+						}
+						for (int k = 0; k < 3; k++)
+						{
+							const long long index = (long long)PlyRead(f + count_size + k * index_size, indices.type, swap);
+							triangles[3 * i + k] = index >= 0 && index < vertex_count ? (int)index : -1;
+						}
+					}
+				});
+				for (int i = 0; i < parts; i++)
+					triangles_only = triangles_only && valid[i];
+				if (triangles_only)
+					data += face_size * element.count;
+				else
+					triangles.clear();
+			}
+
+			// wielokty lub dodatkowe wasnoci - odczyt sekwencyjny
+			if (!triangles_only)
+			{
+				for (long long i = 0; i < element.count; i++)
+				{
+					std::vector<int> polygon;
+					for (size_t j = 0; j < element.properties.size(); j++)
+					{
+						const PlyProperty &property = element.properties[j];
+						if (property.count_type == PLY_NONE)
+						{
+							if (PlySize(property.type) > data_end - data)
+							{
+								printf("PLY: plik jest za krotki\n");
+								return false;
+							}
+							data += PlySize(property.type);
+							continue;
+						}
+						if (data + PlySize(property.count_type) > data_end)
+						{
+							printf("PLY: plik jest za krotki\n");
+							return false;
+						}
+						const int n = (int)PlyRead(data, property.count_type, swap);
+						data += PlySize(property.count_type);
+						if (data + n * PlySize(property.type) > data_end)
+						{
+							printf("PLY: plik jest za krotki\n");
+							return false;
+						}
+						for (int k = 0; k < n && (int)j == list; k++)
+						{
+							const long long index = (long long)PlyRead(data + k * index_size, property.type, swap);
+							polygon.push_back(index >= 0 && index < vertex_count ? (int)index : -1);
+						}
+						data += n * PlySize(property.type);
+					}
+					for (size_t k = 2; k < polygon.size(); k++)
+					{
+						triangles.push_back(polygon[0]);
+						triangles.push_back(polygon[k - 1]);
+						triangles.push_back(polygon[k]);
+					}
+				}
+			}
+		}
+		else
+		{
+			// pozostae elementy s pomijane; dugo kadej pomijanej
+			// wartoci i listy jest porwnywana z reszt pliku przed odczytem
+			if (fixed)
+			{
+				if (stride * element.count > data_end - data)
+				{
+					printf("PLY: plik jest za krotki\n");
+					return false;
+				}
+				data += stride * element.count;
+			}
+			else
+				for (long long i = 0; i < element.count; i++)
+					for (size_t j = 0; j < element.properties.size(); j++)
+					{
+						const PlyProperty &property = element.properties[j];
+						const long long remaining = data_end - data;
+						long long size = PlySize(property.count_type == PLY_NONE ? property.type : property.count_type);
+						if (size <= remaining && property.count_type != PLY_NONE)
+						{
+							const long long n = (long long)PlyRead(data, property.count_type, swap);
+							size = n < 0 ? remaining + 1 : size + n * PlySize(property.type);
+						}
+						if (size > remaining)
+						{
+							printf("PLY: plik jest za krotki\n");
+							return false;
+						}
+						data += size;
+					}
+		}
+		if (data > data_end)
+		{
+			printf("PLY: plik jest za krotki\n");
+			return false;
+		}
+	}
+
+	// usunicie trjktw z bdnymi indeksami
+	size_t out = 0;
+	for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+		if (triangles[i] >= 0 && triangles[i + 1] >= 0 && triangles[i + 2] >= 0)
+		{
+			triangles[out++] = triangles[i];
+			triangles[out++] = triangles[i + 1];
+			triangles[out++] = triangles[i + 2];
+		}
+	if (out != triangles.size())
+		printf("PLY: %d trojkatow z blednymi indeksami pominieto\n", (int)(triangles.size() - out) / 3);
+	triangles.resize(out);
+	return true;
+}
+
+// czenie wierzchokw o identycznych wsprzdnych; w pierwszym przebiegu
+// kady wtek liczy klucze swojego przedziau wierzchokw i rozdziela je wg
+// wartoci skrtu, w drugim - kady wtek czy wierzchoki swojej wartoci
+// skrtu (mapy s niezalene) w kolejnoci numerw, wic reprezentantem jest
+// zawsze pierwsze wystpienie
+
+struct VertexKey
+{
+	unsigned int x, y, z;
+	bool operator==(const VertexKey &k) const { return x == k.x && y == k.y && z == k.z; }
+};
+
+struct VertexHash
+{
+	size_t operator()(const VertexKey &k) const
+	{
+		unsigned long long h = k.x * 0x9E3779B97F4A7C15ULL;
+		h ^= (h >> 29) + k.y * 0xBF58476D1CE4E5B9ULL;
+		h ^= (h >> 31) + k.z * 0x94D049BB133111EBULL;
+		return (size_t)(h ^ (h >> 32));
+	}
+};
+
+static VertexKey Key(const float *v)
+{
+	VertexKey key;
+	// -0.0 i 0.0 to ten sam punkt
+	const float x = v[0] == 0.0f ? 0.0f : v[0], y = v[1] == 0.0f ? 0.0f : v[1], z = v[2] == 0.0f ? 0.0f : v[2];
+	memcpy(&key.x, &x, 4);
+	memcpy(&key.y, &y, 4);
+	memcpy(&key.z, &z, 4);
+	return key;
+}
+
+static void WeldVertices(std::vector<float> &vertices, std::vector<int> &triangles)
+{
+	const int count = (int)vertices.size() / 3;
+	const int parts = ThreadCount();
+
+	// klucze wierzchokw i ich numery rozdzielone wg skrtu:
+	// buckets[przedzia][skrt % parts]
+	std::vector<VertexKey> keys(count);
+	std::vector<std::vector<std::vector<int> > > buckets(parts, std::vector<std::vector<int> >(parts));
+	Parallel(parts, [&](int part)
+	{
+		const int from = (int)((long long)count * part / parts), to = (int)((long long)count * (part + 1) / parts);
+		std::vector<std::vector<int> > &bucket = buckets[part];
+		for (int i = 0; i < parts; i++)
+			bucket[i].reserve((to - from) / parts + 1);
+		VertexHash hash;
+		for (int i = from; i < to; i++)
+		{
+			keys[i] = Key(&vertices[3 * i]);
+			bucket[hash(keys[i]) % parts].push_back(i);
+		}
+	});
+
+	// reprezentant (pierwsze wystpienie) kadego wierzchoka
+	std::vector<int> first(count);
+	Parallel(parts, [&](int part)
+	{
+		size_t size = 0;
+		for (int i = 0; i < parts; i++)
+			size += buckets[i][part].size();
+		std::unordered_map<VertexKey, int, VertexHash> map;
+		map.reserve(size);
+		for (int i = 0; i < parts; i++)
+		{
+			const std::vector<int> &bucket = buckets[i][part];
+			for (size_t j = 0; j < bucket.size(); j++)
+				first[bucket[j]] = map.insert(std::make_pair(keys[bucket[j]], bucket[j])).first->second;
+		}
+	});
+
+	// nowa numeracja wierzchokw
+	std::vector<int> remap(count);
+	int welded = 0;
+	for (int i = 0; i < count; i++)
+		if (first[i] == i)
+		{
+			remap[i] = welded;
+			if (welded != i)
+				memcpy(&vertices[3 * welded], &vertices[3 * i], 3 * sizeof(float));
+			welded++;
+		}
+		else
+			remap[i] = remap[first[i]];
+	vertices.resize(3 * welded);
+
+	// trjkty z nowymi indeksami, bez zdegenerowanych
+	size_t out = 0;
+	for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+	{
+		const int a = remap[triangles[i]], b = remap[triangles[i + 1]], c = remap[triangles[i + 2]];
+		if (a == b || b == c || a == c)
+			continue;
+		triangles[out++] = a;
+		triangles[out++] = b;
+		triangles[out++] = c;
+	}
+	triangles.resize(out);
+}
+
+bool ImportMesh(const char *filename, std::vector<float> &vertices, std::vector<int> &triangles)
+{
+	MappedFile map;
+	if (!MapFile(filename, map))
+	{
+		printf("Nie mozna otworzyc pliku %s\n", filename);
+		UnmapFile(map);
+		return false;
+	}
+
+	bool ok;
+	if (map.size >= 4 && memcmp(map.data, "ply", 3) == 0 && (map.data[3] == '\n' || map.data[3] == '\r'))
+		ok = ImportPly(map, vertices, triangles);
+	else
+		ok = ImportObj(map, vertices, triangles);
+	UnmapFile(map);
+
+	if (ok)
+		WeldVertices(vertices, triangles);
+	if (ok && triangles.empty())
+	{
+		printf("Plik %s nie zawiera trojkatow\n", filename);
+		ok = false;
+	}
+	return ok;
+}
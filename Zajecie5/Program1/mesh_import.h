@@ -0,0 +1,17 @@
+#ifndef __MESH_IMPORT__H__
+#define __MESH_IMPORT__H__
+
+#include <vector>
+
+// odczyt siatki trjktw z pliku OBJ (tekstowy) lub PLY (binarny,
+// little/big endian); plik jest odwzorowywany w pamici i dzielony na
+// fragmenty parsowane rwnolegle, wielokty s dzielone na trjkty,
+// a wierzchoki o identycznych wsprzdnych s czone
+// filename - nazwa pliku (format rozpoznawany po zawartoci)
+// vertices - wsprzdne (x, y, z) wierzchokw
+// triangles - indeksy wierzchokw trjktw
+// zwraca false w przypadku bdu (komunikat na stdout)
+
+bool ImportMesh(const char *filename, std::vector<float> &vertices, std::vector<int> &triangles);
+
+#endif // __MESH_IMPORT__H__
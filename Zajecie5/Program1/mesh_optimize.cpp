@@ -0,0 +1,153 @@
+#include "mesh_optimize.h"
+#include <string.h>
+#include <vector>
+
+VertexCacheStats AnalyzeVertexCache(const int *triangles, int triangle_count, int vertex_count, int cache_size)
+{
+	// wierzchoek jest w pamici podrcznej, gdy od jego wstawienia
+	// nastpio mniej ni cache_size chybie
+	std::vector<int> stamp(vertex_count, -cache_size - 1);
+	std::vector<char> used(vertex_count, 0);
+	int misses = 0, used_count = 0;
+	for (int i = 0; i < 3 * triangle_count; i++)
+	{
+		const int v = triangles[i];
+		if (misses - stamp[v] > cache_size)
+			stamp[v] = ++misses;
+		if (!used[v])
+		{
+			used[v] = 1;
+			used_count++;
+		}
+	}
+
+	VertexCacheStats stats;
+	if (triangle_count > 0)
+		stats.acmr = (float)misses / triangle_count;
+	if (used_count > 0)
+		stats.atvr = (float)misses / used_count;
+	return stats;
+}
+
+// Tipsify: trjkty s emitowane wachlarzami wok kolejnych wierzchokw;
+// nastpny wierzchoek wachlarza jest wybierany spord wierzchokw wanie
+// wyemitowanych trjktw tak, aby wci by w pamici podrcznej po
+// wyemitowaniu jego pozostaych trjktw; w lepym zauku brany jest
+// ostatni wierzchoek ze stosu lub kolejny wierzchoek z niewyemitowanymi
+// trjktami
+
+void OptimizeVertexCache(int *triangles, int triangle_count, int vertex_count, int cache_size)
+{
+	if (triangle_count <= 0)
+		return;
+
+	// ssiedztwo wierzchoek -> trjkty (sumy prefiksowe)
+	std::vector<int> offsets(vertex_count + 1, 0);
+	for (int i = 0; i < 3 * triangle_count; i++)
+		offsets[triangles[i] + 1]++;
+	for (int v = 0; v < vertex_count; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<int> faces(3 * triangle_count);
+	std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+	for (int i = 0; i < 3 * triangle_count; i++)
+		faces[fill[triangles[i]]++] = i / 3;
+
+	// liczba niewyemitowanych trjktw wierzchokw
+	std::vector<int> live(vertex_count);
+	for (int v = 0; v < vertex_count; v++)
+		live[v] = offsets[v + 1] - offsets[v];
+
+	std::vector<int> stamp(vertex_count, 0);
+	std::vector<char> emitted(triangle_count, 0);
+	std::vector<int> dead_end, candidates, output;
+	output.reserve(3 * triangle_count);
+	dead_end.reserve(3 * triangle_count);
+
+	int fan = 0, time = cache_size + 1, cursor = 1;
+	while (fan >= 0)
+	{
+		// wszystkie niewyemitowane trjkty wok wierzchoka fan
+		candidates.clear();
+		for (int j = offsets[fan]; j < offsets[fan + 1]; j++)
+		{
+			const int t = faces[j];
+			if (emitted[t])
+				continue;
+			for (int k = 0; k < 3; k++)
+			{
+				const int v = triangles[3 * t + k];
+				output.push_back(v);
+				dead_end.push_back(v);
+				candidates.push_back(v);
+				live[v]--;
+				if (time - stamp[v] > cache_size)
+					stamp[v] = time++;
+			}
+			emitted[t] = 1;
+		}
+
+		// wybr nastpnego wierzchoka - najstarszy, ktry pozostanie w
+		// pamici podrcznej po wyemitowaniu swoich trjktw
+		int next = -1, best = -1;
+		for (size_t j = 0; j < candidates.size(); j++)
+		{
+			const int v = candidates[j];
+			if (live[v] <= 0)
+				continue;
+			int priority = 0;
+			if (time - stamp[v] + 2 * live[v] <= cache_size)
+				priority = time - stamp[v];
+			if (priority > best)
+			{
+				best = priority;
+				next = v;
+			}
+		}
+
+		// lepy zauek
+		if (next < 0)
+		{
+			while (!dead_end.empty())
+			{
+				const int v = dead_end.back();
+				dead_end.pop_back();
+				if (live[v] > 0)
+				{
+					next = v;
+					break;
+				}
+			}
+		}
+		if (next < 0)
+		{
+			while (cursor < vertex_count && live[cursor] == 0)
+				cursor++;
+			if (cursor < vertex_count)
+				next = cursor;
+		}
+		fan = next;
+	}
+
+	memcpy(triangles, output.data(), output.size() * sizeof(int));
+}
+
+int OptimizeVertexFetch(float *vertices, int vertex_count, int *triangles, int triangle_count)
+{
+	// nowe numery wierzchokw w kolejnoci pierwszego uycia
+	std::vector<int> remap(vertex_count, -1);
+	int count = 0;
+	for (int i = 0; i < 3 * triangle_count; i++)
+	{
+		int &v = remap[triangles[i]];
+		if (v < 0)
+			v = count++;
+		triangles[i] = v;
+	}
+
+	std::vector<float> reordered(3 * count);
+	for (int v = 0; v < vertex_count; v++)
+		if (remap[v] >= 0)
+			memcpy(&reordered[3 * remap[v]], &vertices[3 * v], 3 * sizeof(float));
+	memcpy(vertices, reordered.data(), reordered.size() * sizeof(float));
+	return count;
+}
@@ -0,0 +1,685 @@
+#include "mesh_simplify.h"
+#include <math.h>
+#include <string.h>
+#include <float.h>
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
+// kwadryka bdu: symetryczna macierz 4x4 sumy kwadratw odlegoci od
+// paszczyzn cian (a00 a01 a02 a03 a11 a12 a13 a22 a23 a33) waonych polem
+// cian oraz suma wag
+
+struct Quadric
+{
+	double a[10] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	double weight = 0.0;
+};
+
+static void QuadricPlane(Quadric &q, double a, double b, double c, double d, double w)
+{
+	q.a[0] += w * a * a; q.a[1] += w * a * b; q.a[2] += w * a * c; q.a[3] += w * a * d;
+	q.a[4] += w * b * b; q.a[5] += w * b * c; q.a[6] += w * b * d;
+	q.a[7] += w * c * c; q.a[8] += w * c * d;
+	q.a[9] += w * d * d;
+}
+
+static void QuadricAdd(Quadric &q, const Quadric &r)
+{
+	for (int i = 0; i < 10; i++)
+		q.a[i] += r.a[i];
+	q.weight += r.weight;
+}
+
+// redni kwadrat odlegoci punktu p od paszczyzn kwadryk q i r
+
+static double QuadricError(const Quadric &q, const Quadric &r, const float *p)
+{
+	double a[10];
+	for (int i = 0; i < 10; i++)
+		a[i] = q.a[i] + r.a[i];
+	const double x = p[0], y = p[1], z = p[2];
+	const double e = a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+		+ a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+		+ a[7] * z * z + 2 * a[8] * z
+		+ a[9];
+	const double w = q.weight + r.weight;
+	return e > 0.0 ? e / (w > 0.0 ? w : 1.0) : 0.0;
+}
+
+static void Cross(const float *a, const float *b, const float *c, double *n)
+{
+	const double u[3] = { (double)b[0] - a[0], (double)b[1] - a[1], (double)b[2] - a[2] };
+	const double v[3] = { (double)c[0] - a[0], (double)c[1] - a[1], (double)c[2] - a[2] };
+	n[0] = u[1] * v[2] - u[2] * v[1];
+	n[1] = u[2] * v[0] - u[0] * v[2];
+	n[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+// rodzaje wierzchokw
+
+enum
+{
+	VERTEX_INTERIOR, // wntrze siatki
+	VERTEX_BORDER, // brzeg - zwijanie tylko wzdu krawdzi brzegowych
+	VERTEX_LOCKED // szew lub wierzchoek nierozmaitociowy - nie jest usuwany
+};
+
+// wierzchoek usunity przez zwinicie krawdzi (pole owner)
+
+const int VERTEX_REMOVED = -2;
+
+// wagi paszczyzn prostopadych do krawdzi brzegowych
+
+const double BORDER_WEIGHT = 10.0;
+
+// najwikszy stopie wierzchoka tworzony przez zwinicie krawdzi
+
+const int MAX_VALENCE = 16;
+
+// stan upraszczania siatki
+
+struct Simplifier
+{
+	const float *vertices = 0;
+	int vertex_count = 0;
+	std::vector<int> triangles; // biece indeksy trjktw (-1 - trjkt usunity)
+	std::vector<int> part; // fragment siatki trjkta
+	std::vector<std::vector<int> > adjacency; // trjkty wierzchoka (usunite s usuwane z opnieniem)
+	std::vector<Quadric> quadrics;
+	std::vector<char> kind; // rodzaj wierzchoka
+	std::vector<int> owner; // fragment wszystkich trjktw wierzchoka, -1 - kilka fragmentw
+	std::vector<int> target; // wierzchoek docelowy najtaszego zwinicia
+	std::vector<double> cost; // bd najtaszego zwinicia
+	std::vector<int> heap_position; // pozycja wierzchoka w kopcu (-1 - brak)
+};
+
+// kopiec binarny wierzchokw uporzdkowany wedug kosztu zwinicia;
+// pozycje wierzchokw w kopcu pozwalaj na zmian kosztu w czasie O(log n)
+
+struct VertexHeap
+{
+	Simplifier *s;
+	std::vector<int> items;
+
+	bool Less(int i, int j) const
+	{
+		return s->cost[items[i]] < s->cost[items[j]];
+	}
+
+	void Swap(int i, int j)
+	{
+		std::swap(items[i], items[j]);
+		s->heap_position[items[i]] = i;
+		s->heap_position[items[j]] = j;
+	}
+
+	void Up(int i)
+	{
+		while (i > 0 && Less(i, (i - 1) / 2))
+		{
+			Swap(i, (i - 1) / 2);
+			i = (i - 1) / 2;
+		}
+	}
+
+	void Down(int i)
+	{
+		for (;;)
+		{
+			int m = i;
+			const int l = 2 * i + 1, r = 2 * i + 2;
+			if (l < (int)items.size() && Less(l, m))
+				m = l;
+			if (r < (int)items.size() && Less(r, m))
+				m = r;
+			if (m == i)
+				return;
+			Swap(i, m);
+			i = m;
+		}
+	}
+
+	void Push(int v)
+	{
+		s->heap_position[v] = (int)items.size();
+		items.push_back(v);
+		Up((int)items.size() - 1);
+	}
+
+	void Remove(int v)
+	{
+		const int i = s->heap_position[v];
+		if (i < 0)
+			return;
+		Swap(i, (int)items.size() - 1);
+		items.pop_back();
+		s->heap_position[v] = -1;
+		if (i < (int)items.size())
+		{
+			Up(i);
+			Down(i);
+		}
+	}
+
+	void Clear()
+	{
+		for (size_t i = 0; i < items.size(); i++)
+			s->heap_position[items[i]] = -1;
+		items.clear();
+	}
+
+	// wstawienie, zmiana pozycji lub usunicie (koszt nieskoczony) wierzchoka
+	void Update(int v)
+	{
+		if (s->cost[v] == DBL_MAX)
+			Remove(v);
+		else if (s->heap_position[v] < 0)
+			Push(v);
+		else
+		{
+			Up(s->heap_position[v]);
+			Down(s->heap_position[v]);
+		}
+	}
+};
+
+static inline bool Dead(const Simplifier &s, int t)
+{
+	return s.triangles[3 * t] < 0;
+}
+
+static inline bool Contains(const int *t, int v)
+{
+	return t[0] == v || t[1] == v || t[2] == v;
+}
+
+// posortowana lista ssiadw wierzchoka v; przy okazji z listy trjktw
+// wierzchoka usuwane s trjkty usunite
+
+static void Neighbors(Simplifier &s, int v, std::vector<int> &neighbors)
+{
+	std::vector<int> &adjacency = s.adjacency[v];
+	size_t alive = 0;
+	neighbors.clear();
+	for (size_t j = 0; j < adjacency.size(); j++)
+	{
+		const int t = adjacency[j];
+		if (Dead(s, t))
+			continue;
+		adjacency[alive++] = t;
+		for (int k = 0; k < 3; k++)
+			if (s.triangles[3 * t + k] != v)
+				neighbors.push_back(s.triangles[3 * t + k]);
+	}
+	adjacency.resize(alive);
+
+	// sortowanie przez wstawianie - listy s zwykle krtkie
+	if (neighbors.size() > 64)
+		std::sort(neighbors.begin(), neighbors.end());
+	else
+		for (size_t i = 1; i < neighbors.size(); i++)
+		{
+			const int w = neighbors[i];
+			size_t j = i;
+			for (; j > 0 && neighbors[j - 1] > w; j--)
+				neighbors[j] = neighbors[j - 1];
+			neighbors[j] = w;
+		}
+	neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+}
+
+// liczba wsplnych elementw posortowanych list
+
+static int Common(const std::vector<int> &a, const std::vector<int> &b)
+{
+	int count = 0;
+	for (size_t i = 0, j = 0; i < a.size() && j < b.size();)
+		if (a[i] < b[j])
+			i++;
+		else if (b[j] < a[i])
+			j++;
+		else
+		{
+			count++;
+			i++;
+			j++;
+		}
+	return count;
+}
+
+// liczba trjktw zawierajcych krawd (u, w)
+
+static int EdgeTriangles(const Simplifier &s, int u, int w)
+{
+	int count = 0;
+	for (size_t j = 0; j < s.adjacency[u].size(); j++)
+	{
+		const int t = s.adjacency[u][j];
+		if (!Dead(s, t) && Contains(&s.triangles[3 * t], w))
+			count++;
+	}
+	return count;
+}
+
+// czy przesunicie u do w nie odwraca (ani nie degeneruje) pozostaych trjktw u
+
+static bool Flips(const Simplifier &s, int u, int w)
+{
+	for (size_t j = 0; j < s.adjacency[u].size(); j++)
+	{
+		const int t = s.adjacency[u][j];
+		const int *i = &s.triangles[3 * t];
+		if (Dead(s, t) || Contains(i, w))
+			continue;
+		const float *p[3], *q[3];
+		for (int k = 0; k < 3; k++)
+		{
+			p[k] = &s.vertices[3 * i[k]];
+			q[k] = i[k] == u ? &s.vertices[3 * w] : p[k];
+		}
+		double before[3], after[3];
+		Cross(p[0], p[1], p[2], before);
+		Cross(q[0], q[1], q[2], after);
+		const double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+		const double lengths = sqrt((before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+			(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]));
+		if (lengths == 0.0 || dot < 0.2 * lengths)
+			return true;
+	}
+	return false;
+}
+
+// pomocnicze tablice wtku
+
+struct Scratch
+{
+	std::vector<int> neighbors, other;
+	std::vector<std::pair<double, int> > candidates;
+};
+
+// wyznaczenie najtaszego dopuszczalnego zwinicia wierzchoka u w zakresie
+// scope (fragment siatki lub -1 - caa siatka)
+
+static void Evaluate(Simplifier &s, int u, int scope, Scratch &scratch)
+{
+	s.cost[u] = DBL_MAX;
+	s.target[u] = -1;
+	if (s.kind[u] == VERTEX_LOCKED || s.owner[u] == VERTEX_REMOVED || (scope >= 0 && s.owner[u] != scope))
+		return;
+
+	// przy zachowaniu warunku cza stopie po zwiniciu wynosi co najmniej
+	// stopie u zmniejszony o 2, wic wierzchoki o duym stopniu s pomijane
+	Neighbors(s, u, scratch.neighbors);
+	if ((int)scratch.neighbors.size() > MAX_VALENCE + 2)
+		return;
+
+	// koszty zwini do wszystkich ssiadw; sprawdzane s w kolejnoci
+	// rosncego kosztu, a do pierwszego dopuszczalnego
+	scratch.candidates.clear();
+	for (size_t j = 0; j < scratch.neighbors.size(); j++)
+	{
+		const int w = scratch.neighbors[j];
+		if (scope < 0 || s.owner[w] == scope)
+			scratch.candidates.push_back(std::make_pair(QuadricError(s.quadrics[u], s.quadrics[w], &s.vertices[3 * w]), w));
+	}
+	std::sort(scratch.candidates.begin(), scratch.candidates.end());
+
+	for (size_t j = 0; j < scratch.candidates.size(); j++)
+	{
+		const int w = scratch.candidates[j].second;
+
+		// wierzchoek brzegowy tylko wzdu krawdzi brzegowej
+		const int shared = EdgeTriangles(s, u, w);
+		if (s.kind[u] == VERTEX_BORDER && (s.kind[w] == VERTEX_INTERIOR || shared != 1))
+			continue;
+		if (Flips(s, u, w))
+			continue;
+
+		// warunek cza: wsplni ssiedzi u i w to tylko wierzchoki
+		// trjktw krawdzi (u, w) - inaczej powstaaby siatka nierozmaitociowa
+		Neighbors(s, w, scratch.other);
+		const int common = Common(scratch.neighbors, scratch.other);
+		if (common != shared)
+			continue;
+
+		// ograniczenie stopnia wierzchoka w - przy wielu zwiniciach o zerowym
+		// koszcie (ciany paskie) powstawayby wachlarze dugich, wskich trjktw
+		const int valence = (int)(scratch.neighbors.size() + scratch.other.size()) - common - 2;
+		if (valence > std::max(MAX_VALENCE, (int)scratch.other.size()))
+			continue;
+
+		s.cost[u] = scratch.candidates[j].first;
+		s.target[u] = w;
+		return;
+	}
+}
+
+// zwijanie krawdzi w kolejnoci rosncego bdu, a liczba trjktw
+// zakresu scope spadnie do target; alive - liczba trjktw fragmentw;
+// pusty kopiec jest wypeniany wierzchokami zakresu (members, dla caej
+// siatki - wszystkimi), niepusty (z poprzedniego wywoania dla tego samego
+// zakresu) jest uywany dalej
+
+static double Collapse(Simplifier &s, VertexHeap &heap, int scope, const std::vector<int> &members,
+	long long target, std::vector<long long> &alive)
+{
+	Scratch scratch;
+	if (heap.items.empty())
+		for (int j = 0; j < (scope < 0 ? s.vertex_count : (int)members.size()); j++)
+		{
+			const int v = scope < 0 ? j : members[j];
+			Evaluate(s, v, scope, scratch);
+			if (s.target[v] >= 0)
+				heap.Push(v);
+		}
+
+	long long remaining = 0;
+	if (scope >= 0)
+		remaining = alive[scope];
+	else
+		for (size_t i = 0; i < alive.size(); i++)
+			remaining += alive[i];
+
+	double max_error = 0.0;
+	std::vector<int> neighbors;
+	while (remaining > target && !heap.items.empty())
+	{
+		const int u = heap.items[0];
+		const int w = s.target[u];
+		heap.Remove(u);
+		max_error = std::max(max_error, s.cost[u]);
+
+		// trjkty krawdzi (u, w) s usuwane, pozostae trjkty u przechodz do w
+		for (size_t j = 0; j < s.adjacency[u].size(); j++)
+		{
+			const int t = s.adjacency[u][j];
+			if (Dead(s, t))
+				continue;
+			int *i = &s.triangles[3 * t];
+			if (Contains(i, w))
+			{
+				i[0] = -1;
+				alive[s.part[t]]--;
+				remaining--;
+				continue;
+			}
+			for (int k = 0; k < 3; k++)
+				if (i[k] == u)
+					i[k] = w;
+			s.adjacency[w].push_back(t);
+			if (s.part[t] != s.owner[w])
+				s.owner[w] = -1;
+		}
+		QuadricAdd(s.quadrics[w], s.quadrics[u]);
+		s.adjacency[u].clear();
+		s.owner[u] = VERTEX_REMOVED;
+
+		// nowe koszty w i jego ssiadw
+		Evaluate(s, w, scope, scratch);
+		heap.Update(w);
+		Neighbors(s, w, neighbors);
+		for (size_t j = 0; j < neighbors.size(); j++)
+			if (scope < 0 || s.owner[neighbors[j]] == scope)
+			{
+				Evaluate(s, neighbors[j], scope, scratch);
+				heap.Update(neighbors[j]);
+			}
+	}
+
+	return max_error;
+}
+
+// inicjalizacja: ssiedztwo, kwadryki i rodzaje wierzchokw
+
+static void Prepare(Simplifier &s, const float *vertices, int vertex_count, const int *triangles, int triangle_count)
+{
+	s.vertices = vertices;
+	s.vertex_count = vertex_count;
+	s.triangles.clear();
+	for (int i = 0; i < triangle_count; i++)
+	{
+		const int *t = &triangles[3 * i];
+		if (t[0] != t[1] && t[1] != t[2] && t[0] != t[2])
+			s.triangles.insert(s.triangles.end(), t, t + 3);
+	}
+	const int count = (int)s.triangles.size() / 3;
+	s.part.assign(count, 0);
+	s.adjacency.assign(vertex_count, std::vector<int>());
+	for (int i = 0; i < 3 * count; i++)
+		s.adjacency[s.triangles[i]].push_back(i / 3);
+
+	// paszczyzny cian
+	s.quadrics.assign(vertex_count, Quadric());
+	for (int i = 0; i < count; i++)
+	{
+		const int *t = &s.triangles[3 * i];
+		double n[3];
+		Cross(&vertices[3 * t[0]], &vertices[3 * t[1]], &vertices[3 * t[2]], n);
+		const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (length == 0.0)
+			continue;
+		n[0] /= length;
+		n[1] /= length;
+		n[2] /= length;
+		const float *p = &vertices[3 * t[0]];
+		const double d = -(n[0] * p[0] + n[1] * p[1] + n[2] * p[2]);
+		for (int k = 0; k < 3; k++)
+		{
+			QuadricPlane(s.quadrics[t[k]], n[0], n[1], n[2], d, length / 2);
+			s.quadrics[t[k]].weight += length / 2;
+		}
+	}
+
+	// rodzaje wierzchokw: krawd naleca do jednego trjkta jest
+	// brzegowa, do wicej ni dwch - nierozmaitociowa
+	s.kind.assign(vertex_count, VERTEX_INTERIOR);
+	std::vector<std::pair<int, int> > edges;
+	for (int v = 0; v < vertex_count; v++)
+	{
+		edges.clear();
+		for (size_t j = 0; j < s.adjacency[v].size(); j++)
+		{
+			const int t = s.adjacency[v][j];
+			for (int k = 0; k < 3; k++)
+			{
+				const int w = s.triangles[3 * t + k];
+				if (w == v)
+					continue;
+				size_t e = 0;
+				while (e < edges.size() && edges[e].first != w)
+					e++;
+				if (e == edges.size())
+					edges.push_back(std::make_pair(w, 0));
+				edges[e].second++;
+			}
+		}
+		for (size_t e = 0; e < edges.size(); e++)
+			if (edges[e].second > 2)
+				s.kind[v] = VERTEX_LOCKED;
+			else if (edges[e].second == 1 && s.kind[v] == VERTEX_INTERIOR)
+				s.kind[v] = VERTEX_BORDER;
+	}
+
+	// paszczyzny prostopade do krawdzi brzegowych utrzymuj ksztat brzegu
+	for (int i = 0; i < count; i++)
+		for (int k = 0; k < 3; k++)
+		{
+			const int *t = &s.triangles[3 * i];
+			const int a = t[k], b = t[(k + 1) % 3];
+			if (s.kind[a] == VERTEX_INTERIOR || s.kind[b] == VERTEX_INTERIOR || EdgeTriangles(s, a, b) != 1)
+				continue;
+			double n[3];
+			Cross(&vertices[3 * t[0]], &vertices[3 * t[1]], &vertices[3 * t[2]], n);
+			const double e[3] = { (double)vertices[3 * b] - vertices[3 * a], (double)vertices[3 * b + 1] - vertices[3 * a + 1],
+				(double)vertices[3 * b + 2] - vertices[3 * a + 2] };
+			double m[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+			const double length = sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+			if (length == 0.0)
+				continue;
+			m[0] /= length;
+			m[1] /= length;
+			m[2] /= length;
+			const double d = -(m[0] * vertices[3 * a] + m[1] * vertices[3 * a + 1] + m[2] * vertices[3 * a + 2]);
+			const double w = BORDER_WEIGHT * (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+			QuadricPlane(s.quadrics[a], m[0], m[1], m[2], d, w);
+			QuadricPlane(s.quadrics[b], m[0], m[1], m[2], d, w);
+		}
+
+	// szwy: wierzchoki o identycznych wsprzdnych
+	std::unordered_map<unsigned long long, int> positions;
+	positions.reserve(vertex_count);
+	for (int v = 0; v < vertex_count; v++)
+	{
+		unsigned int bits[3];
+		memcpy(bits, &vertices[3 * v], sizeof(bits));
+		const unsigned long long key = bits[0] * 0x9E3779B97F4A7C15ULL ^ bits[1] * 0xBF58476D1CE4E5B9ULL ^ bits[2] * 0x94D049BB133111EBULL;
+		std::pair<std::unordered_map<unsigned long long, int>::iterator, bool> found = positions.insert(std::make_pair(key, v));
+		if (found.second)
+			continue;
+		const int w = found.first->second;
+		if (memcmp(&vertices[3 * v], &vertices[3 * w], 3 * sizeof(float)) == 0)
+		{
+			s.kind[v] = VERTEX_LOCKED;
+			s.kind[w] = VERTEX_LOCKED;
+		}
+	}
+
+	s.owner.assign(vertex_count, 0);
+	s.target.assign(vertex_count, -1);
+	s.cost.assign(vertex_count, DBL_MAX);
+	s.heap_position.assign(vertex_count, -1);
+}
+
+// podzia trjktw na fragmenty o rwnej liczbie trjktw wzdu
+// najduszej osi prostopadocianu otaczajcego; wierzchoki nalece do
+// trjktw kilku fragmentw nie s zwijane w przebiegu rwnolegym
+
+static void Partition(Simplifier &s, int parts)
+{
+	const int count = (int)s.triangles.size() / 3;
+	float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (int i = 0; i < 3 * count; i++)
+		for (int k = 0; k < 3; k++)
+		{
+			min[k] = std::min(min[k], s.vertices[3 * s.triangles[i] + k]);
+			max[k] = std::max(max[k], s.vertices[3 * s.triangles[i] + k]);
+		}
+	int axis = 0;
+	for (int k = 1; k < 3; k++)
+		if (max[k] - min[k] > max[axis] - min[axis])
+			axis = k;
+
+	std::vector<std::pair<float, int> > order(count);
+	for (int i = 0; i < count; i++)
+	{
+		const int *t = &s.triangles[3 * i];
+		order[i] = std::make_pair(s.vertices[3 * t[0] + axis] + s.vertices[3 * t[1] + axis] + s.vertices[3 * t[2] + axis], i);
+	}
+	std::sort(order.begin(), order.end());
+	for (int i = 0; i < count; i++)
+		s.part[order[i].second] = (int)((long long)i * parts / count);
+
+	for (int v = 0; v < s.vertex_count; v++)
+	{
+		const std::vector<int> &adjacency = s.adjacency[v];
+		s.owner[v] = adjacency.empty() ? -1 : s.part[adjacency[0]];
+		for (size_t j = 1; j < adjacency.size() && s.owner[v] >= 0; j++)
+			if (s.part[adjacency[j]] != s.owner[v])
+				s.owner[v] = -1;
+	}
+}
+
+// minimalna liczba trjktw fragmentu przy podziale siatki
+
+const int PART_TRIANGLES = 20000;
+
+void BuildLod(const float *vertices, int vertex_count, const int *triangles, int triangle_count, MeshLod &lod,
+	int levels, float ratio)
+{
+	Simplifier s;
+	Prepare(s, vertices, vertex_count, triangles, triangle_count);
+	const int count = (int)s.triangles.size() / 3;
+
+	int parts = (int)std::thread::hardware_concurrency();
+	parts = std::max(1, std::min(parts, count / PART_TRIANGLES));
+	if (parts > 1)
+		Partition(s, parts);
+	std::vector<long long> alive(parts, 0);
+	for (int i = 0; i < count; i++)
+		alive[s.part[i]]++;
+
+	lod.triangles = s.triangles;
+	lod.first.assign(1, 0);
+	lod.count.assign(1, 3 * count);
+	lod.error.assign(1, 0.0f);
+
+	long long total = count;
+	double max_error = 0.0;
+	VertexHeap heap;
+	heap.s = &s;
+	for (int level = 1; level < levels; level++)
+	{
+		const long long target = (long long)(count * pow(ratio, level));
+		if (target < 1)
+			break;
+
+		// przebieg rwnolegy we fragmentach, z docelow liczb trjktw
+		// proporcjonaln do biecej liczby trjktw fragmentu
+		if (parts > 1)
+		{
+			std::vector<double> errors(parts, 0.0);
+			std::vector<long long> targets(parts);
+			std::vector<VertexHeap> heaps(parts);
+			std::vector<std::vector<int> > members(parts);
+			for (int p = 0; p < parts; p++)
+			{
+				targets[p] = alive[p] * target / total;
+				heaps[p].s = &s;
+			}
+			for (int v = 0; v < vertex_count; v++)
+				if (s.owner[v] >= 0)
+					members[s.owner[v]].push_back(v);
+			std::vector<std::thread> threads;
+			for (int p = 1; p < parts; p++)
+				threads.push_back(std::thread([&, p]() { errors[p] = Collapse(s, heaps[p], p, members[p], targets[p], alive); }));
+			errors[0] = Collapse(s, heaps[0], 0, members[0], targets[0], alive);
+			for (size_t i = 0; i < threads.size(); i++)
+				threads[i].join();
+			for (int p = 0; p < parts; p++)
+			{
+				max_error = std::max(max_error, errors[p]);
+				heaps[p].Clear();
+			}
+		}
+
+		// przebieg na caej siatce - krawdzie midzy fragmentami; po
+		// przebiegu rwnolegym koszty s nieaktualne i kopiec jest budowany
+		// od nowa, bez podziau jest zachowywany dla kolejnych poziomw
+		max_error = std::max(max_error, Collapse(s, heap, -1, std::vector<int>(), target, alive));
+		if (parts > 1)
+			heap.Clear();
+
+		long long remaining = 0;
+		for (int p = 0; p < parts; p++)
+			remaining += alive[p];
+		if (remaining == total)
+			break;
+		total = remaining;
+
+		lod.first.push_back((int)lod.triangles.size());
+		for (int i = 0; i < count; i++)
+			if (!Dead(s, i))
+				lod.triangles.insert(lod.triangles.end(), &s.triangles[3 * i], &s.triangles[3 * i] + 3);
+		lod.count.push_back((int)lod.triangles.size() - lod.first.back());
+		lod.error.push_back((float)sqrt(max_error));
+	}
+}
+
+int SelectLod(const MeshLod &lod, float pixels_per_unit, float max_pixel_error)
+{
+	for (int level = LodLevels(lod) - 1; level > 0; level--)
+		if (lod.error[level] * pixels_per_unit <= max_pixel_error)
+			return level;
+	return 0;
+}
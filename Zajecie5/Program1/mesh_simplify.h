@@ -0,0 +1,46 @@
+#ifndef __MESH_SIMPLIFY__H__
+#define __MESH_SIMPLIFY__H__
+
+#include <vector>
+
+// uproszczenia siatki (poziomy szczegowoci, LOD) metod kwadryk bdu
+// (Garland, Heckbert "Surface Simplification Using Quadric Error Metrics");
+// krawdzie s zwijane do jednego z kocw, wic wszystkie poziomy
+// korzystaj z tej samej tablicy wierzchokw, a rni si tylko indeksami;
+// krawdzie brzegowe s zwijane tylko wzdu brzegu, a wierzchoki szww
+// (kilka wierzchokw o tych samych wsprzdnych, np. o rnych
+// wsprzdnych tekstury) i wierzchoki nierozmaitociowe nie s usuwane
+
+struct MeshLod
+{
+	std::vector<int> triangles; // indeksy trjktw kolejnych poziomw
+	std::vector<int> first; // pierwszy indeks poziomu w tablicy triangles
+	std::vector<int> count; // liczba indeksw poziomu
+	std::vector<float> error; // bd geometryczny poziomu (w jednostkach wsprzdnych)
+};
+
+// liczba poziomw szczegowoci
+
+inline int LodLevels(const MeshLod &lod)
+{
+	return (int)lod.first.size();
+}
+
+// budowa acucha poziomw; poziom 0 to siatka wejciowa (bez trjktw
+// zdegenerowanych), kady kolejny ma okoo ratio razy tyle trjktw co
+// poprzedni; budowa koczy si po levels poziomach lub gdy dalsze
+// uproszczenie nie jest moliwe; zwijanie krawdzi jest wykonywane
+// rwnolegle we fragmentach siatki, a nastpnie na caej siatce
+// vertices - wsprzdne (x, y, z) wierzchokw
+// triangles - indeksy wierzchokw trjktw
+
+void BuildLod(const float *vertices, int vertex_count, const int *triangles, int triangle_count, MeshLod &lod,
+	int levels = 6, float ratio = 0.5f);
+
+// wybr najprostszego poziomu, ktrego bd w rzucie na ekran nie
+// przekracza max_pixel_error pikseli
+// pixels_per_unit - liczba pikseli ekranu na jednostk wsprzdnych siatki
+
+int SelectLod(const MeshLod &lod, float pixels_per_unit, float max_pixel_error = 1.0f);
+
+#endif // __MESH_SIMPLIFY__H__
@@ -0,0 +1,425 @@
+#include "primitives.h"
+#include <math.h>
+#include <map>
+#include <vector>
+
+const GLfloat PI = 3.14159265358979323846f;
+
+// rodzaje bry
+
+enum
+{
+	PRIMITIVE_SPHERE,
+	PRIMITIVE_ICOSPHERE,
+	PRIMITIVE_TORUS,
+	PRIMITIVE_CYLINDER,
+	PRIMITIVE_CONE
+};
+
+// klucz pamici podrcznej - rodzaj bryy i jej parametry
+
+struct PrimitiveKey
+{
+	int type = 0;
+	GLfloat size[3] = { 0.0f, 0.0f, 0.0f };
+	int divisions[2] = { 0, 0 };
+
+	bool operator<(const PrimitiveKey &key) const
+	{
+		if (type != key.type)
+			return type < key.type;
+		for (int i = 0; i < 3; i++)
+			if (size[i] != key.size[i])
+				return size[i] < key.size[i];
+		if (divisions[0] != key.divisions[0])
+			return divisions[0] < key.divisions[0];
+		return divisions[1] < key.divisions[1];
+	}
+};
+
+// pami podrczna bry; elementy std::map nie zmieniaj pooenia,
+// wic zwracane referencje pozostaj wane a do PrimitivesFree
+
+static std::map<PrimitiveKey, Primitive> cache;
+
+// dane generowanej bryy
+
+struct PrimitiveBuilder
+{
+	std::vector<GLfloat> positions; // (x, y, z)
+	std::vector<GLfloat> normals; // (nx, ny, nz)
+	std::vector<GLfloat> texcoords; // (s, t)
+	std::vector<int> triangles;
+	std::vector<int> lines;
+};
+
+static int AddVertex(PrimitiveBuilder &builder, GLfloat x, GLfloat y, GLfloat z,
+	GLfloat nx, GLfloat ny, GLfloat nz, GLfloat s, GLfloat t)
+{
+	const GLfloat vertex[] = { x, y, z };
+	const GLfloat normal[] = { nx, ny, nz };
+	builder.positions.insert(builder.positions.end(), vertex, vertex + 3);
+	builder.normals.insert(builder.normals.end(), normal, normal + 3);
+	builder.texcoords.push_back(s);
+	builder.texcoords.push_back(t);
+	return (int)builder.positions.size() / 3 - 1;
+}
+
+static bool SamePosition(const PrimitiveBuilder &builder, int a, int b)
+{
+	const GLfloat *p = &builder.positions[3 * a];
+	const GLfloat *q = &builder.positions[3 * b];
+	return p[0] == q[0] && p[1] == q[1] && p[2] == q[2];
+}
+
+// dodanie trjkta z pominiciem zdegenerowanych (np. przy biegunach kuli);
+// kolejno wierzchokw jest dobierana tak, aby strona przednia (CCW)
+// bya zgodna z wektorami normalnymi wierzchokw
+
+static void AddTriangle(PrimitiveBuilder &builder, int a, int b, int c)
+{
+	if (SamePosition(builder, a, b) || SamePosition(builder, b, c) || SamePosition(builder, c, a))
+		return;
+
+	const GLfloat *p = &builder.positions[0];
+	const GLfloat *n = &builder.normals[0];
+	GLfloat u[3], v[3], dot = 0.0f;
+	for (int i = 0; i < 3; i++)
+	{
+		u[i] = p[3 * b + i] - p[3 * a + i];
+		v[i] = p[3 * c + i] - p[3 * a + i];
+	}
+	const GLfloat face[] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+	for (int i = 0; i < 3; i++)
+		dot += face[i] * (n[3 * a + i] + n[3 * b + i] + n[3 * c + i]);
+
+	builder.triangles.push_back(a);
+	builder.triangles.push_back(dot >= 0.0f ? b : c);
+	builder.triangles.push_back(dot >= 0.0f ? c : b);
+}
+
+static void AddLine(PrimitiveBuilder &builder, int a, int b)
+{
+	if (SamePosition(builder, a, b))
+		return;
+	builder.lines.push_back(a);
+	builder.lines.push_back(b);
+}
+
+// siatka prostoktna (columns + 1) x (rows + 1) wierzchokw zapisanych
+// wierszami od wierzchoka first; krawdzie wersji "szkieletowej" biegn
+// wzdu wierszy i kolumn; wrap_columns / wrap_rows - ostatnia kolumna
+// (wiersz) pokrywa si z pierwsz i jej krawdzie s pomijane
+
+static void AddGrid(PrimitiveBuilder &builder, int first, int columns, int rows, bool wrap_columns, bool wrap_rows)
+{
+	for (int j = 0; j < rows; j++)
+		for (int i = 0; i < columns; i++)
+		{
+			const int a = first + j * (columns + 1) + i;
+			const int b = a + 1;
+			const int c = a + columns + 1;
+			const int d = c + 1;
+			AddTriangle(builder, a, b, d);
+			AddTriangle(builder, a, d, c);
+		}
+
+	for (int j = 0; j <= (wrap_rows ? rows - 1 : rows); j++)
+		for (int i = 0; i < columns; i++)
+			AddLine(builder, first + j * (columns + 1) + i, first + j * (columns + 1) + i + 1);
+	for (int i = 0; i <= (wrap_columns ? columns - 1 : columns); i++)
+		for (int j = 0; j < rows; j++)
+			AddLine(builder, first + j * (columns + 1) + i, first + (j + 1) * (columns + 1) + i);
+}
+
+// koo o rodku (0, 0, z) prostopade do osi Z (podstawa walca i stoka)
+
+static void AddDisk(PrimitiveBuilder &builder, GLfloat radius, GLfloat z, GLfloat nz, int slices)
+{
+	if (radius <= 0.0f)
+		return;
+	const int center = AddVertex(builder, 0.0f, 0.0f, z, 0.0f, 0.0f, nz, 0.5f, 0.5f);
+	for (int i = 0; i <= slices; i++)
+	{
+		const GLfloat angle = 2.0f * PI * (i % slices) / slices;
+		AddVertex(builder, radius * sinf(angle), radius * cosf(angle), z, 0.0f, 0.0f, nz,
+			0.5f + 0.5f * sinf(angle), 0.5f + 0.5f * cosf(angle));
+	}
+	for (int i = 0; i < slices; i++)
+		AddTriangle(builder, center, center + 1 + i, center + 2 + i);
+}
+
+static void BuildSphere(PrimitiveBuilder &builder, GLfloat radius, int slices, int stacks)
+{
+	for (int j = 0; j <= stacks; j++)
+	{
+		const GLfloat phi = PI * j / stacks;
+		const GLfloat ring = (j == 0 || j == stacks) ? 0.0f : sinf(phi);
+		const GLfloat z = (j == 0) ? 1.0f : (j == stacks) ? -1.0f : cosf(phi);
+		for (int i = 0; i <= slices; i++)
+		{
+			const GLfloat theta = 2.0f * PI * (i % slices) / slices;
+			const GLfloat x = ring * sinf(theta);
+			const GLfloat y = ring * cosf(theta);
+			AddVertex(builder, radius * x, radius * y, radius * z, x, y, z,
+				1.0f - (GLfloat)i / slices, 1.0f - (GLfloat)j / stacks);
+		}
+	}
+	AddGrid(builder, 0, slices, stacks, true, false);
+}
+
+static void BuildIcosphere(PrimitiveBuilder &builder, GLfloat radius, int subdivisions)
+{
+	// dwudziestocian foremny
+	const GLfloat g = 1.61803398874989484820f;
+	std::vector<GLfloat> points = {
+		-1, g, 0, 1, g, 0, -1, -g, 0, 1, -g, 0,
+		0, -1, g, 0, 1, g, 0, -1, -g, 0, 1, -g,
+		g, 0, -1, g, 0, 1, -g, 0, -1, -g, 0, 1 };
+	std::vector<int> faces = {
+		0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11,
+		1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+		3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9,
+		4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1 };
+
+	const GLfloat scale = 1.0f / sqrtf(1.0f + g * g);
+	for (size_t i = 0; i < points.size(); i++)
+		points[i] *= scale;
+
+	// podzia kadego trjkta na 4; wierzchoki w rodkach krawdzi s
+	// wsplne dla ssiednich trjktw i od razu rzutowane na kul
+	for (int level = 0; level < subdivisions; level++)
+	{
+		std::map<long long, int> middle;
+		std::vector<int> divided;
+		divided.reserve(4 * faces.size());
+		for (size_t f = 0; f < faces.size(); f += 3)
+		{
+			int middles[3];
+			for (int k = 0; k < 3; k++)
+			{
+				const int a = faces[f + k], b = faces[f + (k + 1) % 3];
+				const long long key = a < b ? (long long)a << 32 | b : (long long)b << 32 | a;
+				std::map<long long, int>::iterator it = middle.find(key);
+				if (it == middle.end())
+				{
+					GLfloat m[3];
+					for (int i = 0; i < 3; i++)
+						m[i] = points[3 * a + i] + points[3 * b + i];
+					const GLfloat length = sqrtf(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+					for (int i = 0; i < 3; i++)
+						points.push_back(m[i] / length);
+					it = middle.insert(std::make_pair(key, (int)points.size() / 3 - 1)).first;
+				}
+				middles[k] = it->second;
+			}
+			const int t[] = {
+				faces[f], middles[0], middles[2], faces[f + 1], middles[1], middles[0],
+				faces[f + 2], middles[2], middles[1], middles[0], middles[1], middles[2] };
+			divided.insert(divided.end(), t, t + 12);
+		}
+		faces.swap(divided);
+	}
+
+	// wsprzdne tekstury jak w kuli UV
+	const int count = (int)points.size() / 3;
+	for (int v = 0; v < count; v++)
+	{
+		const GLfloat x = points[3 * v], y = points[3 * v + 1], z = points[3 * v + 2];
+		GLfloat theta = atan2f(x, y);
+		if (theta < 0.0f)
+			theta += 2.0f * PI;
+		AddVertex(builder, radius * x, radius * y, radius * z, x, y, z,
+			1.0f - theta / (2.0f * PI), 1.0f - acosf(z > 1.0f ? 1.0f : z < -1.0f ? -1.0f : z) / PI);
+	}
+
+	// krawdzie - kada para ssiednich trjktw ma jedn wspln krawd
+	for (size_t f = 0; f < faces.size(); f++)
+	{
+		const int a = faces[f], b = faces[f - f % 3 + (f % 3 + 1) % 3];
+		if (a < b)
+			AddLine(builder, a, b);
+	}
+
+	// trjkty przecinajce szew tekstury (s = 0 / s = 1) otrzymuj kopie
+	// wierzchokw po stronie s < 0.5 ze wsprzdn s zwikszon o 1
+	std::map<int, int> seam;
+	for (size_t f = 0; f < faces.size(); f += 3)
+	{
+		int *t = &faces[f];
+		GLfloat s[3];
+		for (int k = 0; k < 3; k++)
+			s[k] = builder.texcoords[2 * t[k]];
+		const GLfloat min_s = s[0] < s[1] ? (s[0] < s[2] ? s[0] : s[2]) : (s[1] < s[2] ? s[1] : s[2]);
+		const GLfloat max_s = s[0] > s[1] ? (s[0] > s[2] ? s[0] : s[2]) : (s[1] > s[2] ? s[1] : s[2]);
+		if (max_s - min_s <= 0.5f)
+			continue;
+		for (int k = 0; k < 3; k++)
+			if (s[k] < 0.5f)
+			{
+				std::map<int, int>::iterator it = seam.find(t[k]);
+				if (it == seam.end())
+				{
+					const GLfloat *p = &builder.positions[3 * t[k]];
+					const GLfloat *n = &builder.normals[3 * t[k]];
+					const int copy = AddVertex(builder, p[0], p[1], p[2], n[0], n[1], n[2],
+						s[k] + 1.0f, builder.texcoords[2 * t[k] + 1]);
+					it = seam.insert(std::make_pair(t[k], copy)).first;
+				}
+				t[k] = it->second;
+			}
+	}
+
+	for (size_t f = 0; f < faces.size(); f += 3)
+		AddTriangle(builder, faces[f], faces[f + 1], faces[f + 2]);
+}
+
+static void BuildTorus(PrimitiveBuilder &builder, GLfloat inner_radius, GLfloat outer_radius, int sides, int rings)
+{
+	for (int j = 0; j <= sides; j++)
+	{
+		const GLfloat theta = 2.0f * PI * (j % sides) / sides;
+		for (int i = 0; i <= rings; i++)
+		{
+			const GLfloat phi = 2.0f * PI * (i % rings) / rings;
+			const GLfloat nx = cosf(phi) * cosf(theta);
+			const GLfloat ny = sinf(phi) * cosf(theta);
+			const GLfloat nz = sinf(theta);
+			const GLfloat distance = outer_radius + inner_radius * cosf(theta);
+			AddVertex(builder, cosf(phi) * distance, sinf(phi) * distance, inner_radius * nz, nx, ny, nz,
+				(GLfloat)i / rings, (GLfloat)j / sides);
+		}
+	}
+	AddGrid(builder, 0, rings, sides, true, true);
+}
+
+static void BuildCylinder(PrimitiveBuilder &builder, GLfloat base_radius, GLfloat top_radius, GLfloat height,
+	int slices, int stacks)
+{
+	// wektor normalny powierzchni bocznej nachylony zgodnie z jej zbienoci
+	const GLfloat slope = height > 0.0f ? (base_radius - top_radius) / height : 0.0f;
+	const GLfloat length = sqrtf(1.0f + slope * slope);
+	for (int j = 0; j <= stacks; j++)
+	{
+		const GLfloat radius = base_radius + (top_radius - base_radius) * j / stacks;
+		for (int i = 0; i <= slices; i++)
+		{
+			const GLfloat theta = 2.0f * PI * (i % slices) / slices;
+			const GLfloat x = sinf(theta), y = cosf(theta);
+			AddVertex(builder, radius * x, radius * y, height * j / stacks,
+				x / length, y / length, slope / length, 1.0f - (GLfloat)i / slices, (GLfloat)j / stacks);
+		}
+	}
+	AddGrid(builder, 0, slices, stacks, true, false);
+
+	// podstawy
+	AddDisk(builder, base_radius, 0.0f, -1.0f, slices);
+	AddDisk(builder, top_radius, height, 1.0f, slices);
+}
+
+// pobranie bryy z pamici podrcznej lub jej utworzenie
+
+static Primitive &GetPrimitive(const PrimitiveKey &key)
+{
+	std::map<PrimitiveKey, Primitive>::iterator it = cache.find(key);
+	if (it != cache.end())
+		return it->second;
+
+	PrimitiveBuilder builder;
+	switch (key.type)
+	{
+	case PRIMITIVE_SPHERE:
+		BuildSphere(builder, key.size[0], key.divisions[0], key.divisions[1]);
+		break;
+	case PRIMITIVE_ICOSPHERE:
+		BuildIcosphere(builder, key.size[0], key.divisions[0]);
+		break;
+	case PRIMITIVE_TORUS:
+		BuildTorus(builder, key.size[0], key.size[1], key.divisions[0], key.divisions[1]);
+		break;
+	case PRIMITIVE_CYLINDER:
+	case PRIMITIVE_CONE:
+		BuildCylinder(builder, key.size[0], key.size[1], key.size[2], key.divisions[0], key.divisions[1]);
+		break;
+	}
+
+	// krawdzie zapisane w tablicy indeksw za trjktami
+	Primitive &primitive = cache[key];
+	primitive.triangle_indices = (int)builder.triangles.size();
+	primitive.line_indices = (int)builder.lines.size();
+	builder.triangles.insert(builder.triangles.end(), builder.lines.begin(), builder.lines.end());
+	MeshSet(primitive.mesh, &builder.positions[0], &builder.normals[0], &builder.texcoords[0],
+		(int)builder.positions.size() / 3, &builder.triangles[0], (int)builder.triangles.size());
+	return primitive;
+}
+
+Primitive &Sphere(GLfloat radius, int slices, int stacks)
+{
+	PrimitiveKey key;
+	key.type = PRIMITIVE_SPHERE;
+	key.size[0] = radius;
+	key.divisions[0] = slices < 3 ? 3 : slices;
+	key.divisions[1] = stacks < 2 ? 2 : stacks;
+	return GetPrimitive(key);
+}
+
+Primitive &Icosphere(GLfloat radius, int subdivisions)
+{
+	PrimitiveKey key;
+	key.type = PRIMITIVE_ICOSPHERE;
+	key.size[0] = radius;
+	key.divisions[0] = subdivisions < 0 ? 0 : subdivisions > 7 ? 7 : subdivisions;
+	return GetPrimitive(key);
+}
+
+Primitive &Torus(GLfloat inner_radius, GLfloat outer_radius, int sides, int rings)
+{
+	PrimitiveKey key;
+	key.type = PRIMITIVE_TORUS;
+	key.size[0] = inner_radius;
+	key.size[1] = outer_radius;
+	key.divisions[0] = sides < 3 ? 3 : sides;
+	key.divisions[1] = rings < 3 ? 3 : rings;
+	return GetPrimitive(key);
+}
+
+Primitive &Cylinder(GLfloat base_radius, GLfloat top_radius, GLfloat height, int slices, int stacks)
+{
+	PrimitiveKey key;
+	key.type = PRIMITIVE_CYLINDER;
+	key.size[0] = base_radius;
+	key.size[1] = top_radius;
+	key.size[2] = height;
+	key.divisions[0] = slices < 3 ? 3 : slices;
+	key.divisions[1] = stacks < 1 ? 1 : stacks;
+	return GetPrimitive(key);
+}
+
+Primitive &Cone(GLfloat base_radius, GLfloat height, int slices, int stacks)
+{
+	PrimitiveKey key;
+	key.type = PRIMITIVE_CONE;
+	key.size[0] = base_radius;
+	key.size[1] = 0.0f;
+	key.size[2] = height;
+	key.divisions[0] = slices < 3 ? 3 : slices;
+	key.divisions[1] = stacks < 1 ? 1 : stacks;
+	return GetPrimitive(key);
+}
+
+void PrimitiveDrawSolid(Primitive &primitive)
+{
+	MeshDrawRange(primitive.mesh, 0, primitive.triangle_indices);
+}
+
+void PrimitiveDrawWire(Primitive &primitive)
+{
+	MeshDrawRange(primitive.mesh, primitive.triangle_indices, primitive.line_indices, GL_LINES);
+}
+
+void PrimitivesFree()
+{
+	for (std::map<PrimitiveKey, Primitive>::iterator it = cache.begin(); it != cache.end(); ++it)
+		MeshFree(it->second.mesh);
+	cache.clear();
+}
@@ -0,0 +1,56 @@
+#ifndef __PRIMITIVES__H__
+#define __PRIMITIVES__H__
+
+#include "mesh.h"
+
+// biblioteka bry parametrycznych (kula, ikosfera, torus, walec, stoek);
+// siatka indeksowana z wektorami normalnymi i wsprzdnymi tekstury jest
+// generowana tylko raz dla danego zestawu parametrw, a nastpnie
+// przechowywana w pamici podrcznej i rysowana z obiektw buforowych;
+// krawdzie wersji "szkieletowej" (GL_LINES) zapisane s w tym samym
+// buforze indeksw za trjktami
+
+struct Primitive
+{
+	Mesh mesh; // wierzchoki (x, y, z, nx, ny, nz, s, t) i indeksy
+	int triangle_indices = 0; // liczba indeksw trjktw
+	int line_indices = 0; // liczba indeksw krawdzi (za trjktami)
+};
+
+// kula o rodku w pocztku ukadu wsprzdnych i biegunach na osi Z;
+// orientacja i wsprzdne tekstury jak w gluSphere
+// slices - liczba podziaw wok osi Z, stacks - liczba podziaw wzdu osi Z
+
+Primitive &Sphere(GLfloat radius, int slices, int stacks);
+
+// ikosfera - dwudziestocian foremny, ktrego ciany s subdivisions razy
+// dzielone na 4 trjkty, a wierzchoki rzutowane na kul; trjkty maj
+// podobn wielko na caej powierzchni (brak zagszczenia przy biegunach)
+
+Primitive &Icosphere(GLfloat radius, int subdivisions);
+
+// torus wok osi Z (jak glutSolidTorus)
+// inner_radius - promie rury, outer_radius - promie okrgu rodkw rury
+// sides - liczba podziaw rury, rings - liczba podziaw wok osi Z
+
+Primitive &Torus(GLfloat inner_radius, GLfloat outer_radius, int sides, int rings);
+
+// walec (lub stoek city) wzdu osi Z od z = 0 do z = height wraz z
+// podstawami (jak gluCylinder uzupeniony dwoma gluDisk)
+
+Primitive &Cylinder(GLfloat base_radius, GLfloat top_radius, GLfloat height, int slices, int stacks);
+
+// stoek wzdu osi Z z podstaw w z = 0 (jak glutSolidCone)
+
+Primitive &Cone(GLfloat base_radius, GLfloat height, int slices, int stacks);
+
+// narysowanie bryy - wersja pena i "szkieletowa"
+
+void PrimitiveDrawSolid(Primitive &primitive);
+void PrimitiveDrawWire(Primitive &primitive);
+
+// usunicie wszystkich bry z pamici podrcznej (wraz z obiektami buforowymi)
+
+void PrimitivesFree();
+
+#endif // __PRIMITIVES__H__
@@ -0,0 +1,262 @@
+#include "render_queue.h"
+#include <assert.h>
+#include <string.h>
+
+// ukad klucza (od najstarszego bitu):
+// obiekty nieprzezroczyste - mieszanie (2), tekstura (12), materia (12), siatka (14), gbia (24)
+// obiekty pprzezroczyste - mieszanie (2), odwrcona gbia (24), tekstura (12), materia (12), siatka (14)
+
+const int KEY_TEXTURE_BITS = 12;
+const int KEY_MATERIAL_BITS = 12;
+const int KEY_MESH_BITS = 14;
+const int KEY_DEPTH_BITS = 24;
+
+// warto pola klucza o bits bitach; numery spoza zakresu pola otrzymuj
+// jego najwiksz warto (obiekt jest rysowany poprawnie, ale bez grupowania)
+
+static inline unsigned long long KeyField(int value, int bits)
+{
+	const unsigned long long field_max = (1ull << bits) - 1;
+	return (unsigned long long)value < field_max ? (unsigned long long)value : field_max;
+}
+
+// iloczyn macierzy 4 x 4 w ukadzie kolumnowym OpenGL: result = a * b
+
+static void MultiplyMatrix(const GLfloat *a, const GLfloat *b, GLfloat *result)
+{
+	for (int column = 0; column < 4; column++)
+		for (int row = 0; row < 4; row++)
+			result[column * 4 + row] = a[row] * b[column * 4] + a[4 + row] * b[column * 4 + 1] +
+				a[8 + row] * b[column * 4 + 2] + a[12 + row] * b[column * 4 + 3];
+}
+
+int RenderQueueMaterial(RenderQueue &queue, const GLfloat *ambient, const GLfloat *diffuse, const GLfloat *specular,
+	GLfloat shininess)
+{
+	for (size_t i = 0; i < queue.materials.size(); i++)
+	{
+		const RenderMaterial &m = queue.materials[i];
+		if (m.ambient == ambient && m.diffuse == diffuse && m.specular == specular && m.shininess == shininess)
+			return (int)i;
+	}
+	const RenderMaterial material = { ambient, diffuse, specular, shininess };
+	queue.materials.push_back(material);
+	return (int)queue.materials.size() - 1;
+}
+
+int RenderQueueTexture(RenderQueue &queue, GLuint texture)
+{
+	for (size_t i = 0; i < queue.textures.size(); i++)
+		if (queue.textures[i] == texture)
+			return (int)i;
+	queue.textures.push_back(texture);
+	return (int)queue.textures.size() - 1;
+}
+
+int RenderQueueMesh(RenderQueue &queue, Mesh *mesh)
+{
+	for (size_t i = 0; i < queue.meshes.size(); i++)
+		if (queue.meshes[i] == mesh)
+			return (int)i;
+	queue.meshes.push_back(mesh);
+	return (int)queue.meshes.size() - 1;
+}
+
+void RenderQueueAdd(RenderQueue &queue, int mesh, int first, int count, int material, int texture, int blend,
+	GLfloat depth, const GLfloat *matrix)
+{
+	if (count == 0)
+		return;
+	assert(mesh >= 0 && mesh < (int)queue.meshes.size());
+	assert(material >= 0 && material < (int)queue.materials.size());
+	assert(texture >= 0 && texture < (int)queue.textures.size());
+	assert(blend == BLEND_OPAQUE || blend == BLEND_ALPHA);
+
+	RenderItem item;
+	item.mesh = mesh;
+	item.first = first;
+	item.count = count;
+	item.material = material;
+	item.texture = texture;
+	item.blend = blend;
+	if (matrix)
+		memcpy(item.matrix, matrix, sizeof(item.matrix));
+	else
+	{
+		memset(item.matrix, 0, sizeof(item.matrix));
+		item.matrix[0] = item.matrix[5] = item.matrix[10] = item.matrix[15] = 1.0f;
+	}
+
+	// gbia skwantowana do KEY_DEPTH_BITS bitw
+	const unsigned long long depth_max = (1ull << KEY_DEPTH_BITS) - 1;
+	unsigned long long z = depth <= 0.0f ? 0 : depth >= 1.0f ? depth_max : (unsigned long long)(depth * depth_max);
+	const unsigned long long state = KeyField(texture, KEY_TEXTURE_BITS) << (KEY_MATERIAL_BITS + KEY_MESH_BITS) |
+		KeyField(material, KEY_MATERIAL_BITS) << KEY_MESH_BITS | KeyField(mesh, KEY_MESH_BITS);
+	if (blend == BLEND_OPAQUE)
+		item.key = state << KEY_DEPTH_BITS | z;
+	else
+		item.key = (depth_max - z) << (KEY_TEXTURE_BITS + KEY_MATERIAL_BITS + KEY_MESH_BITS) | state;
+	item.key |= (unsigned long long)blend << 62;
+	queue.items.push_back(item);
+}
+
+// sortowanie pozycyjne (LSD) numerw obiektw wg kluczy, 8 bitw na
+// przebieg; przebiegi, w ktrych wszystkie klucze maj t sam cyfr, s
+// pomijane (zwykle wikszo - klucze rni si tylko kilkoma polami)
+
+static void RadixSort(RenderQueue &queue)
+{
+	const int n = (int)queue.items.size();
+	queue.keys.resize(n);
+	queue.order.resize(n);
+	queue.scratch.resize(n);
+	for (int i = 0; i < n; i++)
+	{
+		queue.keys[i] = queue.items[i].key;
+		queue.order[i] = i;
+	}
+
+	int histogram[8][256];
+	memset(histogram, 0, sizeof(histogram));
+	for (int i = 0; i < n; i++)
+		for (int pass = 0; pass < 8; pass++)
+			histogram[pass][(queue.keys[i] >> (8 * pass)) & 0xFF]++;
+
+	for (int pass = 0; pass < 8; pass++)
+	{
+		int *count = histogram[pass];
+		if (count[(queue.keys[0] >> (8 * pass)) & 0xFF] == n)
+			continue;
+
+		int offset = 0;
+		for (int d = 0; d < 256; d++)
+		{
+			const int c = count[d];
+			count[d] = offset;
+			offset += c;
+		}
+		for (int i = 0; i < n; i++)
+		{
+			const int item = queue.order[i];
+			queue.scratch[count[(queue.keys[item] >> (8 * pass)) & 0xFF]++] = item;
+		}
+		queue.order.swap(queue.scratch);
+	}
+}
+
+// liczba zmian stanu przy rysowaniu obiektw w podanej kolejnoci
+
+static void CountChanges(const RenderQueue &queue, const int *order, RenderQueueStats &stats)
+{
+	const RenderItem *previous = NULL;
+	for (size_t i = 0; i < queue.items.size(); i++)
+	{
+		const RenderItem &item = queue.items[order ? order[i] : i];
+		if (previous == NULL || item.material != previous->material)
+			stats.material_changes++;
+		if (previous == NULL || item.texture != previous->texture)
+			stats.texture_changes++;
+		if (previous == NULL || item.blend != previous->blend)
+			stats.blend_changes++;
+		if (previous == NULL || item.mesh != previous->mesh)
+			stats.mesh_changes++;
+		previous = &item;
+	}
+}
+
+void RenderQueueFlush(RenderQueue &queue)
+{
+	queue.stats = RenderQueueStats();
+	queue.stats.items = (int)queue.items.size();
+	if (queue.items.empty())
+		return;
+
+	// zmiany stanu w kolejnoci dodawania - do porwnania
+	RenderQueueStats unsorted;
+	CountChanges(queue, NULL, unsorted);
+	queue.stats.unsorted_changes = unsorted.material_changes + unsorted.texture_changes +
+		unsorted.blend_changes + unsorted.mesh_changes;
+
+	RadixSort(queue);
+
+	// macierz widoku - mnoona przez macierz kadego obiektu
+	GLfloat view[16], modelview[16];
+	glGetFloatv(GL_MODELVIEW_MATRIX, view);
+
+	// stan nieznany - pierwszy obiekt ustawia wszystko
+	int material = -1, texture = -1, blend = -1, mesh = -1;
+	for (size_t i = 0; i < queue.items.size(); i++)
+	{
+		const RenderItem &item = queue.items[queue.order[i]];
+
+		if (item.blend != blend)
+		{
+			if (item.blend == BLEND_ALPHA)
+			{
+				glEnable(GL_BLEND);
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				glDepthMask(GL_FALSE);
+			}
+			else
+			{
+				glDisable(GL_BLEND);
+				glDepthMask(GL_TRUE);
+			}
+			blend = item.blend;
+			queue.stats.blend_changes++;
+		}
+
+		if (item.texture != texture)
+		{
+			if (item.texture == 0)
+				glDisable(GL_TEXTURE_2D);
+			else
+			{
+				if (texture <= 0)
+					glEnable(GL_TEXTURE_2D);
+				glBindTexture(GL_TEXTURE_2D, queue.textures[item.texture]);
+				queue.stats.texture_binds++;
+			}
+			texture = item.texture;
+			queue.stats.texture_changes++;
+		}
+
+		if (item.material != material)
+		{
+			const RenderMaterial &m = queue.materials[item.material];
+			glMaterialfv(GL_FRONT, GL_AMBIENT, m.ambient);
+			glMaterialfv(GL_FRONT, GL_DIFFUSE, m.diffuse);
+			glMaterialfv(GL_FRONT, GL_SPECULAR, m.specular);
+			glMaterialf(GL_FRONT, GL_SHININESS, m.shininess);
+			material = item.material;
+			queue.stats.material_changes++;
+		}
+
+		if (item.mesh != mesh)
+		{
+			if (mesh >= 0)
+				MeshUnbind(*queue.meshes[mesh]);
+			MeshBind(*queue.meshes[item.mesh]);
+			mesh = item.mesh;
+			queue.stats.mesh_changes++;
+		}
+
+		MultiplyMatrix(view, item.matrix, modelview);
+		glLoadMatrixf(modelview);
+		MeshDrawElements(*queue.meshes[mesh], item.first, item.count);
+		queue.stats.indices += item.count;
+	}
+
+	// przywrcenie stanu domylnego
+	glLoadMatrixf(view);
+	MeshUnbind(*queue.meshes[mesh]);
+	if (blend != BLEND_OPAQUE)
+	{
+		glDisable(GL_BLEND);
+		glDepthMask(GL_TRUE);
+	}
+	if (texture > 0)
+		glDisable(GL_TEXTURE_2D);
+
+	queue.items.clear();
+}
@@ -0,0 +1,102 @@
+#ifndef __RENDER_QUEUE__H__
+#define __RENDER_QUEUE__H__
+
+#include "mesh.h"
+#include <vector>
+
+// kolejka rysowania: obiekty zbierane w trakcie ramki s sortowane (sortowanie
+// pozycyjne) wg 64-bitowego klucza zoonego z trybu mieszania, tekstury,
+// materiau i siatki, a nastpnie rysowane z ustawianiem tylko tych
+// elementw stanu, ktre rni si od poprzedniego obiektu;
+// obiekty nieprzezroczyste s rysowane jako pierwsze (od najbliszych),
+// pprzezroczyste na kocu (od najdalszych)
+//
+// ograniczenia klucza: pola tekstury i materiau maj po 12 bitw, pole
+// siatki - 14 bitw, a gbia - 24 bity; obiekty o numerze tekstury lub
+// materiau od 4096 albo numerze siatki od 16384 s rysowane poprawnie (stan
+// jest ustawiany wg pl obiektu), ale nie s grupowane - w kluczu otrzymuj
+// najwiksz warto pola
+
+// tryb mieszania kolorw
+
+enum
+{
+	BLEND_OPAQUE,         // bez mieszania
+	BLEND_ALPHA           // mieszanie wg skadowej alfa, bez zapisu gbi
+};
+
+// materia (wskaniki na tablice RGBA, np. z materials.h)
+
+struct RenderMaterial
+{
+	const GLfloat *ambient;
+	const GLfloat *diffuse;
+	const GLfloat *specular;
+	GLfloat shininess;
+};
+
+// obiekt do narysowania
+
+struct RenderItem
+{
+	unsigned long long key = 0; // klucz sortowania
+	int mesh = 0; // numer siatki w kolejce
+	int first = 0; // pierwszy indeks
+	int count = 0; // liczba indeksw
+	int material = 0; // numer materiau w kolejce
+	int texture = 0; // numer tekstury w kolejce (0 - bez tekstury)
+	int blend = BLEND_OPAQUE;
+	GLfloat matrix[16]; // macierz modelowania obiektu (mnoona przez macierz widoku)
+};
+
+// liczba zmian stanu w ostatniej ramce; unsorted_changes - liczba zmian,
+// ktre byyby potrzebne przy rysowaniu w kolejnoci dodawania; indices -
+// liczba narysowanych indeksw, texture_binds - liczba wywoa glBindTexture
+
+struct RenderQueueStats
+{
+	int items = 0;
+	int material_changes = 0;
+	int texture_changes = 0;
+	int blend_changes = 0;
+	int mesh_changes = 0;
+	int unsorted_changes = 0;
+	int indices = 0;
+	int texture_binds = 0;
+};
+
+struct RenderQueue
+{
+	std::vector<RenderMaterial> materials;
+	std::vector<GLuint> textures = std::vector<GLuint>(1, 0);
+	std::vector<Mesh*> meshes;
+	std::vector<RenderItem> items;
+	std::vector<unsigned long long> keys; // bufory sortowania
+	std::vector<int> order, scratch;
+	RenderQueueStats stats;
+};
+
+// rejestracja materiau, tekstury i siatki; zwracaj numer uywany przy
+// dodawaniu obiektw (ponowna rejestracja zwraca ten sam numer)
+
+int RenderQueueMaterial(RenderQueue &queue, const GLfloat *ambient, const GLfloat *diffuse, const GLfloat *specular,
+	GLfloat shininess);
+int RenderQueueTexture(RenderQueue &queue, GLuint texture);
+int RenderQueueMesh(RenderQueue &queue, Mesh *mesh);
+
+// dodanie obiektu; mesh, material i texture - numery zwrcone przy
+// rejestracji; depth - odlego od obserwatora w zakresie [0, 1];
+// matrix - macierz modelowania obiektu lub NULL (macierz jednostkowa)
+
+void RenderQueueAdd(RenderQueue &queue, int mesh, int first, int count, int material, int texture, int blend,
+	GLfloat depth, const GLfloat *matrix = NULL);
+
+// posortowanie i narysowanie obiektw oraz oprnienie kolejki; bieca
+// macierz modelowania jest macierz widoku - kady obiekt aduje iloczyn
+// macierzy widoku i swojej macierzy (glLoadMatrixf); po zakoczeniu
+// mieszanie i tekstury s wyczone, zapis gbi wczony, a macierz
+// modelowania przywrcona
+
+void RenderQueueFlush(RenderQueue &queue);
+
+#endif // __RENDER_QUEUE__H__
@@ -0,0 +1,283 @@
+#include "vector_simd.h"
+#include <math.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VECTOR_SIMD_SSE
+#endif
+
+// typy "rejestrw" z Width liczbami float i operacjami potrzebnymi w obliczeniach;
+// Float1 (obliczenia skalarne) przetwarza kocwki tablic niepodzielne przez Width
+
+struct Float1
+{
+	enum { Width = 1 };
+	float v;
+
+	Float1() {}
+	Float1(float v) : v(v) {}
+	static Float1 Load(const float *p) { return Float1(*p); }
+	void Store(float *p) const { *p = v; }
+	friend Float1 operator+(Float1 a, Float1 b) { return Float1(a.v + b.v); }
+	friend Float1 operator-(Float1 a, Float1 b) { return Float1(a.v - b.v); }
+	friend Float1 operator*(Float1 a, Float1 b) { return Float1(a.v * b.v); }
+	friend Float1 operator/(Float1 a, Float1 b) { return Float1(a.v / b.v); }
+	friend Float1 Sqrt(Float1 a) { return Float1(sqrtf(a.v)); }
+
+	// a dla mask != 0, w przeciwnym wypadku b
+	friend Float1 SelectNonZero(Float1 mask, Float1 a, Float1 b) { return mask.v != 0.0f ? a : b; }
+};
+
+#if defined(__AVX__)
+
+struct Float8
+{
+	enum { Width = 8 };
+	__m256 v;
+
+	Float8() {}
+	Float8(__m256 v) : v(v) {}
+	Float8(float v) : v(_mm256_set1_ps(v)) {}
+	static Float8 Load(const float *p) { return Float8(_mm256_loadu_ps(p)); }
+	void Store(float *p) const { _mm256_storeu_ps(p, v); }
+	friend Float8 operator+(Float8 a, Float8 b) { return Float8(_mm256_add_ps(a.v, b.v)); }
+	friend Float8 operator-(Float8 a, Float8 b) { return Float8(_mm256_sub_ps(a.v, b.v)); }
+	friend Float8 operator*(Float8 a, Float8 b) { return Float8(_mm256_mul_ps(a.v, b.v)); }
+	friend Float8 operator/(Float8 a, Float8 b) { return Float8(_mm256_div_ps(a.v, b.v)); }
+	friend Float8 Sqrt(Float8 a) { return Float8(_mm256_sqrt_ps(a.v)); }
+	friend Float8 SelectNonZero(Float8 mask, Float8 a, Float8 b)
+	{
+		const __m256 zero = _mm256_cmp_ps(mask.v, _mm256_setzero_ps(), _CMP_EQ_OQ);
+		return Float8(_mm256_blendv_ps(a.v, b.v, zero));
+	}
+};
+
+typedef Float8 FloatN;
+
+#elif defined(VECTOR_SIMD_SSE)
+
+struct Float4
+{
+	enum { Width = 4 };
+	__m128 v;
+
+	Float4() {}
+	Float4(__m128 v) : v(v) {}
+	Float4(float v) : v(_mm_set1_ps(v)) {}
+	static Float4 Load(const float *p) { return Float4(_mm_loadu_ps(p)); }
+	void Store(float *p) const { _mm_storeu_ps(p, v); }
+	friend Float4 operator+(Float4 a, Float4 b) { return Float4(_mm_add_ps(a.v, b.v)); }
+	friend Float4 operator-(Float4 a, Float4 b) { return Float4(_mm_sub_ps(a.v, b.v)); }
+	friend Float4 operator*(Float4 a, Float4 b) { return Float4(_mm_mul_ps(a.v, b.v)); }
+	friend Float4 operator/(Float4 a, Float4 b) { return Float4(_mm_div_ps(a.v, b.v)); }
+	friend Float4 Sqrt(Float4 a) { return Float4(_mm_sqrt_ps(a.v)); }
+	friend Float4 SelectNonZero(Float4 mask, Float4 a, Float4 b)
+	{
+		const __m128 zero = _mm_cmpeq_ps(mask.v, _mm_setzero_ps());
+		return Float4(_mm_or_ps(_mm_andnot_ps(zero, a.v), _mm_and_ps(zero, b.v)));
+	}
+};
+
+typedef Float4 FloatN;
+
+#else
+
+typedef Float1 FloatN;
+
+#endif
+
+int SimdWidth()
+{
+	return FloatN::Width;
+}
+
+// obliczenia na jednej grupie wektorw (i .. i + Width - 1); wzory s takie same
+// jak w funkcjach glt*, wic wyniki zgadzaj si z wynikami tych funkcji
+
+template <class F>
+static void Transform(const GLfloat m[16], bool translate, const ConstVectorSpan &in, const VectorSpan &out,
+	int i)
+{
+	const F x = F::Load(in.x + i), y = F::Load(in.y + i), z = F::Load(in.z + i);
+	F rx = F(m[0]) * x + F(m[4]) * y + F(m[8]) * z;
+	F ry = F(m[1]) * x + F(m[5]) * y + F(m[9]) * z;
+	F rz = F(m[2]) * x + F(m[6]) * y + F(m[10]) * z;
+	if (translate)
+	{
+		rx = rx + F(m[12]);
+		ry = ry + F(m[13]);
+		rz = rz + F(m[14]);
+	}
+	rx.Store(out.x + i);
+	ry.Store(out.y + i);
+	rz.Store(out.z + i);
+}
+
+template <class F>
+static void Normalize(F &x, F &y, F &z)
+{
+	const F length = Sqrt(x * x + y * y + z * z);
+	const F scale = SelectNonZero(length, F(1.0f) / length, F(0.0f));
+	x = x * scale;
+	y = y * scale;
+	z = z * scale;
+}
+
+template <class F>
+static void Normalize(const VectorSpan &vectors, int i)
+{
+	F x = F::Load(vectors.x + i), y = F::Load(vectors.y + i), z = F::Load(vectors.z + i);
+	Normalize(x, y, z);
+	x.Store(vectors.x + i);
+	y.Store(vectors.y + i);
+	z.Store(vectors.z + i);
+}
+
+template <class F>
+static void Cross(F ux, F uy, F uz, F vx, F vy, F vz, F &x, F &y, F &z)
+{
+	x = uy * vz - vy * uz;
+	y = vx * uz - ux * vz;
+	z = ux * vy - vx * uy;
+}
+
+template <class F>
+static void Cross(const ConstVectorSpan &u, const ConstVectorSpan &v, const VectorSpan &out, int i)
+{
+	F x, y, z;
+	Cross(F::Load(u.x + i), F::Load(u.y + i), F::Load(u.z + i), F::Load(v.x + i), F::Load(v.y + i),
+		F::Load(v.z + i), x, y, z);
+	x.Store(out.x + i);
+	y.Store(out.y + i);
+	z.Store(out.z + i);
+}
+
+template <class F>
+static void FaceNormal(const ConstVectorSpan &p1, const ConstVectorSpan &p2, const ConstVectorSpan &p3,
+	const VectorSpan &out, bool normalize, int i)
+{
+	const F x1 = F::Load(p1.x + i), y1 = F::Load(p1.y + i), z1 = F::Load(p1.z + i);
+	F x, y, z;
+	Cross(F::Load(p2.x + i) - x1, F::Load(p2.y + i) - y1, F::Load(p2.z + i) - z1,
+		F::Load(p3.x + i) - x1, F::Load(p3.y + i) - y1, F::Load(p3.z + i) - z1, x, y, z);
+	if (normalize)
+		Normalize(x, y, z);
+	x.Store(out.x + i);
+	y.Store(out.y + i);
+	z.Store(out.z + i);
+}
+
+// podzia zakresu 0 .. count - 1 na grupy FloatN::Width wektorw i kocwk
+
+#define FOR_EACH_GROUP(count, function, arguments) \
+	{ \
+		int i = 0; \
+		for (; i + FloatN::Width <= (count); i += FloatN::Width) \
+			function<FloatN> arguments; \
+		for (; i < (count); i++) \
+			function<Float1> arguments; \
+	}
+
+void TransformPoints(const GLfloat matrix[16], const ConstVectorSpan &points, const VectorSpan &result)
+{
+	FOR_EACH_GROUP(points.count, Transform, (matrix, true, points, result, i));
+}
+
+void RotateVectors(const GLfloat matrix[16], const ConstVectorSpan &vectors, const VectorSpan &result)
+{
+	FOR_EACH_GROUP(vectors.count, Transform, (matrix, false, vectors, result, i));
+}
+
+void NormalizeVectors(const VectorSpan &vectors)
+{
+	FOR_EACH_GROUP(vectors.count, Normalize, (vectors, i));
+}
+
+void CrossProducts(const ConstVectorSpan &u, const ConstVectorSpan &v, const VectorSpan &result)
+{
+	FOR_EACH_GROUP(u.count, Cross, (u, v, result, i));
+}
+
+void FaceNormals(const ConstVectorSpan &p1, const ConstVectorSpan &p2, const ConstVectorSpan &p3,
+	const VectorSpan &result, bool normalize)
+{
+	FOR_EACH_GROUP(p1.count, FaceNormal, (p1, p2, p3, result, normalize, i));
+}
+
+// wektory AoS s przetwarzane blokami przez bufory SoA na stosie
+
+enum { BLOCK = 256 };
+
+struct Block
+{
+	GLfloat x[BLOCK], y[BLOCK], z[BLOCK];
+
+	VectorSpan Span(int count)
+	{
+		return VectorSpan(x, y, z, count);
+	}
+	void Load(const GLfloat *vectors, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			x[i] = vectors[3 * i];
+			y[i] = vectors[3 * i + 1];
+			z[i] = vectors[3 * i + 2];
+		}
+	}
+	void Store(GLfloat *vectors, int count) const
+	{
+		for (int i = 0; i < count; i++)
+		{
+			vectors[3 * i] = x[i];
+			vectors[3 * i + 1] = y[i];
+			vectors[3 * i + 2] = z[i];
+		}
+	}
+};
+
+void TransformPoints(const GLfloat matrix[16], const GLfloat *points, GLfloat *result, int count)
+{
+	Block block;
+	for (int first = 0; first < count; first += BLOCK)
+	{
+		const int n = count - first < BLOCK ? count - first : BLOCK;
+		block.Load(points + 3 * first, n);
+		TransformPoints(matrix, block.Span(n), block.Span(n));
+		block.Store(result + 3 * first, n);
+	}
+}
+
+void NormalizeVectors(GLfloat *vectors, int count)
+{
+	Block block;
+	for (int first = 0; first < count; first += BLOCK)
+	{
+		const int n = count - first < BLOCK ? count - first : BLOCK;
+		block.Load(vectors + 3 * first, n);
+		NormalizeVectors(block.Span(n));
+		block.Store(vectors + 3 * first, n);
+	}
+}
+
+void FaceNormals(const GLfloat *vertices, const int *triangles, int triangle_count, GLfloat *normals,
+	bool normalize)
+{
+	Block p1, p2, p3;
+	for (int first = 0; first < triangle_count; first += BLOCK)
+	{
+		const int n = triangle_count - first < BLOCK ? triangle_count - first : BLOCK;
+		const int *triangle = triangles + 3 * first;
+		for (int i = 0; i < n; i++, triangle += 3)
+		{
+			const GLfloat *a = vertices + 3 * triangle[0], *b = vertices + 3 * triangle[1],
+				*c = vertices + 3 * triangle[2];
+			p1.x[i] = a[0]; p1.y[i] = a[1]; p1.z[i] = a[2];
+			p2.x[i] = b[0]; p2.y[i] = b[1]; p2.z[i] = b[2];
+			p3.x[i] = c[0]; p3.y[i] = c[1]; p3.z[i] = c[2];
+		}
+		FaceNormals(p1.Span(n), p2.Span(n), p3.Span(n), p1.Span(n), normalize);
+		p1.Store(normals + 3 * first, n);
+	}
+}
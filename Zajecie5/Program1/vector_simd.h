@@ -0,0 +1,106 @@
+#ifndef __VECTOR_SIMD__H__
+#define __VECTOR_SIMD__H__
+
+#include <GL/glut.h>
+#include <vector>
+
+// operacje na wielu wektorach 3D naraz: wsprzdne przechowywane s
+// w osobnych tablicach x, y, z (ukad SoA), wic kolejne wektory trafiaj
+// do kolejnych pl rejestrw SIMD - 8 wektorw w rejestrze AVX (kompilacja
+// z AVX, np. /arch:AVX, -mavx), 4 w rejestrze SSE, a bez SSE obliczenia s
+// skalarne; wyniki nie zale od szerokoci rejestrw
+//
+// macierze maj ukad kolumnowy OpenGL (jak GLTMatrix); tablice wyjciowe
+// mog by tymi samymi tablicami co wejciowe
+
+// fragment tablic wsprzdnych count wektorw (przekazywany do funkcji przez
+// referencj); funkcje wsadowe s przeznaczone dla caych tablic - dla
+// pojedynczych wektorw szybsze s skalarne funkcje glt* z VectorMath.cpp
+
+struct VectorSpan
+{
+	GLfloat *x;
+	GLfloat *y;
+	GLfloat *z;
+	int count;
+
+	VectorSpan(GLfloat *x, GLfloat *y, GLfloat *z, int count) : x(x), y(y), z(z), count(count) {}
+};
+
+struct ConstVectorSpan
+{
+	const GLfloat *x;
+	const GLfloat *y;
+	const GLfloat *z;
+	int count;
+
+	ConstVectorSpan(const GLfloat *x, const GLfloat *y, const GLfloat *z, int count) : x(x), y(y), z(z), count(count) {}
+	ConstVectorSpan(const VectorSpan &span) : x(span.x), y(span.y), z(span.z), count(span.count) {}
+};
+
+// tablice wsprzdnych wektorw w ukadzie SoA
+
+struct VectorArray
+{
+	std::vector<GLfloat> x, y, z;
+
+	void Resize(int count)
+	{
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+	}
+	int Count() const
+	{
+		return (int)x.size();
+	}
+	VectorSpan Span()
+	{
+		return VectorSpan(x.data(), y.data(), z.data(), Count());
+	}
+	ConstVectorSpan Span() const
+	{
+		return ConstVectorSpan(x.data(), y.data(), z.data(), Count());
+	}
+};
+
+// liczba wektorw przetwarzanych jedn instrukcj (8, 4 lub 1)
+
+int SimdWidth();
+
+// przeksztacenie punktw macierz 4 x 4 (ostatni wiersz pomijany - jak w gltTransformPoint)
+
+void TransformPoints(const GLfloat matrix[16], const ConstVectorSpan &points, const VectorSpan &result);
+
+// obrt wektorw macierz 4 x 4 z pominiciem przesunicia (jak w gltRotateVector)
+
+void RotateVectors(const GLfloat matrix[16], const ConstVectorSpan &vectors, const VectorSpan &result);
+
+// normalizacja wektorw; wektory zerowe pozostaj zerowe
+
+void NormalizeVectors(const VectorSpan &vectors);
+
+// iloczyny wektorowe u x v
+
+void CrossProducts(const ConstVectorSpan &u, const ConstVectorSpan &v, const VectorSpan &result);
+
+// normalne trjktw (p1, p2, p3) o wierzchokach w kierunku przeciwnym do ruchu
+// wskazwek zegara: (p2 - p1) x (p3 - p1), jednostkowe gdy normalize == true,
+// w przeciwnym wypadku o dugoci rwnej podwjnemu polu trjkta
+
+void FaceNormals(const ConstVectorSpan &p1, const ConstVectorSpan &p2, const ConstVectorSpan &p3,
+	const VectorSpan &result, bool normalize = true);
+
+// te same operacje na tablicach (x, y, z) kolejnych wektorw (ukad AoS, jak
+// tablice wierzchokw OpenGL) - dane s przepisywane blokami do tablic SoA
+
+void TransformPoints(const GLfloat matrix[16], const GLfloat *points, GLfloat *result, int count);
+void NormalizeVectors(GLfloat *vectors, int count);
+
+// normalne trjktw siatki indeksowanej; vertices - wsprzdne (x, y, z)
+// wierzchokw, triangles - indeksy wierzchokw trjktw, normals - 3 * triangle_count
+
+void FaceNormals(const GLfloat *vertices, const int *triangles, int triangle_count, GLfloat *normals,
+	bool normalize = true);
+
+#endif // __VECTOR_SIMD__H__
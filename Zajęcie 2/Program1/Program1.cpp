@@ -12,18 +12,19 @@
 static GLfloat xRot = 0.0f;
 static GLfloat yRot = 0.0f;
 
+// Supported point size range and step - constant for the context,
+// queried once in SetupRC instead of every frame
+static GLfloat sizes[2];
+static GLfloat step;
+
 void RenderScene(void)
 {
 	GLfloat x, y, z, angle;
-	GLfloat sizes[2];
-	GLfloat step;
 	GLfloat curSize;
 	glClear(GL_COLOR_BUFFER_BIT);
 	glPushMatrix();
 	glRotatef(xRot, 1.0f, 0.0f, 0.0f);
 	glRotatef(yRot, 0.0f, 1.0f, 0.0f);
-	glGetFloatv(GL_POINT_SIZE_RANGE, sizes);
-	glGetFloatv(GL_POINT_SIZE_GRANULARITY, &step);
 	curSize = sizes[0];
 	z = -50.0f;
 	for (angle = 0.0f; angle <= (2.0f*3.1415f)*9.0f; angle += 0.1f)
@@ -45,6 +46,8 @@ void SetupRC()
 {
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glColor3f(1.0f, 0.0f, 0.0f);
+	glGetFloatv(GL_POINT_SIZE_RANGE, sizes);
+	glGetFloatv(GL_POINT_SIZE_GRANULARITY, &step);
 }
 void SpecialKeys(int key, int x, int y)
 {
@@ -8,6 +8,8 @@ JanuszG@enter.net.pl
 #include <stdlib.h>
 #include <stdio.h>
 #include "glext.h"
+#include "redraw.h"
+#include "textures.h"
 
 
 // stae do obsugi menu podrcznego
@@ -16,6 +18,7 @@ enum
 {
 	MAG_FILTER,     // filtr powikszajcy
 	MIN_FILTER,     // filtr pomniejszajcy
+	TEXTURE_STATS,  // statystyki tekstur
 	FULL_WINDOW,    // aspekt obrazu - cae okno
 	ASPECT_1_1,     // aspekt obrazu 1:1
 	EXIT            // wyjcie
@@ -52,6 +55,10 @@ GLfloat scale = 1.05;
 GLint RECT_LIST;
 GLint TEXTURE_256_LIST, TEXTURE_128_LIST, TEXTURE_64_LIST;
 
+// obiekty tekstur (obrazy przesyane raz przy tworzeniu)
+
+GLuint texture_256, texture_128, texture_64;
+
 // filtr powikszajcy
 
 GLint mag_filter = GL_NEAREST;
@@ -85,24 +92,32 @@ void DisplayScene()
 	// wczenie teksturowania jednowymiarowego
 	glEnable(GL_TEXTURE_1D);
 
-	// tryb upakowania bajtw danych tekstury
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-	// filtr powikszajcy
-	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, mag_filter);
+	// filtry s parametrami kadego obiektu tekstury
+	const GLuint textures[3] = { texture_256, texture_128, texture_64 };
+	for (int i = 0; i < 3; i++)
+	{
+		// filtr powikszajcy
+		TextureParameteri(textures[i], GL_TEXTURE_MAG_FILTER, mag_filter);
 
-	// filtr pomniejszajcy
-	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, min_filter);
+		// filtr pomniejszajcy
+		TextureParameteri(textures[i], GL_TEXTURE_MIN_FILTER, min_filter);
 
-	// usunuicie bdw przy renderingu brzegu tekstury
-	if (mag_filter == GL_LINEAR)
-		glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		// usunuicie bdw przy renderingu brzegu tekstury
+		if (mag_filter == GL_LINEAR)
+			TextureParameteri(textures[i], GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	}
 
-	// wywietlenie tekstur
+	// wywietlenie tekstur - tylko dowizanie obiektu przed list z prostoktem
+	TextureBind(texture_256);
 	glCallList(TEXTURE_256_LIST);
+	TextureBind(texture_128);
 	glCallList(TEXTURE_128_LIST);
+	TextureBind(texture_64);
 	glCallList(TEXTURE_64_LIST);
 
+	// zakoczenie ramki w licznikach tekstur
+	TextureFrameEnd();
+
 	// skierowanie polece? do wykonania
 	glFlush();
 
@@ -139,7 +154,7 @@ void Reshape(int width, int height)
 		glFrustum(left, right, bottom, top, near, far);
 
 	// generowanie sceny 3D
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga klawiatury
@@ -156,7 +171,7 @@ void Keyboard(unsigned char key, int x, int y)
 			scale -= 0.05;
 
 	// narysowanie sceny
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga menu podrcznego
@@ -171,7 +186,7 @@ void Menu(int value)
 			mag_filter = GL_LINEAR;
 		else
 			mag_filter = GL_NEAREST;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// filtr pomniejszajcy: GL_NEAREST/GL_LINEAR
@@ -180,7 +195,12 @@ void Menu(int value)
 			min_filter = GL_LINEAR;
 		else
 			min_filter = GL_NEAREST;
-		DisplayScene();
+		RedrawRequest();
+		break;
+
+		// statystyki tekstur
+	case TEXTURE_STATS:
+		TexturePrintStats();
 		break;
 
 		// obszar renderingu - cae okno
@@ -201,7 +221,7 @@ void Menu(int value)
 	}
 }
 
-// utworzenie list wywietlania
+// utworzenie tekstur i list wywietlania
 
 void GenerateDisplayLists()
 {
@@ -238,6 +258,9 @@ void GenerateDisplayLists()
 	// dane tekstury
 	GLubyte texture[2048 * 3];
 
+	// tryb upakowania bajtw danych tekstury
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
 	// przygotowanie danych tekstury RGB
 	for (int i = 0; i < 2048; i++)
 	{
@@ -246,15 +269,16 @@ void GenerateDisplayLists()
 		texture[3 * i + 2] = i;
 	}
 
+	// definiowanie tekstury
+	texture_256 = TextureCreate("RGB 256", GL_TEXTURE_1D);
+	TextureImage1D(texture_256, 0, GL_RGB, 256, GL_RGB, GL_UNSIGNED_BYTE, texture);
+
 	// generowanie identyfikatora listy wywietlania
 	TEXTURE_256_LIST = glGenLists(1);
 
-	// lista wywietlania - tekstura o szerokoci 256 tekseli
+	// lista wywietlania - prostokt z tekstur o szerokoci 256 tekseli
 	glNewList(TEXTURE_256_LIST, GL_COMPILE);
 
-	// definiowanie tekstury
-	glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB, 256, 0, GL_RGB, GL_UNSIGNED_BYTE, texture);
-
 	// odo?enie macierzy modelowania na stos
 	glPushMatrix();
 
@@ -276,15 +300,16 @@ void GenerateDisplayLists()
 		texture[i] = i * 2;
 	}
 
+	// definiowanie tekstury
+	texture_128 = TextureCreate("LUMINANCE 128", GL_TEXTURE_1D);
+	TextureImage1D(texture_128, 0, GL_LUMINANCE, 128, GL_LUMINANCE, GL_UNSIGNED_BYTE, texture);
+
 	// generowanie identyfikatora listy wywietlania
 	TEXTURE_128_LIST = glGenLists(1);
 
-	// lista wywietlania - tekstura o szerokoci 128 tekseli
+	// lista wywietlania - prostokt z tekstur o szerokoci 128 tekseli
 	glNewList(TEXTURE_128_LIST, GL_COMPILE);
 
-	// definiowanie tekstury
-	glTexImage1D(GL_TEXTURE_1D, 0, GL_LUMINANCE, 128, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, texture);
-
 	// nao?enie tekstury na prostokt
 	glCallList(RECT_LIST);
 
@@ -297,15 +322,16 @@ void GenerateDisplayLists()
 		texture[3 * i] = i * 4;
 	}
 
+	// definiowanie tekstury
+	texture_64 = TextureCreate("INTENSITY 64", GL_TEXTURE_1D);
+	TextureImage1D(texture_64, 0, GL_INTENSITY, 64, GL_RGB, GL_UNSIGNED_BYTE, texture);
+
 	// generowanie identyfikatora listy wywietlania
 	TEXTURE_64_LIST = glGenLists(1);
 
-	// lista wywietlania - tekstura o szerokoci 64 tekseli
+	// lista wywietlania - prostokt z tekstur o szerokoci 64 tekseli
 	glNewList(TEXTURE_64_LIST, GL_COMPILE);
 
-	// definiowanie tekstury
-	glTexImage1D(GL_TEXTURE_1D, 0, GL_INTENSITY, 64, 0, GL_RGB, GL_UNSIGNED_BYTE, texture);
-
 	// odo?enie macierzy modelowania na stos
 	glPushMatrix();
 
@@ -368,7 +394,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Tekstura 1D");
 
 	// doczenie funkcji generujcej scen 3D
-	glutDisplayFunc(DisplayScene);
+	RedrawInit(DisplayScene, 60);
 
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -395,12 +421,14 @@ int main(int argc, char *argv[])
 
 	glutAddMenuEntry("Filtr powikszajcy: GL_NEAREST/GL_LINEAR", MAG_FILTER);
 	glutAddMenuEntry("Filtr pomniejszajcy: GL_NEAREST/GL_LINEAR", MIN_FILTER);
+	glutAddMenuEntry("Statystyki tekstur", TEXTURE_STATS);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
 	glutAddMenuEntry("Wyjcie", EXIT);
 #else
 
 	glutAddMenuEntry("Filtr powiekszajacy: GL_NEAREST/GL_LINEAR", MAG_FILTER);
 	glutAddMenuEntry("Filtr pomniejszajacy: GL_NEAREST/GL_LINEAR", MIN_FILTER);
+	glutAddMenuEntry("Statystyki tekstur", TEXTURE_STATS);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
 	glutAddMenuEntry("Wyjscie", EXIT);
 #endif
@@ -408,8 +436,9 @@ int main(int argc, char *argv[])
 	// okrelenie przycisku myszki obsugujcego menu podrczne
 	glutAttachMenu(GLUT_RIGHT_BUTTON);
 
-	// utworzenie list wywietlania
+	// utworzenie tekstur i list wywietlania
 	GenerateDisplayLists();
+	TexturePrintStats();
 
 	// sprawdzenie i przygotowanie obsugi wybranych rozszerze?
 	ExtensionSetup();
@@ -0,0 +1,247 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "textures.h"
+#include "glext.h"
+#include <stdio.h>
+#include <map>
+#include <vector>
+
+// tekstura z zapamitanymi parametrami obiektu
+
+struct Texture
+{
+	TextureInfo info;
+	std::map<GLenum, GLint> parameters;
+};
+
+static std::vector<Texture> textures;
+
+// tekstury dowizane do celw GL_TEXTURE_1D i GL_TEXTURE_2D
+
+static GLuint bound_1d = 0, bound_2d = 0;
+
+static TextureFrameStats frame_stats, last_frame_stats;
+
+static Texture *Find(GLuint texture)
+{
+	for (size_t i = 0; i < textures.size(); i++)
+		if (textures[i].info.id == texture)
+			return &textures[i];
+	return NULL;
+}
+
+// liczba bajtw teksela w formacie wewntrznym (szacunkowo - implementacja
+// moe przechowywa tekstury RGB jako RGBA)
+
+static int TexelSize(GLint internal_format)
+{
+	switch (internal_format)
+	{
+	case 1:
+	case GL_ALPHA:
+	case GL_LUMINANCE:
+	case GL_INTENSITY:
+		return 1;
+	case 2:
+	case GL_LUMINANCE_ALPHA:
+		return 2;
+	case 3:
+	case GL_RGB:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+// bajty i liczba poziomw mipmap od rozmiarw width x height do 1 x 1
+
+static void MipmapChain(GLsizei width, GLsizei height, int texel_size, int &memory, int &levels)
+{
+	memory = 0;
+	levels = 0;
+	for (;;)
+	{
+		memory += width * height * texel_size;
+		levels++;
+		if (width == 1 && height == 1)
+			break;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+}
+
+// rejestracja przesania obrazu tekstury; chain - obraz z mipmapami,
+// generated - mipmapy tworzone przez OpenGL (przesyany jest tylko poziom 0)
+
+static void Upload(Texture &texture, GLint level, GLsizei width, GLsizei height, GLint internal_format,
+	bool chain, bool generated)
+{
+	const int texel_size = TexelSize(internal_format);
+	int memory = width * height * texel_size, levels = 1;
+	if (chain)
+		MipmapChain(width, height, texel_size, memory, levels);
+
+	// poziom 0 okrela rozmiary tekstury; przesanie go od nowa zastpuje obraz
+	if (level == 0)
+	{
+		texture.info.width = width;
+		texture.info.height = height;
+		texture.info.memory = 0;
+		texture.info.levels = 0;
+	}
+	texture.info.memory += memory;
+	texture.info.levels = level + levels > texture.info.levels ? level + levels : texture.info.levels;
+	const int uploads = generated ? 1 : levels;
+	texture.info.uploads += uploads;
+	frame_stats.uploads += uploads;
+	frame_stats.upload_bytes += generated ? width * height * texel_size : memory;
+}
+
+GLuint TextureCreate(const char *name, GLenum target)
+{
+	Texture texture;
+	glGenTextures(1, &texture.info.id);
+	texture.info.name = name;
+	texture.info.target = target;
+	textures.push_back(texture);
+	TextureBind(texture.info.id);
+	return texture.info.id;
+}
+
+// czy OpenGL tworzy mipmapy przy przesaniu poziomu 0 (parametr
+// GL_GENERATE_MIPMAP dowizanej tekstury)
+
+static bool GenerateMipmap(GLenum target, GLint level)
+{
+	GLint generate = GL_FALSE;
+	if (level == 0)
+		glGetTexParameteriv(target, GL_GENERATE_MIPMAP, &generate);
+	return generate == GL_TRUE;
+}
+
+void TextureImage1D(GLuint texture, GLint level, GLint internal_format, GLsizei width,
+	GLenum format, GLenum type, const GLvoid *pixels)
+{
+	Texture *object = Find(texture);
+	if (object == NULL)
+		return;
+	TextureBind(texture);
+	glTexImage1D(GL_TEXTURE_1D, level, internal_format, width, 0, format, type, pixels);
+	const bool generated = GenerateMipmap(GL_TEXTURE_1D, level);
+	Upload(*object, level, width, 1, internal_format, generated, generated);
+}
+
+void TextureImage2D(GLuint texture, GLint level, GLint internal_format, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const GLvoid *pixels)
+{
+	Texture *object = Find(texture);
+	if (object == NULL)
+		return;
+	TextureBind(texture);
+	glTexImage2D(GL_TEXTURE_2D, level, internal_format, width, height, 0, format, type, pixels);
+	const bool generated = GenerateMipmap(GL_TEXTURE_2D, level);
+	Upload(*object, level, width, height, internal_format, generated, generated);
+}
+
+// rozmiar poziomu 0 po skalowaniu przez GLU do potgi 2 (bez przekroczenia
+// wartoci GL_MAX_TEXTURE_SIZE - jak w gluBuild*DMipmaps)
+
+static GLsizei PowerOfTwo(GLsizei size)
+{
+	GLint max_size;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+	GLsizei result = 1;
+	while (result * 2 <= size && result * 2 <= max_size)
+		result *= 2;
+	return result;
+}
+
+GLint TextureBuild1DMipmaps(GLuint texture, GLint internal_format, GLsizei width,
+	GLenum format, GLenum type, const GLvoid *pixels)
+{
+	Texture *object = Find(texture);
+	if (object == NULL)
+		return GLU_INVALID_VALUE;
+	TextureBind(texture);
+	const GLint result = gluBuild1DMipmaps(GL_TEXTURE_1D, internal_format, width, format, type, pixels);
+	if (result == 0)
+		Upload(*object, 0, PowerOfTwo(width), 1, internal_format, true, false);
+	return result;
+}
+
+GLint TextureBuild2DMipmaps(GLuint texture, GLint internal_format, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const GLvoid *pixels)
+{
+	Texture *object = Find(texture);
+	if (object == NULL)
+		return GLU_INVALID_VALUE;
+	TextureBind(texture);
+	const GLint result = gluBuild2DMipmaps(GL_TEXTURE_2D, internal_format, width, height, format, type, pixels);
+	if (result == 0)
+		Upload(*object, 0, PowerOfTwo(width), PowerOfTwo(height), internal_format, true, false);
+	return result;
+}
+
+void TextureBind(GLuint texture)
+{
+	Texture *object = Find(texture);
+	if (object == NULL)
+		return;
+	GLuint &bound = object->info.target == GL_TEXTURE_1D ? bound_1d : bound_2d;
+	if (bound == texture)
+		return;
+	glBindTexture(object->info.target, texture);
+	bound = texture;
+	object->info.binds++;
+	frame_stats.binds++;
+}
+
+void TextureParameteri(GLuint texture, GLenum pname, GLint param)
+{
+	Texture *object = Find(texture);
+	if (object == NULL)
+		return;
+	std::map<GLenum, GLint>::iterator it = object->parameters.find(pname);
+	if (it != object->parameters.end() && it->second == param)
+		return;
+	object->parameters[pname] = param;
+	TextureBind(texture);
+	glTexParameteri(object->info.target, pname, param);
+}
+
+const TextureInfo *TextureGetInfo(GLuint texture)
+{
+	const Texture *object = Find(texture);
+	return object ? &object->info : NULL;
+}
+
+void TextureFrameEnd()
+{
+	last_frame_stats = frame_stats;
+	frame_stats = TextureFrameStats();
+}
+
+const TextureFrameStats &TextureLastFrame()
+{
+	return last_frame_stats;
+}
+
+void TexturePrintStats()
+{
+	int memory = 0;
+	printf("%-18s %10s %7s %10s %10s %10s\n", "Tekstura", "Rozmiary", "Mipmapy", "Pamiec [B]", "Przeslania",
+		"Dowiazania");
+	for (size_t i = 0; i < textures.size(); i++)
+	{
+		const TextureInfo &info = textures[i].info;
+		char size[32];
+		if (info.target == GL_TEXTURE_1D)
+			sprintf(size, "%d", info.width);
+		else
+			sprintf(size, "%dx%d", info.width, info.height);
+		printf("%-18s %10s %7d %10d %10d %10d\n", info.name, size, info.levels, info.memory, info.uploads,
+			info.binds);
+		memory += info.memory;
+	}
+	printf("Razem %d B; ostatnia ramka: przeslania %d (%d B), dowiazania %d\n", memory, last_frame_stats.uploads,
+		last_frame_stats.upload_bytes, last_frame_stats.binds);
+}
@@ -8,6 +8,8 @@ JanuszG@enter.net.pl
 #include <stdlib.h>
 #include <stdio.h>
 #include "glext.h"
+#include "redraw.h"
+#include "textures.h"
 
 // tekstura "tcza" o szerokoci 512 tekseli
 
@@ -333,6 +335,7 @@ enum
 {
 	FULL_WINDOW,    // aspekt obrazu - cae okno
 	ASPECT_1_1,     // aspekt obrazu 1:1
+	TEXTURE_STATS,  // statystyki tekstur
 	EXIT            // wyjcie
 };
 
@@ -367,6 +370,10 @@ GLfloat scale = 0.5;
 GLint RECT_LIST;
 GLint SPECTRUM_1_LIST, SPECTRUM_2_LIST, SPECTRUM_3_LIST;
 
+// obiekty tekstur (obrazy i mipmapy przesyane raz przy tworzeniu)
+
+GLuint texture_1, texture_2, texture_3;
+
 // filtr pomniejszajcy
 
 GLint min_filter = GL_NEAREST_MIPMAP_NEAREST;
@@ -396,23 +403,23 @@ void DisplayScene()
 	// wczenie teksturowania jednowymiarowego
 	glEnable(GL_TEXTURE_1D);
 
-	// tryb upakowania bajtw danych tekstury
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-	// filtr powikszajcy
-	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	// usunicie bdw przy renderingu brzegu tekstury
-	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	// filtr pomniejszajcy jest parametrem kadego obiektu tekstury
+	// (pozostae parametry ustawiane s przy tworzeniu tekstur)
+	TextureParameteri(texture_1, GL_TEXTURE_MIN_FILTER, min_filter);
+	TextureParameteri(texture_2, GL_TEXTURE_MIN_FILTER, min_filter);
+	TextureParameteri(texture_3, GL_TEXTURE_MIN_FILTER, min_filter);
 
-	// filtr pomniejszajcy
-	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, min_filter);
-
-	// wywietlenie tekstur
+	// wywietlenie tekstur - tylko dowizanie obiektu przed list z prostoktem
+	TextureBind(texture_1);
 	glCallList(SPECTRUM_1_LIST);
+	TextureBind(texture_2);
 	glCallList(SPECTRUM_2_LIST);
+	TextureBind(texture_3);
 	glCallList(SPECTRUM_3_LIST);
 
+	// zakoczenie ramki w licznikach tekstur
+	TextureFrameEnd();
+
 	// skierowanie polece? do wykonania
 	glFlush();
 
@@ -449,7 +456,7 @@ void Reshape(int width, int height)
 		glFrustum(left, right, bottom, top, near, far);
 
 	// generowanie sceny 3D
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga klawiatury
@@ -466,7 +473,7 @@ void Keyboard(unsigned char key, int x, int y)
 			scale -= 0.05;
 
 	// narysowanie sceny
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga menu podrcznego
@@ -481,7 +488,7 @@ void Menu(int value)
 	case GL_LINEAR_MIPMAP_NEAREST:
 	case GL_LINEAR_MIPMAP_LINEAR:
 		min_filter = value;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// obszar renderingu - cae okno
@@ -496,13 +503,32 @@ void Menu(int value)
 		Reshape(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 		break;
 
+		// statystyki tekstur
+	case TEXTURE_STATS:
+		TexturePrintStats();
+		break;
+
 		// wyjcie
 	case EXIT:
 		exit(0);
 	}
 }
 
-// utworzenie list wywietlania
+// utworzenie obiektu tekstury "tczy" z parametrami wsplnymi dla wszystkich tekstur
+
+GLuint CreateSpectrum(const char *name)
+{
+	const GLuint texture = TextureCreate(name, GL_TEXTURE_1D);
+
+	// filtr powikszajcy
+	TextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// usunicie bdw przy renderingu brzegu tekstury
+	TextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	return texture;
+}
+
+// utworzenie tekstur i list wywietlania
 
 void GenerateDisplayLists()
 {
@@ -536,24 +562,38 @@ void GenerateDisplayLists()
 		exit(0);
 	}
 
+	// tryb upakowania bajtw danych tekstury
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// definiowanie pierwszej tekstury i mipmap
+	texture_1 = CreateSpectrum("Mipmapy 1");
+	TextureImage1D(texture_1, 0, GL_RGB, 512, GL_RGB, GL_UNSIGNED_BYTE, spectrum_512);
+	TextureImage1D(texture_1, 1, GL_RGB, 256, GL_RGB, GL_UNSIGNED_BYTE, spectrum_256);
+	TextureImage1D(texture_1, 2, GL_RGB, 128, GL_RGB, GL_UNSIGNED_BYTE, spectrum_128);
+	TextureImage1D(texture_1, 3, GL_RGB, 64, GL_RGB, GL_UNSIGNED_BYTE, spectrum_64);
+	TextureImage1D(texture_1, 4, GL_RGB, 32, GL_RGB, GL_UNSIGNED_BYTE, spectrum_32);
+	TextureImage1D(texture_1, 5, GL_RGB, 16, GL_RGB, GL_UNSIGNED_BYTE, spectrum_16);
+	TextureImage1D(texture_1, 6, GL_RGB, 8, GL_RGB, GL_UNSIGNED_BYTE, spectrum_8);
+	TextureImage1D(texture_1, 7, GL_RGB, 4, GL_RGB, GL_UNSIGNED_BYTE, spectrum_4);
+	TextureImage1D(texture_1, 8, GL_RGB, 2, GL_RGB, GL_UNSIGNED_BYTE, spectrum_2);
+	TextureImage1D(texture_1, 9, GL_RGB, 1, GL_RGB, GL_UNSIGNED_BYTE, spectrum_1);
+
+	// definiowanie drugiej tekstury cznie z mipmapami
+	texture_2 = CreateSpectrum("gluBuild1DMipmaps");
+	TextureBuild1DMipmaps(texture_2, GL_RGB, 512, GL_RGB, GL_UNSIGNED_BYTE, spectrum_512);
+
+	// definiowanie trzeciej tekstury z automatycznym generowaniem mipmap
+	texture_3 = CreateSpectrum("GL_GENERATE_MIPMAP");
+	TextureParameteri(texture_3, GL_GENERATE_MIPMAP, GL_TRUE);
+	TextureImage1D(texture_3, 0, GL_RGB, 512, GL_RGB, GL_UNSIGNED_BYTE, spectrum_512);
+	TextureParameteri(texture_3, GL_GENERATE_MIPMAP, GL_FALSE);
+
 	// generowanie identyfikatora listy wywietlania
 	SPECTRUM_1_LIST = glGenLists(1);
 
-	// lista wywietlania - pierwsza "tcza"
+	// lista wywietlania - prostokt z pierwsz "tcz"
 	glNewList(SPECTRUM_1_LIST, GL_COMPILE);
 
-	// definiowanie tekstury i mipmap
-	glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB, 512, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_512);
-	glTexImage1D(GL_TEXTURE_1D, 1, GL_RGB, 256, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_256);
-	glTexImage1D(GL_TEXTURE_1D, 2, GL_RGB, 128, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_128);
-	glTexImage1D(GL_TEXTURE_1D, 3, GL_RGB, 64, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_64);
-	glTexImage1D(GL_TEXTURE_1D, 4, GL_RGB, 32, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_32);
-	glTexImage1D(GL_TEXTURE_1D, 5, GL_RGB, 16, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_16);
-	glTexImage1D(GL_TEXTURE_1D, 6, GL_RGB, 8, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_8);
-	glTexImage1D(GL_TEXTURE_1D, 7, GL_RGB, 4, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_4);
-	glTexImage1D(GL_TEXTURE_1D, 8, GL_RGB, 2, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_2);
-	glTexImage1D(GL_TEXTURE_1D, 9, GL_RGB, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_1);
-
 	// odenie macierzy modelowania na stos
 	glPushMatrix();
 
@@ -572,12 +612,9 @@ void GenerateDisplayLists()
 	// generowanie identyfikatora listy wywietlania
 	SPECTRUM_2_LIST = glGenLists(1);
 
-	// lista wywietlania - druga "tcza"
+	// lista wywietlania - prostokt z drug "tcz"
 	glNewList(SPECTRUM_2_LIST, GL_COMPILE);
 
-	// definiowanie tekstury cznie z mipmapami
-	gluBuild1DMipmaps(GL_TEXTURE_1D, GL_RGB, 512, GL_RGB, GL_UNSIGNED_BYTE, spectrum_512);
-
 	// naenie tekstury na prostokt
 	glCallList(RECT_LIST);
 
@@ -587,18 +624,9 @@ void GenerateDisplayLists()
 	// generowanie identyfikatora listy wywietlania
 	SPECTRUM_3_LIST = glGenLists(1);
 
-	// lista wywietlania - trzecia "tcza"
+	// lista wywietlania - prostokt z trzeci "tcz"
 	glNewList(SPECTRUM_3_LIST, GL_COMPILE);
 
-	// wczenie automatycznego generowania mipmap
-	glTexParameteri(GL_TEXTURE_1D, GL_GENERATE_MIPMAP, GL_TRUE);
-
-	// definiowanie tekstury
-	glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB, 512, 0, GL_RGB, GL_UNSIGNED_BYTE, spectrum_512);
-
-	// wyczenie automatycznego generowania mipmap
-	glTexParameteri(GL_TEXTURE_1D, GL_GENERATE_MIPMAP, GL_FALSE);
-
 	// odenie macierzy modelowania na stos
 	glPushMatrix();
 
@@ -670,7 +698,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Mipmapy 1D");
 
 	// doczenie funkcji generujcej scen 3D
-	glutDisplayFunc(DisplayScene);
+	RedrawInit(DisplayScene, 60);
 
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -704,11 +732,13 @@ int main(int argc, char *argv[])
 
 	glutAddSubMenu("Filtr pomniejszajcy", MenuMinFilter);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
+	glutAddMenuEntry("Statystyki tekstur", TEXTURE_STATS);
 	glutAddMenuEntry("Wyjcie", EXIT);
 #else
 
 	glutAddSubMenu("Filtr pomniejszajacy", MenuMinFilter);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
+	glutAddMenuEntry("Statystyki tekstur", TEXTURE_STATS);
 	glutAddMenuEntry("Wyjscie", EXIT);
 #endif
 
@@ -718,8 +748,9 @@ int main(int argc, char *argv[])
 	// sprawdzenie i przygotowanie obsugi wybranych rozszerze?
 	ExtensionSetup();
 
-	// utworzenie list wywietlania
+	// utworzenie tekstur i list wywietlania
 	GenerateDisplayLists();
+	TexturePrintStats();
 
 	// wprowadzenie programu do obsugi ptli komunikatw
 	glutMainLoop();
@@ -0,0 +1,108 @@
+#include "redraw.h"
+
+static void(*display_function)() = NULL;
+static void(*animation_step)(float dt) = NULL;
+
+static int fps = 0; // ograniczenie liczby ramek na sekund (0 - bez ograniczenia)
+static int frame_interval = 0; // najmniejszy odstp midzy ramkami [ms]
+static int interval_remainder = 0; // reszta odstpu 1000 / fps [1/fps ms]
+static int last_frame = 0; // czas rozpoczcia poprzedniej ramki [ms]
+static int last_step = 0; // czas poprzedniego kroku animacji [ms]
+
+// ramka ju zlecona GLUT (glutPostRedisplay) lub oczekujca na upyw
+// odstpu midzy ramkami (glutTimerFunc) - kolejne zgoszenia s czone
+
+static bool posted = false;
+static bool waiting = false;
+
+static RedrawStats stats;
+
+static void RedrawTimer(int)
+{
+	waiting = false;
+	posted = true;
+	glutPostRedisplay();
+}
+
+// zlecenie ramki z zachowaniem odstpu midzy ramkami
+
+static void Schedule()
+{
+	if (posted || waiting)
+		return;
+	const int delay = last_frame + frame_interval - glutGet(GLUT_ELAPSED_TIME);
+	if (delay > 0)
+	{
+		waiting = true;
+		glutTimerFunc(delay, RedrawTimer, 0);
+	}
+	else
+	{
+		posted = true;
+		glutPostRedisplay();
+	}
+}
+
+static void RedrawDisplay()
+{
+	posted = false;
+	const int time = glutGet(GLUT_ELAPSED_TIME);
+	last_frame = time;
+
+	// odstp do nastpnej ramki w penych milisekundach z przeniesieniem
+	// reszty (przy 60 ramkach/s kolejno 16, 17, 17 ms - rednio 1000 / 60)
+	if (fps > 0)
+	{
+		const int total = 1000 + interval_remainder;
+		frame_interval = total / fps;
+		interval_remainder = total % fps;
+	}
+	if (animation_step)
+	{
+		animation_step((time - last_step) / 1000.0f);
+		last_step = time;
+	}
+	stats.frames++;
+	display_function();
+
+	// animacja - kolejna ramka
+	if (animation_step)
+		Schedule();
+}
+
+void RedrawInit(void(*display)(), int fps_cap)
+{
+	display_function = display;
+	RedrawFpsCap(fps_cap);
+	glutDisplayFunc(RedrawDisplay);
+}
+
+void RedrawRequest()
+{
+	stats.requests++;
+
+	// bez RedrawInit (tryb bez okna) ramki rysuje wywoujcy
+	if (display_function)
+		Schedule();
+}
+
+void RedrawAnimation(void(*step)(float dt))
+{
+	if (step && animation_step == NULL)
+		last_step = glutGet(GLUT_ELAPSED_TIME);
+	animation_step = step;
+	if (step)
+		Schedule();
+}
+
+void RedrawFpsCap(int fps_cap)
+{
+	fps = fps_cap > 0 ? fps_cap : 0;
+	frame_interval = fps > 0 ? 1000 / fps : 0;
+	interval_remainder = 0;
+}
+
+const RedrawStats &RedrawGetStats()
+{
+	return stats;
+}
@@ -0,0 +1,79 @@
+#ifndef __TEXTURES__H__
+#define __TEXTURES__H__
+
+#include <GL/glut.h>
+
+// obiekty tekstur tworzone raz przy uruchomieniu programu: obraz tekstury
+// razem z mipmapami jest przesyany do OpenGL tylko przy tworzeniu obiektu,
+// a rysowanie jedynie dowizuje obiekt (zamiast glTexImage* w licie
+// wywietlania, wykonywanego przy kadym glCallList); dla kadej tekstury
+// zliczane s zajta pami i przesania, a dla ramki - przesania i dowizania
+
+// dane tekstury
+
+struct TextureInfo
+{
+	const char *name = "";
+	GLuint id = 0;
+	GLenum target = GL_TEXTURE_2D;
+	int width = 0;
+	int height = 0;
+	int levels = 0;    // liczba poziomw mipmap
+	int memory = 0;    // szacowana pami obrazu i mipmap [bajty]
+	int uploads = 0;   // przesane poziomy obrazu
+	int binds = 0;     // dowizania
+};
+
+// przesania obrazw (liczba poziomw i bajty) i dowizania w ramce
+
+struct TextureFrameStats
+{
+	int uploads = 0;
+	int upload_bytes = 0;
+	int binds = 0;
+};
+
+// utworzenie obiektu tekstury (dowizanego po utworzeniu) o celu
+// GL_TEXTURE_1D lub GL_TEXTURE_2D; name - nazwa w statystykach
+
+GLuint TextureCreate(const char *name, GLenum target);
+
+// obraz poziomu level tekstury; gdy dla poziomu 0 wczony jest parametr
+// GL_GENERATE_MIPMAP, pami obejmuje mipmapy tworzone przez OpenGL
+
+void TextureImage1D(GLuint texture, GLint level, GLint internal_format, GLsizei width,
+	GLenum format, GLenum type, const GLvoid *pixels);
+void TextureImage2D(GLuint texture, GLint level, GLint internal_format, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const GLvoid *pixels);
+
+// obraz tekstury z mipmapami tworzonymi przez bibliotek GLU;
+// zwraca wynik gluBuild*DMipmaps
+
+GLint TextureBuild1DMipmaps(GLuint texture, GLint internal_format, GLsizei width,
+	GLenum format, GLenum type, const GLvoid *pixels);
+GLint TextureBuild2DMipmaps(GLuint texture, GLint internal_format, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const GLvoid *pixels);
+
+// dowizanie tekstury do jej celu (pomijane, gdy jest ju dowizana)
+
+void TextureBind(GLuint texture);
+
+// parametr obiektu tekstury; wywoanie niezmieniajce wartoci jest pomijane
+
+void TextureParameteri(GLuint texture, GLenum pname, GLint param);
+
+// dane tekstury (NULL - nieznany obiekt)
+
+const TextureInfo *TextureGetInfo(GLuint texture);
+
+// zakoczenie ramki - liczniki biecej ramki staj si licznikami
+// ostatniej ramki i s zerowane
+
+void TextureFrameEnd();
+const TextureFrameStats &TextureLastFrame();
+
+// wypisanie pamici i licznikw kadej tekstury oraz ostatniej ramki
+
+void TexturePrintStats();
+
+#endif // __TEXTURES__H__
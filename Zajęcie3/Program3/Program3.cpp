@@ -17,13 +17,13 @@ JanuszG@enter.net.pl
 #include <stdio.h>
 #include "colors.h"
 #include "targa.h"
+#include "primitives.h"
+#include "extensions.h"
+#include "text.h"
+#include "redraw.h"
 #include <GLFW/glfw3.h>
 
 
-// wska?nik na funkcj glWindowPos2i
-
-PFNGLWINDOWPOS2IPROC glWindowPos2i = NULL;
-
 // stae do obsugi menu podrcznego
 
 enum
@@ -85,18 +85,55 @@ GLuint texture;
 
 GLint min_filter = GL_LINEAR_MIPMAP_LINEAR;
 
+// parametry biecej tekstury wywietlane na ekranie - pobierane z OpenGL
+// tylko po utworzeniu lub zmianie tekstury (zapytania glGet* wymuszaj
+// synchronizacj z potokiem OpenGL), wraz z gotowymi napisami
+
+struct TextureInfo
+{
+	GLuint texture = 0;
+	GLfloat priority = 0.0f;
+	GLfloat resident = GL_FALSE;
+	GLfloat width = 0.0f;
+	GLfloat height = 0.0f;
+	char strings[4][64];
+};
+
+TextureInfo texture_info;
+
 // funkcja rysujca napis w wybranym miejscu
-// (wersja korzystajca z funkcji glWindowPos2i)
+// (napisy s zbierane i rysowane razem z atlasu znakw w TextFlush)
 
 void DrawString(GLint x, GLint y, char *string)
 {
-	// pooenie napisu
-	glWindowPos2i(x, y);
+	TextAdd(x, y, string);
+}
+
+// pobranie parametrw biecej tekstury (dowizanej do GL_TEXTURE_2D)
+// i utworzenie napisw
+
+void UpdateTextureInfo()
+{
+	texture_info.texture = texture;
 
-	// wywietlenie napisu
-	int len = strlen(string);
-	for (int i = 0; i < len; i++)
-		glutBitmapCharacter(GLUT_BITMAP_9_BY_15, string[i]);
+	// warto priorytetu tekstury
+	glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_PRIORITY, &texture_info.priority);
+	sprintf(texture_info.strings[0], "GL_TEXTURE_PRIORITY = %f", texture_info.priority);
+
+	// czy tekstura jest rezydentna
+	glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_RESIDENT, &texture_info.resident);
+	if (texture_info.resident == GL_FALSE)
+		strcpy(texture_info.strings[1], "GL_TEXTURE_RESIDENT = GL_FALSE");
+	else
+		strcpy(texture_info.strings[1], "GL_TEXTURE_RESIDENT = GL_TRUE");
+
+	// szeroko tekstury (poziom 0)
+	glGetTexLevelParameterfv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texture_info.width);
+	sprintf(texture_info.strings[2], "GL_TEXTURE_WIDTH = %f", texture_info.width);
+
+	// wysoko tekstury (poziom 0)
+	glGetTexLevelParameterfv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texture_info.height);
+	sprintf(texture_info.strings[3], "GL_TEXTURE_HEIGHT = %f", texture_info.height);
 }
 
 // funkcja generujca scen 3D
@@ -143,54 +180,24 @@ void DisplayScene()
 	// ustawienie parametw rodowiska tekstur
 	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
 
-	// utworzenie kwadryki
-	GLUquadricObj *quadobj = gluNewQuadric();
-
-	// styl (wygld) generowanej kwadryki
-	gluQuadricDrawStyle(quadobj, GLU_FILL);
-
-	// sposb generacji wektorw normalnych
-	gluQuadricNormals(quadobj, GLU_SMOOTH);
-
-	// naoenie tekstury na kwadryk
-	gluQuadricTexture(quadobj, GL_TRUE);
-
-	// narysowanie kuli
-	gluSphere(quadobj, 1.0, 30, 30);
-
-	// usunicie kwadryki
-	gluDeleteQuadric(quadobj);
+	// narysowanie kuli - siatka (jak gluSphere z normalnymi i wsprzdnymi
+	// tekstury) jest tworzona raz i przechowywana w obiektach buforowych
+	PrimitiveDrawSolid(Sphere(1.0, 30, 30));
 
 	// wyczenie teksturowania dwuwymiarowego
 	glDisable(GL_TEXTURE_2D);
 
 	// informacje o wybranych parametrach biecej tekstury
-	char string[200];
-	GLfloat var;
-	glColor3fv(Black);
+	if (texture_info.texture != texture)
+		UpdateTextureInfo();
+	TextColor(Black);
+	DrawString(2, 2, texture_info.strings[0]);
+	DrawString(2, 16, texture_info.strings[1]);
+	DrawString(2, 30, texture_info.strings[2]);
+	DrawString(2, 46, texture_info.strings[3]);
 
-	// warto priorytetu tekstury
-	glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_PRIORITY, &var);
-	sprintf(string, "GL_TEXTURE_PRIORITY = %f", var);
-	DrawString(2, 2, string);
-
-	// czy tekstura jest rezydentna
-	glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_RESIDENT, &var);
-	if (var == GL_FALSE)
-		strcpy(string, "GL_TEXTURE_RESIDENT = GL_FALSE");
-	else
-		strcpy(string, "GL_TEXTURE_RESIDENT = GL_TRUE");
-	DrawString(2, 16, string);
-
-	// szeroko tekstury (poziom 0)
-	glGetTexLevelParameterfv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &var);
-	sprintf(string, "GL_TEXTURE_WIDTH = %f", var);
-	DrawString(2, 30, string);
-
-	// wysoko tekstury (poziom 0)
-	glGetTexLevelParameterfv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &var);
-	sprintf(string, "GL_TEXTURE_HEIGHT = %f", var);
-	DrawString(2, 46, string);
+	// narysowanie napisw
+	TextFlush(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 
 	// skierowanie polece? do wykonania
 	glFlush();
@@ -228,7 +235,7 @@ void Reshape(int width, int height)
 		glFrustum(left, right, bottom, top, near, far);
 
 	// generowanie sceny 3D
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga klawiatury
@@ -245,7 +252,7 @@ void Keyboard(unsigned char key, int x, int y)
 			scale -= 0.05;
 
 	// narysowanie sceny
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsuga przyciskw myszki
@@ -276,7 +283,7 @@ void MouseMotion(int x, int y)
 		button_x = x;
 		rotatex -= 30 * (top - bottom) / glutGet(GLUT_WINDOW_HEIGHT) * (button_y - y);
 		button_y = y;
-		glutPostRedisplay();
+		RedrawRequest();
 	}
 }
 
@@ -289,7 +296,7 @@ void Menu(int value)
 		// Saturn	
 	case SATURN_TEX:
 		texture = SATURN;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// filtr pomniejszajcy
@@ -298,7 +305,7 @@ void Menu(int value)
 	case GL_LINEAR_MIPMAP_NEAREST:
 	case GL_LINEAR_MIPMAP_LINEAR:
 		min_filter = value;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// obszar renderingu - cae okno
@@ -357,48 +364,9 @@ void GenerateTextures()
 
 	// identyfikator biecej tekstury
 	texture = SATURN;
-}
-
-// sprawdzenie i przygotowanie obsugi wybranych rozszerze?
-
-void ExtensionSetup()
-{
-	// pobranie numeru wersji biblioteki OpenGL
-	const char *version = (char*)glGetString(GL_VERSION);
-
-	// odczyt wersji OpenGL
-	int major = 0, minor = 0;
-	if (sscanf(version, "%d.%d", &major, &minor) != 2)
-	{
-#ifdef WIN32
-		printf("Bdny format wersji OpenGL\n");
-#else
 
-		printf("Bledny format wersji OpenGL\n");
-#endif
-
-		exit(0);
-	}
-
-	// sprawdzenie czy jest co najmniej wersja 1.4
-	if (major > 1 || minor >= 4)
-	{
-		// pobranie wska?nika wybranej funkcji OpenGL 1.4
-		glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress("glWindowPos2i");
-	}
-	else
-		// sprawdzenie czy jest obsugiwane rozszerzenie ARB_window_pos
-		if (glutExtensionSupported("GL_ARB_window_pos"))
-		{
-			// pobranie wska?nika wybranej funkcji rozszerzenia ARB_window_pos
-			glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress
-				("glWindowPos2iARB");
-		}
-		else
-		{
-			printf("Brak rozszerzenia ARB_window_pos!\n");
-			exit(0);
-		}
+	// parametry nowej tekstury (tekstura jest nadal dowizana)
+	UpdateTextureInfo();
 }
 
 int main(int argc, char *argv[])
@@ -416,7 +384,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Tekstura 2D");
 
 	// doczenie funkcji generujcej scen 3D
-	glutDisplayFunc(DisplayScene);
+	RedrawInit(DisplayScene, 60);
 
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -476,8 +444,8 @@ int main(int argc, char *argv[])
 	// utworzenie tekstur
 	GenerateTextures();
 
-	// sprawdzenie i przygotowanie obsugi wybranych rozszerze?
-	ExtensionSetup();
+	// obiekty buforowe dla siatek bry i napisw
+	ExtensionFunctionsSetup();
 
 	// wprowadzenie programu do obsugi ptli komunikatw
 	glutMainLoop();
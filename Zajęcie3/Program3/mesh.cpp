@@ -0,0 +1,136 @@
+#include "mesh.h"
+#include "extensions.h"
+
+void MeshSet(Mesh &mesh, const GLfloat *positions, const GLfloat *normals, const GLfloat *texcoords,
+	int vertex_count, const int *indices, int index_count)
+{
+	mesh.texcoords = texcoords != NULL;
+	mesh.vertex_count = vertex_count;
+	mesh.index_count = index_count;
+
+	// wierzchoki przeplatane
+	const int stride = MeshStride(mesh);
+	mesh.vertices.resize(stride * vertex_count);
+	for (int i = 0; i < vertex_count; i++)
+	{
+		GLfloat *v = &mesh.vertices[stride * i];
+		v[0] = positions[3 * i + 0];
+		v[1] = positions[3 * i + 1];
+		v[2] = positions[3 * i + 2];
+		v[3] = normals[3 * i + 0];
+		v[4] = normals[3 * i + 1];
+		v[5] = normals[3 * i + 2];
+		if (texcoords)
+		{
+			v[6] = texcoords[2 * i + 0];
+			v[7] = texcoords[2 * i + 1];
+		}
+	}
+
+	// indeksy moliwie najkrtsze
+	mesh.indices16.clear();
+	mesh.indices32.clear();
+	if (vertex_count <= 65536)
+		mesh.indices16.assign(indices, indices + index_count);
+	else
+		mesh.indices32.assign(indices, indices + index_count);
+
+	mesh.uploaded = false;
+}
+
+void MeshDraw(Mesh &mesh)
+{
+	MeshDrawRange(mesh, 0, mesh.index_count);
+}
+
+void MeshDrawRange(Mesh &mesh, int first, int count, GLenum mode)
+{
+	if (count == 0)
+		return;
+	MeshBind(mesh);
+	MeshDrawElements(mesh, first, count, mode);
+	MeshUnbind(mesh);
+}
+
+void MeshBind(Mesh &mesh)
+{
+	// pusta siatka - bez tablic i buforw (MeshDrawElements nic nie rysuje)
+	if (mesh.vertices.empty() || mesh.index_count == 0)
+		return;
+
+	const GLfloat *vertex_data = &mesh.vertices[0];
+
+	if (buffer_objects)
+	{
+		// wysanie danych do buforw tylko po zmianie siatki
+		if (mesh.vertex_buffer == 0)
+		{
+			glGenBuffers(1, &mesh.vertex_buffer);
+			glGenBuffers(1, &mesh.index_buffer);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.vertex_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.index_buffer);
+		if (!mesh.uploaded)
+		{
+			const bool short_indices = !mesh.indices16.empty();
+			const GLvoid *index_data = short_indices ? (const GLvoid*)&mesh.indices16[0] : (const GLvoid*)&mesh.indices32[0];
+			const GLsizeiptr index_size = mesh.index_count * (short_indices ? sizeof(GLushort) : sizeof(GLuint));
+			glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(GLfloat), vertex_data, GL_STATIC_DRAW);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_size, index_data, GL_STATIC_DRAW);
+			mesh.uploaded = true;
+			mesh.uploads++;
+		}
+
+		// od tej pory wskaniki s przesuniciami w buforach
+		vertex_data = NULL;
+	}
+
+	const GLsizei stride = MeshStride(mesh) * sizeof(GLfloat);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glVertexPointer(3, GL_FLOAT, stride, vertex_data);
+	glNormalPointer(GL_FLOAT, stride, vertex_data + 3);
+	if (mesh.texcoords)
+	{
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2, GL_FLOAT, stride, vertex_data + 6);
+	}
+}
+
+void MeshDrawElements(const Mesh &mesh, int first, int count, GLenum mode)
+{
+	if (count == 0 || mesh.vertices.empty() || mesh.index_count == 0)
+		return;
+
+	const bool short_indices = !mesh.indices16.empty();
+	const GLenum index_type = short_indices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	const GLvoid *index_data = NULL;
+	if (!buffer_objects)
+		index_data = short_indices ? (const GLvoid*)&mesh.indices16[0] : (const GLvoid*)&mesh.indices32[0];
+
+	glDrawElements(mode, count, index_type, (const GLubyte*)index_data + first * (short_indices ? sizeof(GLushort) : sizeof(GLuint)));
+}
+
+void MeshUnbind(const Mesh &mesh)
+{
+	if (mesh.texcoords)
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	if (buffer_objects)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+}
+
+void MeshFree(Mesh &mesh)
+{
+	if (mesh.vertex_buffer != 0)
+	{
+		glDeleteBuffers(1, &mesh.vertex_buffer);
+		glDeleteBuffers(1, &mesh.index_buffer);
+		mesh.vertex_buffer = mesh.index_buffer = 0;
+	}
+	mesh.uploaded = false;
+}
@@ -0,0 +1,63 @@
+#ifndef __MESH__H__
+#define __MESH__H__
+
+#include <GL/glut.h>
+#include <vector>
+
+// siatka indeksowana: wierzchoki przeplatane (x, y, z, nx, ny, nz[, s, t])
+// i indeksy 16-bitowe (do 65536 wierzchokw) lub 32-bitowe; dane
+// wysyane s do obiektw buforowych tylko po zmianie siatki
+
+struct Mesh
+{
+	std::vector<GLfloat> vertices; // wierzchoki przeplatane
+	std::vector<GLushort> indices16; // indeksy 16-bitowe
+	std::vector<GLuint> indices32; // indeksy 32-bitowe
+	int vertex_count = 0;
+	int index_count = 0;
+	bool texcoords = false; // wierzchoki zawieraj wsprzdne tekstury
+	GLuint vertex_buffer = 0; // VBO
+	GLuint index_buffer = 0; // IBO
+	bool uploaded = false; // zawarto buforw zgodna z siatk
+	int uploads = 0; // liczba wysa danych do buforw
+};
+
+// rozmiar wierzchoka w liczbach GLfloat
+
+inline int MeshStride(const Mesh &mesh)
+{
+	return mesh.texcoords ? 8 : 6;
+}
+
+// ustawienie zawartoci siatki; tablica texcoords moe by pusta (NULL)
+// positions - wsprzdne (x, y, z), normals - wektory normalne,
+// texcoords - wsprzdne tekstury (s, t)
+
+void MeshSet(Mesh &mesh, const GLfloat *positions, const GLfloat *normals, const GLfloat *texcoords,
+	int vertex_count, const int *indices, int index_count);
+
+// narysowanie siatki (GL_TRIANGLES) przy pomocy glDrawElements; przy
+// pierwszym wywoaniu po zmianie siatki dane s wysyane do buforw;
+// bez obsugi obiektw buforowych uywane s tablice wierzchokw w pamici klienta
+
+void MeshDraw(Mesh &mesh);
+
+// narysowanie count indeksw siatki poczwszy od indeksu first (np. jednego
+// z poziomw szczegowoci zapisanych kolejno w tablicy indeksw);
+// mode - rodzaj prymityww (np. GL_LINES dla krawdzi zapisanych za trjktami)
+
+void MeshDrawRange(Mesh &mesh, int first, int count, GLenum mode = GL_TRIANGLES);
+
+// rysowanie wielu fragmentw siatki bez ponownego ustawiania tablic
+// wierzchokw: MeshBind ustawia bufory i tablice (wysyajc dane po zmianie
+// siatki), MeshDrawElements rysuje indeksy, MeshUnbind przywraca stan
+
+void MeshBind(Mesh &mesh);
+void MeshDrawElements(const Mesh &mesh, int first, int count, GLenum mode = GL_TRIANGLES);
+void MeshUnbind(const Mesh &mesh);
+
+// usunicie obiektw buforowych
+
+void MeshFree(Mesh &mesh);
+
+#endif // __MESH__H__
@@ -10,10 +10,14 @@
 #include <stdio.h>
 #include "colors.h"
 #include "targa.h"
-
-// wska?nik na funkcję glWindowPos2i
-
-PFNGLWINDOWPOS2IPROC glWindowPos2i = NULL;
+#include "gl_state.h"
+#include "extensions.h"
+#include "text.h"
+#include "redraw.h"
+#include "profiler.h"
+#include "headless.h"
+#include "transform.h"
+#include "dynamic_resolution.h"
 
 // stałe do obsługi menu podręcznego
 
@@ -27,6 +31,7 @@ enum
 	GENERATE_MIPMAP_NICEST,             // jakość generowania mipmap - GL_NICEST
 	FULL_WINDOW,                        // aspekt obrazu - całe okno
 	ASPECT_1_1,                         // aspekt obrazu 1:1
+	DYNAMIC_RESOLUTION,                 // dynamiczna rozdzielczość: włącz/wyłącz
 	EXIT                                // wyjście
 };
 
@@ -77,6 +82,16 @@ GLuint GROUND, WOOD, ROOF,OKNO;
 
 GLint GROUND_LIST, WOOD_LIST, ROOF_LIST,OKNO_LIST;
 
+// liczba wierzchołków w listach wyświetlania (do licznika wydajności)
+
+const int GROUND_VERTICES = 4, WOOD_VERTICES = 30, ROOF_VERTICES = 8, OKNO_VERTICES = 54;
+
+// hierarchia przekształceń: kamera -> podłoże i domek; ściany, okna i dach
+// domku mają wspólny węzeł, więc ich macierz jest ładowana raz w ramce
+
+TransformHierarchy transforms;
+int CAMERA_NODE, GROUND_NODE, HOUSE_NODE;
+
 // filtr pomniejszający
 
 GLint min_filter = GL_LINEAR_MIPMAP_LINEAR;
@@ -90,23 +105,21 @@ GLint perspective_correction_hint = GL_DONT_CARE;
 GLint mipmap_generation_hint = GL_DONT_CARE;
 
 // funkcja rysująca napis w wybranym miejscu
-// (wersja korzystająca z funkcji glWindowPos2i)
+// (napisy są zbierane i rysowane razem z atlasu znaków w TextFlush)
 
 void DrawString(GLint x, GLint y, char *string)
 {
-	// poło?enie napisu
-	glWindowPos2i(x, y);
-
-	// wyświetlenie napisu
-	int len = strlen(string);
-	for (int i = 0; i < len; i++)
-		glutBitmapCharacter(GLUT_BITMAP_9_BY_15, string[i]);
+	TextAdd(x, y, string);
 }
 
 // funkcja generująca scenę 3D
 
 void DisplayScene()
 {
+	// scena 3D w rozdzielczości dobranej do budżetu czasu (przy wyłączonej
+	// dynamicznej rozdzielczości - bezpośrednio w oknie)
+	DynamicResolutionBegin();
+
 	// kolor tła - zawartość bufora koloru
 	glClearColor(1.0, 1.0, 1.0, 1.0);
 
@@ -116,139 +129,205 @@ void DisplayScene()
 	// wybór macierzy modelowania
 	glMatrixMode(GL_MODELVIEW);
 
-	// macierz modelowania = macierz jednostkowa
-	glLoadIdentity();
-
-	// przesunięcie układu współrzędnych obiektów do środka bryły odcinania
-	glTranslatef(0.0, 0.0, -(near + far) / 2);
-
-	// obroty obiektu
-	glRotatef(rotatex, 1.0, 0.0, 0.0);
-	glRotatef(rotatey, 0.0, 1.0, 0.0);
-
-	// skalowanie obiektu - klawisze "+" i "-"
-	glScalef(scale, scale, scale);
+	// macierz kamery: przesunięcie układu współrzędnych obiektów do środka
+	// bryły odcinania, obroty obiektu i skalowanie - klawisze "+" i "-";
+	// macierze podłoża i domku są przeliczane tylko po zmianie kamery
+	Matrix camera = MatrixTranslation(0.0, 0.0, -(near + far) / 2);
+	camera = MatrixMultiply(camera, MatrixRotation(rotatex, 1.0, 0.0, 0.0));
+	camera = MatrixMultiply(camera, MatrixRotation(rotatey, 0.0, 1.0, 0.0));
+	camera = MatrixMultiply(camera, MatrixScaling(scale, scale, scale));
+	TransformSet(transforms, CAMERA_NODE, camera);
+	TransformUpdate(transforms);
 
 	// włączenie testu bufora głębokości
-	glEnable(GL_DEPTH_TEST);
+	StateEnable(GL_DEPTH_TEST);
 
 	// włączenie teksturowania dwuwymiarowego
-	glEnable(GL_TEXTURE_2D);
+	StateEnable(GL_TEXTURE_2D);
 
 	// filtr powiększający
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	StateTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 	// filtr pomniejszający
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+	StateTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
 
 	// wskazówki do korekcji perspektywy przy renderingu tekstur
-	glHint(GL_PERSPECTIVE_CORRECTION_HINT, perspective_correction_hint);
+	StateHintMode(GL_PERSPECTIVE_CORRECTION_HINT, perspective_correction_hint);
 
 	// ustawienie parametów środowiska tekstur
-	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+	StateTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
 
 	// rysowanie podło?a
-	glBindTexture(GL_TEXTURE_2D, GROUND);
-	glPushMatrix();
-	glTranslatef(0.0, -1.0, 0.0);
+	StateBindTexture(GL_TEXTURE_2D, GROUND);
+	TransformLoad(transforms, GROUND_NODE);
 	glCallList(GROUND_LIST);
-	glPopMatrix();
+	ProfilerDraw(GROUND_VERTICES);
 
 	// rysowanie ścian domku
-	glBindTexture(GL_TEXTURE_2D, WOOD);
-	glPushMatrix();
-	glTranslatef(0.0, -0.5, 0.0);
-	glScalef(0.5, 0.5, 0.5);
+	StateBindTexture(GL_TEXTURE_2D, WOOD);
+	TransformLoad(transforms, HOUSE_NODE);
 	glCallList(WOOD_LIST);
-	glPopMatrix();
+	ProfilerDraw(WOOD_VERTICES);
 
 	// rysowanie okien
-	glBindTexture(GL_TEXTURE_2D, OKNO);
-	glPushMatrix();
-	glTranslatef(0.0, -0.5, 0.0);
-	glScalef(0.5, 0.5, 0.5);
+	StateBindTexture(GL_TEXTURE_2D, OKNO);
+	TransformLoad(transforms, HOUSE_NODE);
 	glCallList(OKNO_LIST);
-	glPopMatrix();
+	ProfilerDraw(OKNO_VERTICES);
 
 	// rysowanie dachu domku
-	glBindTexture(GL_TEXTURE_2D, ROOF);
-	glPushMatrix();
-	glTranslatef(0.0, -0.5, 0.0);
-	glScalef(0.5, 0.5, 0.5);
+	StateBindTexture(GL_TEXTURE_2D, ROOF);
+	TransformLoad(transforms, HOUSE_NODE);
 	glCallList(ROOF_LIST);
-	glPopMatrix();
+	ProfilerDraw(ROOF_VERTICES);
 
 	// wyłączenie teksturowania dwuwymiarowego
-	glDisable(GL_TEXTURE_2D);
-
-	// wyświetlenie wybranych informacje
-	char string[200];
+	StateDisable(GL_TEXTURE_2D);
+
+	// powiększenie sceny do rozmiarów okna - napisy i wykres mają pełną
+	// rozdzielczość okna
+	DynamicResolutionEnd();
+
+	// wyświetlenie wybranych informacje; wartości są odczytywane z pamięci
+	// podręcznej stanu (bez glGet*), a napisy tworzone tylko po ich zmianie
+	static GLint shown_min_filter = -1, shown_perspective_hint = -1, shown_mipmap_hint = -1, shown_scale = -1;
+	static StateStats shown_stats;
+	static TransformStats shown_transform_stats;
+	static char min_filter_string[64], perspective_hint_string[64], mipmap_hint_string[64], stats_string[64],
+		transform_string[64], scale_string[64];
 	GLint var;
-	glColor3fv(Black);
+	TextColor(Black);
 
-	// pobranie informacji o filtrze pomniejszający
-	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &var);
-	switch (var)
+	// filtr pomniejszający bieżącej tekstury
+	var = StateGetTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER);
+	if (var != shown_min_filter)
 	{
-		// filtr GL_NEAREST_MIPMAP_NEAREST
-	case GL_NEAREST_MIPMAP_NEAREST:
-		sprintf(string, "GL_TEXTURE_MIN_FILTER = GL_NEAREST_MIPMAP_NEAREST");
-		break;
-
-		// filtr GL_NEAREST_MIPMAP_LINEAR
-	case GL_NEAREST_MIPMAP_LINEAR:
-		sprintf(string, "GL_TEXTURE_MIN_FILTER = GL_NEAREST_MIPMAP_LINEAR");
-		break;
+		shown_min_filter = var;
+		switch (var)
+		{
+			// filtr GL_NEAREST_MIPMAP_NEAREST
+		case GL_NEAREST_MIPMAP_NEAREST:
+			sprintf(min_filter_string, "GL_TEXTURE_MIN_FILTER = GL_NEAREST_MIPMAP_NEAREST");
+			break;
+
+			// filtr GL_NEAREST_MIPMAP_LINEAR
+		case GL_NEAREST_MIPMAP_LINEAR:
+			sprintf(min_filter_string, "GL_TEXTURE_MIN_FILTER = GL_NEAREST_MIPMAP_LINEAR");
+			break;
+
+			// filtr GL_LINEAR_MIPMAP_NEAREST
+		case GL_LINEAR_MIPMAP_NEAREST:
+			sprintf(min_filter_string, "GL_TEXTURE_MIN_FILTER = GL_LINEAR_MIPMAP_NEAREST");
+			break;
+
+			// filtr GL_LINEAR_MIPMAP_LINEAR
+		case GL_LINEAR_MIPMAP_LINEAR:
+			sprintf(min_filter_string, "GL_TEXTURE_MIN_FILTER = GL_LINEAR_MIPMAP_LINEAR");
+			break;
+		}
+	}
+	DrawString(2, WindowHeight() - 17, min_filter_string);
 
-		// filtr GL_LINEAR_MIPMAP_NEAREST
-	case GL_LINEAR_MIPMAP_NEAREST:
-		sprintf(string, "GL_TEXTURE_MIN_FILTER = GL_LINEAR_MIPMAP_NEAREST");
-		break;
+	// wskazówki do korekcji perspektywy przy renderingu tekstur
+	var = StateGetHint(GL_PERSPECTIVE_CORRECTION_HINT);
+	if (var != shown_perspective_hint)
+	{
+		shown_perspective_hint = var;
+		switch (var)
+		{
+		case GL_FASTEST:
+			sprintf(perspective_hint_string, "GL_PERSPECTIVE_CORRECTION_HINT = GL_FASTEST");
+			break;
+		case GL_DONT_CARE:
+			sprintf(perspective_hint_string, "GL_PERSPECTIVE_CORRECTION_HINT = GL_DONT_CARE");
+			break;
+		case GL_NICEST:
+			sprintf(perspective_hint_string, "GL_PERSPECTIVE_CORRECTION_HINT = GL_NICEST");
+			break;
+		}
+	}
+	DrawString(2, WindowHeight() - 33, perspective_hint_string);
 
-		// filtr GL_LINEAR_MIPMAP_LINEAR
-	case GL_LINEAR_MIPMAP_LINEAR:
-		sprintf(string, "GL_TEXTURE_MIN_FILTER = GL_LINEAR_MIPMAP_LINEAR");
-		break;
+	// wskazówki do automatycznego generowania mipmap
+	var = StateGetHint(GL_GENERATE_MIPMAP_HINT);
+	if (var != shown_mipmap_hint)
+	{
+		shown_mipmap_hint = var;
+		switch (var)
+		{
+		case GL_FASTEST:
+			sprintf(mipmap_hint_string, "GL_GENERATE_MIPMAP_HINT = GL_FASTEST");
+			break;
+		case GL_DONT_CARE:
+			sprintf(mipmap_hint_string, "GL_GENERATE_MIPMAP_HINT = GL_DONT_CARE");
+			break;
+		case GL_NICEST:
+			sprintf(mipmap_hint_string, "GL_GENERATE_MIPMAP_HINT = GL_NICEST");
+			break;
+		}
 	}
-	DrawString(2, glutGet(GLUT_WINDOW_HEIGHT) - 17, string);
+	DrawString(2, WindowHeight() - 49, mipmap_hint_string);
 
-	// pobranie informacji o wskazówkach do automatycznego generowania mipmap
-	glGetIntegerv(GL_PERSPECTIVE_CORRECTION_HINT, &var);
-	switch (var)
+	// wywołania zmieniające stan w poprzedniej ramce - wysłane i pominięte
+	// oraz zapytania przekazane do OpenGL
+	const StateStats &stats = StateLastFrame();
+	if (stats_string[0] == '\0' || stats.issued != shown_stats.issued || stats.filtered != shown_stats.filtered ||
+		stats.queried != shown_stats.queried)
 	{
-	case GL_FASTEST:
-		sprintf(string, "GL_PERSPECTIVE_CORRECTION_HINT = GL_FASTEST");
-		break;
-	case GL_DONT_CARE:
-		sprintf(string, "GL_PERSPECTIVE_CORRECTION_HINT = GL_DONT_CARE");
-		break;
-	case GL_NICEST:
-		sprintf(string, "GL_PERSPECTIVE_CORRECTION_HINT = GL_NICEST");
-		break;
+		shown_stats = stats;
+		sprintf(stats_string, "Stan OpenGL: %d wyslanych, %d pominietych, %d zapytan", stats.issued, stats.filtered,
+			stats.queried);
 	}
-	DrawString(2, glutGet(GLUT_WINDOW_HEIGHT) - 33, string);
+	DrawString(2, WindowHeight() - 65, stats_string);
+
+	// macierze w poprzedniej ramce - przeliczone i wzięte z pamięci
+	// podręcznej oraz załadowane (glLoadMatrixf) i pominięte
+	const TransformStats &transform_stats = TransformLastFrame(transforms);
+	if (transform_string[0] == '\0' || transform_stats.updated != shown_transform_stats.updated ||
+		transform_stats.cached != shown_transform_stats.cached || transform_stats.loads != shown_transform_stats.loads ||
+		transform_stats.skipped != shown_transform_stats.skipped)
+	{
+		shown_transform_stats = transform_stats;
+		sprintf(transform_string, "Macierze: %d nowe, %d gotowe, %d wyslane, %d pominiete",
+			transform_stats.updated, transform_stats.cached, transform_stats.loads, transform_stats.skipped);
+	}
+	DrawString(2, WindowHeight() - 81, transform_string);
 
-	// pobranie informacji o wskazówkach do korekcji perspektywy przy renderingu tekstur
-	glGetIntegerv(GL_GENERATE_MIPMAP_HINT, &var);
-	switch (var)
+	// skala rozdzielczości sceny w następnej ramce (w procentach)
+	if (DynamicResolutionEnabled())
 	{
-	case GL_FASTEST:
-		sprintf(string, "GL_GENERATE_MIPMAP_HINT = GL_FASTEST");
-		break;
-	case GL_DONT_CARE:
-		sprintf(string, "GL_GENERATE_MIPMAP_HINT = GL_DONT_CARE");
-		break;
-	case GL_NICEST:
-		sprintf(string, "GL_GENERATE_MIPMAP_HINT = GL_NICEST");
-		break;
+		const GLint percent = (GLint)(100.0f * DynamicResolutionScale() + 0.5f);
+		if (percent != shown_scale)
+		{
+			shown_scale = percent;
+			sprintf(scale_string, "Rozdzielczosc sceny: %d%%", percent);
+		}
+		DrawString(2, WindowHeight() - 97, scale_string);
 	}
-	DrawString(2, glutGet(GLUT_WINDOW_HEIGHT) - 49, string);
+
+	// zakończenie ramki w liczniku wywołań zmieniających stan i w liczniku
+	// przekształceń
+	StateFrameEnd();
+	TransformFrameEnd(transforms);
+
+	// zmiany stanu (w tym załadowane macierze) i dowiązania tekstur w tej
+	// ramce - do licznika wydajności
+	ProfilerStateChanges(StateLastFrame().issued + TransformLastFrame(transforms).loads);
+	ProfilerTextureBind(StateLastFrame().texture_binds);
+
+	// wykres czasów ramek (bez okna pomijany - zapisywane ramki nie zależą
+	// od wyników pomiarów)
+	if (!Headless())
+		ProfilerOverlay(WindowWidth(), WindowHeight());
+
+	// narysowanie napisów
+	TextFlush(WindowWidth(), WindowHeight());
 
 	// skierowanie polece? do wykonania
 	glFlush();
 
 	// zamiana buforów koloru
-	glutSwapBuffers();
+	WindowSwapBuffers();
 }
 
 // zmiana wielkości okna
@@ -258,6 +337,9 @@ void Reshape(int width, int height)
 	// obszar renderingu - całe okno
 	glViewport(0, 0, width, height);
 
+	// rozmiary bufora ramki dynamicznej rozdzielczości
+	DynamicResolutionReshape(width, height);
+
 	// wybór macierzy rzutowania
 	glMatrixMode(GL_PROJECTION);
 
@@ -280,7 +362,7 @@ void Reshape(int width, int height)
 		glFrustum(left, right, bottom, top, near, far);
 
 	// generowanie sceny 3D
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsługa klawiatury
@@ -297,7 +379,7 @@ void Keyboard(unsigned char key, int x, int y)
 			scale -= 0.05;
 
 	// narysowanie sceny
-	DisplayScene();
+	RedrawRequest();
 }
 
 // obsługa przycisków myszki
@@ -328,7 +410,7 @@ void MouseMotion(int x, int y)
 		button_x = x;
 		rotatex -= 30 * (top - bottom) / glutGet(GLUT_WINDOW_HEIGHT) * (button_y - y);
 		button_y = y;
-		glutPostRedisplay();
+		RedrawRequest();
 	}
 }
 
@@ -345,7 +427,7 @@ void GenerateTextures()
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
 	// wskazówki do automatycznego generowania mipmap
-	glHint(GL_GENERATE_MIPMAP_HINT, mipmap_generation_hint);
+	StateHintMode(GL_GENERATE_MIPMAP_HINT, mipmap_generation_hint);
 
 	// wczytanie tekstury ground1-2.tga
 	GLboolean error = load_targa("ground1-2.tga", width, height, format, type, pixels);
@@ -361,10 +443,10 @@ void GenerateTextures()
 	glGenTextures(1, &GROUND);
 
 	// dowiązanie stanu tekstury
-	glBindTexture(GL_TEXTURE_2D, GROUND);
+	StateBindTexture(GL_TEXTURE_2D, GROUND);
 
 	// włączenie automatycznego generowania mipmap
-	glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+	StateTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
 
 	// definiowanie tekstury (z mipmapami)
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, type, pixels);
@@ -386,10 +468,10 @@ void GenerateTextures()
 	glGenTextures(1, &WOOD);
 
 	// dowiązanie stanu tekstury
-	glBindTexture(GL_TEXTURE_2D, WOOD);
+	StateBindTexture(GL_TEXTURE_2D, WOOD);
 
 	// włączenie automatycznego generowania mipmap
-	glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+	StateTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
 
 	// definiowanie tekstury (z mipmapami)
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, type, pixels);
@@ -411,10 +493,10 @@ void GenerateTextures()
 	glGenTextures(1, &ROOF);
 
 	// dowiązanie stanu tekstury
-	glBindTexture(GL_TEXTURE_2D, ROOF);
+	StateBindTexture(GL_TEXTURE_2D, ROOF);
 
 	// włączenie automatycznego generowania mipmap
-	glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+	StateTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
 
 	// definiowanie tekstury (z mipmapami)
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, type, pixels);
@@ -437,10 +519,10 @@ void GenerateTextures()
 	glGenTextures(1, &OKNO);
 
 	// dowiązanie stanu tekstury
-	glBindTexture(GL_TEXTURE_2D, OKNO);
+	StateBindTexture(GL_TEXTURE_2D, OKNO);
 
 	// włączenie automatycznego generowania mipmap
-	glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+	StateTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
 
 	// definiowanie tekstury (z mipmapami)
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, type, pixels);
@@ -462,46 +544,46 @@ void Menu(int value)
 	case GL_LINEAR_MIPMAP_NEAREST:
 	case GL_LINEAR_MIPMAP_LINEAR:
 		min_filter = value;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// wskazówka GL_FASTEST do korekcji perspektywy przy renderingu tekstur
 	case PERSPECTIVE_CORRECTION_FASTEST:
 		perspective_correction_hint = GL_FASTEST;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// wskazówka GL_DONT_CARE do korekcji perspektywy przy renderingu tekstur
 	case PERSPECTIVE_CORRECTION_DONT_CARE:
 		perspective_correction_hint = GL_DONT_CARE;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// wskazówka GL_NICEST do korekcji perspektywy przy renderingu tekstur
 	case PERSPECTIVE_CORRECTION_NICEST:
 		perspective_correction_hint = GL_NICEST;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// wskazówka do automatycznego generowania mipmap
 	case GENERATE_MIPMAP_FASTEST:
 		GenerateTextures();
 		mipmap_generation_hint = GL_FASTEST;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// wskazówka GL_DONT_CARE do automatycznego generowania mipmap
 	case GENERATE_MIPMAP_DONT_CARE:
 		GenerateTextures();
 		mipmap_generation_hint = GL_DONT_CARE;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// wskazówka GL_NICEST do automatycznego generowania mipmap
 	case GENERATE_MIPMAP_NICEST:
 		GenerateTextures();
 		mipmap_generation_hint = GL_NICEST;
-		DisplayScene();
+		RedrawRequest();
 		break;
 
 		// obszar renderingu - całe okno
@@ -516,6 +598,12 @@ void Menu(int value)
 		Reshape(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 		break;
 
+		// dynamiczna rozdzielczość: włącz/wyłącz
+	case DYNAMIC_RESOLUTION:
+		DynamicResolutionEnable(!DynamicResolutionEnabled());
+		RedrawRequest();
+		break;
+
 		// wyjście
 	case EXIT:
 		exit(0);
@@ -807,6 +895,21 @@ void GenerateDisplayLists()
 	glEndList();
 }
 
+// utworzenie hierarchii przekształceń; macierz kamery jest ustawiana
+// w każdej ramce w funkcji DisplayScene
+
+void GenerateTransforms()
+{
+	CAMERA_NODE = TransformAdd(transforms, -1, MatrixIdentity());
+
+	// podłoże pod domkiem
+	GROUND_NODE = TransformAdd(transforms, CAMERA_NODE, MatrixTranslation(0.0, -1.0, 0.0));
+
+	// domek zmniejszony o połowę
+	HOUSE_NODE = TransformAdd(transforms, CAMERA_NODE,
+		MatrixMultiply(MatrixTranslation(0.0, -0.5, 0.0), MatrixScaling(0.5, 0.5, 0.5)));
+}
+
 // sprawdzenie i przygotowanie obsługi wybranych rozszerze?
 
 void ExtensionSetup()
@@ -836,29 +939,18 @@ void ExtensionSetup()
 		printf("Brak rozszerzenia GL_SGIS_generate_mipmap!\n");
 		exit(0);
 	}
+}
 
-	// sprawdzenie czy jest co najmniej wersja 1.4
-	if (major > 1 || minor >= 4)
-	{
-		// pobranie wska?nika wybranej funkcji OpenGL 1.4
-		glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress("glWindowPos2i");
-	}
-	else
-		// sprawdzenie czy jest obsługiwane rozszerzenie ARB_window_pos
-		if (glutExtensionSupported("GL_ARB_window_pos"))
-		{
-			// pobranie wska?nika wybranej funkcji rozszerzenia ARB_window_pos
-			glWindowPos2i = (PFNGLWINDOWPOS2IPROC)wglGetProcAddress
-				("glWindowPos2iARB");
-		}
-		else
-		{
-			printf("Brak rozszerzenia ARB_window_pos!\n");
-			exit(0);
-		}
+// scenariusz kamery w trybie bez okna - pełny obrót sceny wokół osi Y
+
+void HeadlessScript(int frame, int frames)
+{
+	rotatey = 360.0f * frame / frames;
 }
 
-int main(int argc, char *argv[])
+// utworzenie okna GLUT i menu podręcznego oraz dołączenie funkcji obsługi zdarzeń
+
+void WindowSetup(int &argc, char *argv[])
 {
 	// inicjalizacja biblioteki GLUT
 	glutInit(&argc, argv);
@@ -873,7 +965,7 @@ int main(int argc, char *argv[])
 	glutCreateWindow("Mipmapy 2D");
 
 	// dołączenie funkcji generującej scenę 3D
-	glutDisplayFunc(DisplayScene);
+	RedrawInit(ProfilerWrap(DisplayScene), 60);
 
 	// dołączenie funkcji wywoływanej przy zmianie rozmiaru okna
 	glutReshapeFunc(Reshape);
@@ -927,6 +1019,7 @@ int main(int argc, char *argv[])
 	glutAddSubMenu("GL_PERSPECTIVE_CORRECTION_HINT", PerspectiveCorrectionHint);
 	glutAddSubMenu("GL_GENERATE_MIPMAP_HINT", GenerateMipmapHint);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
+	glutAddMenuEntry("Dynamiczna rozdzielczość: włącz/wyłącz", DYNAMIC_RESOLUTION);
 	glutAddMenuEntry("Wyjście", EXIT);
 #else
 
@@ -934,11 +1027,23 @@ int main(int argc, char *argv[])
 	glutAddSubMenu("GL_PERSPECTIVE_CORRECTION_HINT", PerspectiveCorrectionHint);
 	glutAddSubMenu("GL_GENERATE_MIPMAP_HINT", GenerateMipmapHint);
 	glutAddSubMenu("Aspekt obrazu", MenuAspect);
+	glutAddMenuEntry("Dynamiczna rozdzielczosc: wlacz/wylacz", DYNAMIC_RESOLUTION);
 	glutAddMenuEntry("Wyjscie", EXIT);
 #endif
 
 	// określenie przycisku myszki obsługującego menu podręczne
 	glutAttachMenu(GLUT_RIGHT_BUTTON);
+}
+
+int main(int argc, char *argv[])
+{
+	// tryb bez okna (opcja --headless) - kontekst w buforze pozaekranowym
+	const bool headless = HeadlessInit(argc, argv, 500, 500);
+
+	// opcja --frame-budget=MS - dynamiczna rozdzielczość od uruchomienia
+	DynamicResolutionOptions(argc, argv);
+	if (!headless)
+		WindowSetup(argc, argv);
 
 	// utworzenie tekstur
 	GenerateTextures();
@@ -946,9 +1051,22 @@ int main(int argc, char *argv[])
 	// sprawdzenie i przygotowanie obsługi wybranych rozszerze?
 	ExtensionSetup();
 
+	// obiekty buforowe dla napisów i zapytania o czas GPU
+	ExtensionFunctionsSetup();
+
+	// pomiar czasów ramek, dane ramek w pliku Program4_profile.csv
+	ProfilerInit("Program4_profile.csv");
+
 	// utworzenie list wyświetlania
 	GenerateDisplayLists();
 
+	// utworzenie hierarchii przekształceń
+	GenerateTransforms();
+
+	// bez okna - narysowanie ramek według scenariusza kamery
+	if (headless)
+		return HeadlessRun(ProfilerWrap(DisplayScene), Reshape, HeadlessScript);
+
 	// wprowadzenie programu do obsługi pętli komunikatów
 	glutMainLoop();
 	return 0;
@@ -0,0 +1,68 @@
+#ifndef __DYNAMIC_RESOLUTION__H__
+#define __DYNAMIC_RESOLUTION__H__
+
+#include <GL/glut.h>
+
+// dynamiczna rozdzielczo sceny: scena 3D jest rysowana do obiektu bufora
+// ramki (tekstura koloru i bufor gbokoci o rozmiarach okna) w obszarze
+// pomniejszonym o wspczynnik skali, a nastpnie powikszana do caego
+// okna (filtr dwuliniowy, opcjonalnie z wyostrzeniem w programie
+// cieniujcym GLSL); przy skali 1 scena jest rysowana bezporednio w oknie;
+// napisy i wykresy rysowane po DynamicResolutionEnd maj pen
+// rozdzielczo okna
+//
+// skala jest dobierana tak, aby czas ramki (od DynamicResolutionBegin do
+// koca powikszania) by bliski zadanego budetu; czas jest mierzony na
+// GPU znacznikami czasu (GL_TIMESTAMP, OpenGL 3.3 lub ARB_timer_query),
+// a wynik jest odczytywany 1-2 ramki pniej, gdy jest ju dostpny, wic
+// pomiar nie wstrzymuje potoku OpenGL; bez zapyta o czas (np. SOFT_GL)
+// mierzony jest czas do zakoczenia rysowania (glFinish); koszt
+// wypeniania pikseli jest w przyblieniu proporcjonalny do kwadratu
+// skali - przy ograniczeniu wydajnoci przez wypenianie czas ramki
+// pozostaje stay kosztem rozdzielczoci
+//
+// bez obiektw bufora ramki (OpenGL 3.0 lub rozszerzenia
+// ARB/EXT_framebuffer_object; np. SOFT_GL) scena jest rysowana w lewym
+// dolnym rogu okna i kopiowana do tekstury (glCopyTexSubImage2D)
+
+// odczyt opcji (usuwane z argv): --frame-budget=MS - wczenie dynamicznej
+// rozdzielczoci od uruchomienia programu z budetem MS milisekund (bez
+// opcji tryb jest wyczony, take w trybie bez okna, wic zapisywane
+// ramki nie zale od pomiarw czasu); --sharpen - wyostrzenie przy
+// powikszaniu
+
+void DynamicResolutionOptions(int &argc, char *argv[]);
+
+// wczenie/wyczenie dynamicznej rozdzielczoci (np. z menu podrcznego)
+
+void DynamicResolutionEnable(bool enable);
+bool DynamicResolutionEnabled();
+
+// wyostrzenie obrazu przy powikszaniu (wymaga programw cieniujcych
+// GLSL; domylnie wyczone - kosztowne przy programowej rasteryzacji)
+
+void DynamicResolutionSharpen(bool enable);
+bool DynamicResolutionSharpened();
+
+// budet czasu ramki [ms] (domylnie 1000 / 60)
+
+void DynamicResolutionBudget(double milliseconds);
+
+// rozmiary okna; wywoywana w funkcji obsugi zmiany rozmiaru okna
+
+void DynamicResolutionReshape(int width, int height);
+
+// pocztek sceny (przed glClear) - rysowanie do bufora ramki w obszarze
+// zmniejszonym o biec skal; koniec sceny - powikszenie obrazu do okna,
+// dobr skali na podstawie zakoczonych pomiarw i przywrcenie obszaru
+// renderingu caego okna; DynamicResolutionEnd nie zmienia pozostaego
+// stanu OpenGL
+
+void DynamicResolutionBegin();
+void DynamicResolutionEnd();
+
+// bieca skala rozdzielczoci sceny (1 - pena rozdzielczo okna)
+
+GLfloat DynamicResolutionScale();
+
+#endif // __DYNAMIC_RESOLUTION__H__
@@ -0,0 +1,301 @@
+#ifndef __SOFT_GL__H__
+#define __SOFT_GL__H__
+
+#include <GL/glut.h>
+#include <GL/glext.h>
+
+// programowa implementacja podzbioru OpenGL 1.5 uywanego przez programy
+// (rysowanie bez karty graficznej, np. na serwerach bez GPU): prymitywy
+// GL_POINTS, GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS,
+// GL_QUAD_STRIP i GL_POLYGON (glBegin/glEnd, listy wywietlania, tablice
+// wierzchokw i obiekty buforowe), przeksztacenia i stosy macierzy,
+// obcinanie, odrzucanie cian, przesunicie wartoci gbi, owietlenie
+// w wierzchokach (do 8 wiate, materiay, GL_COLOR_MATERIAL, owietlenie
+// dwustronne), tekstury 1D i 2D z mipmapami (GL_GENERATE_MIPMAP,
+// gluBuild1DMipmaps/gluBuild2DMipmaps), tryby GL_REPLACE i GL_MODULATE,
+// mga, test alfa, test gbokoci, mieszanie kolorw, glPushAttrib
+// i glPopAttrib, glReadPixels, glCopyTexSubImage2D; rasteryzacj wykonuje
+// modu soft_raster (kafelki rysowane rwnolegle, wynik niezaleny od
+// liczby wtkw)
+//
+// odcinki (GL_LINES, GL_LINE_STRIP, GL_LINE_LOOP), mapy bitowe, programy
+// cieniujce i bufor szablonowy nie s obsugiwane - wywoania s
+// pomijane z jednorazowym komunikatem
+//
+// wczenie: kompilacja wszystkich plikw programu z symbolem SOFT_GL
+// i z tym plikiem doczanym na pocztku kadego pliku (g++ -DSOFT_GL
+// -include soft_gl.h, w Visual Studio: msbuild /p:SoftGL=true) - makra
+// poniej zastpuj wywoania funkcji OpenGL, GLU i pobieranie wskanikw
+// na funkcje rozszerze; program dziaa wtedy zawsze w trybie bez okna
+// (modu headless), a liczb wtkw rasteryzacji okrela opcja --threads
+
+// utworzenie bufora ramki width x height i wtkw rasteryzacji
+// (threads <= 0 - liczba rdzeni procesora); zwraca false przy bdzie
+
+bool SoftInit(int width, int height, int threads);
+
+// zatrzymanie wtkw rasteryzacji
+
+void SoftFree();
+
+// odpowiedniki glXGetProcAddressARB/wglGetProcAddress (funkcje obiektw
+// buforowych; dla pozostaych nazw NULL) i glutExtensionSupported
+
+extern "C" void (*SoftGetProcAddress(const GLubyte *name))(void);
+int SoftExtensionSupported(const char *name);
+
+// funkcje zastpujce funkcje OpenGL i GLU
+
+void APIENTRY sglBegin(GLenum mode);
+void APIENTRY sglEnd();
+void APIENTRY sglVertex2f(GLfloat x, GLfloat y);
+void APIENTRY sglVertex2i(GLint x, GLint y);
+void APIENTRY sglVertex3f(GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY sglVertex3fv(const GLfloat *v);
+void APIENTRY sglVertex3d(GLdouble x, GLdouble y, GLdouble z);
+void APIENTRY sglVertex3dv(const GLdouble *v);
+void APIENTRY sglTexCoord1f(GLfloat s);
+void APIENTRY sglTexCoord2f(GLfloat s, GLfloat t);
+void APIENTRY sglTexCoord2fv(const GLfloat *v);
+void APIENTRY sglColor3f(GLfloat red, GLfloat green, GLfloat blue);
+void APIENTRY sglColor3fv(const GLfloat *v);
+void APIENTRY sglColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+void APIENTRY sglColor4fv(const GLfloat *v);
+void APIENTRY sglColor3ub(GLubyte red, GLubyte green, GLubyte blue);
+void APIENTRY sglNormal3f(GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY sglNormal3fv(const GLfloat *v);
+
+void APIENTRY sglEnable(GLenum cap);
+void APIENTRY sglDisable(GLenum cap);
+GLboolean APIENTRY sglIsEnabled(GLenum cap);
+void APIENTRY sglEnableClientState(GLenum array);
+void APIENTRY sglDisableClientState(GLenum array);
+
+void APIENTRY sglClear(GLbitfield mask);
+void APIENTRY sglClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void APIENTRY sglClearDepth(GLclampd depth);
+void APIENTRY sglViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void APIENTRY sglDepthRange(GLclampd near_value, GLclampd far_value);
+
+void APIENTRY sglMatrixMode(GLenum mode);
+void APIENTRY sglLoadIdentity();
+void APIENTRY sglLoadMatrixf(const GLfloat *m);
+void APIENTRY sglLoadMatrixd(const GLdouble *m);
+void APIENTRY sglMultMatrixf(const GLfloat *m);
+void APIENTRY sglMultMatrixd(const GLdouble *m);
+void APIENTRY sglPushMatrix();
+void APIENTRY sglPopMatrix();
+void APIENTRY sglTranslatef(GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY sglTranslated(GLdouble x, GLdouble y, GLdouble z);
+void APIENTRY sglRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY sglRotated(GLdouble angle, GLdouble x, GLdouble y, GLdouble z);
+void APIENTRY sglScalef(GLfloat x, GLfloat y, GLfloat z);
+void APIENTRY sglScaled(GLdouble x, GLdouble y, GLdouble z);
+void APIENTRY sglFrustum(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_value,
+	GLdouble far_value);
+void APIENTRY sglOrtho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_value,
+	GLdouble far_value);
+void APIENTRY sgluPerspective(GLdouble fovy, GLdouble aspect, GLdouble near_value, GLdouble far_value);
+void APIENTRY sgluLookAt(GLdouble eye_x, GLdouble eye_y, GLdouble eye_z, GLdouble center_x, GLdouble center_y,
+	GLdouble center_z, GLdouble up_x, GLdouble up_y, GLdouble up_z);
+void APIENTRY sgluOrtho2D(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top);
+
+void APIENTRY sglGenTextures(GLsizei n, GLuint *textures);
+void APIENTRY sglDeleteTextures(GLsizei n, const GLuint *textures);
+void APIENTRY sglBindTexture(GLenum target, GLuint texture);
+void APIENTRY sglTexImage1D(GLenum target, GLint level, GLint internal_format, GLsizei width, GLint border,
+	GLenum format, GLenum type, const GLvoid *pixels);
+void APIENTRY sglTexImage2D(GLenum target, GLint level, GLint internal_format, GLsizei width, GLsizei height,
+	GLint border, GLenum format, GLenum type, const GLvoid *pixels);
+void APIENTRY sglTexParameteri(GLenum target, GLenum pname, GLint param);
+void APIENTRY sglTexParameterf(GLenum target, GLenum pname, GLfloat param);
+void APIENTRY sglGetTexParameteriv(GLenum target, GLenum pname, GLint *params);
+void APIENTRY sglTexEnvi(GLenum target, GLenum pname, GLint param);
+void APIENTRY sglTexEnvf(GLenum target, GLenum pname, GLfloat param);
+GLint APIENTRY sgluBuild1DMipmaps(GLenum target, GLint internal_format, GLsizei width, GLenum format, GLenum type,
+	const void *data);
+GLint APIENTRY sgluBuild2DMipmaps(GLenum target, GLint internal_format, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const void *data);
+void APIENTRY sglCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y,
+	GLsizei width, GLsizei height);
+void APIENTRY sglPixelStorei(GLenum pname, GLint param);
+
+void APIENTRY sglHint(GLenum target, GLenum mode);
+void APIENTRY sglAlphaFunc(GLenum func, GLclampf ref);
+void APIENTRY sglBlendFunc(GLenum sfactor, GLenum dfactor);
+void APIENTRY sglDepthFunc(GLenum func);
+void APIENTRY sglDepthMask(GLboolean flag);
+void APIENTRY sglCullFace(GLenum mode);
+void APIENTRY sglFrontFace(GLenum mode);
+void APIENTRY sglPolygonOffset(GLfloat factor, GLfloat units);
+void APIENTRY sglShadeModel(GLenum mode);
+void APIENTRY sglPointSize(GLfloat size);
+void APIENTRY sglLineWidth(GLfloat width);
+
+void APIENTRY sglFogf(GLenum pname, GLfloat param);
+void APIENTRY sglFogfv(GLenum pname, const GLfloat *params);
+void APIENTRY sglFogi(GLenum pname, GLint param);
+void APIENTRY sglLightf(GLenum light, GLenum pname, GLfloat param);
+void APIENTRY sglLightfv(GLenum light, GLenum pname, const GLfloat *params);
+void APIENTRY sglLightModelf(GLenum pname, GLfloat param);
+void APIENTRY sglLightModelfv(GLenum pname, const GLfloat *params);
+void APIENTRY sglLightModeli(GLenum pname, GLint param);
+void APIENTRY sglMaterialf(GLenum face, GLenum pname, GLfloat param);
+void APIENTRY sglMaterialfv(GLenum face, GLenum pname, const GLfloat *params);
+void APIENTRY sglColorMaterial(GLenum face, GLenum mode);
+
+GLuint APIENTRY sglGenLists(GLsizei range);
+void APIENTRY sglNewList(GLuint list, GLenum mode);
+void APIENTRY sglEndList();
+void APIENTRY sglCallList(GLuint list);
+void APIENTRY sglDeleteLists(GLuint list, GLsizei range);
+
+void APIENTRY sglVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+void APIENTRY sglTexCoordPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+void APIENTRY sglColorPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+void APIENTRY sglNormalPointer(GLenum type, GLsizei stride, const GLvoid *pointer);
+void APIENTRY sglDrawArrays(GLenum mode, GLint first, GLsizei count);
+void APIENTRY sglDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices);
+
+void APIENTRY sglPushAttrib(GLbitfield mask);
+void APIENTRY sglPopAttrib();
+void APIENTRY sglPushClientAttrib(GLbitfield mask);
+void APIENTRY sglPopClientAttrib();
+
+void APIENTRY sglReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+	GLvoid *pixels);
+const GLubyte *APIENTRY sglGetString(GLenum name);
+void APIENTRY sglGetIntegerv(GLenum pname, GLint *params);
+void APIENTRY sglGetFloatv(GLenum pname, GLfloat *params);
+GLenum APIENTRY sglGetError();
+void APIENTRY sglFlush();
+void APIENTRY sglFinish();
+
+#ifdef SOFT_GL
+
+#define glBegin sglBegin
+#define glEnd sglEnd
+#define glVertex2f sglVertex2f
+#define glVertex2i sglVertex2i
+#define glVertex3f sglVertex3f
+#define glVertex3fv sglVertex3fv
+#define glVertex3d sglVertex3d
+#define glVertex3dv sglVertex3dv
+#define glTexCoord1f sglTexCoord1f
+#define glTexCoord2f sglTexCoord2f
+#define glTexCoord2fv sglTexCoord2fv
+#define glColor3f sglColor3f
+#define glColor3fv sglColor3fv
+#define glColor4f sglColor4f
+#define glColor4fv sglColor4fv
+#define glColor3ub sglColor3ub
+#define glNormal3f sglNormal3f
+#define glNormal3fv sglNormal3fv
+
+#define glEnable sglEnable
+#define glDisable sglDisable
+#define glIsEnabled sglIsEnabled
+#define glEnableClientState sglEnableClientState
+#define glDisableClientState sglDisableClientState
+
+#define glClear sglClear
+#define glClearColor sglClearColor
+#define glClearDepth sglClearDepth
+#define glViewport sglViewport
+#define glDepthRange sglDepthRange
+
+#define glMatrixMode sglMatrixMode
+#define glLoadIdentity sglLoadIdentity
+#define glLoadMatrixf sglLoadMatrixf
+#define glLoadMatrixd sglLoadMatrixd
+#define glMultMatrixf sglMultMatrixf
+#define glMultMatrixd sglMultMatrixd
+#define glPushMatrix sglPushMatrix
+#define glPopMatrix sglPopMatrix
+#define glTranslatef sglTranslatef
+#define glTranslated sglTranslated
+#define glRotatef sglRotatef
+#define glRotated sglRotated
+#define glScalef sglScalef
+#define glScaled sglScaled
+#define glFrustum sglFrustum
+#define glOrtho sglOrtho
+#define gluPerspective sgluPerspective
+#define gluLookAt sgluLookAt
+#define gluOrtho2D sgluOrtho2D
+
+#define glGenTextures sglGenTextures
+#define glDeleteTextures sglDeleteTextures
+#define glBindTexture sglBindTexture
+#define glTexImage1D sglTexImage1D
+#define glTexImage2D sglTexImage2D
+#define glTexParameteri sglTexParameteri
+#define glTexParameterf sglTexParameterf
+#define glGetTexParameteriv sglGetTexParameteriv
+#define glTexEnvi sglTexEnvi
+#define glTexEnvf sglTexEnvf
+#define gluBuild1DMipmaps sgluBuild1DMipmaps
+#define gluBuild2DMipmaps sgluBuild2DMipmaps
+#define glCopyTexSubImage2D sglCopyTexSubImage2D
+#define glPixelStorei sglPixelStorei
+
+#define glHint sglHint
+#define glAlphaFunc sglAlphaFunc
+#define glBlendFunc sglBlendFunc
+#define glDepthFunc sglDepthFunc
+#define glDepthMask sglDepthMask
+#define glCullFace sglCullFace
+#define glFrontFace sglFrontFace
+#define glPolygonOffset sglPolygonOffset
+#define glShadeModel sglShadeModel
+#define glPointSize sglPointSize
+#define glLineWidth sglLineWidth
+
+#define glFogf sglFogf
+#define glFogfv sglFogfv
+#define glFogi sglFogi
+#define glLightf sglLightf
+#define glLightfv sglLightfv
+#define glLightModelf sglLightModelf
+#define glLightModelfv sglLightModelfv
+#define glLightModeli sglLightModeli
+#define glMaterialf sglMaterialf
+#define glMaterialfv sglMaterialfv
+#define glColorMaterial sglColorMaterial
+
+#define glGenLists sglGenLists
+#define glNewList sglNewList
+#define glEndList sglEndList
+#define glCallList sglCallList
+#define glDeleteLists sglDeleteLists
+
+#define glVertexPointer sglVertexPointer
+#define glTexCoordPointer sglTexCoordPointer
+#define glColorPointer sglColorPointer
+#define glNormalPointer sglNormalPointer
+#define glDrawArrays sglDrawArrays
+#define glDrawElements sglDrawElements
+
+#define glPushAttrib sglPushAttrib
+#define glPopAttrib sglPopAttrib
+#define glPushClientAttrib sglPushClientAttrib
+#define glPopClientAttrib sglPopClientAttrib
+
+#define glReadPixels sglReadPixels
+#define glGetString sglGetString
+#define glGetIntegerv sglGetIntegerv
+#define glGetFloatv sglGetFloatv
+#define glGetError sglGetError
+#define glFlush sglFlush
+#define glFinish sglFinish
+
+#define glutExtensionSupported SoftExtensionSupported
+#ifdef _WIN32
+#define wglGetProcAddress(name) SoftGetProcAddress((const GLubyte*)(name))
+#else
+#define glXGetProcAddressARB SoftGetProcAddress
+#endif
+
+#endif // SOFT_GL
+
+#endif // __SOFT_GL__H__
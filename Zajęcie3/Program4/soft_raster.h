@@ -0,0 +1,125 @@
+#ifndef __SOFT_RASTER__H__
+#define __SOFT_RASTER__H__
+
+#include <GL/glut.h>
+#include <vector>
+
+// rasteryzator programowy (CPU) - zaplecze moduu soft_gl: bufor ramki
+// podzielony jest na kafelki (RASTER_TILE x RASTER_TILE pikseli), trjkty
+// i punkty po przygotowaniu (rwnania krawdzi i paszczyzny atrybutw) s
+// przypisywane do kafelkw, ktre pokrywaj, a przy RasterFlush kafelki
+// s rasteryzowane rwnolegle przez zadan liczb wtkw; funkcje krawdzi,
+// gbia i atrybuty s liczone dla 4 ssiednich pikseli naraz (SSE, bez
+// SSE - obliczenia skalarne w tej samej kolejnoci)
+//
+// wynik nie zaley od liczby wtkw: kady kafelek rysuje jeden wtek,
+// w kolejnoci przekazania prymityww, a obliczenia dla piksela s
+// identyczne niezalenie od podziau pracy - obrazy mog wic suy
+// jako obrazy wzorcowe
+//
+// operacje na fragmentach (w kolejnoci OpenGL): teksturowanie
+// (GL_REPLACE/GL_MODULATE, tekstury 1D/2D z filtrami GL_NEAREST/GL_LINEAR
+// i mipmapami), mga (GL_LINEAR/GL_EXP/GL_EXP2), test alfa, test gbokoci,
+// mieszanie kolorw; bufor koloru RGB (bez kanau alfa, jak GLUT_RGB)
+// i bufor gbokoci (float)
+
+// rozmiar kafelka w pikselach (wielokrotno 4)
+
+const int RASTER_TILE = 64;
+
+// poziom szczegowoci tekstury - teksele RGBA8 (bajty R, G, B, A)
+
+struct RasterLevel
+{
+	int width = 0, height = 0;
+	std::vector<GLuint> texels;
+};
+
+// tekstura; brakujce skadowe formatu bazowego maj w tekselach warto
+// 255, wic w trybie GL_MODULATE wystarczy mnoenie wszystkich skadowych
+
+struct RasterTexture
+{
+	std::vector<RasterLevel> levels;          // level[0] - obraz podstawowy
+	bool has_color = true;                    // format z kolorem (nie GL_ALPHA)
+	bool has_alpha = false;                   // format z kanaem alfa
+	GLenum min_filter = GL_NEAREST_MIPMAP_LINEAR;
+	GLenum mag_filter = GL_LINEAR;
+	GLenum wrap_s = GL_REPEAT, wrap_t = GL_REPEAT;
+	int dimensions = 2;                       // 1 - tekstura 1D (bez wsprzdnej t)
+};
+
+// stan potoku fragmentw obowizujcy dla kolejnych prymityww
+
+struct RasterState
+{
+	bool depth_test = false;
+	GLenum depth_func = GL_LESS;
+	bool depth_mask = true;
+	bool alpha_test = false;
+	GLenum alpha_func = GL_ALWAYS;
+	GLfloat alpha_ref = 0.0f;
+	bool blend = false;
+	GLenum blend_src = GL_ONE, blend_dst = GL_ZERO;
+	const RasterTexture *texture = NULL;      // NULL - bez teksturowania
+	GLenum texture_env = GL_MODULATE;
+	bool fog = false;
+	GLenum fog_mode = GL_EXP;
+	GLfloat fog_density = 1.0f, fog_start = 0.0f, fog_end = 1.0f;
+	GLfloat fog_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	bool polygon_offset = false;
+	GLfloat offset_factor = 0.0f, offset_units = 0.0f;
+};
+
+// wierzchoek we wsprzdnych okna: x, y - piksele (od lewego dolnego
+// naronika), z - gbia [0, 1], q = 1 / w we wsprzdnych obcinania
+// (do interpolacji z korekcj perspektywy); kolor, wsprzdne tekstury
+// i wsprzdna mgy (odlego od obserwatora)
+
+struct RasterVertex
+{
+	GLfloat x, y, z, q;
+	GLfloat color[4];
+	GLfloat s, t;
+	GLfloat fog;
+};
+
+// utworzenie bufora ramki i wtkw; threads <= 0 - liczba rdzeni procesora;
+// zwraca false przy bdnych rozmiarach
+
+bool RasterInit(int width, int height, int threads);
+
+// zatrzymanie wtkw i zwolnienie buforw
+
+void RasterFree();
+
+// liczba wtkw rasteryzacji (z wtkiem wywoujcym RasterFlush)
+
+int RasterThreads();
+
+// stan dla kolejnych prymityww (kopiowany; tekstura nie moe si
+// zmieni przed RasterFlush)
+
+void RasterSetState(const RasterState &state);
+
+// wyczyszczenie bufora koloru i/lub gbokoci
+
+void RasterClear(bool color, const GLfloat *clear_color, bool depth, GLfloat clear_depth);
+
+// trjkt (w dowolnej kolejnoci wierzchokw - odrzucanie cian odbywa
+// si wczeniej) i punkt o boku size pikseli
+
+void RasterTriangle(const RasterVertex &a, const RasterVertex &b, const RasterVertex &c);
+void RasterPoint(const RasterVertex &v, GLfloat size);
+
+// narysowanie przekazanych prymityww (wszystkie kafelki, rwnolegle)
+
+void RasterFlush();
+
+// odczyt prostokta bufora koloru (po RasterFlush) w formacie GL_RGB,
+// GL_BGR, GL_RGBA lub GL_BGRA (GL_UNSIGNED_BYTE), wiersze od dou
+// wyrwnane do alignment bajtw
+
+void RasterReadPixels(int x, int y, int width, int height, GLenum format, int alignment, GLubyte *pixels);
+
+#endif // __SOFT_RASTER__H__
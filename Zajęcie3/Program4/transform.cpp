@@ -0,0 +1,186 @@
+#define _USE_MATH_DEFINES
+#include "transform.h"
+#include <math.h>
+#include <string.h>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define TRANSFORM_SSE
+#endif
+
+Matrix MatrixIdentity()
+{
+	Matrix result;
+	memset(result.m, 0, sizeof(result.m));
+	result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+	return result;
+}
+
+Matrix MatrixTranslation(GLfloat x, GLfloat y, GLfloat z)
+{
+	Matrix result = MatrixIdentity();
+	result.m[12] = x;
+	result.m[13] = y;
+	result.m[14] = z;
+	return result;
+}
+
+// macierz obrotu wok osi (x, y, z) wedug specyfikacji glRotate
+
+Matrix MatrixRotation(GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+{
+	Matrix result = MatrixIdentity();
+	const GLfloat length = sqrtf(x * x + y * y + z * z);
+	if (length == 0.0f)
+		return result;
+	x /= length;
+	y /= length;
+	z /= length;
+	const GLfloat radians = (GLfloat)(angle * M_PI / 180.0);
+	const GLfloat c = cosf(radians), s = sinf(radians), t = 1.0f - c;
+	result.m[0] = x * x * t + c;
+	result.m[1] = y * x * t + z * s;
+	result.m[2] = x * z * t - y * s;
+	result.m[4] = x * y * t - z * s;
+	result.m[5] = y * y * t + c;
+	result.m[6] = y * z * t + x * s;
+	result.m[8] = x * z * t + y * s;
+	result.m[9] = y * z * t - x * s;
+	result.m[10] = z * z * t + c;
+	return result;
+}
+
+Matrix MatrixScaling(GLfloat x, GLfloat y, GLfloat z)
+{
+	Matrix result = MatrixIdentity();
+	result.m[0] = x;
+	result.m[5] = y;
+	result.m[10] = z;
+	return result;
+}
+
+// kolumna j iloczynu to kombinacja liniowa kolumn a o wspczynnikach
+// z kolumny j macierzy b - jedna kolumna w rejestrze SSE
+
+Matrix MatrixMultiply(const Matrix &a, const Matrix &b)
+{
+	Matrix result;
+#ifdef TRANSFORM_SSE
+	const __m128 a0 = _mm_loadu_ps(a.m), a1 = _mm_loadu_ps(a.m + 4), a2 = _mm_loadu_ps(a.m + 8),
+		a3 = _mm_loadu_ps(a.m + 12);
+	for (int j = 0; j < 4; j++)
+	{
+		const GLfloat *column = b.m + 4 * j;
+		__m128 sum = _mm_mul_ps(a0, _mm_set1_ps(column[0]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(a1, _mm_set1_ps(column[1])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(a2, _mm_set1_ps(column[2])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(a3, _mm_set1_ps(column[3])));
+		_mm_storeu_ps(result.m + 4 * j, sum);
+	}
+#else
+	for (int j = 0; j < 4; j++)
+		for (int i = 0; i < 4; i++)
+			result.m[4 * j + i] = a.m[i] * b.m[4 * j] + a.m[4 + i] * b.m[4 * j + 1] +
+				a.m[8 + i] * b.m[4 * j + 2] + a.m[12 + i] * b.m[4 * j + 3];
+#endif
+	return result;
+}
+
+void MatrixMultiply(const Matrix &a, const Matrix *b, Matrix *result, int count)
+{
+	for (int i = 0; i < count; i++)
+		result[i] = MatrixMultiply(a, b[i]);
+}
+
+void MatrixStackPush(MatrixStack &stack)
+{
+	stack.matrices.push_back(stack.matrices.back());
+}
+
+void MatrixStackPop(MatrixStack &stack)
+{
+	if (stack.matrices.size() > 1)
+		stack.matrices.pop_back();
+}
+
+void MatrixStackLoad(MatrixStack &stack, const Matrix &matrix)
+{
+	stack.matrices.back() = matrix;
+}
+
+void MatrixStackMultiply(MatrixStack &stack, const Matrix &matrix)
+{
+	stack.matrices.back() = MatrixMultiply(stack.matrices.back(), matrix);
+}
+
+const Matrix &MatrixStackTop(const MatrixStack &stack)
+{
+	return stack.matrices.back();
+}
+
+int TransformAdd(TransformHierarchy &hierarchy, int parent, const Matrix &local)
+{
+	TransformNode node;
+	node.parent = parent;
+	node.local = local;
+	node.world = local;
+	node.changed = true;
+	node.updated = false;
+	hierarchy.nodes.push_back(node);
+	return (int)hierarchy.nodes.size() - 1;
+}
+
+void TransformSet(TransformHierarchy &hierarchy, int node, const Matrix &local)
+{
+	TransformNode &n = hierarchy.nodes[node];
+	if (memcmp(n.local.m, local.m, sizeof(local.m)) == 0)
+		return;
+	n.local = local;
+	n.changed = true;
+}
+
+void TransformUpdate(TransformHierarchy &hierarchy)
+{
+	for (size_t i = 0; i < hierarchy.nodes.size(); i++)
+	{
+		TransformNode &node = hierarchy.nodes[i];
+		const TransformNode *parent = node.parent >= 0 ? &hierarchy.nodes[node.parent] : NULL;
+		node.updated = node.changed || (parent && parent->updated);
+		node.changed = false;
+		if (!node.updated)
+		{
+			hierarchy.stats.cached++;
+			continue;
+		}
+		node.world = parent ? MatrixMultiply(parent->world, node.local) : node.local;
+		hierarchy.stats.updated++;
+	}
+	hierarchy.loaded = -1;
+}
+
+const Matrix &TransformWorld(const TransformHierarchy &hierarchy, int node)
+{
+	return hierarchy.nodes[node].world;
+}
+
+void TransformLoad(TransformHierarchy &hierarchy, int node)
+{
+	if (hierarchy.loaded == node)
+	{
+		hierarchy.stats.skipped++;
+		return;
+	}
+	glLoadMatrixf(hierarchy.nodes[node].world.m);
+	hierarchy.loaded = node;
+	hierarchy.stats.loads++;
+}
+
+void TransformFrameEnd(TransformHierarchy &hierarchy)
+{
+	hierarchy.last_stats = hierarchy.stats;
+	hierarchy.stats = TransformStats();
+}
+
+const TransformStats &TransformLastFrame(const TransformHierarchy &hierarchy)
+{
+	return hierarchy.last_stats;
+}
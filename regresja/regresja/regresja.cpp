@@ -0,0 +1,568 @@
+// test regresji obrazu i wydajnoci scen rysowanych w trybie bez okna
+//
+// kada scena z pliku opisu (domylnie sceny.txt) jest uruchamiana z opcj
+// --headless; zapisane ramki (stae pooenia kamery ze scenariusza sceny)
+// s porwnywane z obrazami wzorcowymi TGA (PSNR i odsetek pikseli, ktrych
+// skadowa rni si o wicej ni zadany prg), a czasy ramek z pliku CSV
+// pomiaru (profiler) - z zapisanymi czasami bazowymi; z opcj --update
+// biece ramki i czasy staj si wzorcem (wzorce zale od sterownika
+// OpenGL i komputera, dlatego s tworzone lokalnie przed zmian kodu)
+//
+// opcje:
+// --scenes=PLIK       plik opisu scen (domylnie sceny.txt)
+// --golden=KATALOG    katalog obrazw wzorcowych (domylnie golden)
+// --output=KATALOG    katalog biecych ramek i raportu (domylnie wyniki)
+// --baseline=PLIK     plik czasw bazowych (domylnie baseline.txt)
+// --psnr=DB           najmniejszy dopuszczalny PSNR (domylnie 40)
+// --delta=N           prg rnicy skadowej piksela (domylnie 16)
+// --pixels=PROCENT    dopuszczalny odsetek pikseli powyej progu (domylnie 0.1)
+// --time=PROCENT      dopuszczalny wzrost czasu ramki (domylnie 25)
+// --repeat=N          liczba uruchomie sceny - do porwnania brany jest
+//                     najkrtszy czas (domylnie 1)
+// --update            zapis wzorcw zamiast porwnania
+// pozostae argumenty - nazwy wybranych scen (domylnie wszystkie)
+//
+// kod zakoczenia: 0 - brak regresji, 1 - regresja, 2 - bd uruchomienia (take
+// brak pliku CSV pomiaru po zakoczeniu programu sceny)
+
+#define _CRT_SECURE_NO_WARNINGS
+#ifdef _WIN32
+#include <Windows.h>
+#include <direct.h>
+#else
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+#include "targa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+// pominite ramki pocztkowe (tworzenie tekstur, list wywietlania,
+// kompilacja programw cieniowania w sterowniku)
+
+const int WARMUP_FRAMES = 5;
+
+// zmiana czasu ramki poniej tej wartoci [ms] nie jest regresj
+// (szum pomiaru krtkich ramek)
+
+const double TIME_NOISE_MS = 0.25;
+
+// opis sceny - jeden wiersz pliku sceny.txt
+
+struct Scene
+{
+	std::string name;
+	std::string directory; // katalog roboczy programu (tekstury)
+	std::string program;   // program wzgldem katalogu roboczego
+	std::string csv;       // plik pomiaru zapisywany przez program
+	int frames;
+	int save_every;
+	std::string size;
+};
+
+// czasy ramek sceny [ms]; gpu < 0 - czas GPU niedostpny
+
+struct Timing
+{
+	double cpu_p50 = -1.0;
+	double cpu_p95 = -1.0;
+	double gpu_p50 = -1.0;
+};
+
+// wynik porwnania ramki z wzorcem
+
+struct ImageResult
+{
+	bool loaded = false;
+	double psnr = 0.0;
+	int max_delta = 0;
+	double pixels = 0.0; // odsetek pikseli powyej progu [%]
+};
+
+// opcje
+
+static std::string scenes_file = "sceny.txt";
+static std::string golden_dir = "golden";
+static std::string output_dir = "wyniki";
+static std::string baseline_file = "baseline.txt";
+static double min_psnr = 40.0;
+static int delta_threshold = 16;
+static double max_pixels = 0.1;
+static double max_time = 25.0;
+static int repeat = 1;
+static bool update = false;
+
+// warto opcji postaci --nazwa=warto lub NULL
+
+static const char *Option(const char *arg, const char *name)
+{
+	const size_t length = strlen(name);
+	return strncmp(arg, name, length) == 0 && arg[length] == '=' ? arg + length + 1 : NULL;
+}
+
+static void MakeDirectory(const std::string &path)
+{
+#ifdef _WIN32
+	_mkdir(path.c_str());
+#else
+	mkdir(path.c_str(), 0755);
+#endif
+}
+
+// cieka bezwzgldna (programy scen dziaaj we wasnych katalogach)
+
+static std::string AbsolutePath(const std::string &path)
+{
+	if (!path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':')))
+		return path;
+	char buffer[4096];
+#ifdef _WIN32
+	if (_getcwd(buffer, sizeof(buffer)) == NULL)
+#else
+	if (getcwd(buffer, sizeof(buffer)) == NULL)
+#endif
+		return path;
+	return std::string(buffer) + "/" + path;
+}
+
+// odczyt pliku opisu scen; wiersze: nazwa katalog program plik_CSV ramki
+// zapis_co rozmiar, znak # rozpoczyna komentarz
+
+static bool LoadScenes(const std::string &filename, std::vector<Scene> &scenes)
+{
+	FILE *file = fopen(filename.c_str(), "r");
+	if (!file)
+		return false;
+	char line[1024];
+	int number = 0;
+	while (fgets(line, sizeof(line), file))
+	{
+		number++;
+		char *comment = strchr(line, '#');
+		if (comment)
+			*comment = '\0';
+		char name[256], directory[512], program[512], csv[256], size[32];
+		Scene scene;
+		const int count = sscanf(line, "%255s %511s %511s %255s %d %d %31s", name, directory, program, csv,
+			&scene.frames, &scene.save_every, size);
+		if (count <= 0)
+			continue;
+		if (count != 7 || scene.frames < 1 || scene.save_every < 1)
+		{
+			printf("%s:%d: bledny opis sceny\n", filename.c_str(), number);
+			fclose(file);
+			return false;
+		}
+		scene.name = name;
+		scene.directory = directory;
+		scene.program = program;
+		scene.csv = csv;
+		scene.size = size;
+		scenes.push_back(scene);
+	}
+	fclose(file);
+	return true;
+}
+
+// odczyt i zapis czasw bazowych; wiersze: nazwa cpu_p50 cpu_p95 gpu_p50
+
+static void LoadBaseline(const std::string &filename, std::map<std::string, Timing> &baseline)
+{
+	FILE *file = fopen(filename.c_str(), "r");
+	if (!file)
+		return;
+	char line[512], name[256];
+	Timing timing;
+	while (fgets(line, sizeof(line), file))
+		if (line[0] != '#' && sscanf(line, "%255s %lf %lf %lf", name, &timing.cpu_p50, &timing.cpu_p95,
+			&timing.gpu_p50) == 4)
+			baseline[name] = timing;
+	fclose(file);
+}
+
+static bool SaveBaseline(const std::string &filename, const std::map<std::string, Timing> &baseline)
+{
+	FILE *file = fopen(filename.c_str(), "w");
+	if (!file)
+		return false;
+	fprintf(file, "# scena cpu_p50_ms cpu_p95_ms gpu_p50_ms\n");
+	for (std::map<std::string, Timing>::const_iterator i = baseline.begin(); i != baseline.end(); ++i)
+		fprintf(file, "%s %.4f %.4f %.4f\n", i->first.c_str(), i->second.cpu_p50, i->second.cpu_p95,
+			i->second.gpu_p50);
+	fclose(file);
+	return true;
+}
+
+// percentyl (metoda najbliszej rangi) posortowanych wartoci
+
+static double Percentile(const std::vector<double> &sorted, int p)
+{
+	if (sorted.empty())
+		return -1.0;
+	size_t rank = (sorted.size() * p + 99) / 100;
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// liczba z pola wiersza CSV; false - pole puste lub niepoprawne
+
+static bool ParseField(const char *text, double &value)
+{
+	char *end;
+	value = strtod(text, &end);
+	if (end == text)
+		return false;
+	while (*end == ' ' || *end == '\r' || *end == '\n')
+		end++;
+	return *end == '\0';
+}
+
+// czasy ramek z pliku CSV pomiaru (kolumny frame,time_ms,cpu_ms,gpu_ms,...)
+// z pominiciem ramek pocztkowych; puste pole gpu_ms (brak zapyta
+// o czas GPU) - porwnywane s wtedy tylko czasy CPU
+
+static bool LoadTiming(const std::string &filename, Timing &timing)
+{
+	FILE *file = fopen(filename.c_str(), "r");
+	if (!file)
+		return false;
+	std::vector<double> cpu, gpu;
+	char line[512];
+	while (fgets(line, sizeof(line), file))
+	{
+		// podzia na pola frame, time_ms, cpu_ms, gpu_ms i reszt wiersza
+		char *field[5];
+		int count = 0;
+		for (char *p = line; p && count < 5; count++)
+		{
+			field[count] = p;
+			p = strchr(p, ',');
+			if (p)
+				*p++ = '\0';
+		}
+		double frame, time_ms, cpu_ms, gpu_ms;
+		if (count < 3 || !ParseField(field[0], frame) || !ParseField(field[1], time_ms) ||
+			!ParseField(field[2], cpu_ms))
+			continue;
+		cpu.push_back(cpu_ms);
+		if (count > 3 && ParseField(field[3], gpu_ms) && gpu_ms >= 0.0)
+			gpu.push_back(gpu_ms);
+	}
+	fclose(file);
+
+	const size_t warmup = std::min<size_t>(WARMUP_FRAMES, cpu.size() / 2);
+	cpu.erase(cpu.begin(), cpu.begin() + warmup);
+	gpu.erase(gpu.begin(), gpu.begin() + std::min(warmup, gpu.size() / 2));
+	if (cpu.empty())
+		return false;
+	std::sort(cpu.begin(), cpu.end());
+	std::sort(gpu.begin(), gpu.end());
+	timing.cpu_p50 = Percentile(cpu, 50);
+	timing.cpu_p95 = Percentile(cpu, 95);
+	timing.gpu_p50 = Percentile(gpu, 50);
+	return true;
+}
+
+// nazwa pliku ramki frame sceny w katalogu directory (jak w HeadlessRun)
+
+static std::string FrameFile(const std::string &directory, const Scene &scene, int frame)
+{
+	char filename[64];
+	sprintf(filename, "%s_%04d.tga", scene.name.c_str(), frame);
+	return directory + "/" + filename;
+}
+
+// liczba skadowych piksela obrazu wczytanego przez load_targa
+
+static int Components(GLenum format)
+{
+	return format == GL_BGRA ? 4 : format == GL_BGR ? 3 : 1;
+}
+
+// porwnanie ramki z wzorcem: PSNR (255 - najwiksza warto skadowej),
+// najwiksza rnica skadowej i odsetek pikseli z rnic powyej progu
+
+static ImageResult CompareImages(const std::string &current, const std::string &golden)
+{
+	ImageResult result;
+	GLsizei width[2], height[2];
+	GLenum format[2], type[2];
+	GLvoid *pixels[2];
+	load_targa(current.c_str(), width[0], height[0], format[0], type[0], pixels[0]);
+	load_targa(golden.c_str(), width[1], height[1], format[1], type[1], pixels[1]);
+	if (pixels[0] && pixels[1] && width[0] == width[1] && height[0] == height[1] && format[0] == format[1])
+	{
+		const unsigned char *a = (const unsigned char*)pixels[0];
+		const unsigned char *b = (const unsigned char*)pixels[1];
+		const int components = Components(format[0]);
+		const int count = width[0] * height[0];
+		double squares = 0.0;
+		int above = 0;
+		for (int i = 0; i < count; i++)
+		{
+			int pixel_delta = 0;
+			for (int c = 0; c < components; c++)
+			{
+				const int delta = abs(a[i * components + c] - b[i * components + c]);
+				squares += delta * delta;
+				pixel_delta = std::max(pixel_delta, delta);
+			}
+			result.max_delta = std::max(result.max_delta, pixel_delta);
+			if (pixel_delta > delta_threshold)
+				above++;
+		}
+		const double mse = squares / ((double)count * components);
+		result.psnr = mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : INFINITY;
+		result.pixels = count > 0 ? 100.0 * above / count : 0.0;
+		result.loaded = true;
+	}
+	delete[](unsigned char*)pixels[0];
+	delete[](unsigned char*)pixels[1];
+	return result;
+}
+
+static bool CopyGolden(const std::string &source, const std::string &destination)
+{
+	FILE *in = fopen(source.c_str(), "rb");
+	if (!in)
+		return false;
+	FILE *out = fopen(destination.c_str(), "wb");
+	if (!out)
+	{
+		fclose(in);
+		return false;
+	}
+	char buffer[65536];
+	size_t size;
+	bool ok = true;
+	while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0)
+		ok = ok && fwrite(buffer, 1, size, out) == size;
+	fclose(in);
+	fclose(out);
+	return ok;
+}
+
+// uruchomienie programu sceny w trybie bez okna; ramki trafiaj do katalogu
+// wynikw, plik CSV pomiaru - do katalogu roboczego programu
+
+static bool RunScene(const Scene &scene, const std::string &output)
+{
+	char options[256];
+	sprintf(options, " --headless --frames=%d --save-every=%d --size=%s", scene.frames, scene.save_every,
+		scene.size.c_str());
+	std::string command = "cd \"" + scene.directory + "\" && \"" + scene.program + "\"" + options +
+		" --output=\"" + output + "/" + scene.name + "\"";
+#ifdef _WIN32
+	command = "\"" + command + " > NUL\"";
+#else
+	command += " > /dev/null";
+#endif
+	// usunicie pliku pomiaru poprzedniego uruchomienia
+	remove((scene.directory + "/" + scene.csv).c_str());
+	return system(command.c_str()) == 0;
+}
+
+// procentowa zmiana wartoci wzgldem bazowej
+
+static double Change(double current, double base)
+{
+	return base > 0.0 ? 100.0 * (current - base) / base : 0.0;
+}
+
+// wzrost czasu powyej dopuszczalnego (i powyej szumu pomiaru); porwnywane
+// s mediany - p95 kilkudziesiciu ramek jest zbyt zmienny
+
+static bool Slower(double current, double base)
+{
+	return current >= 0.0 && base > 0.0 && current - base > TIME_NOISE_MS && Change(current, base) > max_time;
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<std::string> selected;
+	for (int i = 1; i < argc; i++)
+	{
+		const char *value;
+		if ((value = Option(argv[i], "--scenes")) != NULL)
+			scenes_file = value;
+		else if ((value = Option(argv[i], "--golden")) != NULL)
+			golden_dir = value;
+		else if ((value = Option(argv[i], "--output")) != NULL)
+			output_dir = value;
+		else if ((value = Option(argv[i], "--baseline")) != NULL)
+			baseline_file = value;
+		else if ((value = Option(argv[i], "--psnr")) != NULL)
+			min_psnr = atof(value);
+		else if ((value = Option(argv[i], "--delta")) != NULL)
+			delta_threshold = atoi(value);
+		else if ((value = Option(argv[i], "--pixels")) != NULL)
+			max_pixels = atof(value);
+		else if ((value = Option(argv[i], "--time")) != NULL)
+			max_time = atof(value);
+		else if ((value = Option(argv[i], "--repeat")) != NULL)
+			repeat = std::max(1, atoi(value));
+		else if (strcmp(argv[i], "--update") == 0)
+			update = true;
+		else if (argv[i][0] == '-')
+		{
+			printf("Nieznana opcja %s\n", argv[i]);
+			return 2;
+		}
+		else
+			selected.push_back(argv[i]);
+	}
+
+	std::vector<Scene> scenes;
+	if (!LoadScenes(scenes_file, scenes))
+	{
+		printf("Nie mozna odczytac opisu scen %s\n", scenes_file.c_str());
+		return 2;
+	}
+	std::map<std::string, Timing> baseline;
+	LoadBaseline(baseline_file, baseline);
+
+	MakeDirectory(output_dir);
+	MakeDirectory(golden_dir);
+	const std::string output = AbsolutePath(output_dir);
+
+	// raport CSV z wynikami kadej ramki i czasami kadej sceny
+	FILE *report = fopen((output_dir + "/raport.csv").c_str(), "w");
+	if (report)
+		fprintf(report, "scena,ramka,psnr_db,max_delta,piksele_proc,cpu_p50_ms,cpu_p95_ms,gpu_p50_ms,wynik\n");
+
+	int run = 0, visual = 0, performance = 0, errors = 0;
+	printf("%-12s %6s %9s %6s %8s   %s\n", "scena", "ramka", "PSNR[dB]", "delta", "piksele", "wynik");
+	for (size_t s = 0; s < scenes.size(); s++)
+	{
+		const Scene &scene = scenes[s];
+		if (!selected.empty() && std::find(selected.begin(), selected.end(), scene.name) == selected.end())
+			continue;
+		run++;
+
+		// najkrtsze czasy z kilku uruchomie (ramki s za kadym razem takie same)
+		// program, ktry zakoczy si bez zapisania pomiaru (np. brak pliku
+		// tekstury - programy kocz wtedy prac z kodem 0), to bd sceny
+		Timing timing;
+		bool ran = true, measured = true;
+		for (int r = 0; r < repeat && ran && measured; r++)
+		{
+			Timing current;
+			ran = RunScene(scene, output);
+			measured = ran && LoadTiming(scene.directory + "/" + scene.csv, current);
+			if (measured && (timing.cpu_p50 < 0.0 || current.cpu_p50 < timing.cpu_p50))
+				timing = current;
+		}
+		if (!ran || !measured)
+		{
+			if (!ran)
+				printf("%-12s nie mozna uruchomic %s w katalogu %s\n", scene.name.c_str(), scene.program.c_str(),
+					scene.directory.c_str());
+			else
+				printf("%-12s BLAD: %s nie zapisal pliku pomiaru %s w katalogu %s\n", scene.name.c_str(),
+					scene.program.c_str(), scene.csv.c_str(), scene.directory.c_str());
+			if (report)
+				fprintf(report, "%s,,,,,,,,blad\n", scene.name.c_str());
+			errors++;
+			continue;
+		}
+
+		// ramki ze staymi pooeniami kamery
+		for (int frame = 0; frame < scene.frames; frame += scene.save_every)
+		{
+			const std::string current = FrameFile(output, scene, frame);
+			const std::string golden = FrameFile(golden_dir, scene, frame);
+			const char *status;
+			ImageResult result;
+			if (update)
+			{
+				status = "wzorzec";
+				if (!CopyGolden(current, golden))
+				{
+					status = "blad";
+					errors++;
+				}
+			}
+			else
+			{
+				result = CompareImages(current, golden);
+				if (!result.loaded)
+				{
+					status = "brak wzorca";
+					errors++;
+				}
+				else if (result.psnr < min_psnr || result.pixels > max_pixels)
+				{
+					status = "REGRESJA";
+					visual++;
+				}
+				else
+					status = "ok";
+			}
+			if (result.loaded)
+				printf("%-12s %6d %9.2f %6d %7.3f%%   %s\n", scene.name.c_str(), frame, result.psnr,
+					result.max_delta, result.pixels, status);
+			else
+				printf("%-12s %6d %9s %6s %8s   %s\n", scene.name.c_str(), frame, "-", "-", "-", status);
+			if (report)
+				fprintf(report, "%s,%d,%.2f,%d,%.4f,,,,%s\n", scene.name.c_str(), frame, result.psnr,
+					result.max_delta, result.pixels, status);
+		}
+
+		// czasy ramek wzgldem bazowych
+		const char *status = "ok";
+		std::map<std::string, Timing>::const_iterator base = baseline.find(scene.name);
+		if (update)
+		{
+			baseline[scene.name] = timing;
+			status = "bazowy";
+		}
+		else if (base == baseline.end())
+			status = "brak czasu bazowego";
+		else if (Slower(timing.cpu_p50, base->second.cpu_p50) || Slower(timing.gpu_p50, base->second.gpu_p50))
+		{
+			status = "REGRESJA";
+			performance++;
+		}
+		printf("%-12s czas CPU p50 %.3f ms, p95 %.3f ms", scene.name.c_str(), timing.cpu_p50, timing.cpu_p95);
+		if (timing.gpu_p50 >= 0.0)
+			printf(", GPU p50 %.3f ms", timing.gpu_p50);
+		else
+			printf(", GPU brak");
+		if (!update && base != baseline.end())
+		{
+			printf(" (%+.1f%%, %+.1f%%", Change(timing.cpu_p50, base->second.cpu_p50),
+				Change(timing.cpu_p95, base->second.cpu_p95));
+			if (timing.gpu_p50 >= 0.0 && base->second.gpu_p50 >= 0.0)
+				printf(", %+.1f%%", Change(timing.gpu_p50, base->second.gpu_p50));
+			printf(")");
+		}
+		printf("   %s\n", status);
+		if (report)
+			fprintf(report, "%s,,,,,%.4f,%.4f,%.4f,%s\n", scene.name.c_str(), timing.cpu_p50, timing.cpu_p95,
+				timing.gpu_p50, status);
+	}
+	if (report)
+		fclose(report);
+
+	if (update)
+	{
+		if (!SaveBaseline(baseline_file, baseline))
+		{
+			printf("Nie mozna zapisac pliku %s\n", baseline_file.c_str());
+			return 2;
+		}
+		printf("Zapisano wzorce %d scen w katalogu %s i czasy bazowe w pliku %s\n", run, golden_dir.c_str(),
+			baseline_file.c_str());
+		return errors > 0 ? 2 : 0;
+	}
+	printf("Sceny: %d, regresje obrazu: %d, regresje wydajnosci: %d, bledy: %d\n", run, visual, performance,
+		errors);
+	if (errors > 0)
+		return 2;
+	return visual > 0 || performance > 0 ? 1 : 0;
+}
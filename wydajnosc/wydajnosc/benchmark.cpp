@@ -0,0 +1,166 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "benchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+static int repetitions = 15;
+static double warmup_ms = 50.0;
+static double min_time_ms = 5.0;
+static std::string filter;
+static std::string json;
+
+static std::vector<std::pair<std::string, std::string> > context;
+static std::vector<BenchmarkResult> results;
+static bool header = false;
+
+// warto opcji postaci --nazwa=warto lub NULL
+
+static const char *Option(const char *arg, const char *name)
+{
+	const size_t length = strlen(name);
+	return strncmp(arg, name, length) == 0 && arg[length] == '=' ? arg + length + 1 : NULL;
+}
+
+bool BenchmarkInit(int &argc, char *argv[])
+{
+	int count = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		const char *value;
+		if ((value = Option(argv[i], "--repetitions")) != NULL)
+			repetitions = atoi(value);
+		else if ((value = Option(argv[i], "--warmup")) != NULL)
+			warmup_ms = atof(value);
+		else if ((value = Option(argv[i], "--min-time")) != NULL)
+			min_time_ms = atof(value);
+		else if ((value = Option(argv[i], "--filter")) != NULL)
+			filter = value;
+		else if ((value = Option(argv[i], "--json")) != NULL)
+			json = value;
+		else
+			argv[count++] = argv[i];
+	}
+	argc = count;
+	argv[argc] = NULL;
+	return repetitions >= 1 && warmup_ms >= 0.0 && min_time_ms > 0.0;
+}
+
+void BenchmarkContext(const char *key, const std::string &value)
+{
+	context.push_back(std::make_pair(std::string(key), value));
+}
+
+bool BenchmarkSelected(const char *group, const char *name)
+{
+	return filter.empty() || (std::string(group) + "/" + name).find(filter) != std::string::npos;
+}
+
+int BenchmarkRepetitions()
+{
+	return repetitions;
+}
+
+double BenchmarkWarmupMs()
+{
+	return warmup_ms;
+}
+
+double BenchmarkMinTimeMs()
+{
+	return min_time_ms;
+}
+
+void BenchmarkUse(const volatile void *)
+{
+}
+
+void BenchmarkAddResult(const char *group, const char *name, int size, long long items, long long iterations,
+	std::vector<double> &samples)
+{
+	BenchmarkResult result;
+	result.group = group;
+	result.name = name;
+	result.size = size;
+	result.items = items;
+	result.iterations = iterations;
+	result.samples = (int)samples.size();
+
+	std::sort(samples.begin(), samples.end());
+	const size_t n = samples.size();
+	result.median_ns = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+	result.min_ns = samples[0];
+	for (size_t i = 0; i < n; i++)
+		result.mean_ns += samples[i];
+	result.mean_ns /= n;
+	for (size_t i = 0; i < n; i++)
+		result.stddev_ns += (samples[i] - result.mean_ns) * (samples[i] - result.mean_ns);
+	result.stddev_ns = n > 1 ? sqrt(result.stddev_ns / (n - 1)) : 0.0;
+	results.push_back(result);
+
+	if (!header)
+	{
+		printf("%-10s %-28s %8s %12s %12s %8s %12s\n", "grupa", "test", "rozmiar", "ns/el p50", "ns/el min",
+			"odch.%", "Mel/s");
+		header = true;
+	}
+	printf("%-10s %-28s %8d %12.3f %12.3f %8.2f %12.2f\n", group, name, size, result.median_ns, result.min_ns,
+		100.0 * result.stddev_ns / result.mean_ns, 1.0e3 / result.median_ns);
+	fflush(stdout);
+}
+
+// tekst w cudzysowach z sekwencjami specjalnymi JSON
+
+static void WriteString(FILE *file, const std::string &text)
+{
+	fputc('"', file);
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		const unsigned char c = (unsigned char)text[i];
+		if (c == '"' || c == '\\')
+			fprintf(file, "\\%c", c);
+		else if (c < 0x20)
+			fprintf(file, "\\u%04x", c);
+		else
+			fputc(c, file);
+	}
+	fputc('"', file);
+}
+
+bool BenchmarkFinish()
+{
+	if (json.empty())
+		return true;
+	FILE *file = fopen(json.c_str(), "w");
+	if (file == NULL)
+		return false;
+
+	fprintf(file, "{\n  \"context\": {");
+	for (size_t i = 0; i < context.size(); i++)
+	{
+		fprintf(file, "%s\n    ", i ? "," : "");
+		WriteString(file, context[i].first);
+		fprintf(file, ": ");
+		WriteString(file, context[i].second);
+	}
+	fprintf(file, "\n  },\n  \"benchmarks\": [");
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const BenchmarkResult &r = results[i];
+		fprintf(file, "%s\n    {\"group\": ", i ? "," : "");
+		WriteString(file, r.group);
+		fprintf(file, ", \"name\": ");
+		WriteString(file, r.name);
+		fprintf(file, ", \"size\": %d, \"items\": %lld, \"iterations\": %lld, \"samples\": %d, "
+			"\"median_ns\": %.4f, \"min_ns\": %.4f, \"mean_ns\": %.4f, \"stddev_ns\": %.4f}",
+			r.size, r.items, r.iterations, r.samples, r.median_ns, r.min_ns, r.mean_ns, r.stddev_ns);
+	}
+	fprintf(file, "\n  ]\n}\n");
+	const bool ok = ferror(file) == 0;
+	fclose(file);
+	if (ok)
+		printf("Zapisano wyniki w pliku %s\n", json.c_str());
+	return ok;
+}
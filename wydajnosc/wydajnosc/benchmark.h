@@ -0,0 +1,145 @@
+#ifndef __BENCHMARK__H__
+#define __BENCHMARK__H__
+
+#include <chrono>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// pomiar czasu krtkich fragmentw kodu: po rozgrzewce (pami podrczna,
+// predykcja skokw, zegar procesora) liczba powtrze w prbce jest
+// dobierana tak, by prbka trwaa co najmniej zadany czas, a wynikiem jest
+// mediana, minimum, rednia i odchylenie standardowe czasu na element
+// z kilkunastu prbek
+//
+// opcje (usuwane z listy argumentw przez BenchmarkInit):
+// --repetitions=N     liczba prbek (domylnie 15)
+// --warmup=MS         czas rozgrzewki kadego testu (domylnie 50 ms)
+// --min-time=MS       najkrtszy czas prbki (domylnie 5 ms)
+// --filter=TEKST      tylko testy, ktrych "grupa/nazwa" zawiera tekst
+// --json=PLIK         zapis wynikw do pliku JSON
+
+// wynik testu; czasy w nanosekundach na element
+
+struct BenchmarkResult
+{
+	std::string group;
+	std::string name;
+	int size = 0;              // rozmiar danych (liczba wektorw, trjktw, ...)
+	long long items = 0;       // elementy przetwarzane w jednym wywoaniu
+	long long iterations = 0;  // wywoania w jednej prbce
+	int samples = 0;
+	double median_ns = 0.0;
+	double min_ns = 0.0;
+	double mean_ns = 0.0;
+	double stddev_ns = 0.0;
+};
+
+// odczyt opcji; zwraca false przy bdnej wartoci opcji
+
+bool BenchmarkInit(int &argc, char *argv[]);
+
+// dodatkowa informacja o warunkach pomiaru zapisywana w pliku JSON
+
+void BenchmarkContext(const char *key, const std::string &value);
+
+// czy test zostanie wykonany (filtr --filter) - pozwala pomin
+// przygotowanie danych testw wyczonych
+
+bool BenchmarkSelected(const char *group, const char *name);
+
+// zakoczenie testu - obliczenie statystyk z czasw prbek [ns na element],
+// wydruk wiersza tabeli i zapamitanie wyniku
+
+void BenchmarkAddResult(const char *group, const char *name, int size, long long items, long long iterations,
+	std::vector<double> &samples);
+
+// zapis pliku JSON (jeli podano --json); zwraca false przy bdzie zapisu
+
+bool BenchmarkFinish();
+
+// ustawienia pomiaru (z opcji)
+
+int BenchmarkRepetitions();
+double BenchmarkWarmupMs();
+double BenchmarkMinTimeMs();
+
+// bariery dla optymalizatora: DoNotOptimize wymusza obliczenie wartoci
+// (kompilator nie moe usun kodu, ktrego wynikiem jest value), a
+// ClobberMemory - zapis wszystkich wynikw do pamici przed pomiarem czasu
+
+void BenchmarkUse(const volatile void *pointer);
+
+#if defined(_MSC_VER) && !defined(__clang__)
+
+template <class T>
+inline void DoNotOptimize(const T &value)
+{
+	// funkcja z innej jednostki kompilacji - kompilator nie zna jej dziaania
+	BenchmarkUse(&value);
+	_ReadWriteBarrier();
+}
+
+inline void ClobberMemory()
+{
+	_ReadWriteBarrier();
+}
+
+#else
+
+template <class T>
+inline void DoNotOptimize(const T &value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory()
+{
+	asm volatile("" : : : "memory");
+}
+
+#endif
+
+// pomiar wywoa body(); items - liczba elementw przetwarzanych w jednym
+// wywoaniu (czasy s podawane na element)
+
+template <class F>
+void Benchmark(const char *group, const char *name, int size, long long items, F body)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+	if (!BenchmarkSelected(group, name))
+		return;
+
+	// rozgrzewka, a rwnoczenie dobr liczby wywoa w prbce
+	long long iterations = 1;
+	double elapsed_ms = 0.0, warmup_ms = 0.0;
+	for (;;)
+	{
+		const Clock::time_point start = Clock::now();
+		for (long long i = 0; i < iterations; i++)
+			body();
+		ClobberMemory();
+		elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		warmup_ms += elapsed_ms;
+		if (elapsed_ms < BenchmarkMinTimeMs())
+			iterations *= 2;
+		else if (warmup_ms >= BenchmarkWarmupMs())
+			break;
+	}
+
+	std::vector<double> samples(BenchmarkRepetitions());
+	for (size_t s = 0; s < samples.size(); s++)
+	{
+		const Clock::time_point start = Clock::now();
+		for (long long i = 0; i < iterations; i++)
+			body();
+		ClobberMemory();
+		const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		samples[s] = ns / ((double)iterations * items);
+	}
+	BenchmarkAddResult(group, name, size, items, iterations, samples);
+}
+
+#endif // __BENCHMARK__H__
@@ -0,0 +1,117 @@
+/*
+* (c) Copyright 2016, Vasyl Martsenyuk
+* Email: marceniuk@yahoo.com
+*/
+
+#include "bezier.h"
+#include <math.h>
+#include <stdlib.h>
+
+//functions for vector operations. It can be used any C++ class for 3D point
+// addition of 2 points
+POINT_3D pointAdd(POINT_3D p, POINT_3D q) {
+	p.x += q.x; p.y += q.y; p.z += q.z;
+	return p;
+}
+// multiplication of point by constant
+POINT_3D pointTimes(double c, POINT_3D p) {
+	p.x *= c; p.y *= c; p.z *= c;
+	return p;
+}
+// making new point
+POINT_3D makePoint(double a, double b, double c) {
+	POINT_3D p;
+	p.x = a; p.y = b;	p.z = c;
+
+	return p;
+}
+//function for calculation of 3rd order polynomial (each counterpart in Bezie curve equation
+//is one of so called
+// Bernstane polynomials); it necessary to transfer variable u and array containing 4 points p
+// and to calculate point on curve. Changing u with the same increments between 0 and 1 we get
+// good curve approximation
+// calculate polynomial of 3rd order based on array of 4 points
+// and variable u changed from 0 to 1
+POINT_3D Bernstein(float u, POINT_3D *p) {
+	POINT_3D a, b, c, d, r;
+	a = pointTimes(pow(u, 3), p[0]);
+	b = pointTimes(3 * pow(u, 2)*(1 - u), p[1]);
+	c = pointTimes(3 * u*pow((1 - u), 2), p[2]);
+	d = pointTimes(pow((1 - u), 3), p[3]);
+	r = pointAdd(pointAdd(a, b), pointAdd(c, d));
+
+	return r;
+}
+//this function generates all slices of triangles and stores them in display list.
+// we do it in order not to recalculate fragment during each frame.
+// Meanwhile we can use morphing of anchor points. We will get intereting effect of smoothed
+//low-cost morphing.
+//// (we only do morphing of 16 points but we should recalculate them). Array "last" is used to
+//store previous line
+//// of points (since for triangular slices both raws are needed).
+//// Also coordinates of texture are calculated with help of values of u and v in form of
+//procents(flat covering).
+// We don't do calculation of normals for lighting.
+// For this purpose we need 2 parameters.
+// The first paramater is the center of each triangle
+// and then to use bitwise calculus and calculation of tan of both axes x and y,
+// then to calculate vector product in order to get perpendicular for both axes and then
+// to normalize vector and to use it as normal.
+// Only the 4 rows of the net take part in the surface, so only those are evaluated
+// (evaluating anchors[4..7] read past the end of the 4x8 array).
+GLuint genBezier(BEZIER_PATCH patch, int divs) {
+	int u = 0, v;
+	float py, px, pyold;
+	GLuint drawlist = glGenLists(1);
+	POINT_3D temp[4];
+	POINT_3D *last = (POINT_3D*)malloc(sizeof(POINT_3D)*(divs + 1));
+	if (patch.dlBPatch != 0)
+		glDeleteLists(patch.dlBPatch, 1);
+	temp[0] = patch.anchors[0][7];
+	temp[1] = patch.anchors[1][7];
+	temp[2] = patch.anchors[2][7];
+	temp[3] = patch.anchors[3][7];
+	for (v = 0; v <= divs; v++) {
+		px = ((float)v) / ((float)divs);
+		last[v] = Bernstein(px, temp);
+	}
+	glNewList(drawlist, GL_COMPILE);
+	glBindTexture(GL_TEXTURE_2D, patch.texture);
+	for (u = 1; u <= divs; u++) {
+		py = ((float)u) / ((float)divs);
+		pyold = ((float)u - 1.0f) / ((float)divs);
+		temp[0] = Bernstein(py, patch.anchors[0]);
+		temp[1] = Bernstein(py, patch.anchors[1]);
+		temp[2] = Bernstein(py, patch.anchors[2]);
+		temp[3] = Bernstein(py, patch.anchors[3]);
+
+		glBegin(GL_TRIANGLE_STRIP);
+		for (v = 0; v <= divs; v++) {
+			px = ((float)v) / ((float)divs);
+			glTexCoord2f(pyold, px);
+			glVertex3d(last[v].x, last[v].y, last[v].z);
+			last[v] = Bernstein(px, temp);
+			glTexCoord2f(py, px);
+			glVertex3d(last[v].x, last[v].y, last[v].z);
+		}
+		glEnd();
+	}
+	glEndList();
+	free(last);
+	return drawlist;
+}
+
+// the grid version of the same evaluation: first the 4 points of the net rows
+// for py = row / (size - 1), then the point on their curve for px = col / (size - 1)
+void gridBezier(const BEZIER_PATCH &patch, int size, POINT_3D *out) {
+	POINT_3D temp[4];
+	for (int row = 0; row < size; row++) {
+		const float py = ((float)row) / ((float)(size - 1));
+		temp[0] = Bernstein(py, (POINT_3D*)patch.anchors[0]);
+		temp[1] = Bernstein(py, (POINT_3D*)patch.anchors[1]);
+		temp[2] = Bernstein(py, (POINT_3D*)patch.anchors[2]);
+		temp[3] = Bernstein(py, (POINT_3D*)patch.anchors[3]);
+		for (int col = 0; col < size; col++)
+			out[row * size + col] = Bernstein(((float)col) / ((float)(size - 1)), temp);
+	}
+}
@@ -0,0 +1,7 @@
+#include <GL/glut.h>
+
+// Some data types
+typedef GLfloat GLTVector2[2];      // Two component floating point vector
+typedef GLfloat GLTVector3[3];      // Three component floating point vector
+typedef GLfloat GLTVector4[4];      // Four component floating point vector
+typedef GLfloat GLTMatrix[16];      // A column major 4x4 matrix of type GLfloat
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "mesh_normals.h"
+#include "vector_simd.h"
+
+void InvalidateNormals(MeshNormals &mesh, bool topology)
+{
+	mesh.normals_valid = false;
+	if (topology)
+		mesh.adjacency_valid = false;
+}
+
+// budowa ssiedztwa wierzchoek -> ciany: zliczenie cian kadego
+// wierzchoka, sumy prefiksowe i rozoenie numerw cian - O(T)
+
+static void BuildAdjacency(MeshNormals &mesh, int vertex_count, const int *triangles, int triangle_count)
+{
+	mesh.offsets.assign(vertex_count + 1, 0);
+	for (int i = 0; i < 3 * triangle_count; i++)
+		mesh.offsets[triangles[i] + 1]++;
+	for (int v = 0; v < vertex_count; v++)
+		mesh.offsets[v + 1] += mesh.offsets[v];
+
+	mesh.faces.resize(3 * triangle_count);
+	std::vector<int> fill(mesh.offsets.begin(), mesh.offsets.end() - 1);
+	for (int i = 0; i < 3 * triangle_count; i++)
+		mesh.faces[fill[triangles[i]]++] = i / 3;
+
+	mesh.adjacency_valid = true;
+}
+
+const GLfloat *SmoothNormals(MeshNormals &mesh, const GLfloat *vertices, int vertex_count,
+	const int *triangles, int triangle_count)
+{
+	if (mesh.normals_valid)
+		return mesh.vertex_normals.data();
+	if (!mesh.adjacency_valid)
+		BuildAdjacency(mesh, vertex_count, triangles, triangle_count);
+
+	// normalne cian - iloczyn wektorowy krawdzi, jego dugo jest
+	// rwna podwjnemu polu trjkta, wic suma jest waona polem
+	mesh.face_normals.resize(3 * triangle_count);
+	FaceNormals(vertices, triangles, triangle_count, mesh.face_normals.data(), false);
+
+	// suma normalnych cian ssiadujcych z kadym wierzchokiem
+	mesh.vertex_normals.resize(3 * vertex_count);
+	for (int v = 0; v < vertex_count; v++)
+	{
+		GLfloat n[3] = { 0.0f, 0.0f, 0.0f };
+		for (int j = mesh.offsets[v]; j < mesh.offsets[v + 1]; j++)
+		{
+			const GLfloat *fn = &mesh.face_normals[3 * mesh.faces[j]];
+			n[0] += fn[0];
+			n[1] += fn[1];
+			n[2] += fn[2];
+		}
+		mesh.vertex_normals[3 * v + 0] = n[0];
+		mesh.vertex_normals[3 * v + 1] = n[1];
+		mesh.vertex_normals[3 * v + 2] = n[2];
+	}
+	NormalizeVectors(mesh.vertex_normals.data(), vertex_count);
+
+	mesh.normals_valid = true;
+	return mesh.vertex_normals.data();
+}
@@ -0,0 +1,34 @@
+#ifndef __MESH_NORMALS__H__
+#define __MESH_NORMALS__H__
+
+#include <GL/glut.h>
+#include <vector>
+
+// wektory normalne wierzchokw siatki trjktw liczone raz i przechowywane
+// do czasu zmiany geometrii; ssiedztwo wierzchoek -> ciany zapisane jest
+// w formacie CSR: ciany wierzchoka v to faces[offsets[v]] ... faces[offsets[v + 1] - 1]
+
+struct MeshNormals
+{
+	std::vector<int> offsets; // pocztki list cian kolejnych wierzchokw (vertex_count + 1)
+	std::vector<int> faces; // numery cian (3 * triangle_count)
+	std::vector<GLfloat> face_normals; // nieznormalizowane normalne cian - dugo rwna podwjnemu polu
+	std::vector<GLfloat> vertex_normals; // jednostkowe normalne wierzchokw
+	bool adjacency_valid = false; // ssiedztwo zgodne z aktualn topologi
+	bool normals_valid = false; // normalne zgodne z aktualnymi wsprzdnymi
+};
+
+// uniewanienie danych po zmianie wsprzdnych wierzchokw (topology == false)
+// lub take listy trjktw (topology == true)
+
+void InvalidateNormals(MeshNormals &mesh, bool topology = true);
+
+// wektory normalne wierzchokw (waone polem cian); przeliczane tylko
+// po uniewanieniu, w przeciwnym wypadku zwracane s zapamitane wartoci
+// vertices - wsprzdne (x, y, z) wierzchokw
+// triangles - indeksy wierzchokw trjktw
+
+const GLfloat *SmoothNormals(MeshNormals &mesh, const GLfloat *vertices, int vertex_count,
+	const int *triangles, int triangle_count);
+
+#endif // __MESH_NORMALS__H__
@@ -0,0 +1,301 @@
+// testy wydajnoci funkcji obliczeniowych uywanych w programach:
+// funkcje wektorowe glt* (VectorMath.cpp z zajecie7) i ich wersje
+// wsadowe (vector_simd), normalne cian i wierzchokw (Normal() z zajecie11,
+// flat i SmoothNormals z Zajecie5), wielomiany Bernsteina fragmentw
+// Beziera (zajecie9) oraz odczyt i zapis plikw TGA - kady test dla kilku
+// rozmiarw danych
+//
+// uruchomienie: wydajnosc [--repetitions=N] [--warmup=MS] [--min-time=MS]
+//               [--filter=TEKST] [--json=PLIK]
+// wyniki - czas na element (wektor, trjkt, punkt, piksel) - s drukowane
+// w tabeli, a z opcj --json zapisywane take w pliku do porwnania
+// z wynikami po zmianie kodu
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "benchmark.h"
+#include "gltools_extracted.h"
+#include "VectorMath.cpp"
+#include "vector_simd.h"
+#include "mesh_normals.h"
+#include "pyramid.h"
+#include "bezier.h"
+#include "targa.h"
+
+// rozmiary danych testw
+
+const int vector_counts[] = { 64, 4096, 262144 };
+const int pyramid_sides[] = { 16, 64, 256 };
+const int bezier_divs[] = { 4, 16, 64 };
+const int image_sizes[] = { 64, 256, 1024 };
+
+// plik tymczasowy testw TGA
+
+const char *const TEMP_FILE = "wydajnosc_tmp.tga";
+
+#define COUNT(array) (int)(sizeof(array) / sizeof(array[0]))
+
+// pseudolosowa liczba z przedziau [-1, 1] (powtarzalna midzy uruchomieniami)
+
+static GLfloat Random()
+{
+	return 2.0f * rand() / RAND_MAX - 1.0f;
+}
+
+static void RandomVectors(std::vector<GLfloat> &aos, VectorArray &soa, int count)
+{
+	aos.resize(3 * count);
+	soa.Resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		soa.x[i] = aos[3 * i + 0] = Random();
+		soa.y[i] = aos[3 * i + 1] = Random();
+		soa.z[i] = aos[3 * i + 2] = Random();
+	}
+}
+
+// funkcje glt* w ptli po wektorach i odpowiadajce im funkcje wsadowe
+
+static void VectorMathBenchmarks()
+{
+	GLTMatrix matrix;
+	for (int i = 0; i < 16; i++)
+		matrix[i] = Random();
+
+	for (int c = 0; c < COUNT(vector_counts); c++)
+	{
+		const int n = vector_counts[c];
+		std::vector<GLfloat> a, b, d, out(3 * n);
+		VectorArray sa, sb, sd, so;
+		RandomVectors(a, sa, n);
+		RandomVectors(b, sb, n);
+		RandomVectors(d, sd, n);
+		so.Resize(n);
+
+		Benchmark("VectorMath", "gltTransformPoint", n, n, [&]()
+		{
+			for (int i = 0; i < n; i++)
+				gltTransformPoint(&a[3 * i], matrix, &out[3 * i]);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("VectorMath", "TransformPoints SoA", n, n, [&]()
+		{
+			TransformPoints(matrix, sa.Span(), so.Span());
+			DoNotOptimize(so.x[0]);
+		});
+		Benchmark("VectorMath", "TransformPoints AoS", n, n, [&]()
+		{
+			TransformPoints(matrix, a.data(), out.data(), n);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("VectorMath", "gltRotateVector", n, n, [&]()
+		{
+			for (int i = 0; i < n; i++)
+				gltRotateVector(&a[3 * i], matrix, &out[3 * i]);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("VectorMath", "RotateVectors SoA", n, n, [&]()
+		{
+			RotateVectors(matrix, sa.Span(), so.Span());
+			DoNotOptimize(so.x[0]);
+		});
+		Benchmark("VectorMath", "gltVectorCrossProduct", n, n, [&]()
+		{
+			for (int i = 0; i < n; i++)
+				gltVectorCrossProduct(&a[3 * i], &b[3 * i], &out[3 * i]);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("VectorMath", "CrossProducts SoA", n, n, [&]()
+		{
+			CrossProducts(sa.Span(), sb.Span(), so.Span());
+			DoNotOptimize(so.x[0]);
+		});
+
+		// normalizacja kopii wektorw (te same dane wejciowe w kadym wywoaniu)
+		Benchmark("VectorMath", "gltNormalizeVector", n, n, [&]()
+		{
+			memcpy(out.data(), a.data(), 3 * n * sizeof(GLfloat));
+			for (int i = 0; i < n; i++)
+				gltNormalizeVector(&out[3 * i]);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("VectorMath", "NormalizeVectors SoA", n, n, [&]()
+		{
+			so = sa;
+			NormalizeVectors(so.Span());
+			DoNotOptimize(so.x[0]);
+		});
+		Benchmark("VectorMath", "gltGetNormalVector", n, n, [&]()
+		{
+			for (int i = 0; i < n; i++)
+				gltGetNormalVector(&a[3 * i], &b[3 * i], &d[3 * i], &out[3 * i]);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("VectorMath", "FaceNormals SoA", n, n, [&]()
+		{
+			FaceNormals(sa.Span(), sb.Span(), sd.Span(), so.Span());
+			DoNotOptimize(so.x[0]);
+		});
+	}
+}
+
+// normalna ciany i z programu zajecie11 (nieznormalizowana, krawdzie
+// (b - a) x (c - b)) - kopia funkcji Normal() z danymi siatki jako parametrami
+
+static void Normal(const GLfloat *vertex, const int *triangles, GLfloat *n, int i)
+{
+	GLfloat v1[3], v2[3];
+	v1[0] = vertex[3 * triangles[3 * i + 1] + 0] - vertex[3 * triangles[3 * i + 0] + 0];
+	v1[1] = vertex[3 * triangles[3 * i + 1] + 1] - vertex[3 * triangles[3 * i + 0] + 1];
+	v1[2] = vertex[3 * triangles[3 * i + 1] + 2] - vertex[3 * triangles[3 * i + 0] + 2];
+	v2[0] = vertex[3 * triangles[3 * i + 2] + 0] - vertex[3 * triangles[3 * i + 1] + 0];
+	v2[1] = vertex[3 * triangles[3 * i + 2] + 1] - vertex[3 * triangles[3 * i + 1] + 1];
+	v2[2] = vertex[3 * triangles[3 * i + 2] + 2] - vertex[3 * triangles[3 * i + 1] + 2];
+	n[0] = v1[1] * v2[2] - v1[2] * v2[1];
+	n[1] = v1[2] * v2[0] - v1[0] * v2[2];
+	n[2] = v1[0] * v2[1] - v1[1] * v2[0];
+}
+
+// normalne siatek ostrosupw o podziale radialnym i pionowym rwnym liczbie bokw
+
+static void NormalBenchmarks()
+{
+	for (int s = 0; s < COUNT(pyramid_sides); s++)
+	{
+		PyramidParams params;
+		params.sides = params.rings = params.stacks = pyramid_sides[s];
+		PyramidMesh pyramid;
+		GeneratePyramid(params, pyramid);
+		const GLfloat *vertices = pyramid.vertices.data();
+		const int *triangles = pyramid.triangles.data();
+		const int vertex_count = (int)pyramid.vertices.size() / 3;
+		const int n = (int)pyramid.triangles.size() / 3;
+		std::vector<GLfloat> out(3 * n);
+		MeshNormals mesh;
+
+		Benchmark("Normalne", "Normal (zajecie11)", n, n, [&]()
+		{
+			for (int i = 0; i < n; i++)
+				Normal(vertices, triangles, &out[3 * i], i);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("Normalne", "gltGetNormalVector", n, n, [&]()
+		{
+			for (int i = 0; i < n; i++)
+				gltGetNormalVector(&vertices[3 * triangles[3 * i + 0]], &vertices[3 * triangles[3 * i + 1]],
+					&vertices[3 * triangles[3 * i + 2]], &out[3 * i]);
+			DoNotOptimize(out[0]);
+		});
+		Benchmark("Normalne", "FaceNormals (Zajecie5)", n, n, [&]()
+		{
+			FaceNormals(vertices, triangles, n, out.data());
+			DoNotOptimize(out[0]);
+		});
+
+		// normalne wierzchokw przeliczane od nowa (ssiedztwo zachowane)
+		Benchmark("Normalne", "SmoothNormals (Zajecie5)", n, n, [&]()
+		{
+			InvalidateNormals(mesh, false);
+			DoNotOptimize(SmoothNormals(mesh, vertices, vertex_count, triangles, n));
+		});
+	}
+}
+
+// punkty fragmentu Beziera w wzach siatki (divs + 1) x (divs + 1)
+
+static void BezierBenchmarks()
+{
+	BEZIER_PATCH patch;
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 8; j++)
+			patch.anchors[i][j] = makePoint(i + Random(), (j < 4 ? j : 3) + Random(), Random());
+
+	for (int d = 0; d < COUNT(bezier_divs); d++)
+	{
+		const int divs = bezier_divs[d];
+		const int n = divs + 1;
+		std::vector<POINT_3D> grid(n * n);
+
+		// krzywa z 4 punktw kontrolnych - wywoania jak w genBezier
+		Benchmark("Bezier", "Bernstein", n, n, [&]()
+		{
+			for (int v = 0; v <= divs; v++)
+				DoNotOptimize(Bernstein((float)v / divs, patch.anchors[0]));
+		});
+		Benchmark("Bezier", "gridBezier", n, (long long)n * n, [&]()
+		{
+			gridBezier(patch, n, grid.data());
+			DoNotOptimize(grid[0]);
+		});
+	}
+}
+
+// zapis i odczyt obrazu RGB size x size
+
+static bool TargaBenchmarks()
+{
+	for (int s = 0; s < COUNT(image_sizes); s++)
+	{
+		const int size = image_sizes[s];
+		std::vector<GLubyte> image(3 * size * size);
+		for (size_t i = 0; i < image.size(); i++)
+			image[i] = (GLubyte)(i * 7 + i / 3);
+		if (!save_targa(TEMP_FILE, size, size, GL_BGR, GL_UNSIGNED_BYTE, image.data()))
+		{
+			printf("Nie mozna zapisac pliku %s\n", TEMP_FILE);
+			return false;
+		}
+
+		Benchmark("TGA", "save_targa", size, (long long)size * size, [&]()
+		{
+			DoNotOptimize(save_targa(TEMP_FILE, size, size, GL_BGR, GL_UNSIGNED_BYTE, image.data()));
+		});
+		Benchmark("TGA", "load_targa", size, (long long)size * size, [&]()
+		{
+			GLsizei width, height;
+			GLenum format, type;
+			GLvoid *pixels = NULL;
+			DoNotOptimize(load_targa(TEMP_FILE, width, height, format, type, pixels));
+			delete[] (unsigned char*)pixels;
+		});
+	}
+	remove(TEMP_FILE);
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	if (!BenchmarkInit(argc, argv) || argc > 1)
+	{
+		printf("Uzycie: %s [--repetitions=N] [--warmup=MS] [--min-time=MS] [--filter=TEKST] [--json=PLIK]\n",
+			argv[0]);
+		return 2;
+	}
+
+	char text[32];
+	sprintf(text, "%d", SimdWidth());
+	BenchmarkContext("simd_width", text);
+#ifdef NDEBUG
+	BenchmarkContext("build", "release");
+#else
+	BenchmarkContext("build", "debug");
+#endif
+	printf("Szerokosc SIMD: %d, probki: %d, rozgrzewka %.0f ms, probka >= %.1f ms\n\n", SimdWidth(),
+		BenchmarkRepetitions(), BenchmarkWarmupMs(), BenchmarkMinTimeMs());
+
+	srand(1);
+	VectorMathBenchmarks();
+	NormalBenchmarks();
+	BezierBenchmarks();
+	const bool targa = TargaBenchmarks();
+
+	if (!BenchmarkFinish())
+	{
+		printf("Nie mozna zapisac wynikow\n");
+		return 2;
+	}
+	return targa ? 0 : 2;
+}
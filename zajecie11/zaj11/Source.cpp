@@ -12,12 +12,22 @@ JanuszG@enter.net.pl
 #include <time.h>
 #include <sys/types.h>
 #include <stdio.h>
+#include <vector>
+#include "pyramid.h"
+#include "mesh_optimize.h"
+#include "gl_state.h"
+#include "extensions.h"
+#include "profiler.h"
+#include "headless.h"
+#include "transform.h"
+#include "dynamic_resolution.h"
 #define NUM_PARTICLES 1000 /* Number of particles */
 #define NUM_DEBRIS 70 /* Number of debris */
 /* GLUT menu entries */
 #define PAUSE 0
 #define NORMALIZE_SPEED 1
 #define QUIT 2
+#define DYNAMIC_RESOLUTION 3
 /* A particle */
 struct particleData
 {
@@ -65,39 +75,36 @@ int wantPause = 0; /* Pause flag */
 				   *
 				   */
 
-const int N = 9;
-const int VertexNumber = N + 2;
-const int TrianglesNumber = N * 2;
+// ostrosłup wyświetlany przed wybuchem; liczba boków podstawy
+// może być podana jako argument programu
+PyramidParams pyramid;
+std::vector<GLfloat> vertex;
+std::vector<GLint> triangles;
+int TrianglesNumber = 0;
 
-GLfloat vertex[VertexNumber * 3];
-GLint triangles[TrianglesNumber * 3];
+// hierarchia przekształceń: kamera -> odłamki; macierze odłamków są
+// przeliczane tylko po ruchu odłamka lub kamery (nie w czasie pauzy)
+TransformHierarchy transforms;
+int cameraNode, debrisNodes[NUM_DEBRIS];
 
-void GenerateVerticles(GLfloat* vertices, int Sides)
+void BuildPyramid()
 {
-	for (auto i = 0; i < Sides; ++i)
-	{
-		vertices[i * 3 + 0] = sinf(i / static_cast<float>(Sides) * 2 * M_PI);
-		vertices[i * 3 + 1] = -1.2f;
-		vertices[i * 3 + 2] = cosf(i / static_cast<float>(Sides) * 2 * M_PI);
-	}
-	int l = Sides * 3;
-	vertices[l + 0] = 0.f;
-	vertices[l + 1] = -1.2f;
-	vertices[l + 2] = 0.f;
-	vertices[l + 3] = 0.f;
-	vertices[l + 4] = 1.0f;
-	vertices[l + 5] = 0.f;
-}
-void GenerateTriangles(GLint* triangles, int Sides)
-{
-	for (int i = 0; i < 2; ++i)
-		for (int j = 0; j < Sides; ++j)
-		{
-			triangles[i*Sides * 3 + j * 3] = j;
-			triangles[i*Sides * 3 + j * 3 + 1] = (j + 1) % Sides;
-			triangles[i*Sides * 3 + j * 3 + 2] = Sides + i;
-		}
+	pyramid.radius = 1.0f;
+	pyramid.bottom = -1.2f;
+	pyramid.top = 1.0f;
+	PyramidMesh solid;
+	GeneratePyramid(pyramid, solid);
+	vertex.swap(solid.vertices);
+	triangles.swap(solid.triangles);
+	TrianglesNumber = (int)triangles.size() / 3;
 
+	// kolejność trójkątów i wierzchołków pod kątem pamięci podręcznej wierzchołków
+	const VertexCacheStats before = AnalyzeVertexCache(triangles.data(), TrianglesNumber, (int)vertex.size() / 3);
+	OptimizeVertexCache(triangles.data(), TrianglesNumber, (int)vertex.size() / 3);
+	vertex.resize(3 * OptimizeVertexFetch(vertex.data(), (int)vertex.size() / 3, triangles.data(), TrianglesNumber));
+	const VertexCacheStats after = AnalyzeVertexCache(triangles.data(), TrianglesNumber, (int)vertex.size() / 3);
+	printf("Ostroslup: %d trojkatow, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+		TrianglesNumber, before.acmr, after.acmr, before.atvr, after.atvr);
 }
 
 void Normal(GLfloat *n, int i)
@@ -160,6 +167,24 @@ newSpeed(float dest[3])
 	dest[1] = y;
 	dest[2] = z;
 }
+// macierze lokalne odłamków: przesunięcie, obroty wokół osi x, y, z
+// i skalowanie - ustawiane po każdej zmianie położenia odłamków
+void debrisTransforms(void)
+{
+	for (int i = 0; i < NUM_DEBRIS; i++)
+	{
+		Matrix local = MatrixTranslation(debris[i].position[0],
+			debris[i].position[1],
+			debris[i].position[2]);
+		local = MatrixMultiply(local, MatrixRotation(debris[i].orientation[0], 1.0, 0.0, 0.0));
+		local = MatrixMultiply(local, MatrixRotation(debris[i].orientation[1], 0.0, 1.0, 0.0));
+		local = MatrixMultiply(local, MatrixRotation(debris[i].orientation[2], 0.0, 0.0, 1.0));
+		local = MatrixMultiply(local, MatrixScaling(debris[i].scale[0],
+			debris[i].scale[1],
+			debris[i].scale[2]));
+		TransformSet(transforms, debrisNodes[i], local);
+	}
+}
 /*
 * newExplosion
 *
@@ -199,6 +224,7 @@ void newExplosion(void)
 		newSpeed(debris[i].speed);
 		newSpeed(debris[i].orientationSpeed);
 	}
+	debrisTransforms();
 	fuel = 100;
 }
 /*
@@ -223,45 +249,50 @@ GLfloat fog_mode = GL_EXP;
 void display(void)
 {
 	int i;
+
+	// scena w rozdzielczości dobranej do budżetu czasu (przy wyłączonej
+	// dynamicznej rozdzielczości - bezpośrednio w oknie)
+	DynamicResolutionBegin();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glLoadIdentity();
 	/* Place the camera */
-	glTranslatef(0.0, 0.0, -10.0);
-	glRotatef(angle, 0.0, 1.0, 0.0);
+	TransformSet(transforms, cameraNode, MatrixMultiply(MatrixTranslation(0.0, 0.0, -10.0),
+		MatrixRotation(angle, 0.0, 1.0, 0.0)));
+	TransformUpdate(transforms);
+	TransformLoad(transforms, cameraNode);
 	/* If no explosion, draw cube */
-	glEnable(GL_FOG);
+	StateEnable(GL_FOG);
 
 	// wskazówki jakości generacji mgły
-	glHint(GL_FOG_HINT, fog_hint);
+	StateHintMode(GL_FOG_HINT, fog_hint);
 
 	// kolor mgły
-	glFogfv(GL_FOG_COLOR, White);
+	StateFogfv(GL_FOG_COLOR, White);
 
 	// gęstość mgły
-	glFogf(GL_FOG_DENSITY, fog_density);
+	StateFogf(GL_FOG_DENSITY, fog_density);
 
 	// rodzaj mgły
-	glFogf(GL_FOG_MODE, fog_mode);
+	StateFogf(GL_FOG_MODE, fog_mode);
 
 	// początek i koniec oddziaływania mgły liniowej
-	glFogf(GL_FOG_START, fog_start);
-	glFogf(GL_FOG_END, fog_end);
+	StateFogf(GL_FOG_START, fog_start);
+	StateFogf(GL_FOG_END, fog_end);
 	if (fuel == 0)
 	{
-		glEnable(GL_LIGHTING);
-		glDisable(GL_LIGHT0);
-		glEnable(GL_DEPTH_TEST);
+		StateEnable(GL_LIGHTING);
+		StateDisable(GL_LIGHT0);
+		StateEnable(GL_DEPTH_TEST);
 		glBegin(GL_TRIANGLES);
 		glColor3fv(DarkOrange);
 		DrawPyramid();
 		glEnd();
+		ProfilerDraw(3 * TrianglesNumber);
 
 	}
 	if (fuel > 0)
 	{
-		glPushMatrix();
-		glDisable(GL_LIGHTING);
-		glDisable(GL_DEPTH_TEST);
+		StateDisable(GL_LIGHTING);
+		StateDisable(GL_DEPTH_TEST);
 		glBegin(GL_POINTS);
 		for (i = 0; i < NUM_PARTICLES; i++)
 		{
@@ -269,33 +300,53 @@ void display(void)
 			glVertex3fv(particles[i].position);
 		}
 		glEnd();
-		glPopMatrix();
-		glEnable(GL_LIGHTING);
-		glEnable(GL_LIGHT0);
-		glEnable(GL_DEPTH_TEST);
+		ProfilerDraw(NUM_PARTICLES);
+		StateEnable(GL_LIGHTING);
+		StateEnable(GL_LIGHT0);
+		StateEnable(GL_DEPTH_TEST);
 		glNormal3f(0.0, 0.0, 1.0);
 		for (i = 0; i < NUM_DEBRIS; i++)
 		{
 			glColor3fv(debris[i].color);
-			glPushMatrix();
-			glTranslatef(debris[i].position[0],
-				debris[i].position[1],
-				debris[i].position[2]);
-			glRotatef(debris[i].orientation[0], 1.0, 0.0, 0.0);
-			glRotatef(debris[i].orientation[1], 0.0, 1.0, 0.0);
-			glRotatef(debris[i].orientation[2], 0.0, 0.0, 1.0);
-			glScalef(debris[i].scale[0],
-				debris[i].scale[1],
-				debris[i].scale[2]);
+			TransformLoad(transforms, debrisNodes[i]);
 			glBegin(GL_TRIANGLES);
 			glVertex3f(0.0, 0.5, 0.0);
 			glVertex3f(-0.25, 0.0, 0.0);
 			glVertex3f(0.25, 0.0, 0.0);
 			glEnd();
-			glPopMatrix();
+			ProfilerDraw(3);
 		}
 	}
-	glutSwapBuffers();
+
+	// powiększenie sceny do rozmiarów okna - wykres w pełnej rozdzielczości
+	DynamicResolutionEnd();
+
+	// wykres czasów ramek (bez okna pomijany - zapisywane ramki nie zależą od pomiarów)
+	if (!Headless())
+		ProfilerOverlay(WindowWidth(), WindowHeight());
+	WindowSwapBuffers();
+
+	// liczniki wywołań zmieniających stan i przekształceń (załadowane
+	// macierze są liczone jako zmiany stanu) - wypisywane, gdy się zmienią
+	static StateStats reported;
+	static TransformStats reportedTransforms;
+	StateFrameEnd();
+	TransformFrameEnd(transforms);
+	const TransformStats &transformStats = TransformLastFrame(transforms);
+	ProfilerStateChanges(StateLastFrame().issued + transformStats.loads);
+	ProfilerTextureBind(StateLastFrame().texture_binds);
+	if (StateLastFrame().issued != reported.issued || StateLastFrame().filtered != reported.filtered)
+	{
+		reported = StateLastFrame();
+		printf("Stan OpenGL: %d wyslanych, %d pominietych\n", reported.issued, reported.filtered);
+	}
+	if (transformStats.updated != reportedTransforms.updated || transformStats.cached != reportedTransforms.cached ||
+		transformStats.loads != reportedTransforms.loads || transformStats.skipped != reportedTransforms.skipped)
+	{
+		reportedTransforms = transformStats;
+		printf("Macierze: %d nowe, %d gotowe, %d wyslane, %d pominiete\n", reportedTransforms.updated,
+			reportedTransforms.cached, reportedTransforms.loads, reportedTransforms.skipped);
+	}
 }
 /*
 * keyboard
@@ -332,7 +383,7 @@ void keyboard(unsigned char key,
 * Update animation variables.
 *
 */
-void idle(void)
+void animate(void)
 {
 	int i;
 	if (!wantPause)
@@ -369,13 +420,31 @@ void idle(void)
 				debris[i].orientation[1] += debris[i].orientationSpeed[1] * 10;
 				debris[i].orientation[2] += debris[i].orientationSpeed[2] * 10;
 			}
+			debrisTransforms();
 			--fuel;
 		}
 		angle += 0.3; /* Always continue to rotate the camera */
 	}
+}
+void idle(void)
+{
+	animate();
 	glutPostRedisplay();
 }
 /*
+* headlessScript
+*
+* Scripted run without a window: the pyramid for a quarter of the frames,
+* then the explosion; one simulation step per frame.
+*
+*/
+void headlessScript(int frame, int frames)
+{
+	if (frame == frames / 4)
+		newExplosion();
+	animate();
+}
+/*
 * reshape
 *
 * Window reshape callback.
@@ -385,6 +454,7 @@ void reshape(int w,
 	int h)
 {
 	glViewport(0.0, 0.0, (GLfloat)w, (GLfloat)h);
+	DynamicResolutionReshape(w, h);
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
 	gluPerspective(45.0, (GLfloat)w / (GLfloat)h, 0.1, 100.0);
@@ -406,6 +476,9 @@ void menuSelect(int value)
 	case NORMALIZE_SPEED:
 		wantNormalize = 1 - wantNormalize;
 		break;
+	case DYNAMIC_RESOLUTION:
+		DynamicResolutionEnable(!DynamicResolutionEnabled());
+		break;
 	case QUIT:
 		exit(0);
 		break;
@@ -420,35 +493,62 @@ void menuSelect(int value)
 int main(int argc,
 	char *argv[])
 {
-	GenerateVerticles(vertex, N);
-	GenerateTriangles(triangles, N);
-	glutInit(&argc, argv);
-	glutInitDisplayMode(GLUT_DOUBLE | GLUT_DEPTH | GLUT_RGB);
-	glutCreateWindow("Explosion demo");
-	glutKeyboardFunc(keyboard);
-	glutIdleFunc(idle);
-	glutDisplayFunc(display);
-	glutReshapeFunc(reshape);
-	srand(time(NULL));
-	glEnable(GL_LIGHT0);
-	glEnable(GL_LIGHT1);
-	glLightfv(GL_LIGHT0, GL_AMBIENT, light0Amb);
-	glLightfv(GL_LIGHT0, GL_DIFFUSE, light0Dif);
-	glLightfv(GL_LIGHT0, GL_SPECULAR, light0Spec);
-	glLightfv(GL_LIGHT0, GL_POSITION, light0Pos);
-	glLightfv(GL_LIGHT1, GL_AMBIENT, light1Amb);
-	glLightfv(GL_LIGHT1, GL_DIFFUSE, light1Dif);
-	glLightfv(GL_LIGHT1, GL_SPECULAR, light1Spec);
-	glLightfv(GL_LIGHT1, GL_POSITION, light1Pos);
+	// tryb bez okna (opcja --headless) - kontekst w buforze pozaekranowym
+	const bool headless = HeadlessInit(argc, argv, 300, 300);
+
+	// opcja --frame-budget=MS - dynamiczna rozdzielczość od uruchomienia
+	DynamicResolutionOptions(argc, argv);
+	if (!headless)
+		glutInit(&argc, argv);
+	if (argc > 1 && atoi(argv[1]) >= 3)
+		pyramid.sides = atoi(argv[1]);
+	BuildPyramid();
+
+	// kamera i odłamki jako jej węzły podrzędne
+	cameraNode = TransformAdd(transforms, -1, MatrixIdentity());
+	for (int i = 0; i < NUM_DEBRIS; i++)
+		debrisNodes[i] = TransformAdd(transforms, cameraNode, MatrixIdentity());
+	if (!headless)
+	{
+		glutInitDisplayMode(GLUT_DOUBLE | GLUT_DEPTH | GLUT_RGB);
+		glutCreateWindow("Explosion demo");
+	}
+
+	// pomiar czasów ramek (zapytania o czas GPU), dane ramek w zaj11_profile.csv
+	ExtensionFunctionsSetup();
+	ProfilerInit("zaj11_profile.csv");
+	if (!headless)
+	{
+		glutKeyboardFunc(keyboard);
+		glutIdleFunc(idle);
+		glutDisplayFunc(ProfilerWrap(display));
+		glutReshapeFunc(reshape);
+	}
+	// bez okna - powtarzalny przebieg wybuchu
+	srand(headless ? 1 : time(NULL));
+	StateEnable(GL_LIGHT0);
+	StateEnable(GL_LIGHT1);
+	StateLightfv(GL_LIGHT0, GL_AMBIENT, light0Amb);
+	StateLightfv(GL_LIGHT0, GL_DIFFUSE, light0Dif);
+	StateLightfv(GL_LIGHT0, GL_SPECULAR, light0Spec);
+	StateLightfv(GL_LIGHT0, GL_POSITION, light0Pos);
+	StateLightfv(GL_LIGHT1, GL_AMBIENT, light1Amb);
+	StateLightfv(GL_LIGHT1, GL_DIFFUSE, light1Dif);
+	StateLightfv(GL_LIGHT1, GL_SPECULAR, light1Spec);
+	StateLightfv(GL_LIGHT1, GL_POSITION, light1Pos);
 	glLightModelf(GL_LIGHT_MODEL_TWO_SIDE, GL_TRUE);
 	glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, materialAmb);
 	glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, materialDif);
 	glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, materialSpec);
 	glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, materialShininess);
 	glEnable(GL_NORMALIZE);
+	// bez okna - narysowanie ramek według scenariusza
+	if (headless)
+		return HeadlessRun(ProfilerWrap(display), reshape, headlessScript);
 	glutCreateMenu(menuSelect);
 	glutAddMenuEntry("Pause", PAUSE);
 	glutAddMenuEntry("Toggle normalized speed vectors", NORMALIZE_SPEED);
+	glutAddMenuEntry("Toggle dynamic resolution", DYNAMIC_RESOLUTION);
 	glutAddMenuEntry("Quit", QUIT);
 	glutAttachMenu(GLUT_RIGHT_BUTTON);
 	glutMainLoop();
@@ -0,0 +1,532 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "dynamic_resolution.h"
+#include "extensions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <algorithm>
+
+// zakres skali rozdzielczoci sceny
+
+const GLfloat MIN_SCALE = 0.25f;
+const GLfloat MAX_SCALE = 1.0f;
+
+// najwiksza wzgldna zmiana skali w jednej ramce
+
+const GLfloat MAX_STEP = 0.1f;
+
+// strefa nieczuoci regulatora - czas ramki midzy LOW_BUDGET a HIGH_BUDGET
+// budetu nie zmienia skali; poza ni skala jest dobierana tak, aby czas
+// wrci do rodka strefy
+
+const double LOW_BUDGET = 0.8;
+const double HIGH_BUDGET = 1.0;
+
+// wspczynnik wygadzania pomiarw czasu (rednia wykadnicza)
+
+const double SMOOTHING = 0.25;
+
+// sia wyostrzenia przy najmniejszej skali (maleje liniowo do zera przy
+// penej rozdzielczoci)
+
+const GLfloat MAX_SHARPNESS = 0.25f;
+
+// liczba par zapyta o znaczniki czasu - wynik ramki jest odczytywany
+// najwczeniej w nastpnej ramce (zwykle 1-2 ramki pniej)
+
+const int QUERY_COUNT = 3;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static bool enabled = false;
+static bool sharpen = false;
+static double budget = 1000.0 / 60.0;
+static double average = -1.0;
+static GLfloat scale = 1.0f;
+static int window_width = 0, window_height = 0;
+
+// obszar sceny w biecej ramce; active - pomiar czasu ramki, direct - scena
+// w penej rozdzielczoci rysowana bezporednio w oknie (bez kopiowania)
+
+static int scene_width = 0, scene_height = 0;
+static bool active = false, direct = false;
+static Clock::time_point frame_start;
+
+// pomiar czasu ramki na GPU: znaczniki czasu GL_TIMESTAMP na pocztku sceny
+// i po powikszeniu w piercieniu par zapyta (bez oczekiwania na GPU);
+// zapytania GL_TIME_ELAPSED nie mog by zagniedone, a modu profiler
+// mierzy nimi ca ramk; frame_scale - skala mierzonej ramki, pending -
+// wynik jeszcze nieodczytany
+
+struct TimerQuery
+{
+	GLuint begin = 0, end = 0;
+	GLfloat frame_scale = 1.0f;
+	bool pending = false;
+};
+
+static TimerQuery queries[QUERY_COUNT];
+static bool queries_created = false;
+static int next_query = 0, active_query = -1;
+
+// tekstura koloru o rozmiarach okna i obiekt bufora ramki z t tekstur
+// i buforem gbokoci; bez obiektw bufora ramki (np. SOFT_GL) scena
+// jest rysowana w lewym dolnym rogu okna i kopiowana do tekstury
+// (glCopyTexSubImage2D)
+
+static GLuint framebuffer = 0, color_texture = 0, depth_buffer = 0;
+static int buffer_width = 0, buffer_height = 0;
+static bool framebuffer_failed = false;
+
+// program cieniujcy powikszenia z wyostrzeniem (0 - filtr dwuliniowy
+// bez wyostrzenia) i pooenia zmiennych jednorodnych; program jest
+// tworzony tylko po wczeniu wyostrzenia - przy programowej rasteryzacji
+// (llvmpipe) pi prbek na piksel okna kosztuje tyle co rysowanie
+// prostej sceny
+
+static GLuint program = 0;
+static bool program_failed = false;
+static GLint texel_location = -1, limit_location = -1, sharpness_location = -1;
+
+static const char *vertex_shader =
+	"void main()\n"
+	"{\n"
+	"	gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+	"	gl_Position = ftransform();\n"
+	"}\n";
+
+// filtr dwuliniowy z mask wyostrzajc (rnica piksela i czterech
+// ssiadw); wsprzdne ssiadw s ograniczone do obszaru sceny, wic
+// przy krawdziach nie s pobierane teksele spoza narysowanego obrazu
+
+static const char *fragment_shader =
+	"uniform sampler2D image;\n"
+	"uniform vec2 texel;\n"
+	"uniform vec2 limit;\n"
+	"uniform float sharpness;\n"
+	"vec4 Fetch(vec2 coord)\n"
+	"{\n"
+	"	return texture2D(image, clamp(coord, 0.5 * texel, limit));\n"
+	"}\n"
+	"void main()\n"
+	"{\n"
+	"	vec2 coord = gl_TexCoord[0].st;\n"
+	"	vec4 center = Fetch(coord);\n"
+	"	vec4 around = Fetch(coord + vec2(texel.x, 0.0)) + Fetch(coord - vec2(texel.x, 0.0)) +\n"
+	"		Fetch(coord + vec2(0.0, texel.y)) + Fetch(coord - vec2(0.0, texel.y));\n"
+	"	gl_FragColor = clamp(center + sharpness * (4.0 * center - around), 0.0, 1.0);\n"
+	"}\n";
+
+static GLuint CompileShader(GLenum type, const char *source)
+{
+	const GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	GLint status = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status != GL_TRUE)
+	{
+		char log[1024] = "";
+		glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+		printf("Blad kompilacji programu cieniujacego:\n%s\n", log);
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+// utworzenie programu powikszenia przy pierwszym uyciu; przy bdzie
+// pozostaje filtr dwuliniowy
+
+static void CreateProgram()
+{
+	if (!sharpen || program != 0 || program_failed)
+		return;
+	program_failed = true;
+	if (!shaders || glUniform2f == NULL || glUniform1f == NULL)
+		return;
+
+	const GLuint vertex = CompileShader(GL_VERTEX_SHADER, vertex_shader);
+	const GLuint fragment = CompileShader(GL_FRAGMENT_SHADER, fragment_shader);
+	if (vertex == 0 || fragment == 0)
+	{
+		if (vertex != 0)
+			glDeleteShader(vertex);
+		if (fragment != 0)
+			glDeleteShader(fragment);
+		return;
+	}
+	program = glCreateProgram();
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE)
+	{
+		char log[1024] = "";
+		glGetProgramInfoLog(program, sizeof(log), NULL, log);
+		printf("Blad konsolidacji programu cieniujacego:\n%s\n", log);
+		glDeleteProgram(program);
+		program = 0;
+		return;
+	}
+	texel_location = glGetUniformLocation(program, "texel");
+	limit_location = glGetUniformLocation(program, "limit");
+	sharpness_location = glGetUniformLocation(program, "sharpness");
+	program_failed = false;
+}
+
+static void DeleteBuffer()
+{
+	if (framebuffer != 0)
+		glDeleteFramebuffers(1, &framebuffer);
+	if (depth_buffer != 0)
+		glDeleteRenderbuffers(1, &depth_buffer);
+	if (color_texture != 0)
+		glDeleteTextures(1, &color_texture);
+	framebuffer = color_texture = depth_buffer = 0;
+	buffer_width = buffer_height = 0;
+}
+
+// bufor ramki o rozmiarach okna (tworzony ponownie tylko po zmianie
+// rozmiarw okna - zmiana skali zmienia jedynie obszar renderingu)
+
+static void CreateBuffer(int width, int height)
+{
+	DeleteBuffer();
+
+	// tekstura koloru (bez zmiany biecego dowizania tekstury)
+	glPushAttrib(GL_TEXTURE_BIT);
+	glGenTextures(1, &color_texture);
+	glBindTexture(GL_TEXTURE_2D, color_texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glPopAttrib();
+	buffer_width = width;
+	buffer_height = height;
+	if (!framebuffer_objects || framebuffer_failed)
+		return;
+
+	// bufor gbokoci
+	glGenRenderbuffers(1, &depth_buffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_texture, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_buffer);
+	const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (!complete)
+	{
+		printf("Niekompletny obiekt bufora ramki - obraz sceny kopiowany z okna\n");
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &depth_buffer);
+		framebuffer = depth_buffer = 0;
+		framebuffer_failed = true;
+	}
+}
+
+// wsprzdne tekstury krawdzi okna: rodki skrajnych pikseli okna
+// trafiaj w rodki skrajnych tekseli obszaru sceny, wic filtr dwuliniowy
+// nie pobiera tekseli spoza obszaru
+
+static void EdgeCoords(int scene, int window, int buffer, GLfloat &first, GLfloat &last)
+{
+	const GLfloat ratio = (GLfloat)(scene - 1) / std::max(window - 1, 1);
+	first = (0.5f - 0.5f * ratio) / buffer;
+	last = (0.5f + (window - 0.5f) * ratio) / buffer;
+}
+
+// powikszenie obszaru sceny do caego okna (prostokt z tekstur bufora
+// ramki)
+
+static void Upscale()
+{
+	GLfloat s0, s1, t0, t1;
+	EdgeCoords(scene_width, window_width, buffer_width, s0, s1);
+	EdgeCoords(scene_height, window_height, buffer_height, t0, t1);
+
+	glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_FOG);
+	glDisable(GL_ALPHA_TEST);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_TEXTURE_1D);
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, color_texture);
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	const bool sharpened = sharpen && program != 0;
+	if (sharpened)
+	{
+		glUseProgram(program);
+		glUniform2f(texel_location, 1.0f / buffer_width, 1.0f / buffer_height);
+		glUniform2f(limit_location, (scene_width - 0.5f) / buffer_width, (scene_height - 0.5f) / buffer_height);
+		glUniform1f(sharpness_location, MAX_SHARPNESS * (MAX_SCALE - scale) / (MAX_SCALE - MIN_SCALE));
+	}
+	glBegin(GL_QUADS);
+	glTexCoord2f(s0, t0);
+	glVertex2f(-1.0f, -1.0f);
+	glTexCoord2f(s1, t0);
+	glVertex2f(1.0f, -1.0f);
+	glTexCoord2f(s1, t1);
+	glVertex2f(1.0f, 1.0f);
+	glTexCoord2f(s0, t1);
+	glVertex2f(-1.0f, 1.0f);
+	glEnd();
+	if (sharpened)
+		glUseProgram(0);
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+}
+
+// dobr skali na podstawie wygadzonego czasu ramki: koszt wypeniania
+// jest proporcjonalny do liczby pikseli, czyli do kwadratu skali;
+// frame_scale - skala mierzonej ramki (pomiar z GPU dotyczy ramki sprzed
+// 1-2 ramek, wic ta sama przyczyna nie zmniejsza skali kilka razy)
+
+static void Adjust(double milliseconds, GLfloat frame_scale)
+{
+	average = average < 0.0 ? milliseconds : average + SMOOTHING * (milliseconds - average);
+	if (average >= LOW_BUDGET * budget && average <= HIGH_BUDGET * budget)
+		return;
+	const double target = 0.5 * (LOW_BUDGET + HIGH_BUDGET) * budget;
+	GLfloat next = frame_scale * (GLfloat)sqrt(target / std::max(average, 0.001));
+	next = std::min(std::max(next, scale * (1.0f - MAX_STEP)), scale * (1.0f + MAX_STEP));
+	scale = std::min(std::max(next, MIN_SCALE), MAX_SCALE);
+}
+
+// odczyt wynikw zakoczonych pomiarw (od najstarszego) bez oczekiwania
+// na GPU
+
+static void CollectQueries()
+{
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		TimerQuery &q = queries[(next_query + i) % QUERY_COUNT];
+		if (!q.pending)
+			continue;
+		GLint available = 0;
+		glGetQueryObjectiv(q.end, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			break;
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(q.begin, GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(q.end, GL_QUERY_RESULT, &end);
+		q.pending = false;
+		if (end > begin)
+			Adjust((end - begin) / 1.0e6, q.frame_scale);
+	}
+}
+
+// pocztek pomiaru ramki - znacznik czasu w wolnej parze zapyta (przy
+// zajtym piercieniu ramka nie jest mierzona)
+
+static void MeasureBegin()
+{
+	if (!timer_query)
+	{
+		frame_start = Clock::now();
+		return;
+	}
+	if (!queries_created)
+	{
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			glGenQueries(1, &queries[i].begin);
+			glGenQueries(1, &queries[i].end);
+		}
+		queries_created = true;
+	}
+	CollectQueries();
+	active_query = -1;
+	TimerQuery &q = queries[next_query];
+	if (q.pending)
+		return;
+	glQueryCounter(q.begin, GL_TIMESTAMP);
+	q.frame_scale = direct ? MAX_SCALE : scale;
+	active_query = next_query;
+	next_query = (next_query + 1) % QUERY_COUNT;
+}
+
+// koniec pomiaru ramki (po powikszeniu); bez zapyta o czas (np. SOFT_GL)
+// - czas do zakoczenia rysowania (glFinish): przy programowej rasteryzacji
+// obraz i tak jest rysowany przez procesor przed wywietleniem ramki, wic
+// oczekiwanie nie opnia ramki (na karcie graficznej bez zapyta o czas -
+// kosztem rwnolegej pracy procesora i karty)
+
+static void MeasureEnd()
+{
+	if (timer_query)
+	{
+		if (active_query >= 0)
+		{
+			glQueryCounter(queries[active_query].end, GL_TIMESTAMP);
+			queries[active_query].pending = true;
+		}
+		return;
+	}
+	glFinish();
+	Adjust(std::chrono::duration<double, std::milli>(Clock::now() - frame_start).count(), direct ? MAX_SCALE : scale);
+}
+
+// warto opcji postaci --nazwa=warto lub NULL
+
+static const char *Option(const char *arg, const char *name)
+{
+	const size_t length = strlen(name);
+	return strncmp(arg, name, length) == 0 && arg[length] == '=' ? arg + length + 1 : NULL;
+}
+
+void DynamicResolutionOptions(int &argc, char *argv[])
+{
+	int count = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		const char *value = Option(argv[i], "--frame-budget");
+		if (value != NULL)
+		{
+			if (atof(value) > 0.0)
+			{
+				DynamicResolutionBudget(atof(value));
+				enabled = true;
+			}
+		}
+		else
+			if (strcmp(argv[i], "--sharpen") == 0)
+				sharpen = true;
+			else
+				argv[count++] = argv[i];
+	}
+	argc = count;
+	argv[argc] = NULL;
+}
+
+void DynamicResolutionEnable(bool enable)
+{
+	enabled = enable;
+	if (!enabled)
+	{
+		scale = MAX_SCALE;
+		average = -1.0;
+
+		// wyniki sprzed wyczenia s pomijane
+		for (int i = 0; i < QUERY_COUNT; i++)
+			queries[i].pending = false;
+	}
+}
+
+bool DynamicResolutionEnabled()
+{
+	return enabled;
+}
+
+void DynamicResolutionSharpen(bool enable)
+{
+	sharpen = enable;
+}
+
+bool DynamicResolutionSharpened()
+{
+	return sharpen;
+}
+
+void DynamicResolutionBudget(double milliseconds)
+{
+	budget = milliseconds;
+	average = -1.0;
+}
+
+void DynamicResolutionReshape(int width, int height)
+{
+	window_width = width;
+	window_height = height;
+}
+
+void DynamicResolutionBegin()
+{
+	active = false;
+	if (!enabled || window_width <= 0 || window_height <= 0)
+		return;
+
+	// przy penej rozdzielczoci tylko pomiar czasu
+	direct = scale >= MAX_SCALE;
+	if (!direct)
+	{
+		if (buffer_width != window_width || buffer_height != window_height)
+			CreateBuffer(window_width, window_height);
+		CreateProgram();
+		scene_width = std::max(1, (int)(window_width * scale + 0.5f));
+		scene_height = std::max(1, (int)(window_height * scale + 0.5f));
+		glViewport(0, 0, scene_width, scene_height);
+
+		// glClear nie zaley od obszaru renderingu - czyszczenie tylko
+		// obszaru sceny (przy rysowaniu w oknie cae okno jest potem
+		// zastpowane powikszonym obrazem)
+		if (framebuffer != 0)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+			glPushAttrib(GL_SCISSOR_BIT);
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(0, 0, scene_width, scene_height);
+		}
+	}
+	active = true;
+	MeasureBegin();
+}
+
+void DynamicResolutionEnd()
+{
+	if (!active)
+		return;
+	active = false;
+
+	if (!direct)
+	{
+		if (framebuffer != 0)
+		{
+			glPopAttrib();
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+		else
+		{
+			glPushAttrib(GL_TEXTURE_BIT);
+			glBindTexture(GL_TEXTURE_2D, color_texture);
+			glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, scene_width, scene_height);
+			glPopAttrib();
+		}
+		glViewport(0, 0, window_width, window_height);
+		Upscale();
+	}
+	MeasureEnd();
+}
+
+GLfloat DynamicResolutionScale()
+{
+	return enabled ? scale : MAX_SCALE;
+}
@@ -0,0 +1,61 @@
+#ifndef __GL_STATE__H__
+#define __GL_STATE__H__
+
+#include <GL/glut.h>
+
+// pami podrczna stanu OpenGL: funkcje State* zapamituj ostatnio
+// ustawione wartoci (wczenia, tekstury dowizane do celw, parametry
+// kadego obiektu tekstury, rodowisko tekstur, wskazwki, mieszanie,
+// test alfa, mga, parametry wiate) i pomijaj wywoania, ktre niczego
+// by nie zmieniy; stan zmieniany z pominiciem tych funkcji (bezporednie
+// wywoania OpenGL, glPopAttrib, listy wywietlania) wymaga StateInvalidate
+
+// liczba wywoa przekazanych do OpenGL i pominitych (w tym przekazanych
+// dowiza tekstur) oraz zapyta glGet*, na ktre nie byo odpowiedzi
+// w pamici podrcznej
+
+struct StateStats
+{
+	int issued = 0;
+	int filtered = 0;
+	int queried = 0;
+	int texture_binds = 0;
+};
+
+void StateEnable(GLenum cap);
+void StateDisable(GLenum cap);
+void StateBindTexture(GLenum target, GLuint texture);
+
+// parametry obiektu tekstury dowizanego do celu target
+void StateTexParameteri(GLenum target, GLenum pname, GLint param);
+
+void StateTexEnvi(GLenum target, GLenum pname, GLint param);
+void StateHintMode(GLenum target, GLenum mode);
+void StateBlendFunc(GLenum sfactor, GLenum dfactor);
+void StateAlphaFunc(GLenum func, GLclampf ref);
+void StateFogf(GLenum pname, GLfloat param);
+void StateFogfv(GLenum pname, const GLfloat *params);
+
+// pooenie i kierunek wiata zale od biecej macierzy modelowania,
+// wic GL_POSITION i GL_SPOT_DIRECTION s przekazywane zawsze
+void StateLightf(GLenum light, GLenum pname, GLfloat param);
+void StateLightfv(GLenum light, GLenum pname, const GLfloat *params);
+
+// odczyt stanu z pamici podrcznej zamiast glGet* (zapytanie wymusza
+// synchronizacj z potokiem OpenGL); warto nieustawiona funkcjami State*
+// od ostatniego StateInvalidate jest pobierana z OpenGL tylko raz
+
+GLboolean StateIsEnabled(GLenum cap);
+GLint StateGetTexParameteri(GLenum target, GLenum pname);
+GLint StateGetHint(GLenum target);
+
+// zapomnienie zapamitanego stanu - kolejne wywoania bd przekazane
+void StateInvalidate();
+
+// zakoczenie ramki - liczniki biecej ramki staj si licznikami
+// ostatniej ramki i s zerowane
+
+void StateFrameEnd();
+const StateStats &StateLastFrame();
+
+#endif // __GL_STATE__H__
@@ -0,0 +1,40 @@
+#ifndef __MESH_OPTIMIZE__H__
+#define __MESH_OPTIMIZE__H__
+
+// optymalizacja kolejnoci trjktw i wierzchokw siatki indeksowanej
+// pod ktem pamici podrcznej przetworzonych wierzchokw (post-transform
+// cache) oraz pobierania danych wierzchokw z pamici
+
+// domylny rozmiar pamici podrcznej wierzchokw (FIFO)
+
+const int VERTEX_CACHE_SIZE = 16;
+
+// statystyka pamici podrcznej wierzchokw:
+// acmr - rednia liczba przetworze wierzchokw na trjkt (0.5 - 3.0),
+// atvr - rednia liczba przetworze na uyty wierzchoek (1.0 - optimum)
+
+struct VertexCacheStats
+{
+	float acmr = 0.0f;
+	float atvr = 0.0f;
+};
+
+// symulacja pamici podrcznej FIFO o cache_size pozycjach dla trjktw
+// w podanej kolejnoci
+
+VertexCacheStats AnalyzeVertexCache(const int *triangles, int triangle_count, int vertex_count,
+	int cache_size = VERTEX_CACHE_SIZE);
+
+// zmiana kolejnoci trjktw algorytmem Tipsify (Sander, Nehab, Barczak
+// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw");
+// czas dziaania liniowy wzgldem liczby trjktw
+
+void OptimizeVertexCache(int *triangles, int triangle_count, int vertex_count, int cache_size = VERTEX_CACHE_SIZE);
+
+// zmiana kolejnoci wierzchokw (x, y, z) na kolejno pierwszego uycia
+// przez trjkty i poprawienie indeksw; nieuywane wierzchoki s usuwane;
+// zwraca now liczb wierzchokw
+
+int OptimizeVertexFetch(float *vertices, int vertex_count, int *triangles, int triangle_count);
+
+#endif // __MESH_OPTIMIZE__H__
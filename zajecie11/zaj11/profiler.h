@@ -0,0 +1,65 @@
+#ifndef __PROFILER__H__
+#define __PROFILER__H__
+
+#include <GL/glut.h>
+
+// pomiar wydajnoci ramek: czas CPU funkcji generujcej scen (zegar
+// wysokiej rozdzielczoci), czas GPU (zapytania GL_TIME_ELAPSED w piercieniu
+// kilku obiektw zapyta - wynik odczytywany jest kilka ramek pniej, gdy
+// jest ju dostpny, wic pomiar nie wstrzymuje potoku OpenGL) oraz liczniki
+// wywoa rysujcych, wierzchokw, dowiza tekstur i zmian stanu;
+// przy zakoczeniu programu zapisywany jest plik CSV z danymi kadej ramki
+// i wypisywane s percentyle p50/p95/p99 czasw ramek
+
+// dane jednej ramki; gpu_ms < 0 - czas GPU niedostpny
+
+struct ProfilerFrame
+{
+	double time_ms = 0.0; // pocztek ramki od uruchomienia pomiaru
+	double cpu_ms = 0.0;
+	double gpu_ms = -1.0;
+	int draw_calls = 0;
+	int vertices = 0;
+	int texture_binds = 0;
+	int state_changes = 0;
+};
+
+// rozpoczcie pomiaru; wywoywana po ExtensionFunctionsSetup
+// csv_file - nazwa pliku z danymi ramek (NULL - bez pliku)
+
+void ProfilerInit(const char *csv_file);
+
+// funkcja generujca scen otoczona pomiarem (do glutDisplayFunc lub RedrawInit)
+
+void(*ProfilerWrap(void(*display)()))();
+
+// pocztek i koniec ramki (gdy funkcja generujca scen nie jest otoczona
+// przez ProfilerWrap)
+
+void ProfilerFrameBegin();
+void ProfilerFrameEnd();
+
+// liczniki biecej ramki: wywoania rysujce (glDrawArrays, glDrawElements,
+// glBegin/glEnd, glCallList) z czn liczb wierzchokw, dowizania
+// tekstur, zmiany stanu OpenGL
+
+void ProfilerDraw(int vertices, int calls = 1);
+void ProfilerTextureBind(int count = 1);
+void ProfilerStateChanges(int count);
+
+// wykres czasw ostatnich ramek w prawym dolnym rogu okna (CPU - supki,
+// GPU - linia, poziome linie 16,7 ms i 33,3 ms); wywoywana przed glFlush
+// lub glutSwapBuffers; nie zmienia stanu OpenGL
+
+void ProfilerOverlay(int width, int height);
+
+// dane ostatniej zakoczonej ramki (czas GPU tej ramki moe by jeszcze
+// niedostpny - zob. ProfilerLastGpu)
+
+const ProfilerFrame &ProfilerLastFrame();
+
+// ostatni odczytany czas GPU [ms] (-1 - brak)
+
+double ProfilerLastGpu();
+
+#endif // __PROFILER__H__
@@ -0,0 +1,147 @@
+#include "pyramid.h"
+#include <math.h>
+
+long long PyramidTriangleCount(const PyramidParams &params)
+{
+	const long long n = params.sides;
+	const long long caps = params.base ? (params.top_radius > 0.0f ? 2 : 1) : 0;
+	const long long side = params.top_radius > 0.0f ? 2 * n * params.stacks : n * (2 * params.stacks - 1);
+	return caps * n * (2 * params.rings - 1) + side;
+}
+
+// dodanie piercienia sides wierzchokw o promieniu r na wysokoci h;
+// zwraca indeks pierwszego wierzchoka
+
+static int Ring(const PyramidParams &params, PyramidMesh &mesh, float r, float h)
+{
+	const int first = (int)mesh.vertices.size() / 3;
+	for (int i = 0; i < params.sides; i++)
+	{
+		const float a = 2.0f * 3.14159265f * i / params.sides;
+		mesh.vertices.push_back(r * sinf(a));
+		mesh.vertices.push_back(params.z_up ? r * cosf(a) : h);
+		mesh.vertices.push_back(params.z_up ? h : r * cosf(a));
+	}
+	return first;
+}
+
+static int Center(const PyramidParams &params, PyramidMesh &mesh, float h)
+{
+	const int index = (int)mesh.vertices.size() / 3;
+	mesh.vertices.push_back(0.0f);
+	mesh.vertices.push_back(params.z_up ? 0.0f : h);
+	mesh.vertices.push_back(params.z_up ? h : 0.0f);
+	return index;
+}
+
+// trjkt podany w orientacji dla osi Z; przy osi Y kierunek obiegu
+// wierzchokw podstawy jest przeciwny, wic kolejno jest odwracana
+
+static void Triangle(const PyramidParams &params, PyramidMesh &mesh, int a, int b, int c)
+{
+	mesh.triangles.push_back(a);
+	mesh.triangles.push_back(params.z_up ? b : c);
+	mesh.triangles.push_back(params.z_up ? c : b);
+}
+
+// podstawa: wachlarz wok rodka i pasy midzy kolejnymi piercieniami;
+// ring[k] - pierwszy wierzchoek piercienia k (k = 0 - najbliszy rodka),
+// outward_down - podstawa dolna (normalna w kierunku -osi)
+
+static void Cap(const PyramidParams &params, PyramidMesh &mesh, int center, const std::vector<int> &ring, bool outward_down)
+{
+	const int n = params.sides;
+	for (int i = 0; i < n; i++)
+	{
+		const int j = (i + 1) % n;
+		if (outward_down)
+			Triangle(params, mesh, center, ring[0] + i, ring[0] + j);
+		else
+			Triangle(params, mesh, center, ring[0] + j, ring[0] + i);
+		for (size_t k = 1; k < ring.size(); k++)
+		{
+			const int in = ring[k - 1], out = ring[k];
+			if (outward_down)
+			{
+				Triangle(params, mesh, in + i, out + i, out + j);
+				Triangle(params, mesh, in + i, out + j, in + j);
+			}
+			else
+			{
+				Triangle(params, mesh, in + i, out + j, out + i);
+				Triangle(params, mesh, in + i, in + j, out + j);
+			}
+		}
+	}
+}
+
+void GeneratePyramid(const PyramidParams &params, PyramidMesh &mesh)
+{
+	PyramidParams p = params;
+	if (p.sides < 3)
+		p.sides = 3;
+	if (p.rings < 1)
+		p.rings = 1;
+	if (p.stacks < 1)
+		p.stacks = 1;
+	const bool prism = p.top_radius > 0.0f;
+	const int n = p.sides;
+
+	mesh.vertices.clear();
+	mesh.triangles.clear();
+	mesh.triangles.reserve(3 * (size_t)PyramidTriangleCount(p));
+
+	// dolna podstawa: rodek i piercienie wewntrzne
+	std::vector<int> bottom_rings, top_rings;
+	int bottom_center = -1, top_center = -1;
+	if (p.base)
+	{
+		bottom_center = Center(p, mesh, p.bottom);
+		for (int k = 1; k < p.rings; k++)
+			bottom_rings.push_back(Ring(p, mesh, p.radius * k / p.rings, p.bottom));
+	}
+
+	// wiersze cian bocznych; wiersz 0 jest zewntrznym piercieniem dolnej podstawy
+	std::vector<int> rows;
+	const int ring_rows = prism ? p.stacks + 1 : p.stacks;
+	for (int j = 0; j < ring_rows; j++)
+	{
+		const float t = (float)j / p.stacks;
+		rows.push_back(Ring(p, mesh, p.radius + (p.top_radius - p.radius) * t, p.bottom + (p.top - p.bottom) * t));
+	}
+	const int apex = prism ? -1 : Center(p, mesh, p.top);
+
+	// grna podstawa graniastosupa
+	if (p.base && prism)
+	{
+		for (int k = p.rings - 1; k >= 1; k--)
+			top_rings.insert(top_rings.begin(), Ring(p, mesh, p.top_radius * k / p.rings, p.top));
+		top_center = Center(p, mesh, p.top);
+	}
+
+	// trjkty podstaw
+	if (p.base)
+	{
+		bottom_rings.push_back(rows.front());
+		Cap(p, mesh, bottom_center, bottom_rings, true);
+		if (prism)
+		{
+			top_rings.push_back(rows.back());
+			Cap(p, mesh, top_center, top_rings, false);
+		}
+	}
+	mesh.base_triangles = (int)mesh.triangles.size() / 3;
+
+	// trjkty cian bocznych
+	for (int j = 0; j + 1 < ring_rows; j++)
+		for (int i = 0; i < n; i++)
+		{
+			const int k = (i + 1) % n;
+			const int lower = rows[j], upper = rows[j + 1];
+			Triangle(p, mesh, lower + k, lower + i, upper + i);
+			Triangle(p, mesh, lower + k, upper + i, upper + k);
+		}
+	if (!prism)
+		for (int i = 0; i < n; i++)
+			Triangle(p, mesh, rows.back() + (i + 1) % n, rows.back() + i, apex);
+}
@@ -0,0 +1,2855 @@
+#define _USE_MATH_DEFINES
+#include "soft_gl.h"
+#include "soft_raster.h"
+#include "transform.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// w tym pliku wywoywane s wycznie funkcje sgl* (nazwy gl* mog by
+// makrami z soft_gl.h)
+
+// najwikszy rozmiar tekstury i gboko stosw
+
+const int MAX_TEXTURE_SIZE = 4096;
+const int MAX_STACK_DEPTH = 32;
+const int MAX_LIGHTS = 8;
+
+// rdo wiata; pooenie i kierunek reflektora we wsprzdnych
+// obserwatora (przeksztacone macierz modelowania przy glLightfv)
+
+struct Light
+{
+	GLfloat ambient[4];
+	GLfloat diffuse[4];
+	GLfloat specular[4];
+	GLfloat position[4];
+	GLfloat spot_direction[3];
+	GLfloat spot_exponent;
+	GLfloat spot_cutoff;
+	GLfloat attenuation[3];       // stae, liniowe, kwadratowe
+};
+
+struct Material
+{
+	GLfloat ambient[4];
+	GLfloat diffuse[4];
+	GLfloat specular[4];
+	GLfloat emission[4];
+	GLfloat shininess;
+};
+
+// stan serwera pogrupowany wedug bitw glPushAttrib
+
+struct CurrentState           // GL_CURRENT_BIT
+{
+	GLfloat color[4];
+	GLfloat normal[3];
+	GLfloat texcoord[4];
+};
+
+struct EnableState            // GL_ENABLE_BIT
+{
+	bool alpha_test, blend, color_material, cull_face, depth_test, fog, lighting, normalize, polygon_offset,
+		texture_1d, texture_2d;
+	bool light[MAX_LIGHTS];
+	std::set<GLenum> other;       // opcje bez wpywu na rysowanie
+};
+
+struct DepthState             // GL_DEPTH_BUFFER_BIT
+{
+	GLenum func;
+	bool mask;
+	GLfloat clear;
+};
+
+struct ColorBufferState       // GL_COLOR_BUFFER_BIT
+{
+	GLenum alpha_func;
+	GLfloat alpha_ref;
+	GLenum blend_src, blend_dst;
+	GLfloat clear[4];
+};
+
+struct FogState               // GL_FOG_BIT
+{
+	GLenum mode;
+	GLfloat density, start, end;
+	GLfloat color[4];
+};
+
+struct LightingState          // GL_LIGHTING_BIT
+{
+	Light lights[MAX_LIGHTS];
+	Material materials[2];        // strona przednia i tylna
+	GLfloat model_ambient[4];
+	bool two_side, local_viewer;
+	GLenum shade_model;
+	GLenum color_material_face, color_material_mode;
+};
+
+struct PolygonState           // GL_POLYGON_BIT
+{
+	GLenum cull_face, front_face;
+	GLfloat offset_factor, offset_units;
+};
+
+struct TextureState           // GL_TEXTURE_BIT
+{
+	GLuint binding_1d, binding_2d;
+	GLenum env_mode;
+};
+
+struct ViewportState          // GL_VIEWPORT_BIT
+{
+	GLint x, y, width, height;
+	GLfloat near_value, far_value;
+};
+
+struct ServerState
+{
+	CurrentState current;
+	EnableState enable;
+	DepthState depth;
+	ColorBufferState color_buffer;
+	FogState fog;
+	LightingState lighting;
+	PolygonState polygon;
+	TextureState texture;
+	GLenum matrix_mode;           // GL_TRANSFORM_BIT
+	ViewportState viewport;
+	GLfloat point_size;           // GL_POINT_BIT
+	GLfloat line_width;           // GL_LINE_BIT
+	std::map<GLenum, GLenum> hints; // GL_HINT_BIT
+};
+
+// tablice wierzchokw; buffer - obiekt buforowy zwizany z GL_ARRAY_BUFFER
+// przy wywoaniu gl*Pointer (pointer jest wtedy przesuniciem w buforze)
+
+struct ArrayPointer
+{
+	bool enabled = false;
+	GLint size = 4;
+	GLenum type = GL_FLOAT;
+	GLsizei stride = 0;
+	const GLvoid *pointer = NULL;
+	GLuint buffer = 0;
+};
+
+struct ClientState
+{
+	ArrayPointer vertex, normal, color, texcoord;   // GL_CLIENT_VERTEX_ARRAY_BIT
+	GLuint array_buffer = 0, element_buffer = 0;
+	GLint unpack_alignment = 4, pack_alignment = 4; // GL_CLIENT_PIXEL_STORE_BIT
+};
+
+// obiekt tekstury; target == 0 - nazwa jeszcze nie zwizana
+
+struct Texture
+{
+	RasterTexture raster;
+	GLenum target = 0;
+	bool generate_mipmap = false;
+};
+
+// wierzchoek po przeksztaceniach: wsprzdne obcinania, kolory strony
+// przedniej i tylnej, wsprzdne tekstury i wsprzdna mgy
+
+struct SoftVertex
+{
+	GLfloat clip[4];
+	GLfloat front[4], back[4];
+	GLfloat s, t;
+	GLfloat fog;
+};
+
+// wierzchoek odczytany z tablic (dla tablic wyczonych - bez znaczenia)
+
+struct ArrayVertex
+{
+	GLfloat position[4];
+	GLfloat color[4];
+	GLfloat normal[3];
+	GLfloat texcoord[4];
+};
+
+// tablice uyte przy rysowaniu z tablic wierzchokw
+
+enum
+{
+	ARRAY_COLOR = 1,
+	ARRAY_NORMAL = 2,
+	ARRAY_TEXCOORD = 4
+};
+
+typedef std::vector<std::function<void()> > DisplayList;
+
+static ServerState state;
+static std::vector<std::pair<GLbitfield, ServerState> > attrib_stack;
+static ClientState client;
+static std::vector<std::pair<GLbitfield, ClientState> > client_stack;
+static MatrixStack modelview, projection, texture_matrix;
+static GLenum error = GL_NO_ERROR;
+
+// macierz normalnych (odwrotna transponowana do macierzy modelowania, 3 x 3
+// kolumnami) i informacja, czy macierz tekstury jest jednostkowa
+
+static GLfloat normal_matrix[9];
+static bool normal_matrix_valid = false;
+static bool texture_matrix_identity = true;
+
+// stan rasteryzatora wymaga uaktualnienia przed kolejnym prymitywem
+
+static bool raster_dirty = true;
+
+static std::map<GLuint, Texture> textures;
+static Texture default_textures[2];           // obiekty 0 dla GL_TEXTURE_1D i GL_TEXTURE_2D
+static GLuint next_texture = 1;
+
+static std::map<GLuint, std::vector<GLubyte> > buffers;
+static GLuint next_buffer = 1;
+
+static std::map<GLuint, DisplayList> lists;
+static GLuint next_list = 1;
+static DisplayList compiled;
+static GLuint compiled_name = 0;
+static bool compiling = false, compile_only = false;
+
+// wierzchoki midzy glBegin i glEnd
+
+static bool inside_begin = false;
+static GLenum begin_mode = GL_POINTS;
+static std::vector<SoftVertex> batch;
+
+static char renderer[64] = "SoftGL";
+
+// zapis wywoania w kompilowanej licie wywietlania (argumenty kopiowane
+// do domknicia); przy GL_COMPILE funkcja koczy si bez wykonania
+
+#define RECORD(call) \
+	if (compiling) \
+	{ \
+		compiled.push_back([=]() { call; }); \
+		if (compile_only) \
+			return; \
+	}
+
+// kopia tablicy parametrw zapisywana w licie wywietlania
+
+struct Values
+{
+	GLfloat v[16];
+};
+
+static Values CopyValues(const GLfloat *params, int count)
+{
+	Values values;
+	memset(values.v, 0, sizeof(values.v));
+	memcpy(values.v, params, count * sizeof(GLfloat));
+	return values;
+}
+
+// liczba wartoci parametru funkcji gl*fv
+
+static int ValueCount(GLenum pname)
+{
+	switch (pname)
+	{
+	case GL_AMBIENT:
+	case GL_DIFFUSE:
+	case GL_SPECULAR:
+	case GL_EMISSION:
+	case GL_AMBIENT_AND_DIFFUSE:
+	case GL_POSITION:
+	case GL_FOG_COLOR:
+	case GL_LIGHT_MODEL_AMBIENT:
+		return 4;
+	case GL_SPOT_DIRECTION:
+		return 3;
+	default:
+		return 1;
+	}
+}
+
+// komunikaty o nieobsugiwanych wywoaniach (raz dla kadej wartoci)
+
+static void Unsupported(const char *what, GLenum value)
+{
+	static std::set<std::pair<std::string, GLenum> > reported;
+	if (reported.insert(std::make_pair(std::string(what), value)).second)
+		printf("SoftGL: nieobslugiwane %s 0x%04X\n", what, value);
+}
+
+// wywoanie, ktre nie jest zapisywane w licie wywietlania, tylko
+// wykonywane od razu
+
+static void NotCompiled(const char *name)
+{
+	static std::set<std::string> reported;
+	if (compiling && reported.insert(name).second)
+		printf("SoftGL: %s w liscie wyswietlania jest wykonywane od razu\n", name);
+}
+
+static void SetError(GLenum code)
+{
+	if (error == GL_NO_ERROR)
+		error = code;
+}
+
+static void Copy4(GLfloat *out, GLfloat a, GLfloat b, GLfloat c, GLfloat d)
+{
+	out[0] = a;
+	out[1] = b;
+	out[2] = c;
+	out[3] = d;
+}
+
+static inline GLfloat Clamp(GLfloat value)
+{
+	return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+}
+
+static void DefaultState()
+{
+	state = ServerState();
+	Copy4(state.current.color, 1.0f, 1.0f, 1.0f, 1.0f);
+	state.current.normal[0] = state.current.normal[1] = 0.0f;
+	state.current.normal[2] = 1.0f;
+	Copy4(state.current.texcoord, 0.0f, 0.0f, 0.0f, 1.0f);
+
+	EnableState &enable = state.enable;
+	enable.alpha_test = enable.blend = enable.color_material = enable.cull_face = enable.depth_test = false;
+	enable.fog = enable.lighting = enable.normalize = enable.polygon_offset = false;
+	enable.texture_1d = enable.texture_2d = false;
+	for (int i = 0; i < MAX_LIGHTS; i++)
+		enable.light[i] = false;
+	enable.other.insert(GL_DITHER);
+
+	state.depth.func = GL_LESS;
+	state.depth.mask = true;
+	state.depth.clear = 1.0f;
+
+	state.color_buffer.alpha_func = GL_ALWAYS;
+	state.color_buffer.alpha_ref = 0.0f;
+	state.color_buffer.blend_src = GL_ONE;
+	state.color_buffer.blend_dst = GL_ZERO;
+	Copy4(state.color_buffer.clear, 0.0f, 0.0f, 0.0f, 0.0f);
+
+	state.fog.mode = GL_EXP;
+	state.fog.density = 1.0f;
+	state.fog.start = 0.0f;
+	state.fog.end = 1.0f;
+	Copy4(state.fog.color, 0.0f, 0.0f, 0.0f, 0.0f);
+
+	LightingState &lighting = state.lighting;
+	for (int i = 0; i < MAX_LIGHTS; i++)
+	{
+		Light &light = lighting.lights[i];
+		const GLfloat value = i == 0 ? 1.0f : 0.0f;
+		Copy4(light.ambient, 0.0f, 0.0f, 0.0f, 1.0f);
+		Copy4(light.diffuse, value, value, value, 1.0f);
+		Copy4(light.specular, value, value, value, 1.0f);
+		Copy4(light.position, 0.0f, 0.0f, 1.0f, 0.0f);
+		light.spot_direction[0] = light.spot_direction[1] = 0.0f;
+		light.spot_direction[2] = -1.0f;
+		light.spot_exponent = 0.0f;
+		light.spot_cutoff = 180.0f;
+		light.attenuation[0] = 1.0f;
+		light.attenuation[1] = light.attenuation[2] = 0.0f;
+	}
+	for (int i = 0; i < 2; i++)
+	{
+		Material &material = lighting.materials[i];
+		Copy4(material.ambient, 0.2f, 0.2f, 0.2f, 1.0f);
+		Copy4(material.diffuse, 0.8f, 0.8f, 0.8f, 1.0f);
+		Copy4(material.specular, 0.0f, 0.0f, 0.0f, 1.0f);
+		Copy4(material.emission, 0.0f, 0.0f, 0.0f, 1.0f);
+		material.shininess = 0.0f;
+	}
+	Copy4(lighting.model_ambient, 0.2f, 0.2f, 0.2f, 1.0f);
+	lighting.two_side = lighting.local_viewer = false;
+	lighting.shade_model = GL_SMOOTH;
+	lighting.color_material_face = GL_FRONT_AND_BACK;
+	lighting.color_material_mode = GL_AMBIENT_AND_DIFFUSE;
+
+	state.polygon.cull_face = GL_BACK;
+	state.polygon.front_face = GL_CCW;
+	state.polygon.offset_factor = state.polygon.offset_units = 0.0f;
+
+	state.texture.binding_1d = state.texture.binding_2d = 0;
+	state.texture.env_mode = GL_MODULATE;
+
+	state.matrix_mode = GL_MODELVIEW;
+	state.viewport.x = state.viewport.y = 0;
+	state.viewport.width = state.viewport.height = 0;
+	state.viewport.near_value = 0.0f;
+	state.viewport.far_value = 1.0f;
+	state.point_size = 1.0f;
+	state.line_width = 1.0f;
+}
+
+// ---------------------------------------------------------------------------
+// macierze
+
+static MatrixStack &CurrentStack()
+{
+	switch (state.matrix_mode)
+	{
+	case GL_PROJECTION:
+		return projection;
+	case GL_TEXTURE:
+		return texture_matrix;
+	default:
+		return modelview;
+	}
+}
+
+static void MatrixChanged()
+{
+	if (state.matrix_mode == GL_MODELVIEW)
+		normal_matrix_valid = false;
+	else if (state.matrix_mode == GL_TEXTURE)
+	{
+		const Matrix identity = MatrixIdentity();
+		texture_matrix_identity = memcmp(MatrixStackTop(texture_matrix).m, identity.m, sizeof(identity.m)) == 0;
+	}
+}
+
+static void MultiplyCurrent(const Matrix &matrix)
+{
+	MatrixStackMultiply(CurrentStack(), matrix);
+	MatrixChanged();
+}
+
+static void Transform(const Matrix &matrix, const GLfloat *v, GLfloat *out)
+{
+	const GLfloat *m = matrix.m;
+	for (int i = 0; i < 4; i++)
+		out[i] = m[i] * v[0] + m[4 + i] * v[1] + m[8 + i] * v[2] + m[12 + i] * v[3];
+}
+
+// odwrotna transponowana grnej czci 3 x 3 macierzy modelowania
+// (dopenienia algebraiczne podzielone przez wyznacznik)
+
+static const GLfloat *NormalMatrix()
+{
+	if (normal_matrix_valid)
+		return normal_matrix;
+	const GLfloat *m = MatrixStackTop(modelview).m;
+	const GLfloat a = m[0], b = m[4], c = m[8], d = m[1], e = m[5], f = m[9], g = m[2], h = m[6], i = m[10];
+	const GLfloat A = e * i - f * h, B = f * g - d * i, C = d * h - e * g;
+	const GLfloat det = a * A + b * B + c * C;
+	const GLfloat inverse = det != 0.0f ? 1.0f / det : 0.0f;
+
+	// kolumny macierzy normalnych = wiersze macierzy dopenie
+	normal_matrix[0] = A * inverse;
+	normal_matrix[1] = B * inverse;
+	normal_matrix[2] = C * inverse;
+	normal_matrix[3] = (c * h - b * i) * inverse;
+	normal_matrix[4] = (a * i - c * g) * inverse;
+	normal_matrix[5] = (b * g - a * h) * inverse;
+	normal_matrix[6] = (b * f - c * e) * inverse;
+	normal_matrix[7] = (c * d - a * f) * inverse;
+	normal_matrix[8] = (a * e - b * d) * inverse;
+	normal_matrix_valid = true;
+	return normal_matrix;
+}
+
+static Matrix ToMatrix(const GLfloat *m)
+{
+	Matrix matrix;
+	memcpy(matrix.m, m, sizeof(matrix.m));
+	return matrix;
+}
+
+static Matrix ToMatrix(const GLdouble *m)
+{
+	Matrix matrix;
+	for (int i = 0; i < 16; i++)
+		matrix.m[i] = (GLfloat)m[i];
+	return matrix;
+}
+
+// ---------------------------------------------------------------------------
+// tekstury
+
+static Texture &BoundTexture(GLenum target)
+{
+	const GLuint name = target == GL_TEXTURE_1D ? state.texture.binding_1d : state.texture.binding_2d;
+	if (name == 0)
+		return default_textures[target == GL_TEXTURE_1D ? 0 : 1];
+	return textures[name];
+}
+
+// tekstura moe by uywana przez prymitywy w kolejce rasteryzatora -
+// przed zmian trzeba je narysowa
+
+static void TextureChanging()
+{
+	RasterFlush();
+	raster_dirty = true;
+}
+
+// kompletno tekstury: przy filtrach z mipmapami potrzebne s wszystkie
+// poziomy a do 1 x 1
+
+static bool Complete(const RasterTexture &texture)
+{
+	if (texture.levels.empty() || texture.levels[0].width == 0)
+		return false;
+	if (texture.min_filter == GL_NEAREST || texture.min_filter == GL_LINEAR)
+		return true;
+	int width = texture.levels[0].width, height = texture.levels[0].height;
+	for (size_t i = 0; i < texture.levels.size(); i++)
+	{
+		if (texture.levels[i].width != width || texture.levels[i].height != height)
+			return false;
+		if (width == 1 && height == 1)
+			return i + 1 == texture.levels.size();
+		width = std::max(1, width / 2);
+		height = std::max(1, height / 2);
+	}
+	return false;
+}
+
+// tekstura uywana przy rysowaniu (GL_TEXTURE_2D ma pierwszestwo;
+// tekstura niekompletna wycza teksturowanie)
+
+static const RasterTexture *ActiveTexture()
+{
+	if (state.enable.texture_2d || state.enable.texture_1d)
+	{
+		const Texture &texture = BoundTexture(state.enable.texture_2d ? GL_TEXTURE_2D : GL_TEXTURE_1D);
+		if (Complete(texture.raster))
+			return &texture.raster;
+	}
+	return NULL;
+}
+
+// poziom o poow mniejszy (rednia z blokw 2 x 2 tekseli)
+
+static void Downsample(const RasterLevel &source, RasterLevel &level)
+{
+	level.width = std::max(1, source.width / 2);
+	level.height = std::max(1, source.height / 2);
+	level.texels.resize(level.width * level.height);
+	const int dx = source.width > 1 ? 1 : 0, dy = source.height > 1 ? 1 : 0;
+	for (int y = 0; y < level.height; y++)
+		for (int x = 0; x < level.width; x++)
+		{
+			const GLuint *row0 = &source.texels[std::min(2 * y, source.height - 1) * source.width];
+			const GLuint *row1 = &source.texels[std::min(2 * y + dy, source.height - 1) * source.width];
+			const int x0 = std::min(2 * x, source.width - 1), x1 = std::min(2 * x + dx, source.width - 1);
+			const GLuint t[4] = { row0[x0], row0[x1], row1[x0], row1[x1] };
+			GLuint texel = 0;
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				GLuint sum = 2;
+				for (int k = 0; k < 4; k++)
+					sum += t[k] >> shift & 0xFF;
+				texel |= (sum / 4) << shift;
+			}
+			level.texels[y * level.width + x] = texel;
+		}
+}
+
+static void GenerateMipmaps(RasterTexture &texture)
+{
+	texture.levels.resize(1);
+	while (texture.levels.back().width > 1 || texture.levels.back().height > 1)
+	{
+		RasterLevel level;
+		Downsample(texture.levels.back(), level);
+		texture.levels.push_back(level);
+	}
+}
+
+// format bazowy dla wewntrznego formatu tekstury
+
+static GLenum BaseFormat(GLint internal_format)
+{
+	switch (internal_format)
+	{
+	case GL_ALPHA:
+	case GL_ALPHA4:
+	case GL_ALPHA8:
+	case GL_ALPHA12:
+	case GL_ALPHA16:
+		return GL_ALPHA;
+	case 1:
+	case GL_LUMINANCE:
+	case GL_LUMINANCE4:
+	case GL_LUMINANCE8:
+	case GL_LUMINANCE12:
+	case GL_LUMINANCE16:
+		return GL_LUMINANCE;
+	case 2:
+	case GL_LUMINANCE_ALPHA:
+	case GL_LUMINANCE4_ALPHA4:
+	case GL_LUMINANCE8_ALPHA8:
+	case GL_LUMINANCE12_ALPHA12:
+	case GL_LUMINANCE16_ALPHA16:
+		return GL_LUMINANCE_ALPHA;
+	case GL_INTENSITY:
+	case GL_INTENSITY4:
+	case GL_INTENSITY8:
+	case GL_INTENSITY12:
+	case GL_INTENSITY16:
+		return GL_INTENSITY;
+	case 3:
+	case GL_RGB:
+	case GL_BGR:
+	case GL_R3_G3_B2:
+	case GL_RGB4:
+	case GL_RGB5:
+	case GL_RGB8:
+	case GL_RGB10:
+	case GL_RGB12:
+	case GL_RGB16:
+		return GL_RGB;
+	default:
+		return GL_RGBA;
+	}
+}
+
+// odczyt obrazu (GL_UNSIGNED_BYTE, wiersze wyrwnane do GL_UNPACK_ALIGNMENT)
+// do tekseli RGBA wedug formatu bazowego base (brakujce skadowe - 255);
+// pixels == NULL - obraz wypeniony zerami
+
+static bool ReadImage(GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels, GLenum base,
+	std::vector<GLuint> &texels)
+{
+	if (type != GL_UNSIGNED_BYTE)
+	{
+		Unsupported("typ danych tekstury", type);
+		return false;
+	}
+	int components;
+	switch (format)
+	{
+	case GL_RGB:
+	case GL_BGR:
+		components = 3;
+		break;
+	case GL_RGBA:
+	case GL_BGRA:
+		components = 4;
+		break;
+	case GL_LUMINANCE_ALPHA:
+		components = 2;
+		break;
+	case GL_ALPHA:
+	case GL_LUMINANCE:
+	case GL_RED:
+		components = 1;
+		break;
+	default:
+		Unsupported("format tekstury", format);
+		return false;
+	}
+
+	texels.assign(width * height, 0);
+	if (pixels == NULL)
+		return true;
+	const int alignment = client.unpack_alignment;
+	const int row_size = (width * components + alignment - 1) / alignment * alignment;
+	for (int y = 0; y < height; y++)
+	{
+		const GLubyte *p = (const GLubyte*)pixels + y * row_size;
+		for (int x = 0; x < width; x++, p += components)
+		{
+			// skadowe RGBA obrazu rdowego
+			GLuint r = 0, g = 0, b = 0, a = 255;
+			switch (format)
+			{
+			case GL_RGB:
+				r = p[0], g = p[1], b = p[2];
+				break;
+			case GL_BGR:
+				r = p[2], g = p[1], b = p[0];
+				break;
+			case GL_RGBA:
+				r = p[0], g = p[1], b = p[2], a = p[3];
+				break;
+			case GL_BGRA:
+				r = p[2], g = p[1], b = p[0], a = p[3];
+				break;
+			case GL_LUMINANCE_ALPHA:
+				r = g = b = p[0], a = p[1];
+				break;
+			case GL_ALPHA:
+				a = p[0];
+				break;
+			case GL_LUMINANCE:
+				r = g = b = p[0];
+				break;
+			default:
+				r = p[0];
+				break;
+			}
+
+			// skadowe formatu bazowego (luminancja i intensywno - skadowa R)
+			switch (base)
+			{
+			case GL_ALPHA:
+				r = g = b = 255;
+				break;
+			case GL_LUMINANCE:
+				g = b = r, a = 255;
+				break;
+			case GL_LUMINANCE_ALPHA:
+				g = b = r;
+				break;
+			case GL_INTENSITY:
+				g = b = a = r;
+				break;
+			case GL_RGB:
+				a = 255;
+				break;
+			}
+			texels[y * width + x] = r | g << 8 | b << 16 | a << 24;
+		}
+	}
+	return true;
+}
+
+// zapis poziomu level tekstury zwizanej z target
+
+static void SetImage(GLenum target, GLint level, GLenum base, int width, int height, std::vector<GLuint> &texels)
+{
+	TextureChanging();
+	Texture &texture = BoundTexture(target);
+	RasterTexture &raster = texture.raster;
+	if ((int)raster.levels.size() <= level)
+		raster.levels.resize(level + 1);
+	RasterLevel &image = raster.levels[level];
+	image.width = width;
+	image.height = height;
+	image.texels.swap(texels);
+	if (level == 0)
+	{
+		raster.has_color = base != GL_ALPHA;
+		raster.has_alpha = base == GL_ALPHA || base == GL_LUMINANCE_ALPHA || base == GL_INTENSITY || base == GL_RGBA;
+		if (texture.generate_mipmap)
+			GenerateMipmaps(raster);
+	}
+}
+
+static bool TextureTarget(GLenum target)
+{
+	if (target == GL_TEXTURE_1D || target == GL_TEXTURE_2D)
+		return true;
+	Unsupported("rodzaj tekstury", target);
+	return false;
+}
+
+// ---------------------------------------------------------------------------
+// przeksztacenie wierzchokw i owietlenie
+
+static void ApplyColorMaterial(const GLfloat *color)
+{
+	const LightingState &lighting = state.lighting;
+	for (int face = 0; face < 2; face++)
+	{
+		if ((face == 0 && lighting.color_material_face == GL_BACK) ||
+			(face == 1 && lighting.color_material_face == GL_FRONT))
+			continue;
+		Material &material = state.lighting.materials[face];
+		switch (lighting.color_material_mode)
+		{
+		case GL_AMBIENT:
+			memcpy(material.ambient, color, 4 * sizeof(GLfloat));
+			break;
+		case GL_DIFFUSE:
+			memcpy(material.diffuse, color, 4 * sizeof(GLfloat));
+			break;
+		case GL_SPECULAR:
+			memcpy(material.specular, color, 4 * sizeof(GLfloat));
+			break;
+		case GL_EMISSION:
+			memcpy(material.emission, color, 4 * sizeof(GLfloat));
+			break;
+		default:
+			memcpy(material.ambient, color, 4 * sizeof(GLfloat));
+			memcpy(material.diffuse, color, 4 * sizeof(GLfloat));
+			break;
+		}
+	}
+}
+
+static void Normalize(GLfloat *v)
+{
+	const GLfloat length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	if (length > 0.0f)
+	{
+		const GLfloat inverse = 1.0f / length;
+		v[0] *= inverse;
+		v[1] *= inverse;
+		v[2] *= inverse;
+	}
+}
+
+static inline GLfloat Dot(const GLfloat *a, const GLfloat *b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// rwnanie owietlenia OpenGL 1.x w wierzchoku (eye - pooenie
+// we wsprzdnych obserwatora, n - wektor normalny)
+
+static void Lighting(const GLfloat *eye, const GLfloat *n, const Material &material, GLfloat *out)
+{
+	const LightingState &lighting = state.lighting;
+	GLfloat color[3];
+	for (int k = 0; k < 3; k++)
+		color[k] = material.emission[k] + lighting.model_ambient[k] * material.ambient[k];
+
+	const GLfloat w = eye[3] != 0.0f ? 1.0f / eye[3] : 1.0f;
+	const GLfloat position[3] = { eye[0] * w, eye[1] * w, eye[2] * w };
+	for (int i = 0; i < MAX_LIGHTS; i++)
+	{
+		if (!state.enable.light[i])
+			continue;
+		const Light &light = lighting.lights[i];
+
+		// kierunek do wiata i osabienie
+		GLfloat L[3], attenuation = 1.0f;
+		if (light.position[3] != 0.0f)
+		{
+			const GLfloat inverse_w = 1.0f / light.position[3];
+			for (int k = 0; k < 3; k++)
+				L[k] = light.position[k] * inverse_w - position[k];
+			const GLfloat distance = sqrtf(Dot(L, L));
+			if (distance > 0.0f)
+				for (int k = 0; k < 3; k++)
+					L[k] /= distance;
+			attenuation = 1.0f / (light.attenuation[0] + light.attenuation[1] * distance +
+				light.attenuation[2] * distance * distance);
+		}
+		else
+		{
+			memcpy(L, light.position, sizeof(L));
+			Normalize(L);
+		}
+
+		// reflektor
+		if (light.spot_cutoff != 180.0f)
+		{
+			GLfloat direction[3] = { light.spot_direction[0], light.spot_direction[1], light.spot_direction[2] };
+			Normalize(direction);
+			const GLfloat cosine = -Dot(L, direction);
+			if (cosine < cosf(light.spot_cutoff * (GLfloat)M_PI / 180.0f))
+				continue;
+			attenuation *= powf(std::max(cosine, 0.0f), light.spot_exponent);
+		}
+
+		const GLfloat diffuse = Dot(n, L);
+		GLfloat specular = 0.0f;
+		if (diffuse > 0.0f)
+		{
+			GLfloat H[3] = { L[0], L[1], L[2] + 1.0f };
+			if (lighting.local_viewer)
+			{
+				GLfloat V[3] = { -position[0], -position[1], -position[2] };
+				Normalize(V);
+				for (int k = 0; k < 3; k++)
+					H[k] = L[k] + V[k];
+			}
+			Normalize(H);
+			specular = powf(std::max(Dot(n, H), 0.0f), material.shininess);
+		}
+		for (int k = 0; k < 3; k++)
+			color[k] += attenuation * (light.ambient[k] * material.ambient[k] +
+				std::max(diffuse, 0.0f) * light.diffuse[k] * material.diffuse[k] +
+				specular * light.specular[k] * material.specular[k]);
+	}
+	for (int k = 0; k < 3; k++)
+		out[k] = Clamp(color[k]);
+	out[3] = Clamp(material.diffuse[3]);
+}
+
+static void ProcessVertex(const GLfloat *position, const GLfloat *color, const GLfloat *normal,
+	const GLfloat *texcoord, SoftVertex &out)
+{
+	GLfloat eye[4];
+	Transform(MatrixStackTop(modelview), position, eye);
+	Transform(MatrixStackTop(projection), eye, out.clip);
+
+	if (state.enable.lighting)
+	{
+		if (state.enable.color_material)
+			ApplyColorMaterial(color);
+		const GLfloat *m = NormalMatrix();
+		GLfloat n[3];
+		for (int k = 0; k < 3; k++)
+			n[k] = m[k] * normal[0] + m[3 + k] * normal[1] + m[6 + k] * normal[2];
+		if (state.enable.normalize)
+			Normalize(n);
+		Lighting(eye, n, state.lighting.materials[0], out.front);
+		if (state.lighting.two_side)
+		{
+			const GLfloat back[3] = { -n[0], -n[1], -n[2] };
+			Lighting(eye, back, state.lighting.materials[1], out.back);
+		}
+		else
+			memcpy(out.back, out.front, sizeof(out.back));
+	}
+	else
+	{
+		for (int k = 0; k < 4; k++)
+			out.front[k] = out.back[k] = Clamp(color[k]);
+	}
+
+	GLfloat st[4];
+	if (texture_matrix_identity)
+		memcpy(st, texcoord, sizeof(st));
+	else
+		Transform(MatrixStackTop(texture_matrix), texcoord, st);
+	const GLfloat inverse_q = st[3] != 0.0f && st[3] != 1.0f ? 1.0f / st[3] : 1.0f;
+	out.s = st[0] * inverse_q;
+	out.t = st[1] * inverse_q;
+	out.fog = fabsf(eye[2]);
+}
+
+// ---------------------------------------------------------------------------
+// obcinanie i przekazanie prymityww do rasteryzatora
+
+static void SyncRaster()
+{
+	if (!raster_dirty)
+		return;
+	RasterState raster;
+	raster.depth_test = state.enable.depth_test;
+	raster.depth_func = state.depth.func;
+	raster.depth_mask = state.depth.mask;
+	raster.alpha_test = state.enable.alpha_test;
+	raster.alpha_func = state.color_buffer.alpha_func;
+	raster.alpha_ref = state.color_buffer.alpha_ref;
+	raster.blend = state.enable.blend;
+	raster.blend_src = state.color_buffer.blend_src;
+	raster.blend_dst = state.color_buffer.blend_dst;
+	raster.texture = ActiveTexture();
+	raster.texture_env = state.texture.env_mode;
+	raster.fog = state.enable.fog;
+	raster.fog_mode = state.fog.mode;
+	raster.fog_density = state.fog.density;
+	raster.fog_start = state.fog.start;
+	raster.fog_end = state.fog.end;
+	memcpy(raster.fog_color, state.fog.color, sizeof(raster.fog_color));
+	raster.polygon_offset = state.enable.polygon_offset;
+	raster.offset_factor = state.polygon.offset_factor;
+	raster.offset_units = state.polygon.offset_units;
+	RasterSetState(raster);
+	raster_dirty = false;
+}
+
+// kod pooenia wzgldem bryy widzenia (bit na kad paszczyzn)
+
+static int OutCode(const GLfloat *clip)
+{
+	const GLfloat w = clip[3];
+	return (clip[0] < -w) | (clip[0] > w) << 1 | (clip[1] < -w) << 2 | (clip[1] > w) << 3 | (clip[2] < -w) << 4 |
+		(clip[2] > w) << 5;
+}
+
+// odlego od paszczyzny bryy widzenia (dodatnia wewntrz)
+
+static GLfloat PlaneDistance(const SoftVertex &v, int plane)
+{
+	const GLfloat w = v.clip[3], value = v.clip[plane / 2];
+	return plane % 2 == 0 ? w + value : w - value;
+}
+
+static void Interpolate(const SoftVertex &a, const SoftVertex &b, GLfloat t, SoftVertex &out)
+{
+	for (int k = 0; k < 4; k++)
+	{
+		out.clip[k] = a.clip[k] + (b.clip[k] - a.clip[k]) * t;
+		out.front[k] = a.front[k] + (b.front[k] - a.front[k]) * t;
+		out.back[k] = a.back[k] + (b.back[k] - a.back[k]) * t;
+	}
+	out.s = a.s + (b.s - a.s) * t;
+	out.t = a.t + (b.t - a.t) * t;
+	out.fog = a.fog + (b.fog - a.fog) * t;
+}
+
+static void ToWindow(const SoftVertex &v, const GLfloat *color, RasterVertex &out)
+{
+	const ViewportState &viewport = state.viewport;
+	const GLfloat q = 1.0f / v.clip[3];
+	out.x = viewport.x + (v.clip[0] * q + 1.0f) * 0.5f * viewport.width;
+	out.y = viewport.y + (v.clip[1] * q + 1.0f) * 0.5f * viewport.height;
+	out.z = viewport.near_value + (v.clip[2] * q + 1.0f) * 0.5f * (viewport.far_value - viewport.near_value);
+	out.q = q;
+	memcpy(out.color, color, sizeof(out.color));
+	out.s = v.s;
+	out.t = v.t;
+	out.fog = v.fog;
+}
+
+// trjkt wewntrz bryy widzenia: kierunek obiegu w oknie, odrzucanie
+// cian, wybr kolorw strony przedniej lub tylnej; flat - wierzchoek
+// wyznaczajcy kolor przy cieniowaniu paskim (NULL - cieniowanie gadkie)
+
+static void EmitTriangle(const SoftVertex &a, const SoftVertex &b, const SoftVertex &c, const SoftVertex *flat)
+{
+	if (a.clip[3] <= 0.0f || b.clip[3] <= 0.0f || c.clip[3] <= 0.0f)
+		return;
+	const SoftVertex *v[3] = { &a, &b, &c };
+	RasterVertex w[3];
+	for (int i = 0; i < 3; i++)
+		ToWindow(*v[i], v[i]->front, w[i]);
+	const GLfloat area = (w[1].x - w[0].x) * (w[2].y - w[0].y) - (w[2].x - w[0].x) * (w[1].y - w[0].y);
+	if (area == 0.0f)
+		return;
+	const bool front = (area > 0.0f) == (state.polygon.front_face == GL_CCW);
+	if (state.enable.cull_face &&
+		(state.polygon.cull_face == GL_FRONT_AND_BACK || (state.polygon.cull_face == GL_BACK) != front))
+		return;
+	for (int i = 0; i < 3; i++)
+	{
+		const SoftVertex &source = flat ? *flat : *v[i];
+		memcpy(w[i].color, front ? source.front : source.back, sizeof(w[i].color));
+	}
+	RasterTriangle(w[0], w[1], w[2]);
+}
+
+// trjkt obcinany (algorytm Sutherlanda-Hodgmana) tylko wzgldem
+// paszczyzn, ktrych nie le po wewntrznej stronie wszystkie wierzchoki
+
+static void Triangle(const SoftVertex &a, const SoftVertex &b, const SoftVertex &c, const SoftVertex *flat)
+{
+	const int code_a = OutCode(a.clip), code_b = OutCode(b.clip), code_c = OutCode(c.clip);
+	if (code_a & code_b & code_c)
+		return;
+	const int planes = code_a | code_b | code_c;
+	if (planes == 0)
+	{
+		EmitTriangle(a, b, c, flat);
+		return;
+	}
+
+	// wierzchoek cieniowania paskiego moe zosta odcity - kopia
+	SoftVertex provoking;
+	if (flat)
+	{
+		provoking = *flat;
+		flat = &provoking;
+	}
+
+	SoftVertex buffer[2][9];
+	int count = 3;
+	buffer[0][0] = a;
+	buffer[0][1] = b;
+	buffer[0][2] = c;
+	int in = 0;
+	for (int plane = 0; plane < 6 && count >= 3; plane++)
+	{
+		if (!(planes >> plane & 1))
+			continue;
+		const SoftVertex *input = buffer[in];
+		SoftVertex *output = buffer[1 - in];
+		int output_count = 0;
+		for (int i = 0; i < count; i++)
+		{
+			const SoftVertex &p = input[i], &q = input[(i + 1) % count];
+			const GLfloat dp = PlaneDistance(p, plane), dq = PlaneDistance(q, plane);
+			if (dp >= 0.0f)
+				output[output_count++] = p;
+			if ((dp >= 0.0f) != (dq >= 0.0f))
+				Interpolate(p, q, dp / (dp - dq), output[output_count++]);
+		}
+		count = output_count;
+		in = 1 - in;
+	}
+	for (int i = 1; i + 1 < count; i++)
+		EmitTriangle(buffer[in][0], buffer[in][i], buffer[in][i + 1], flat);
+}
+
+static void Point(const SoftVertex &v)
+{
+	if (OutCode(v.clip) != 0 || v.clip[3] <= 0.0f)
+		return;
+	RasterVertex w;
+	ToWindow(v, v.front, w);
+	RasterPoint(w, state.point_size);
+}
+
+// skadanie prymityww z wierzchokw (wierzchoek cieniowania paskiego
+// wedug specyfikacji OpenGL)
+
+static void DrawVertices(GLenum mode, const SoftVertex *v, int count)
+{
+	SyncRaster();
+	const bool flat = state.lighting.shade_model == GL_FLAT;
+	switch (mode)
+	{
+	case GL_POINTS:
+		for (int i = 0; i < count; i++)
+			Point(v[i]);
+		break;
+	case GL_TRIANGLES:
+		for (int i = 0; i + 2 < count; i += 3)
+			Triangle(v[i], v[i + 1], v[i + 2], flat ? &v[i + 2] : NULL);
+		break;
+	case GL_TRIANGLE_STRIP:
+		for (int i = 0; i + 2 < count; i++)
+			if (i % 2 == 0)
+				Triangle(v[i], v[i + 1], v[i + 2], flat ? &v[i + 2] : NULL);
+			else
+				Triangle(v[i + 1], v[i], v[i + 2], flat ? &v[i + 2] : NULL);
+		break;
+	case GL_TRIANGLE_FAN:
+		for (int i = 1; i + 1 < count; i++)
+			Triangle(v[0], v[i], v[i + 1], flat ? &v[i + 1] : NULL);
+		break;
+	case GL_QUADS:
+		for (int i = 0; i + 3 < count; i += 4)
+		{
+			Triangle(v[i], v[i + 1], v[i + 2], flat ? &v[i + 3] : NULL);
+			Triangle(v[i], v[i + 2], v[i + 3], flat ? &v[i + 3] : NULL);
+		}
+		break;
+	case GL_QUAD_STRIP:
+		for (int i = 0; i + 3 < count; i += 2)
+		{
+			Triangle(v[i], v[i + 1], v[i + 3], flat ? &v[i + 3] : NULL);
+			Triangle(v[i], v[i + 3], v[i + 2], flat ? &v[i + 3] : NULL);
+		}
+		break;
+	case GL_POLYGON:
+		for (int i = 1; i + 1 < count; i++)
+			Triangle(v[0], v[i], v[i + 1], flat ? &v[0] : NULL);
+		break;
+	default:
+		Unsupported("prymityw", mode);
+		break;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// inicjalizacja
+
+bool SoftInit(int width, int height, int threads)
+{
+	if (!RasterInit(width, height, threads))
+		return false;
+	DefaultState();
+	state.viewport.width = width;
+	state.viewport.height = height;
+	raster_dirty = true;
+	snprintf(renderer, sizeof(renderer), "SoftGL (watki: %d, kafelki %dx%d)", RasterThreads(), RASTER_TILE,
+		RASTER_TILE);
+	return true;
+}
+
+void SoftFree()
+{
+	RasterFree();
+}
+
+// ---------------------------------------------------------------------------
+// glBegin/glEnd i atrybuty biece
+
+void APIENTRY sglBegin(GLenum mode)
+{
+	RECORD(sglBegin(mode))
+	inside_begin = true;
+	begin_mode = mode;
+	batch.clear();
+}
+
+void APIENTRY sglEnd()
+{
+	RECORD(sglEnd())
+	if (!inside_begin)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+	inside_begin = false;
+	if (!batch.empty())
+		DrawVertices(begin_mode, &batch[0], (int)batch.size());
+	batch.clear();
+}
+
+static void Vertex(GLfloat x, GLfloat y, GLfloat z)
+{
+	RECORD(Vertex(x, y, z))
+	if (!inside_begin)
+		return;
+	const GLfloat position[4] = { x, y, z, 1.0f };
+	batch.push_back(SoftVertex());
+	ProcessVertex(position, state.current.color, state.current.normal, state.current.texcoord, batch.back());
+}
+
+void APIENTRY sglVertex2f(GLfloat x, GLfloat y)
+{
+	Vertex(x, y, 0.0f);
+}
+
+void APIENTRY sglVertex2i(GLint x, GLint y)
+{
+	Vertex((GLfloat)x, (GLfloat)y, 0.0f);
+}
+
+void APIENTRY sglVertex3f(GLfloat x, GLfloat y, GLfloat z)
+{
+	Vertex(x, y, z);
+}
+
+void APIENTRY sglVertex3fv(const GLfloat *v)
+{
+	Vertex(v[0], v[1], v[2]);
+}
+
+void APIENTRY sglVertex3d(GLdouble x, GLdouble y, GLdouble z)
+{
+	Vertex((GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void APIENTRY sglVertex3dv(const GLdouble *v)
+{
+	Vertex((GLfloat)v[0], (GLfloat)v[1], (GLfloat)v[2]);
+}
+
+static void TexCoord(GLfloat s, GLfloat t)
+{
+	RECORD(TexCoord(s, t))
+	Copy4(state.current.texcoord, s, t, 0.0f, 1.0f);
+}
+
+void APIENTRY sglTexCoord1f(GLfloat s)
+{
+	TexCoord(s, 0.0f);
+}
+
+void APIENTRY sglTexCoord2f(GLfloat s, GLfloat t)
+{
+	TexCoord(s, t);
+}
+
+void APIENTRY sglTexCoord2fv(const GLfloat *v)
+{
+	TexCoord(v[0], v[1]);
+}
+
+void APIENTRY sglColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+	RECORD(sglColor4f(red, green, blue, alpha))
+	Copy4(state.current.color, red, green, blue, alpha);
+}
+
+void APIENTRY sglColor3f(GLfloat red, GLfloat green, GLfloat blue)
+{
+	sglColor4f(red, green, blue, 1.0f);
+}
+
+void APIENTRY sglColor3fv(const GLfloat *v)
+{
+	sglColor4f(v[0], v[1], v[2], 1.0f);
+}
+
+void APIENTRY sglColor4fv(const GLfloat *v)
+{
+	sglColor4f(v[0], v[1], v[2], v[3]);
+}
+
+void APIENTRY sglColor3ub(GLubyte red, GLubyte green, GLubyte blue)
+{
+	sglColor4f(red / 255.0f, green / 255.0f, blue / 255.0f, 1.0f);
+}
+
+void APIENTRY sglNormal3f(GLfloat x, GLfloat y, GLfloat z)
+{
+	RECORD(sglNormal3f(x, y, z))
+	state.current.normal[0] = x;
+	state.current.normal[1] = y;
+	state.current.normal[2] = z;
+}
+
+void APIENTRY sglNormal3fv(const GLfloat *v)
+{
+	sglNormal3f(v[0], v[1], v[2]);
+}
+
+// ---------------------------------------------------------------------------
+// wczanie i wyczanie opcji
+
+static bool *EnableFlag(GLenum cap)
+{
+	EnableState &enable = state.enable;
+	switch (cap)
+	{
+	case GL_ALPHA_TEST:
+		return &enable.alpha_test;
+	case GL_BLEND:
+		return &enable.blend;
+	case GL_COLOR_MATERIAL:
+		return &enable.color_material;
+	case GL_CULL_FACE:
+		return &enable.cull_face;
+	case GL_DEPTH_TEST:
+		return &enable.depth_test;
+	case GL_FOG:
+		return &enable.fog;
+	case GL_LIGHTING:
+		return &enable.lighting;
+	case GL_NORMALIZE:
+	case GL_RESCALE_NORMAL:
+		return &enable.normalize;
+	case GL_POLYGON_OFFSET_FILL:
+		return &enable.polygon_offset;
+	case GL_TEXTURE_1D:
+		return &enable.texture_1d;
+	case GL_TEXTURE_2D:
+		return &enable.texture_2d;
+	}
+	if (cap >= GL_LIGHT0 && cap < GL_LIGHT0 + MAX_LIGHTS)
+		return &enable.light[cap - GL_LIGHT0];
+	return NULL;
+}
+
+static void SetCapability(GLenum cap, bool value)
+{
+	bool *flag = EnableFlag(cap);
+	if (flag)
+	{
+		*flag = value;
+		if (cap == GL_COLOR_MATERIAL && value)
+			ApplyColorMaterial(state.current.color);
+		raster_dirty = true;
+		return;
+	}
+
+	// opcje bez wpywu na wynik (np. wygadzanie odcinkw, ktre nie s rysowane)
+	if (value && cap != GL_DITHER && cap != GL_MULTISAMPLE && cap != GL_LINE_SMOOTH && cap != GL_POINT_SMOOTH)
+		Unsupported("glEnable", cap);
+	if (value)
+		state.enable.other.insert(cap);
+	else
+		state.enable.other.erase(cap);
+}
+
+void APIENTRY sglEnable(GLenum cap)
+{
+	RECORD(sglEnable(cap))
+	SetCapability(cap, true);
+}
+
+void APIENTRY sglDisable(GLenum cap)
+{
+	RECORD(sglDisable(cap))
+	SetCapability(cap, false);
+}
+
+GLboolean APIENTRY sglIsEnabled(GLenum cap)
+{
+	const bool *flag = EnableFlag(cap);
+	if (flag)
+		return *flag ? GL_TRUE : GL_FALSE;
+	switch (cap)
+	{
+	case GL_VERTEX_ARRAY:
+		return client.vertex.enabled;
+	case GL_NORMAL_ARRAY:
+		return client.normal.enabled;
+	case GL_COLOR_ARRAY:
+		return client.color.enabled;
+	case GL_TEXTURE_COORD_ARRAY:
+		return client.texcoord.enabled;
+	}
+	return state.enable.other.count(cap) ? GL_TRUE : GL_FALSE;
+}
+
+static ArrayPointer *ClientArray(GLenum array)
+{
+	switch (array)
+	{
+	case GL_VERTEX_ARRAY:
+		return &client.vertex;
+	case GL_NORMAL_ARRAY:
+		return &client.normal;
+	case GL_COLOR_ARRAY:
+		return &client.color;
+	case GL_TEXTURE_COORD_ARRAY:
+		return &client.texcoord;
+	}
+	Unsupported("tablica wierzcholkow", array);
+	return NULL;
+}
+
+void APIENTRY sglEnableClientState(GLenum array)
+{
+	ArrayPointer *pointer = ClientArray(array);
+	if (pointer)
+		pointer->enabled = true;
+}
+
+void APIENTRY sglDisableClientState(GLenum array)
+{
+	ArrayPointer *pointer = ClientArray(array);
+	if (pointer)
+		pointer->enabled = false;
+}
+
+// ---------------------------------------------------------------------------
+// bufory i okno
+
+void APIENTRY sglClear(GLbitfield mask)
+{
+	RECORD(sglClear(mask))
+	RasterClear((mask & GL_COLOR_BUFFER_BIT) != 0, state.color_buffer.clear,
+		(mask & GL_DEPTH_BUFFER_BIT) != 0 && state.depth.mask, state.depth.clear);
+}
+
+void APIENTRY sglClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+	RECORD(sglClearColor(red, green, blue, alpha))
+	Copy4(state.color_buffer.clear, Clamp(red), Clamp(green), Clamp(blue), Clamp(alpha));
+}
+
+void APIENTRY sglClearDepth(GLclampd depth)
+{
+	RECORD(sglClearDepth(depth))
+	state.depth.clear = Clamp((GLfloat)depth);
+}
+
+void APIENTRY sglViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	RECORD(sglViewport(x, y, width, height))
+	state.viewport.x = x;
+	state.viewport.y = y;
+	state.viewport.width = width;
+	state.viewport.height = height;
+}
+
+void APIENTRY sglDepthRange(GLclampd near_value, GLclampd far_value)
+{
+	RECORD(sglDepthRange(near_value, far_value))
+	state.viewport.near_value = Clamp((GLfloat)near_value);
+	state.viewport.far_value = Clamp((GLfloat)far_value);
+}
+
+// ---------------------------------------------------------------------------
+// macierze
+
+void APIENTRY sglMatrixMode(GLenum mode)
+{
+	RECORD(sglMatrixMode(mode))
+	if (mode != GL_MODELVIEW && mode != GL_PROJECTION && mode != GL_TEXTURE)
+	{
+		SetError(GL_INVALID_ENUM);
+		return;
+	}
+	state.matrix_mode = mode;
+}
+
+void APIENTRY sglLoadIdentity()
+{
+	RECORD(sglLoadIdentity())
+	MatrixStackLoad(CurrentStack(), MatrixIdentity());
+	MatrixChanged();
+}
+
+void APIENTRY sglLoadMatrixf(const GLfloat *m)
+{
+	const Matrix matrix = ToMatrix(m);
+	RECORD(sglLoadMatrixf(matrix.m))
+	MatrixStackLoad(CurrentStack(), matrix);
+	MatrixChanged();
+}
+
+void APIENTRY sglLoadMatrixd(const GLdouble *m)
+{
+	const Matrix matrix = ToMatrix(m);
+	sglLoadMatrixf(matrix.m);
+}
+
+void APIENTRY sglMultMatrixf(const GLfloat *m)
+{
+	const Matrix matrix = ToMatrix(m);
+	RECORD(sglMultMatrixf(matrix.m))
+	MultiplyCurrent(matrix);
+}
+
+void APIENTRY sglMultMatrixd(const GLdouble *m)
+{
+	const Matrix matrix = ToMatrix(m);
+	sglMultMatrixf(matrix.m);
+}
+
+void APIENTRY sglPushMatrix()
+{
+	RECORD(sglPushMatrix())
+	MatrixStack &stack = CurrentStack();
+	if ((int)stack.matrices.size() >= MAX_STACK_DEPTH)
+	{
+		SetError(GL_STACK_OVERFLOW);
+		return;
+	}
+	MatrixStackPush(stack);
+}
+
+void APIENTRY sglPopMatrix()
+{
+	RECORD(sglPopMatrix())
+	MatrixStack &stack = CurrentStack();
+	if (stack.matrices.size() <= 1)
+	{
+		SetError(GL_STACK_UNDERFLOW);
+		return;
+	}
+	MatrixStackPop(stack);
+	MatrixChanged();
+}
+
+void APIENTRY sglTranslatef(GLfloat x, GLfloat y, GLfloat z)
+{
+	RECORD(sglTranslatef(x, y, z))
+	MultiplyCurrent(MatrixTranslation(x, y, z));
+}
+
+void APIENTRY sglTranslated(GLdouble x, GLdouble y, GLdouble z)
+{
+	sglTranslatef((GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void APIENTRY sglRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+{
+	RECORD(sglRotatef(angle, x, y, z))
+	MultiplyCurrent(MatrixRotation(angle, x, y, z));
+}
+
+void APIENTRY sglRotated(GLdouble angle, GLdouble x, GLdouble y, GLdouble z)
+{
+	sglRotatef((GLfloat)angle, (GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void APIENTRY sglScalef(GLfloat x, GLfloat y, GLfloat z)
+{
+	RECORD(sglScalef(x, y, z))
+	MultiplyCurrent(MatrixScaling(x, y, z));
+}
+
+void APIENTRY sglScaled(GLdouble x, GLdouble y, GLdouble z)
+{
+	sglScalef((GLfloat)x, (GLfloat)y, (GLfloat)z);
+}
+
+void APIENTRY sglFrustum(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_value,
+	GLdouble far_value)
+{
+	GLdouble m[16] = { 0.0 };
+	m[0] = 2.0 * near_value / (right - left);
+	m[5] = 2.0 * near_value / (top - bottom);
+	m[8] = (right + left) / (right - left);
+	m[9] = (top + bottom) / (top - bottom);
+	m[10] = -(far_value + near_value) / (far_value - near_value);
+	m[11] = -1.0;
+	m[14] = -2.0 * far_value * near_value / (far_value - near_value);
+	sglMultMatrixd(m);
+}
+
+void APIENTRY sglOrtho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble near_value,
+	GLdouble far_value)
+{
+	GLdouble m[16] = { 0.0 };
+	m[0] = 2.0 / (right - left);
+	m[5] = 2.0 / (top - bottom);
+	m[10] = -2.0 / (far_value - near_value);
+	m[12] = -(right + left) / (right - left);
+	m[13] = -(top + bottom) / (top - bottom);
+	m[14] = -(far_value + near_value) / (far_value - near_value);
+	m[15] = 1.0;
+	sglMultMatrixd(m);
+}
+
+void APIENTRY sgluPerspective(GLdouble fovy, GLdouble aspect, GLdouble near_value, GLdouble far_value)
+{
+	const GLdouble f = 1.0 / tan(fovy * M_PI / 360.0);
+	GLdouble m[16] = { 0.0 };
+	m[0] = f / aspect;
+	m[5] = f;
+	m[10] = (far_value + near_value) / (near_value - far_value);
+	m[11] = -1.0;
+	m[14] = 2.0 * far_value * near_value / (near_value - far_value);
+	sglMultMatrixd(m);
+}
+
+void APIENTRY sgluLookAt(GLdouble eye_x, GLdouble eye_y, GLdouble eye_z, GLdouble center_x, GLdouble center_y,
+	GLdouble center_z, GLdouble up_x, GLdouble up_y, GLdouble up_z)
+{
+	// f - kierunek patrzenia, s = f x up, u = s x f
+	GLdouble f[3] = { center_x - eye_x, center_y - eye_y, center_z - eye_z };
+	GLdouble length = sqrt(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+	if (length == 0.0)
+		return;
+	for (int k = 0; k < 3; k++)
+		f[k] /= length;
+	GLdouble s[3] = { f[1] * up_z - f[2] * up_y, f[2] * up_x - f[0] * up_z, f[0] * up_y - f[1] * up_x };
+	length = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+	if (length == 0.0)
+		return;
+	for (int k = 0; k < 3; k++)
+		s[k] /= length;
+	const GLdouble u[3] = { s[1] * f[2] - s[2] * f[1], s[2] * f[0] - s[0] * f[2], s[0] * f[1] - s[1] * f[0] };
+	GLdouble m[16] = { 0.0 };
+	for (int k = 0; k < 3; k++)
+	{
+		m[4 * k] = s[k];
+		m[4 * k + 1] = u[k];
+		m[4 * k + 2] = -f[k];
+	}
+	m[15] = 1.0;
+	sglMultMatrixd(m);
+	sglTranslated(-eye_x, -eye_y, -eye_z);
+}
+
+void APIENTRY sgluOrtho2D(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top)
+{
+	sglOrtho(left, right, bottom, top, -1.0, 1.0);
+}
+
+// ---------------------------------------------------------------------------
+// tekstury
+
+void APIENTRY sglGenTextures(GLsizei n, GLuint *names)
+{
+	NotCompiled("glGenTextures");
+	for (int i = 0; i < n; i++)
+	{
+		while (textures.count(next_texture))
+			next_texture++;
+		names[i] = next_texture;
+		textures[next_texture++];
+	}
+}
+
+void APIENTRY sglDeleteTextures(GLsizei n, const GLuint *names)
+{
+	NotCompiled("glDeleteTextures");
+	TextureChanging();
+	for (int i = 0; i < n; i++)
+	{
+		if (names[i] == 0)
+			continue;
+		textures.erase(names[i]);
+		if (state.texture.binding_1d == names[i])
+			state.texture.binding_1d = 0;
+		if (state.texture.binding_2d == names[i])
+			state.texture.binding_2d = 0;
+	}
+}
+
+void APIENTRY sglBindTexture(GLenum target, GLuint texture)
+{
+	RECORD(sglBindTexture(target, texture))
+	if (!TextureTarget(target))
+		return;
+	GLuint &binding = target == GL_TEXTURE_1D ? state.texture.binding_1d : state.texture.binding_2d;
+	if (binding == texture)
+		return;
+	binding = texture;
+	Texture &object = BoundTexture(target);
+	if (object.target == 0)
+	{
+		object.target = target;
+		object.raster.dimensions = target == GL_TEXTURE_1D ? 1 : 2;
+	}
+	raster_dirty = true;
+}
+
+void APIENTRY sglTexImage1D(GLenum target, GLint level, GLint internal_format, GLsizei width, GLint border,
+	GLenum format, GLenum type, const GLvoid *pixels)
+{
+	NotCompiled("glTexImage1D");
+	if (target != GL_TEXTURE_1D)
+	{
+		Unsupported("rodzaj tekstury", target);
+		return;
+	}
+	if (level < 0 || width < 0 || width > MAX_TEXTURE_SIZE || border != 0)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+	const GLenum base = BaseFormat(internal_format);
+	std::vector<GLuint> texels;
+	if (ReadImage(width, 1, format, type, pixels, base, texels))
+		SetImage(target, level, base, width, 1, texels);
+}
+
+void APIENTRY sglTexImage2D(GLenum target, GLint level, GLint internal_format, GLsizei width, GLsizei height,
+	GLint border, GLenum format, GLenum type, const GLvoid *pixels)
+{
+	NotCompiled("glTexImage2D");
+	if (target != GL_TEXTURE_2D)
+	{
+		Unsupported("rodzaj tekstury", target);
+		return;
+	}
+	if (level < 0 || width < 0 || height < 0 || width > MAX_TEXTURE_SIZE || height > MAX_TEXTURE_SIZE ||
+		border != 0)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+	const GLenum base = BaseFormat(internal_format);
+	std::vector<GLuint> texels;
+	if (ReadImage(width, height, format, type, pixels, base, texels))
+		SetImage(target, level, base, width, height, texels);
+}
+
+// kopia prostokta bufora koloru do czci poziomu level tekstury
+// (skadowe jak przy formacie GL_RGBA; bufor koloru nie ma kanau alfa,
+// wic alfa = 255)
+
+void APIENTRY sglCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y,
+	GLsizei width, GLsizei height)
+{
+	NotCompiled("glCopyTexSubImage2D");
+	if (target != GL_TEXTURE_2D)
+	{
+		Unsupported("rodzaj tekstury", target);
+		return;
+	}
+	Texture &texture = BoundTexture(target);
+	RasterTexture &raster = texture.raster;
+	if (level < 0 || level >= (int)raster.levels.size() || width < 0 || height < 0 || xoffset < 0 || yoffset < 0 ||
+		xoffset + width > raster.levels[level].width || yoffset + height > raster.levels[level].height)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	// narysowanie prymityww w kolejce (take tych, ktre uywaj tekstury)
+	TextureChanging();
+	std::vector<GLubyte> pixels(width * height * 4);
+	RasterReadPixels(x, y, width, height, GL_RGBA, 4, pixels.data());
+	RasterLevel &image = raster.levels[level];
+	for (int j = 0; j < height; j++)
+	{
+		const GLubyte *p = &pixels[j * width * 4];
+		GLuint *texels = &image.texels[(yoffset + j) * image.width + xoffset];
+		for (int i = 0; i < width; i++, p += 4)
+			texels[i] = p[0] | p[1] << 8 | p[2] << 16 | (GLuint)p[3] << 24;
+	}
+	if (level == 0 && texture.generate_mipmap)
+		GenerateMipmaps(raster);
+}
+
+void APIENTRY sglTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	RECORD(sglTexParameteri(target, pname, param))
+	if (!TextureTarget(target))
+		return;
+	Texture &texture = BoundTexture(target);
+	GLenum *value;
+	switch (pname)
+	{
+	case GL_TEXTURE_MIN_FILTER:
+		value = &texture.raster.min_filter;
+		break;
+	case GL_TEXTURE_MAG_FILTER:
+		value = &texture.raster.mag_filter;
+		break;
+	case GL_TEXTURE_WRAP_S:
+		value = &texture.raster.wrap_s;
+		break;
+	case GL_TEXTURE_WRAP_T:
+		value = &texture.raster.wrap_t;
+		break;
+	case GL_GENERATE_MIPMAP:
+		texture.generate_mipmap = param != 0;
+		return;
+	default:
+		Unsupported("parametr tekstury", pname);
+		return;
+	}
+
+	// GL_CLAMP_TO_EDGE i GL_CLAMP_TO_BORDER (bez koloru brzegu) jak GL_CLAMP
+	if (*value != (GLenum)param)
+	{
+		TextureChanging();
+		*value = param;
+	}
+}
+
+void APIENTRY sglTexParameterf(GLenum target, GLenum pname, GLfloat param)
+{
+	sglTexParameteri(target, pname, (GLint)param);
+}
+
+void APIENTRY sglGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+	if (!TextureTarget(target))
+		return;
+	const Texture &texture = BoundTexture(target);
+	switch (pname)
+	{
+	case GL_TEXTURE_MIN_FILTER:
+		*params = texture.raster.min_filter;
+		break;
+	case GL_TEXTURE_MAG_FILTER:
+		*params = texture.raster.mag_filter;
+		break;
+	case GL_TEXTURE_WRAP_S:
+		*params = texture.raster.wrap_s;
+		break;
+	case GL_TEXTURE_WRAP_T:
+		*params = texture.raster.wrap_t;
+		break;
+	case GL_GENERATE_MIPMAP:
+		*params = texture.generate_mipmap ? GL_TRUE : GL_FALSE;
+		break;
+	default:
+		Unsupported("glGetTexParameteriv", pname);
+		break;
+	}
+}
+
+void APIENTRY sglTexEnvi(GLenum target, GLenum pname, GLint param)
+{
+	RECORD(sglTexEnvi(target, pname, param))
+	if (target != GL_TEXTURE_ENV || pname != GL_TEXTURE_ENV_MODE)
+	{
+		Unsupported("glTexEnv", pname);
+		return;
+	}
+	if (param != GL_MODULATE && param != GL_REPLACE)
+		Unsupported("tryb tekstury", param);
+	state.texture.env_mode = param;
+	raster_dirty = true;
+}
+
+void APIENTRY sglTexEnvf(GLenum target, GLenum pname, GLfloat param)
+{
+	sglTexEnvi(target, pname, (GLint)param);
+}
+
+// najblisza potga 2 (jak w GLU: 3 -> 4, 5 -> 4, 6 -> 8)
+
+static int NearestPower(int value)
+{
+	int power = 1;
+	for (;;)
+	{
+		if (value == 1)
+			return power;
+		if (value == 3)
+			return 4 * power;
+		value >>= 1;
+		power *= 2;
+	}
+}
+
+// przeskalowanie obrazu (rednia tekseli obszaru odpowiadajcego tekselowi)
+
+static void ScaleImage(const std::vector<GLuint> &source, int width, int height, std::vector<GLuint> &scaled,
+	int scaled_width, int scaled_height)
+{
+	scaled.resize(scaled_width * scaled_height);
+	for (int y = 0; y < scaled_height; y++)
+	{
+		const int y0 = y * height / scaled_height, y1 = std::max(y0 + 1, (y + 1) * height / scaled_height);
+		for (int x = 0; x < scaled_width; x++)
+		{
+			const int x0 = x * width / scaled_width, x1 = std::max(x0 + 1, (x + 1) * width / scaled_width);
+			GLuint sum[4] = { 0, 0, 0, 0 };
+			for (int j = y0; j < y1; j++)
+				for (int i = x0; i < x1; i++)
+					for (int k = 0; k < 4; k++)
+						sum[k] += source[j * width + i] >> (8 * k) & 0xFF;
+			const GLuint count = (x1 - x0) * (y1 - y0);
+			GLuint texel = 0;
+			for (int k = 0; k < 4; k++)
+				texel |= (sum[k] + count / 2) / count << (8 * k);
+			scaled[y * scaled_width + x] = texel;
+		}
+	}
+}
+
+static GLint BuildMipmaps(GLenum target, GLint internal_format, GLsizei width, GLsizei height, GLenum format,
+	GLenum type, const void *data)
+{
+	if (width < 1 || height < 1)
+		return GLU_INVALID_VALUE;
+	const GLenum base = BaseFormat(internal_format);
+	std::vector<GLuint> texels, scaled;
+	if (!ReadImage(width, height, format, type, data, base, texels))
+		return GLU_INVALID_ENUM;
+	int scaled_width = std::min(NearestPower(width), MAX_TEXTURE_SIZE);
+	int scaled_height = std::min(NearestPower(height), MAX_TEXTURE_SIZE);
+	if (scaled_width != width || scaled_height != height)
+		ScaleImage(texels, width, height, scaled, scaled_width, scaled_height);
+	else
+		scaled.swap(texels);
+
+	SetImage(target, 0, base, scaled_width, scaled_height, scaled);
+	GenerateMipmaps(BoundTexture(target).raster);
+	return 0;
+}
+
+GLint APIENTRY sgluBuild1DMipmaps(GLenum target, GLint internal_format, GLsizei width, GLenum format, GLenum type,
+	const void *data)
+{
+	NotCompiled("gluBuild1DMipmaps");
+	if (target != GL_TEXTURE_1D)
+		return GLU_INVALID_ENUM;
+	return BuildMipmaps(target, internal_format, width, 1, format, type, data);
+}
+
+GLint APIENTRY sgluBuild2DMipmaps(GLenum target, GLint internal_format, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const void *data)
+{
+	NotCompiled("gluBuild2DMipmaps");
+	if (target != GL_TEXTURE_2D)
+		return GLU_INVALID_ENUM;
+	return BuildMipmaps(target, internal_format, width, height, format, type, data);
+}
+
+void APIENTRY sglPixelStorei(GLenum pname, GLint param)
+{
+	switch (pname)
+	{
+	case GL_UNPACK_ALIGNMENT:
+		client.unpack_alignment = param;
+		break;
+	case GL_PACK_ALIGNMENT:
+		client.pack_alignment = param;
+		break;
+	default:
+		Unsupported("glPixelStorei", pname);
+		break;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// operacje na fragmentach i wieloktach
+
+void APIENTRY sglHint(GLenum target, GLenum mode)
+{
+	RECORD(sglHint(target, mode))
+	state.hints[target] = mode;
+}
+
+void APIENTRY sglAlphaFunc(GLenum func, GLclampf ref)
+{
+	RECORD(sglAlphaFunc(func, ref))
+	state.color_buffer.alpha_func = func;
+	state.color_buffer.alpha_ref = Clamp(ref);
+	raster_dirty = true;
+}
+
+void APIENTRY sglBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	RECORD(sglBlendFunc(sfactor, dfactor))
+	state.color_buffer.blend_src = sfactor;
+	state.color_buffer.blend_dst = dfactor;
+	raster_dirty = true;
+}
+
+void APIENTRY sglDepthFunc(GLenum func)
+{
+	RECORD(sglDepthFunc(func))
+	state.depth.func = func;
+	raster_dirty = true;
+}
+
+void APIENTRY sglDepthMask(GLboolean flag)
+{
+	RECORD(sglDepthMask(flag))
+	state.depth.mask = flag != GL_FALSE;
+	raster_dirty = true;
+}
+
+void APIENTRY sglCullFace(GLenum mode)
+{
+	RECORD(sglCullFace(mode))
+	state.polygon.cull_face = mode;
+}
+
+void APIENTRY sglFrontFace(GLenum mode)
+{
+	RECORD(sglFrontFace(mode))
+	state.polygon.front_face = mode;
+}
+
+void APIENTRY sglPolygonOffset(GLfloat factor, GLfloat units)
+{
+	RECORD(sglPolygonOffset(factor, units))
+	state.polygon.offset_factor = factor;
+	state.polygon.offset_units = units;
+	raster_dirty = true;
+}
+
+void APIENTRY sglShadeModel(GLenum mode)
+{
+	RECORD(sglShadeModel(mode))
+	state.lighting.shade_model = mode;
+}
+
+void APIENTRY sglPointSize(GLfloat size)
+{
+	RECORD(sglPointSize(size))
+	state.point_size = size;
+}
+
+void APIENTRY sglLineWidth(GLfloat width)
+{
+	RECORD(sglLineWidth(width))
+	state.line_width = width;
+}
+
+// ---------------------------------------------------------------------------
+// mga i owietlenie
+
+void APIENTRY sglFogf(GLenum pname, GLfloat param)
+{
+	RECORD(sglFogf(pname, param))
+	switch (pname)
+	{
+	case GL_FOG_MODE:
+		state.fog.mode = (GLenum)param;
+		break;
+	case GL_FOG_DENSITY:
+		state.fog.density = param;
+		break;
+	case GL_FOG_START:
+		state.fog.start = param;
+		break;
+	case GL_FOG_END:
+		state.fog.end = param;
+		break;
+	default:
+		Unsupported("glFog", pname);
+		return;
+	}
+	raster_dirty = true;
+}
+
+void APIENTRY sglFogi(GLenum pname, GLint param)
+{
+	sglFogf(pname, (GLfloat)param);
+}
+
+void APIENTRY sglFogfv(GLenum pname, const GLfloat *params)
+{
+	if (pname != GL_FOG_COLOR)
+	{
+		sglFogf(pname, params[0]);
+		return;
+	}
+	const Values values = CopyValues(params, 4);
+	RECORD(sglFogfv(pname, values.v))
+	for (int k = 0; k < 4; k++)
+		state.fog.color[k] = Clamp(params[k]);
+	raster_dirty = true;
+}
+
+void APIENTRY sglLightfv(GLenum light, GLenum pname, const GLfloat *params)
+{
+	const Values values = CopyValues(params, ValueCount(pname));
+	RECORD(sglLightfv(light, pname, values.v))
+	if (light < GL_LIGHT0 || light >= GL_LIGHT0 + MAX_LIGHTS)
+	{
+		SetError(GL_INVALID_ENUM);
+		return;
+	}
+	Light &target = state.lighting.lights[light - GL_LIGHT0];
+	switch (pname)
+	{
+	case GL_AMBIENT:
+		memcpy(target.ambient, params, 4 * sizeof(GLfloat));
+		break;
+	case GL_DIFFUSE:
+		memcpy(target.diffuse, params, 4 * sizeof(GLfloat));
+		break;
+	case GL_SPECULAR:
+		memcpy(target.specular, params, 4 * sizeof(GLfloat));
+		break;
+	case GL_POSITION:
+		Transform(MatrixStackTop(modelview), params, target.position);
+		break;
+	case GL_SPOT_DIRECTION:
+	{
+		const GLfloat *m = MatrixStackTop(modelview).m;
+		for (int k = 0; k < 3; k++)
+			target.spot_direction[k] = m[k] * params[0] + m[4 + k] * params[1] + m[8 + k] * params[2];
+		break;
+	}
+	case GL_SPOT_EXPONENT:
+		target.spot_exponent = params[0];
+		break;
+	case GL_SPOT_CUTOFF:
+		target.spot_cutoff = params[0];
+		break;
+	case GL_CONSTANT_ATTENUATION:
+		target.attenuation[0] = params[0];
+		break;
+	case GL_LINEAR_ATTENUATION:
+		target.attenuation[1] = params[0];
+		break;
+	case GL_QUADRATIC_ATTENUATION:
+		target.attenuation[2] = params[0];
+		break;
+	default:
+		Unsupported("glLight", pname);
+		break;
+	}
+}
+
+void APIENTRY sglLightf(GLenum light, GLenum pname, GLfloat param)
+{
+	sglLightfv(light, pname, &param);
+}
+
+void APIENTRY sglLightModelfv(GLenum pname, const GLfloat *params)
+{
+	const Values values = CopyValues(params, ValueCount(pname));
+	RECORD(sglLightModelfv(pname, values.v))
+	switch (pname)
+	{
+	case GL_LIGHT_MODEL_AMBIENT:
+		memcpy(state.lighting.model_ambient, params, 4 * sizeof(GLfloat));
+		break;
+	case GL_LIGHT_MODEL_TWO_SIDE:
+		state.lighting.two_side = params[0] != 0.0f;
+		break;
+	case GL_LIGHT_MODEL_LOCAL_VIEWER:
+		state.lighting.local_viewer = params[0] != 0.0f;
+		break;
+	default:
+		Unsupported("glLightModel", pname);
+		break;
+	}
+}
+
+void APIENTRY sglLightModelf(GLenum pname, GLfloat param)
+{
+	sglLightModelfv(pname, &param);
+}
+
+void APIENTRY sglLightModeli(GLenum pname, GLint param)
+{
+	const GLfloat value = (GLfloat)param;
+	sglLightModelfv(pname, &value);
+}
+
+void APIENTRY sglMaterialfv(GLenum face, GLenum pname, const GLfloat *params)
+{
+	const Values values = CopyValues(params, ValueCount(pname));
+	RECORD(sglMaterialfv(face, pname, values.v))
+	for (int i = 0; i < 2; i++)
+	{
+		if ((i == 0 && face == GL_BACK) || (i == 1 && face == GL_FRONT))
+			continue;
+		Material &material = state.lighting.materials[i];
+		switch (pname)
+		{
+		case GL_AMBIENT:
+			memcpy(material.ambient, params, 4 * sizeof(GLfloat));
+			break;
+		case GL_DIFFUSE:
+			memcpy(material.diffuse, params, 4 * sizeof(GLfloat));
+			break;
+		case GL_AMBIENT_AND_DIFFUSE:
+			memcpy(material.ambient, params, 4 * sizeof(GLfloat));
+			memcpy(material.diffuse, params, 4 * sizeof(GLfloat));
+			break;
+		case GL_SPECULAR:
+			memcpy(material.specular, params, 4 * sizeof(GLfloat));
+			break;
+		case GL_EMISSION:
+			memcpy(material.emission, params, 4 * sizeof(GLfloat));
+			break;
+		case GL_SHININESS:
+			material.shininess = params[0];
+			break;
+		default:
+			Unsupported("glMaterial", pname);
+			return;
+		}
+	}
+}
+
+void APIENTRY sglMaterialf(GLenum face, GLenum pname, GLfloat param)
+{
+	sglMaterialfv(face, pname, &param);
+}
+
+void APIENTRY sglColorMaterial(GLenum face, GLenum mode)
+{
+	RECORD(sglColorMaterial(face, mode))
+	state.lighting.color_material_face = face;
+	state.lighting.color_material_mode = mode;
+}
+
+// ---------------------------------------------------------------------------
+// listy wywietlania
+
+GLuint APIENTRY sglGenLists(GLsizei range)
+{
+	if (range <= 0)
+		return 0;
+	const GLuint first = next_list;
+	for (int i = 0; i < range; i++)
+		lists[first + i];
+	next_list += range;
+	return first;
+}
+
+void APIENTRY sglNewList(GLuint list, GLenum mode)
+{
+	if (compiling || list == 0)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+	compiled.clear();
+	compiled_name = list;
+	compiling = true;
+	compile_only = mode == GL_COMPILE;
+}
+
+void APIENTRY sglEndList()
+{
+	if (!compiling)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+	compiling = false;
+	lists[compiled_name].swap(compiled);
+	compiled.clear();
+}
+
+void APIENTRY sglCallList(GLuint list)
+{
+	RECORD(sglCallList(list))
+	std::map<GLuint, DisplayList>::const_iterator found = lists.find(list);
+	if (found == lists.end())
+		return;
+
+	// przy GL_COMPILE_AND_EXECUTE wywoania z listy nie s zapisywane
+	// drugi raz (zapisane jest samo glCallList)
+	const bool was_compiling = compiling;
+	compiling = false;
+	const DisplayList &commands = found->second;
+	for (size_t i = 0; i < commands.size(); i++)
+		commands[i]();
+	compiling = was_compiling;
+}
+
+void APIENTRY sglDeleteLists(GLuint list, GLsizei range)
+{
+	for (int i = 0; i < range; i++)
+		lists.erase(list + i);
+}
+
+// ---------------------------------------------------------------------------
+// tablice wierzchokw i obiekty buforowe
+
+static void SetPointer(ArrayPointer &array, GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+	array.size = size;
+	array.type = type;
+	array.stride = stride;
+	array.pointer = pointer;
+	array.buffer = client.array_buffer;
+}
+
+void APIENTRY sglVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+	SetPointer(client.vertex, size, type, stride, pointer);
+}
+
+void APIENTRY sglTexCoordPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+	SetPointer(client.texcoord, size, type, stride, pointer);
+}
+
+void APIENTRY sglColorPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+	SetPointer(client.color, size, type, stride, pointer);
+}
+
+void APIENTRY sglNormalPointer(GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+	SetPointer(client.normal, 3, type, stride, pointer);
+}
+
+static int TypeSize(GLenum type)
+{
+	switch (type)
+	{
+	case GL_BYTE:
+	case GL_UNSIGNED_BYTE:
+		return 1;
+	case GL_SHORT:
+	case GL_UNSIGNED_SHORT:
+		return 2;
+	case GL_DOUBLE:
+		return 8;
+	default:
+		return 4;
+	}
+}
+
+// adres danych tablicy lub bufora (NULL - brak danych)
+
+static const GLubyte *BufferData(GLuint buffer, const GLvoid *pointer)
+{
+	if (buffer == 0)
+		return (const GLubyte*)pointer;
+	std::map<GLuint, std::vector<GLubyte> >::const_iterator found = buffers.find(buffer);
+	if (found == buffers.end() || found->second.empty())
+		return NULL;
+	return &found->second[0] + (size_t)pointer;
+}
+
+template<typename T> static GLfloat Component(const GLubyte *p, int k)
+{
+	T value;
+	memcpy(&value, p + k * sizeof(T), sizeof(T));
+	return (GLfloat)value;
+}
+
+// odczyt elementu index tablicy (skadowe cakowite kolorw - normalizowane)
+
+static void ReadArray(const ArrayPointer &array, const GLubyte *base, int index, bool normalized, GLfloat *out)
+{
+	const int stride = array.stride != 0 ? array.stride : array.size * TypeSize(array.type);
+	const GLubyte *p = base + (size_t)index * stride;
+	for (int k = 0; k < array.size; k++)
+		switch (array.type)
+		{
+		case GL_FLOAT:
+			out[k] = Component<GLfloat>(p, k);
+			break;
+		case GL_DOUBLE:
+			out[k] = Component<GLdouble>(p, k);
+			break;
+		case GL_INT:
+			out[k] = Component<GLint>(p, k);
+			break;
+		case GL_SHORT:
+			out[k] = Component<GLshort>(p, k) / (normalized ? 32767.0f : 1.0f);
+			break;
+		case GL_UNSIGNED_BYTE:
+			out[k] = Component<GLubyte>(p, k) / (normalized ? 255.0f : 1.0f);
+			break;
+		default:
+			Unsupported("typ tablicy wierzcholkow", array.type);
+			out[k] = 0.0f;
+			break;
+		}
+}
+
+// rysowanie wierzchokw odczytanych z tablic; atrybuty tablic wyczonych
+// (arrays) - wartoci biece
+
+static void DrawArrayVertices(GLenum mode, const std::vector<ArrayVertex> &vertices, int arrays)
+{
+	std::vector<SoftVertex> transformed(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const ArrayVertex &v = vertices[i];
+		ProcessVertex(v.position, arrays & ARRAY_COLOR ? v.color : state.current.color,
+			arrays & ARRAY_NORMAL ? v.normal : state.current.normal,
+			arrays & ARRAY_TEXCOORD ? v.texcoord : state.current.texcoord, transformed[i]);
+	}
+	if (!transformed.empty())
+		DrawVertices(mode, &transformed[0], (int)transformed.size());
+}
+
+// odczyt wierzchokw z tablic (indices == NULL - kolejne od first) i ich
+// narysowanie; w licie wywietlania zapisywane s odczytane wartoci
+
+static void DrawArrays(GLenum mode, int first, int count, const std::vector<GLuint> *indices)
+{
+	if (!client.vertex.enabled || count <= 0)
+		return;
+	const GLubyte *vertex = BufferData(client.vertex.buffer, client.vertex.pointer);
+	const GLubyte *color = client.color.enabled ? BufferData(client.color.buffer, client.color.pointer) : NULL;
+	const GLubyte *normal = client.normal.enabled ? BufferData(client.normal.buffer, client.normal.pointer) : NULL;
+	const GLubyte *texcoord = client.texcoord.enabled ?
+		BufferData(client.texcoord.buffer, client.texcoord.pointer) : NULL;
+	if (vertex == NULL)
+		return;
+	const int arrays = (color ? ARRAY_COLOR : 0) | (normal ? ARRAY_NORMAL : 0) | (texcoord ? ARRAY_TEXCOORD : 0);
+
+	std::vector<ArrayVertex> vertices(count);
+	for (int i = 0; i < count; i++)
+	{
+		const int index = indices ? (int)(*indices)[i] : first + i;
+		ArrayVertex &v = vertices[i];
+		Copy4(v.position, 0.0f, 0.0f, 0.0f, 1.0f);
+		Copy4(v.color, 0.0f, 0.0f, 0.0f, 1.0f);
+		Copy4(v.texcoord, 0.0f, 0.0f, 0.0f, 1.0f);
+		ReadArray(client.vertex, vertex, index, false, v.position);
+		if (color)
+			ReadArray(client.color, color, index, true, v.color);
+		if (normal)
+			ReadArray(client.normal, normal, index, true, v.normal);
+		if (texcoord)
+			ReadArray(client.texcoord, texcoord, index, false, v.texcoord);
+	}
+	RECORD(DrawArrayVertices(mode, vertices, arrays))
+	DrawArrayVertices(mode, vertices, arrays);
+}
+
+void APIENTRY sglDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	DrawArrays(mode, first, count, NULL);
+}
+
+void APIENTRY sglDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices)
+{
+	const GLubyte *data = BufferData(client.element_buffer, indices);
+	if (data == NULL || count <= 0)
+		return;
+	std::vector<GLuint> values(count);
+	for (int i = 0; i < count; i++)
+		switch (type)
+		{
+		case GL_UNSIGNED_BYTE:
+			values[i] = data[i];
+			break;
+		case GL_UNSIGNED_SHORT:
+			values[i] = (GLuint)Component<GLushort>(data, i);
+			break;
+		default:
+			memcpy(&values[i], data + 4 * i, 4);
+			break;
+		}
+	DrawArrays(mode, 0, count, &values);
+}
+
+static void APIENTRY GenBuffers(GLsizei n, GLuint *names)
+{
+	for (int i = 0; i < n; i++)
+	{
+		while (buffers.count(next_buffer))
+			next_buffer++;
+		names[i] = next_buffer;
+		buffers[next_buffer++];
+	}
+}
+
+static void APIENTRY DeleteBuffers(GLsizei n, const GLuint *names)
+{
+	for (int i = 0; i < n; i++)
+	{
+		buffers.erase(names[i]);
+		if (client.array_buffer == names[i])
+			client.array_buffer = 0;
+		if (client.element_buffer == names[i])
+			client.element_buffer = 0;
+	}
+}
+
+static void APIENTRY BindBuffer(GLenum target, GLuint buffer)
+{
+	if (target == GL_ARRAY_BUFFER)
+		client.array_buffer = buffer;
+	else if (target == GL_ELEMENT_ARRAY_BUFFER)
+		client.element_buffer = buffer;
+	else
+		Unsupported("rodzaj bufora", target);
+}
+
+static std::vector<GLubyte> *BoundBuffer(GLenum target)
+{
+	const GLuint name = target == GL_ELEMENT_ARRAY_BUFFER ? client.element_buffer : client.array_buffer;
+	if (name == 0)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return NULL;
+	}
+	return &buffers[name];
+}
+
+static void APIENTRY BufferDataFunction(GLenum target, GLsizeiptr size, const void *data, GLenum)
+{
+	std::vector<GLubyte> *buffer = BoundBuffer(target);
+	if (buffer == NULL)
+		return;
+	if (data)
+		buffer->assign((const GLubyte*)data, (const GLubyte*)data + size);
+	else
+		buffer->assign(size, 0);
+}
+
+static void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+	std::vector<GLubyte> *buffer = BoundBuffer(target);
+	if (buffer == NULL)
+		return;
+	if (offset < 0 || offset + size > (GLsizeiptr)buffer->size())
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+	memcpy(&(*buffer)[offset], data, size);
+}
+
+extern "C" void (*SoftGetProcAddress(const GLubyte *name))(void)
+{
+	typedef void (*Function)(void);
+	std::string function = (const char*)name;
+	if (function.size() > 3 && function.compare(function.size() - 3, 3, "ARB") == 0)
+		function.erase(function.size() - 3);
+	if (function == "glGenBuffers")
+		return (Function)GenBuffers;
+	if (function == "glDeleteBuffers")
+		return (Function)DeleteBuffers;
+	if (function == "glBindBuffer")
+		return (Function)BindBuffer;
+	if (function == "glBufferData")
+		return (Function)BufferDataFunction;
+	if (function == "glBufferSubData")
+		return (Function)BufferSubData;
+	return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// stosy atrybutw
+
+void APIENTRY sglPushAttrib(GLbitfield mask)
+{
+	RECORD(sglPushAttrib(mask))
+	if ((int)attrib_stack.size() >= MAX_STACK_DEPTH)
+	{
+		SetError(GL_STACK_OVERFLOW);
+		return;
+	}
+	attrib_stack.push_back(std::make_pair(mask, state));
+}
+
+void APIENTRY sglPopAttrib()
+{
+	RECORD(sglPopAttrib())
+	if (attrib_stack.empty())
+	{
+		SetError(GL_STACK_UNDERFLOW);
+		return;
+	}
+	const GLbitfield mask = attrib_stack.back().first;
+	const ServerState &saved = attrib_stack.back().second;
+	EnableState &enable = state.enable;
+
+	if (mask & GL_CURRENT_BIT)
+		state.current = saved.current;
+	if (mask & GL_ENABLE_BIT)
+		enable = saved.enable;
+	if (mask & GL_DEPTH_BUFFER_BIT)
+	{
+		state.depth = saved.depth;
+		enable.depth_test = saved.enable.depth_test;
+	}
+	if (mask & GL_COLOR_BUFFER_BIT)
+	{
+		state.color_buffer = saved.color_buffer;
+		enable.alpha_test = saved.enable.alpha_test;
+		enable.blend = saved.enable.blend;
+	}
+	if (mask & GL_FOG_BIT)
+	{
+		state.fog = saved.fog;
+		enable.fog = saved.enable.fog;
+	}
+	if (mask & GL_LIGHTING_BIT)
+	{
+		state.lighting = saved.lighting;
+		enable.lighting = saved.enable.lighting;
+		enable.color_material = saved.enable.color_material;
+		memcpy(enable.light, saved.enable.light, sizeof(enable.light));
+	}
+	if (mask & GL_POLYGON_BIT)
+	{
+		state.polygon = saved.polygon;
+		enable.cull_face = saved.enable.cull_face;
+		enable.polygon_offset = saved.enable.polygon_offset;
+	}
+	if (mask & GL_TEXTURE_BIT)
+	{
+		state.texture = saved.texture;
+		enable.texture_1d = saved.enable.texture_1d;
+		enable.texture_2d = saved.enable.texture_2d;
+	}
+	if (mask & GL_TRANSFORM_BIT)
+	{
+		state.matrix_mode = saved.matrix_mode;
+		enable.normalize = saved.enable.normalize;
+	}
+	if (mask & GL_VIEWPORT_BIT)
+		state.viewport = saved.viewport;
+	if (mask & GL_POINT_BIT)
+		state.point_size = saved.point_size;
+	if (mask & GL_LINE_BIT)
+		state.line_width = saved.line_width;
+	if (mask & GL_HINT_BIT)
+		state.hints = saved.hints;
+	attrib_stack.pop_back();
+	raster_dirty = true;
+}
+
+void APIENTRY sglPushClientAttrib(GLbitfield mask)
+{
+	if ((int)client_stack.size() >= MAX_STACK_DEPTH)
+	{
+		SetError(GL_STACK_OVERFLOW);
+		return;
+	}
+	client_stack.push_back(std::make_pair(mask, client));
+}
+
+void APIENTRY sglPopClientAttrib()
+{
+	if (client_stack.empty())
+	{
+		SetError(GL_STACK_UNDERFLOW);
+		return;
+	}
+	const GLbitfield mask = client_stack.back().first;
+	const ClientState &saved = client_stack.back().second;
+	if (mask & GL_CLIENT_VERTEX_ARRAY_BIT)
+	{
+		client.vertex = saved.vertex;
+		client.normal = saved.normal;
+		client.color = saved.color;
+		client.texcoord = saved.texcoord;
+		client.array_buffer = saved.array_buffer;
+		client.element_buffer = saved.element_buffer;
+	}
+	if (mask & GL_CLIENT_PIXEL_STORE_BIT)
+	{
+		client.unpack_alignment = saved.unpack_alignment;
+		client.pack_alignment = saved.pack_alignment;
+	}
+	client_stack.pop_back();
+}
+
+// ---------------------------------------------------------------------------
+// odczyt obrazu i stanu
+
+void APIENTRY sglReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
+	GLvoid *pixels)
+{
+	if (type != GL_UNSIGNED_BYTE ||
+		(format != GL_RGB && format != GL_BGR && format != GL_RGBA && format != GL_BGRA))
+	{
+		Unsupported("format glReadPixels", type != GL_UNSIGNED_BYTE ? type : format);
+		return;
+	}
+	RasterFlush();
+	RasterReadPixels(x, y, width, height, format, client.pack_alignment, (GLubyte*)pixels);
+}
+
+int SoftExtensionSupported(const char *name)
+{
+	const char *extensions = (const char*)sglGetString(GL_EXTENSIONS);
+	const size_t length = strlen(name);
+	for (const char *p = strstr(extensions, name); p != NULL; p = strstr(p + 1, name))
+		if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0'))
+			return 1;
+	return 0;
+}
+
+const GLubyte *APIENTRY sglGetString(GLenum name)
+{
+	switch (name)
+	{
+	case GL_VENDOR:
+		return (const GLubyte*)"SoftGL";
+	case GL_RENDERER:
+		return (const GLubyte*)renderer;
+	case GL_VERSION:
+		return (const GLubyte*)"1.5 SoftGL";
+	case GL_EXTENSIONS:
+		return (const GLubyte*)"GL_ARB_vertex_buffer_object GL_SGIS_generate_mipmap";
+	default:
+		SetError(GL_INVALID_ENUM);
+		return NULL;
+	}
+}
+
+void APIENTRY sglGetIntegerv(GLenum pname, GLint *params)
+{
+	switch (pname)
+	{
+	case GL_VIEWPORT:
+		params[0] = state.viewport.x;
+		params[1] = state.viewport.y;
+		params[2] = state.viewport.width;
+		params[3] = state.viewport.height;
+		return;
+	case GL_MATRIX_MODE:
+		*params = state.matrix_mode;
+		return;
+	case GL_MAX_TEXTURE_SIZE:
+		*params = MAX_TEXTURE_SIZE;
+		return;
+	case GL_MAX_LIGHTS:
+		*params = MAX_LIGHTS;
+		return;
+	case GL_MAX_MODELVIEW_STACK_DEPTH:
+	case GL_MAX_PROJECTION_STACK_DEPTH:
+	case GL_MAX_TEXTURE_STACK_DEPTH:
+	case GL_MAX_ATTRIB_STACK_DEPTH:
+	case GL_MAX_CLIENT_ATTRIB_STACK_DEPTH:
+		*params = MAX_STACK_DEPTH;
+		return;
+	case GL_TEXTURE_BINDING_1D:
+		*params = state.texture.binding_1d;
+		return;
+	case GL_TEXTURE_BINDING_2D:
+		*params = state.texture.binding_2d;
+		return;
+	case GL_ARRAY_BUFFER_BINDING:
+		*params = client.array_buffer;
+		return;
+	case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+		*params = client.element_buffer;
+		return;
+	case GL_DEPTH_FUNC:
+		*params = state.depth.func;
+		return;
+	case GL_DEPTH_WRITEMASK:
+		*params = state.depth.mask;
+		return;
+	case GL_ALPHA_TEST_FUNC:
+		*params = state.color_buffer.alpha_func;
+		return;
+	case GL_BLEND_SRC:
+		*params = state.color_buffer.blend_src;
+		return;
+	case GL_BLEND_DST:
+		*params = state.color_buffer.blend_dst;
+		return;
+	case GL_CULL_FACE_MODE:
+		*params = state.polygon.cull_face;
+		return;
+	case GL_FRONT_FACE:
+		*params = state.polygon.front_face;
+		return;
+	case GL_SHADE_MODEL:
+		*params = state.lighting.shade_model;
+		return;
+	case GL_FOG_MODE:
+		*params = state.fog.mode;
+		return;
+	case GL_UNPACK_ALIGNMENT:
+		*params = client.unpack_alignment;
+		return;
+	case GL_PACK_ALIGNMENT:
+		*params = client.pack_alignment;
+		return;
+	case GL_RED_BITS:
+	case GL_GREEN_BITS:
+	case GL_BLUE_BITS:
+		*params = 8;
+		return;
+	case GL_ALPHA_BITS:
+	case GL_STENCIL_BITS:
+		*params = 0;
+		return;
+	case GL_DEPTH_BITS:
+		*params = 24;
+		return;
+	case GL_PERSPECTIVE_CORRECTION_HINT:
+	case GL_POINT_SMOOTH_HINT:
+	case GL_LINE_SMOOTH_HINT:
+	case GL_POLYGON_SMOOTH_HINT:
+	case GL_FOG_HINT:
+	case GL_GENERATE_MIPMAP_HINT:
+	{
+		std::map<GLenum, GLenum>::const_iterator found = state.hints.find(pname);
+		*params = found != state.hints.end() ? found->second : GL_DONT_CARE;
+		return;
+	}
+	}
+	GLfloat values[16];
+	sglGetFloatv(pname, values);
+	*params = (GLint)values[0];
+}
+
+void APIENTRY sglGetFloatv(GLenum pname, GLfloat *params)
+{
+	switch (pname)
+	{
+	case GL_MODELVIEW_MATRIX:
+		memcpy(params, MatrixStackTop(modelview).m, 16 * sizeof(GLfloat));
+		return;
+	case GL_PROJECTION_MATRIX:
+		memcpy(params, MatrixStackTop(projection).m, 16 * sizeof(GLfloat));
+		return;
+	case GL_TEXTURE_MATRIX:
+		memcpy(params, MatrixStackTop(texture_matrix).m, 16 * sizeof(GLfloat));
+		return;
+	case GL_CURRENT_COLOR:
+		memcpy(params, state.current.color, 4 * sizeof(GLfloat));
+		return;
+	case GL_COLOR_CLEAR_VALUE:
+		memcpy(params, state.color_buffer.clear, 4 * sizeof(GLfloat));
+		return;
+	case GL_FOG_COLOR:
+		memcpy(params, state.fog.color, 4 * sizeof(GLfloat));
+		return;
+	case GL_FOG_DENSITY:
+		*params = state.fog.density;
+		return;
+	case GL_FOG_START:
+		*params = state.fog.start;
+		return;
+	case GL_FOG_END:
+		*params = state.fog.end;
+		return;
+	case GL_ALPHA_TEST_REF:
+		*params = state.color_buffer.alpha_ref;
+		return;
+	case GL_DEPTH_CLEAR_VALUE:
+		*params = state.depth.clear;
+		return;
+	case GL_POINT_SIZE:
+		*params = state.point_size;
+		return;
+	case GL_LINE_WIDTH:
+		*params = state.line_width;
+		return;
+	case GL_POLYGON_OFFSET_FACTOR:
+		*params = state.polygon.offset_factor;
+		return;
+	case GL_POLYGON_OFFSET_UNITS:
+		*params = state.polygon.offset_units;
+		return;
+	}
+	Unsupported("glGet", pname);
+	*params = 0.0f;
+}
+
+GLenum APIENTRY sglGetError()
+{
+	const GLenum code = error;
+	error = GL_NO_ERROR;
+	return code;
+}
+
+void APIENTRY sglFlush()
+{
+	RasterFlush();
+}
+
+void APIENTRY sglFinish()
+{
+	RasterFlush();
+}
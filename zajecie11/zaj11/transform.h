@@ -0,0 +1,119 @@
+#ifndef __TRANSFORM__H__
+#define __TRANSFORM__H__
+
+#include <GL/glut.h>
+#include <vector>
+
+// przeksztacenia obliczane na CPU zamiast cigu glLoadIdentity, glTranslatef,
+// glRotatef, glScalef i glPushMatrix/glPopMatrix w kadej ramce: macierze
+// obiektw tworz hierarchi (kamera -> obiekty -> czci obiektw), macierz
+// wynikowa wza jest przeliczana tylko po zmianie jego macierzy lokalnej
+// lub macierzy ktrego z przodkw, a do OpenGL trafia jednym wywoaniem
+// glLoadMatrixf (pomijanym, gdy macierz jest ju zaadowana); mnoenie
+// macierzy korzysta z instrukcji SSE (bez SSE - obliczenia skalarne)
+
+// macierz 4 x 4 w ukadzie kolumnowym OpenGL
+
+struct Matrix
+{
+	GLfloat m[16];
+};
+
+// macierze przeksztace - odpowiedniki glLoadIdentity, glTranslatef,
+// glRotatef (kt w stopniach) i glScalef
+
+Matrix MatrixIdentity();
+Matrix MatrixTranslation(GLfloat x, GLfloat y, GLfloat z);
+Matrix MatrixRotation(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+Matrix MatrixScaling(GLfloat x, GLfloat y, GLfloat z);
+
+// iloczyn a * b (przeksztacenie b wykonywane jako pierwsze - jak przy
+// wywoaniu glMultMatrixf(b) po zaadowaniu macierzy a)
+
+Matrix MatrixMultiply(const Matrix &a, const Matrix &b);
+
+// iloczyny result[i] = a * b[i] dla count macierzy
+
+void MatrixMultiply(const Matrix &a, const Matrix *b, Matrix *result, int count);
+
+// stos macierzy na CPU - odpowiednik stosu macierzy modelowania OpenGL;
+// MatrixStackMultiply mnoy macierz na szczycie stosu z prawej strony
+
+struct MatrixStack
+{
+	std::vector<Matrix> matrices;
+
+	MatrixStack() : matrices(1, MatrixIdentity()) {}
+};
+
+void MatrixStackPush(MatrixStack &stack);
+void MatrixStackPop(MatrixStack &stack);
+void MatrixStackLoad(MatrixStack &stack, const Matrix &matrix);
+void MatrixStackMultiply(MatrixStack &stack, const Matrix &matrix);
+const Matrix &MatrixStackTop(const MatrixStack &stack);
+
+// wywoania w ramce: przeliczone macierze wzw, macierze wzite bez zmian
+// z pamici podrcznej, wywoania glLoadMatrixf i wywoania pominite
+
+struct TransformStats
+{
+	int updated = 0;
+	int cached = 0;
+	int loads = 0;
+	int skipped = 0;
+};
+
+// wze hierarchii
+
+struct TransformNode
+{
+	int parent;           // wze nadrzdny (-1 - korze)
+	Matrix local;         // przeksztacenie wzgldem wza nadrzdnego
+	Matrix world;         // macierz wynikowa: world rodzica * local
+	bool changed;         // local zmieniona od ostatniego TransformUpdate
+	bool updated;         // world przeliczona w ostatnim TransformUpdate
+};
+
+// hierarchia przeksztace; wze nadrzdny jest zawsze dodawany przed
+// wzami podrzdnymi, wic przeliczenie w kolejnoci dodania wzw
+// obejmuje najpierw rodzicw
+
+struct TransformHierarchy
+{
+	std::vector<TransformNode> nodes;
+	int loaded = -1;      // wze, ktrego macierz jest zaadowana do OpenGL
+	TransformStats stats, last_stats;
+};
+
+// dodanie wza (parent == -1 - korze); zwraca numer wza
+
+int TransformAdd(TransformHierarchy &hierarchy, int parent, const Matrix &local);
+
+// zmiana macierzy lokalnej wza; macierz rwna dotychczasowej nie
+// uniewania macierzy wynikowych wza i jego potomkw
+
+void TransformSet(TransformHierarchy &hierarchy, int node, const Matrix &local);
+
+// przeliczenie macierzy wynikowych zmienionych wzw i ich potomkw -
+// wywoywane raz w ramce, przed rysowaniem; macierz zaadowana do OpenGL
+// przed wywoaniem nie jest ju uznawana za biec (moga zosta
+// zmieniona poza hierarchi)
+
+void TransformUpdate(TransformHierarchy &hierarchy);
+
+// macierz wynikowa wza (po TransformUpdate)
+
+const Matrix &TransformWorld(const TransformHierarchy &hierarchy, int node);
+
+// zaadowanie macierzy wynikowej wza jako macierzy modelowania
+// (glLoadMatrixf przy wybranej macierzy GL_MODELVIEW)
+
+void TransformLoad(TransformHierarchy &hierarchy, int node);
+
+// zakoczenie ramki - liczniki biecej ramki staj si licznikami
+// ostatniej ramki i s zerowane
+
+void TransformFrameEnd(TransformHierarchy &hierarchy);
+const TransformStats &TransformLastFrame(const TransformHierarchy &hierarchy);
+
+#endif // __TRANSFORM__H__
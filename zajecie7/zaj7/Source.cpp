@@ -1,12 +1,22 @@
 #include <GL/glut.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
 #include "colors.h"
 #include "gltools_extracted.h"
 #include "VectorMath.cpp"
+#include "vector_simd.h"
 #include <array>
+#include <map>
 #include <vector>
+#include "pyramid.h"
+#include "primitives.h"
+#include "mesh.h"
+#include "wireframe.h"
+#include "extensions.h"
 
-const GLint N = 9;
+// liczba bokw podstawy ostrosupa (argument programu)
+GLint sides = 9;
 
 // rozmiary bryy obcinania
 const GLdouble left = -2.0;
@@ -20,6 +30,7 @@ enum
 {
 	CUTTING_PLANE, // paszczyzna przekroju
 	POLYGON_OFFSET, // przesunicie wartoci gbi
+	SINGLE_PASS, // krawdzie w jednym przebiegu (GLSL)
 	EXIT // wyjcie
 };
 // kt obrotu kuli
@@ -31,53 +42,99 @@ GLfloat rotatey = 0.0;
 bool cutting_plane = true;
 // wskanik przesunicia wartoci gbi
 bool polygon_offset = true;
+// wskanik rysowania bry z krawdziami w jednym przebiegu (program GLSL);
+// bez programw GLSL wypenienie i krawdzie s rysowane osobno
+bool single_pass = true;
 // wskanik nacinicia lewego przycisku myszki
 int button_state = GLUT_UP;
 // pooenie kursora myszki
 int button_x, button_y;
 
 
-void drawPyramid(GLuint n, GLfloat size, GLenum type, bool drawBase)
+// ostrosup zapisany w obiektach buforowych - generowany tylko raz dla
+// danej liczby bokw i rozmiaru; kady trjkt ma wasne wierzchoki
+// z wektorem normalnym ciany, a za indeksami trjktw zapisane s
+// krawdzie trjktw (GL_LINES) w tej samej kolejnoci (obwd kadego
+// trjkta jak przy GL_LINE_LOOP); trjkty i krawdzie podstawy s
+// pierwsze, wic bez podstawy rysowany jest tylko koniec zakresu
+struct PyramidGeometry
 {
-	GLTVector3 topVertice{ 0.0f, +size, 0.0f };
-	GLTVector3 baseCenter{ 0.0f, -size / 2.0, 0.0f };
+	Mesh mesh;
+	int triangle_indices = 0; // liczba indeksw trjktw
+	int base_indices = 0; // w tym indeksw trjktw podstawy
+	WireframeMesh wireframe; // trjkty z krawdziami cian bocznych (jeden przebieg)
+};
 
-	std::vector<GLTVector3> bottomVertices{ n };
+// klucz pamici podrcznej - liczba bokw i rozmiar ostrosupa
+struct PyramidKey
+{
+	GLuint n;
+	GLfloat size;
 
-	for (int i = 0; i < n; ++i)
+	bool operator<(const PyramidKey &key) const
 	{
-		const GLfloat angle = (GLfloat)i / n * 3.1415926 * 2.0;
-
-		bottomVertices[i][0] = size * sin(angle);
-		bottomVertices[i][1] = -size / 2;
-		bottomVertices[i][2] = size * cos(angle);
+		return n != key.n ? n < key.n : size < key.size;
 	}
+};
+
+std::map<PyramidKey, PyramidGeometry> pyramids;
+
+PyramidGeometry &getPyramid(GLuint n, GLfloat size)
+{
+	const PyramidKey key = { n, size };
+	std::map<PyramidKey, PyramidGeometry>::iterator it = pyramids.find(key);
+	if (it != pyramids.end())
+		return it->second;
 
-	if (drawBase)
+	PyramidParams params;
+	params.sides = n;
+	params.radius = size;
+	params.bottom = -size / 2;
+	params.top = size;
+	PyramidMesh solid;
+	GeneratePyramid(params, solid);
+
+	// normalne wszystkich cian liczone jednym wywoaniem
+	const int triangles = (int)solid.triangles.size() / 3;
+	std::vector<GLfloat> normals(solid.triangles.size());
+	FaceNormals(solid.vertices.data(), solid.triangles.data(), triangles, normals.data());
+
+	// wierzchoki trjktw z normalnymi cian; indeksy trjktw, a za nimi krawdzie
+	std::vector<GLfloat> positions(9 * triangles), vertex_normals(9 * triangles);
+	std::vector<int> indices(9 * triangles);
+	for (int i = 0; i < 3 * triangles; i++)
 	{
-		for (int i = 0; i <= n; ++i)
+		for (int k = 0; k < 3; k++)
 		{
-			glBegin(type);
-			glNormal3f(0.0f, -1.0f, 0.0f);
-			glVertex3fv(baseCenter);
-			glVertex3fv(bottomVertices[(i + 1) % n]);
-			glVertex3fv(bottomVertices[i % n]);
-			glEnd();
+			positions[3 * i + k] = solid.vertices[3 * solid.triangles[i] + k];
+			vertex_normals[3 * i + k] = normals[3 * (i / 3) + k];
 		}
+		indices[i] = i;
+		indices[3 * triangles + 2 * i + 0] = i;
+		indices[3 * triangles + 2 * i + 1] = i % 3 == 2 ? i - 2 : i + 1;
 	}
-	for (int i = 0; i <= n; ++i)
-	{
-		glBegin(type);
-		GLTVector3 normal;
-		gltGetNormalVector(bottomVertices[i % n], bottomVertices[(i + 1) % n], topVertice, normal);
-		glNormal3fv(normal);
 
-		glVertex3fv(bottomVertices[i % n]);
-		glVertex3fv(bottomVertices[(i + 1) % n]);
-		glVertex3fv(topVertice);
+	PyramidGeometry &pyramid = pyramids[key];
+	pyramid.triangle_indices = 3 * triangles;
+	pyramid.base_indices = 3 * solid.base_triangles;
+	MeshSet(pyramid.mesh, positions.data(), vertex_normals.data(), NULL, 3 * triangles, indices.data(),
+		(int)indices.size());
+	WireframeSet(pyramid.wireframe, pyramid.mesh, 0, pyramid.triangle_indices,
+		pyramid.triangle_indices + 2 * pyramid.base_indices, 2 * (pyramid.triangle_indices - pyramid.base_indices));
+	return pyramid;
+}
 
-		glEnd();
-	}
+// narysowanie ostrosupa jednym wywoaniem: trjkty (GL_TRIANGLES) lub
+// obwody trjktw (GL_LINE_LOOP) zapisane w buforze indeksw jako GL_LINES
+void drawPyramid(GLuint n, GLfloat size, GLenum type, bool drawBase)
+{
+	PyramidGeometry &pyramid = getPyramid(n, size);
+	const int skip = drawBase ? 0 : pyramid.base_indices;
+	if (type == GL_LINE_LOOP)
+		MeshDrawRange(pyramid.mesh, pyramid.triangle_indices + 2 * skip, 2 * (pyramid.triangle_indices - skip),
+			GL_LINES);
+	else
+		MeshDrawRange(pyramid.mesh, skip, pyramid.triangle_indices - skip, type);
 }
 
 void drawSolidPyramid(GLint n, GLdouble size)
@@ -90,6 +147,25 @@ void drawWirePyramid(GLint n, GLdouble size)
 	drawPyramid(n, size, GL_LINE_LOOP, false);
 }
 
+// ostrosup w kolorze biecym z krawdziami cian w kolorze edge_color
+// narysowany w jednym przebiegu
+void drawEdgedPyramid(GLint n, GLdouble size, const GLfloat *edge_color)
+{
+	WireframeDraw(getPyramid(n, size).wireframe, edge_color);
+}
+
+// kula z krawdziami w jednym przebiegu; siatka z wierzchokami
+// trjktw tworzona przy pierwszym uyciu
+WireframeMesh sphere_wireframe;
+
+void drawEdgedSphere(Primitive &sphere, const GLfloat *edge_color)
+{
+	if (sphere_wireframe.vertex_count == 0)
+		WireframeSet(sphere_wireframe, sphere.mesh, 0, sphere.triangle_indices, sphere.triangle_indices,
+			sphere.line_indices);
+	WireframeDraw(sphere_wireframe, edge_color);
+}
+
 // funkcja generujca scen 3D
 void Display()
 {
@@ -117,14 +193,21 @@ void Display()
 	angle += 0.2;
 	glRotatef(angle, 1.0, 1.0, 0.0);
 	glColor3fv(Yellow);
-	if (polygon_offset)
-		glEnable(GL_POLYGON_OFFSET_FILL);
-	glPolygonOffset(1.0, 1.0);
-	glutSolidSphere(0.5, 10, 10);
-	glColor3fv(Black);
-	glutWireSphere(0.5, 10, 10);
-	if (polygon_offset)
-		glDisable(GL_POLYGON_OFFSET_FILL);
+	// obie kule korzystaj z tej samej siatki zapisanej w obiektach buforowych
+	Primitive &sphere = Sphere(0.5, 10, 10);
+	if (single_pass && WireframeAvailable())
+		drawEdgedSphere(sphere, Black);
+	else
+	{
+		if (polygon_offset)
+			glEnable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(1.0, 1.0);
+		PrimitiveDrawSolid(sphere);
+		glColor3fv(Black);
+		PrimitiveDrawWire(sphere);
+		if (polygon_offset)
+			glDisable(GL_POLYGON_OFFSET_FILL);
+	}
 	glPopMatrix();
 
 
@@ -185,14 +268,19 @@ void Display()
 	}
 	// waciwy szecian z obramowaniem, ktrego rysowanie wymusza brak owietlenia
 	glColor3fv(Red);
-	if (polygon_offset)
-		glEnable(GL_POLYGON_OFFSET_FILL);
-	//glPolygonOffset(1.0, 1.0);
-	drawSolidPyramid(N, 2.0);
-	glColor3fv(Black);
-	drawWirePyramid(N, 2.0);
-	if (polygon_offset)
-		glDisable(GL_POLYGON_OFFSET_FILL);
+	if (single_pass && WireframeAvailable())
+		drawEdgedPyramid(sides, 2.0, Black);
+	else
+	{
+		if (polygon_offset)
+			glEnable(GL_POLYGON_OFFSET_FILL);
+		//glPolygonOffset(1.0, 1.0);
+		drawSolidPyramid(sides, 2.0);
+		glColor3fv(Black);
+		drawWirePyramid(sides, 2.0);
+		if (polygon_offset)
+			glDisable(GL_POLYGON_OFFSET_FILL);
+	}
 	// skierowanie polece do wykonania
 	glFlush();
 	// zamiana buforw koloru
@@ -279,6 +367,11 @@ void Menu(int value)
 		polygon_offset = !polygon_offset;
 		Display();
 		break;
+		// krawdzie w jednym lub w dwch przebiegach
+	case SINGLE_PASS:
+		single_pass = !single_pass;
+		Display();
+		break;
 		// wyjcie
 	case EXIT:
 		exit(0);
@@ -288,12 +381,19 @@ int main(int argc, char * argv[])
 {
 	// inicjalizacja biblioteki GLUT
 	glutInit(&argc, argv);
+	if (argc > 1 && atoi(argv[1]) >= 3)
+		sides = atoi(argv[1]);
 	// inicjalizacja bufora ramki
 	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
 	// rozmiary gwnego okna programu
 	glutInitWindowSize(500, 500);
 	// utworzenie gwnego okna programu
 	glutCreateWindow("Z-bufor");
+	// obiekty buforowe dla siatek bry
+	ExtensionFunctionsSetup();
+	// program cieniujcy do rysowania bry z krawdziami w jednym przebiegu
+	if (!WireframeInit())
+		printf("Programy GLSL niedostepne - krawedzie rysowane w dwoch przebiegach\n");
 	// doczenie funkcji generujcej scen 3D
 	glutDisplayFunc(Display);
 	// doczenie funkcji wywoywanej przy zmianie rozmiaru okna
@@ -311,10 +411,12 @@ int main(int argc, char * argv[])
 #ifdef WIN32
 	glutAddMenuEntry("Paszczyzna przekroju: rysowana/nierysowana", CUTTING_PLANE);
 	glutAddMenuEntry("Przesunicie wartoci gbi: wcz/wycz", POLYGON_OFFSET);
+	glutAddMenuEntry("Krawdzie: jeden przebieg (GLSL)/dwa przebiegi", SINGLE_PASS);
 	glutAddMenuEntry("Wyjcie", EXIT);
 #else
 	glutAddMenuEntry("Plaszczyzna przekroju: rysowana/nierysowana", CUTTING_PLANE);
 	glutAddMenuEntry("Przesuniecie wartosci glebi: wlacz/wylacz", POLYGON_OFFSET);
+	glutAddMenuEntry("Krawedzie: jeden przebieg (GLSL)/dwa przebiegi", SINGLE_PASS);
 	glutAddMenuEntry("Wyjscie", EXIT);
 #endif
 	// okrelenie przycisku myszki obsugujcej menu podrczne
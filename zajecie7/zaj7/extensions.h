@@ -0,0 +1,80 @@
+#ifndef __EXTENSIONS__H__
+#define __EXTENSIONS__H__
+
+#include <GL/glut.h>
+#include <GL/glext.h>
+
+// wskaniki na funkcje obiektw buforowych (OpenGL 1.5 / ARB_vertex_buffer_object)
+
+extern PFNGLGENBUFFERSPROC glGenBuffers;
+extern PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+extern PFNGLBINDBUFFERPROC glBindBuffer;
+extern PFNGLBUFFERDATAPROC glBufferData;
+extern PFNGLBUFFERSUBDATAPROC glBufferSubData;
+
+// wskaniki na funkcje obiektw zapyta (OpenGL 1.5 / 3.3 / ARB_timer_query)
+
+extern PFNGLGENQUERIESPROC glGenQueries;
+extern PFNGLDELETEQUERIESPROC glDeleteQueries;
+extern PFNGLBEGINQUERYPROC glBeginQuery;
+extern PFNGLENDQUERYPROC glEndQuery;
+extern PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+extern PFNGLQUERYCOUNTERPROC glQueryCounter;
+
+// wskaniki na funkcje programw cieniujcych GLSL (OpenGL 2.0)
+
+extern PFNGLCREATESHADERPROC glCreateShader;
+extern PFNGLSHADERSOURCEPROC glShaderSource;
+extern PFNGLCOMPILESHADERPROC glCompileShader;
+extern PFNGLGETSHADERIVPROC glGetShaderiv;
+extern PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
+extern PFNGLDELETESHADERPROC glDeleteShader;
+extern PFNGLCREATEPROGRAMPROC glCreateProgram;
+extern PFNGLATTACHSHADERPROC glAttachShader;
+extern PFNGLLINKPROGRAMPROC glLinkProgram;
+extern PFNGLGETPROGRAMIVPROC glGetProgramiv;
+extern PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
+extern PFNGLUSEPROGRAMPROC glUseProgram;
+extern PFNGLDELETEPROGRAMPROC glDeleteProgram;
+extern PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
+extern PFNGLUNIFORM1FPROC glUniform1f;
+extern PFNGLUNIFORM2FPROC glUniform2f;
+extern PFNGLUNIFORM4FVPROC glUniform4fv;
+
+// wskaniki na funkcje obiektw bufora ramki (OpenGL 3.0 / ARB_framebuffer_object
+// / EXT_framebuffer_object)
+
+extern PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+extern PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
+extern PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+extern PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D;
+extern PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
+extern PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers;
+extern PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers;
+extern PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer;
+extern PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage;
+extern PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
+
+// dostpno obiektw buforowych
+
+extern bool buffer_objects;
+
+// dostpno zapyta o czas wykonania polece (GL_TIME_ELAPSED i GL_TIMESTAMP)
+
+extern bool timer_query;
+
+// dostpno programw cieniujcych GLSL
+
+extern bool shaders;
+
+// dostpno obiektw bufora ramki (rysowanie do tekstury)
+
+extern bool framebuffer_objects;
+
+// pobranie wskanikw na funkcje rozszerze; wywoywana po utworzeniu
+// kontekstu (okna); funkcje niedostpne maj warto NULL
+
+void ExtensionFunctionsSetup();
+
+#endif // __EXTENSIONS__H__
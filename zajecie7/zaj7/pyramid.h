@@ -0,0 +1,41 @@
+#ifndef __PYRAMID__H__
+#define __PYRAMID__H__
+
+#include <vector>
+
+// parametry ostrosupa lub graniastosupa o podstawie n-kta foremnego;
+// o bryy to o Y (lub Z gdy z_up == true), wierzchoki podstawy le
+// w kierunkach (sin a, cos a) dla a = 2 pi i / sides
+
+struct PyramidParams
+{
+	int sides = 9; // liczba bokw podstawy
+	int rings = 1; // podzia radialny podstaw (liczba piercieni)
+	int stacks = 1; // podzia pionowy cian bocznych
+	float radius = 1.0f; // promie okrgu opisanego na podstawie
+	float top_radius = 0.0f; // promie grnej podstawy (0 - ostrosup)
+	float bottom = 0.0f; // pooenie dolnej podstawy na osi bryy
+	float top = 1.0f; // pooenie wierzchoka (grnej podstawy)
+	bool base = true; // generowanie cian podstaw
+	bool z_up = false; // o bryy - o Z zamiast osi Y
+};
+
+// wygenerowana brya; trjkty s zorientowane przeciwnie do ruchu wskazwek
+// zegara patrzc z zewntrz bryy; najpierw trjkty podstaw, potem cian bocznych
+
+struct PyramidMesh
+{
+	std::vector<float> vertices; // wsprzdne (x, y, z) wierzchokw
+	std::vector<int> triangles; // indeksy wierzchokw trjktw
+	int base_triangles = 0; // liczba trjktw podstaw
+};
+
+// liczba trjktw bryy o podanych parametrach (bez generowania)
+
+long long PyramidTriangleCount(const PyramidParams &params);
+
+// generowanie bryy
+
+void GeneratePyramid(const PyramidParams &params, PyramidMesh &mesh);
+
+#endif // __PYRAMID__H__
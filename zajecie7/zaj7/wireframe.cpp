@@ -0,0 +1,205 @@
+#include "wireframe.h"
+#include "extensions.h"
+#include <stdio.h>
+#include <algorithm>
+#include <array>
+#include <set>
+
+// program cieniujcy (0 - niedostpny) i pooenia zmiennych jednorodnych
+
+static GLuint program = 0;
+static GLint edge_color_location = -1;
+static GLint edge_width_location = -1;
+
+// wsprzdne barycentryczne przekazywane jako wsprzdne tekstury
+// (tablice wierzchokw jak w pozostaych siatkach), kolor biecy jako
+// kolor wypenienia; owietlenie nie jest obliczane
+
+static const char *vertex_shader =
+	"varying vec3 barycentric;\n"
+	"void main()\n"
+	"{\n"
+	"	barycentric = gl_MultiTexCoord0.xyz;\n"
+	"	gl_FrontColor = gl_Color;\n"
+	"	gl_Position = ftransform();\n"
+	"}\n";
+
+// fwidth - zmiana wsprzdnych midzy ssiednimi pikselami, wic szeroko
+// krawdzi jest staa w pikselach niezalenie od odlegoci i nachylenia trjkta
+
+static const char *fragment_shader =
+	"uniform vec4 edge_color;\n"
+	"uniform float edge_width;\n"
+	"varying vec3 barycentric;\n"
+	"void main()\n"
+	"{\n"
+	"	vec3 edge = smoothstep(vec3(0.0), fwidth(barycentric) * edge_width, barycentric);\n"
+	"	gl_FragColor = mix(edge_color, gl_Color, min(min(edge.x, edge.y), edge.z));\n"
+	"}\n";
+
+static GLuint CompileShader(GLenum type, const char *source)
+{
+	const GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	GLint status = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status != GL_TRUE)
+	{
+		char log[1024] = "";
+		glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+		printf("Blad kompilacji programu cieniujacego:\n%s\n", log);
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+bool WireframeInit()
+{
+	if (program != 0)
+		return true;
+	if (!shaders)
+		return false;
+
+	const GLuint vertex = CompileShader(GL_VERTEX_SHADER, vertex_shader);
+	const GLuint fragment = CompileShader(GL_FRAGMENT_SHADER, fragment_shader);
+	if (vertex == 0 || fragment == 0)
+	{
+		if (vertex != 0)
+			glDeleteShader(vertex);
+		if (fragment != 0)
+			glDeleteShader(fragment);
+		return false;
+	}
+
+	program = glCreateProgram();
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+
+	// shadery s usuwane razem z programem
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE)
+	{
+		char log[1024] = "";
+		glGetProgramInfoLog(program, sizeof(log), NULL, log);
+		printf("Blad konsolidacji programu cieniujacego:\n%s\n", log);
+		glDeleteProgram(program);
+		program = 0;
+		return false;
+	}
+	edge_color_location = glGetUniformLocation(program, "edge_color");
+	edge_width_location = glGetUniformLocation(program, "edge_width");
+	return true;
+}
+
+bool WireframeAvailable()
+{
+	return program != 0;
+}
+
+// krawd - wsprzdne obu kocw w ustalonej kolejnoci
+
+typedef std::array<GLfloat, 6> Edge;
+
+static int Index(const Mesh &mesh, int i)
+{
+	return mesh.indices16.empty() ? (int)mesh.indices32[i] : (int)mesh.indices16[i];
+}
+
+static Edge MakeEdge(const Mesh &mesh, int a, int b)
+{
+	const GLfloat *p = &mesh.vertices[MeshStride(mesh) * a];
+	const GLfloat *q = &mesh.vertices[MeshStride(mesh) * b];
+	if (std::lexicographical_compare(q, q + 3, p, p + 3))
+		std::swap(p, q);
+	const Edge edge = { p[0], p[1], p[2], q[0], q[1], q[2] };
+	return edge;
+}
+
+void WireframeSet(WireframeMesh &wireframe, const Mesh &mesh, int first, int count, int line_first, int line_count)
+{
+	std::set<Edge> lines;
+	for (int i = line_first; i + 1 < line_first + line_count; i += 2)
+		lines.insert(MakeEdge(mesh, Index(mesh, i), Index(mesh, i + 1)));
+
+	wireframe.vertex_count = count - count % 3;
+	wireframe.vertices.resize(6 * wireframe.vertex_count);
+	for (int t = 0; t < wireframe.vertex_count; t += 3)
+	{
+		const int v[3] = { Index(mesh, first + t), Index(mesh, first + t + 1), Index(mesh, first + t + 2) };
+
+		// krawd naprzeciw wierzchoka k czy dwa pozostae wierzchoki
+		bool hidden[3];
+		for (int k = 0; k < 3; k++)
+			hidden[k] = lines.find(MakeEdge(mesh, v[(k + 1) % 3], v[(k + 2) % 3])) == lines.end();
+
+		for (int j = 0; j < 3; j++)
+		{
+			GLfloat *out = &wireframe.vertices[6 * (t + j)];
+			const GLfloat *position = &mesh.vertices[MeshStride(mesh) * v[j]];
+			out[0] = position[0];
+			out[1] = position[1];
+			out[2] = position[2];
+			for (int k = 0; k < 3; k++)
+				out[3 + k] = (j == k || hidden[k]) ? 1.0f : 0.0f;
+		}
+	}
+	wireframe.uploaded = false;
+}
+
+void WireframeDraw(WireframeMesh &wireframe, const GLfloat *edge_color)
+{
+	if (program == 0 || wireframe.vertex_count == 0)
+		return;
+
+	const GLfloat *vertex_data = &wireframe.vertices[0];
+	if (buffer_objects)
+	{
+		// wysanie danych do bufora tylko po zmianie siatki
+		if (wireframe.vertex_buffer == 0)
+			glGenBuffers(1, &wireframe.vertex_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, wireframe.vertex_buffer);
+		if (!wireframe.uploaded)
+		{
+			glBufferData(GL_ARRAY_BUFFER, wireframe.vertices.size() * sizeof(GLfloat), vertex_data, GL_STATIC_DRAW);
+			wireframe.uploaded = true;
+		}
+		vertex_data = NULL;
+	}
+
+	glUseProgram(program);
+	glUniform4fv(edge_color_location, 1, edge_color);
+	// krawd wsplna dla dwch trjktw jest rysowana w obu, a krawd
+	// na obrysie bryy tylko w jednym - szeroko w kadym trjkcie to
+	// kompromis midzy jednymi a drugimi (ok. 1 - 1,5 piksela)
+	glUniform1f(edge_width_location, 0.75f);
+
+	const GLsizei stride = 6 * sizeof(GLfloat);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(3, GL_FLOAT, stride, vertex_data);
+	glTexCoordPointer(3, GL_FLOAT, stride, vertex_data + 3);
+	glDrawArrays(GL_TRIANGLES, 0, wireframe.vertex_count);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+	glUseProgram(0);
+	if (buffer_objects)
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void WireframeFree(WireframeMesh &wireframe)
+{
+	if (wireframe.vertex_buffer != 0)
+	{
+		glDeleteBuffers(1, &wireframe.vertex_buffer);
+		wireframe.vertex_buffer = 0;
+	}
+	wireframe.uploaded = false;
+}
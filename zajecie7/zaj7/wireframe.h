@@ -0,0 +1,51 @@
+#ifndef __WIREFRAME__H__
+#define __WIREFRAME__H__
+
+#include "mesh.h"
+
+// brya z zaznaczonymi krawdziami rysowana w jednym przebiegu: kady
+// trjkt ma wasne wierzchoki ze wsprzdnymi barycentrycznymi
+// (1, 0, 0), (0, 1, 0), (0, 0, 1), a program cieniujcy GLSL zamalowuje
+// kolorem krawdzi fragmenty, w ktrych najmniejsza wsprzdna jest
+// bliska zeru (w odlegoci ok. 1 piksela od krawdzi); krawdzie, ktrych
+// nie ma w wersji "szkieletowej" bryy (np. przektne czworoktw kuli),
+// maj wsprzdn przeciwlegego wierzchoka rwn 1 we wszystkich
+// wierzchokach trjkta, wic nie s rysowane;
+// zastpuje rysowanie bryy dwa razy (wypenienie z przesuniciem
+// wartoci gbi i krawdzie GL_LINES)
+
+struct WireframeMesh
+{
+	std::vector<GLfloat> vertices; // wierzchoki (x, y, z, b0, b1, b2)
+	int vertex_count = 0;
+	GLuint vertex_buffer = 0; // VBO
+	bool uploaded = false; // zawarto bufora zgodna z siatk
+};
+
+// kompilacja programu cieniujcego; zwraca false, gdy programy GLSL nie s
+// dostpne (wtedy bryy trzeba rysowa w dwch przebiegach);
+// wywoywana po ExtensionFunctionsSetup
+
+bool WireframeInit();
+
+// czy program cieniujcy jest gotowy do uycia
+
+bool WireframeAvailable();
+
+// utworzenie siatki z trjktw siatki mesh (count indeksw od indeksu
+// first) i krawdzi zapisanych jako GL_LINES (line_count indeksw od
+// indeksu line_first); krawdzie s porwnywane wedug pooenia
+// wierzchokw, wic mog nalee do innych trjktw tej samej siatki
+
+void WireframeSet(WireframeMesh &wireframe, const Mesh &mesh, int first, int count, int line_first, int line_count);
+
+// narysowanie bryy w kolorze biecym (glColor) z krawdziami w kolorze
+// edge_color
+
+void WireframeDraw(WireframeMesh &wireframe, const GLfloat *edge_color);
+
+// usunicie obiektu buforowego
+
+void WireframeFree(WireframeMesh &wireframe);
+
+#endif // __WIREFRAME__H__
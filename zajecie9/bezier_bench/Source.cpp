@@ -0,0 +1,512 @@
+// Porównanie wydajności trzech sposobów renderingu fragmentów Beziera:
+// listy wyświetlania budowane przez genBezier, ewaluatory OpenGL
+// (glMap2d/glMapGrid2d/glEvalMesh2) oraz teselacja na CPU z użyciem SIMD
+// zapisywana do obiektu buforowego wierzchołków.
+//
+// Uruchomienie: bezier_bench [liczba_ramek]
+// Dla każdej kombinacji divs i liczby fragmentów mierzony jest czas CPU
+// (wysłanie poleceń), czas GPU (zapytania GL_TIME_ELAPSED) oraz liczba
+// trójkątów na sekundę, osobno dla siatki statycznej i animowanej
+// (punkty kontrolne zmieniane w każdej ramce).
+
+#define _CRT_SECURE_NO_WARNINGS
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <chrono>
+#include <GL/glu.h>
+#include <GL/glut.h>
+#include "extensions.h"
+#include "bezier.h"
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BENCH_SSE
+#endif
+
+// rodzaje renderingu
+enum
+{
+	PATH_DISPLAY_LIST,  // genBezier + glCallList
+	PATH_EVALUATOR,     // glMap2d + glEvalMesh2
+	PATH_SIMD_VBO,      // teselacja SIMD + glDrawElements
+	PATH_COUNT
+};
+
+const char *path_names[PATH_COUNT] = { "genBezier", "glEvalMesh2", "SIMD+VBO" };
+
+// badane wartości parametrów
+
+const int divs_values[] = { 4, 8, 16, 32, 64 };
+const int patch_values[] = { 1, 16, 64, 256 };
+
+// liczba ramek pomiarowych i ramek "rozgrzewających"
+
+int frames = 30;
+const int warmup_frames = 3;
+
+// rozmiary okna
+
+const int window_size = 512;
+
+// fragmenty Beziera bieżącego pomiaru
+
+std::vector<BEZIER_PATCH> patches;
+int patch_count = 0;
+int grid_side = 1;
+int divs = 4;
+
+// teselacja CPU: wierzchołki (x, y, z, s, t) i indeksy trójkątów
+
+std::vector<GLfloat> simd_vertices;
+std::vector<GLuint> simd_indices;
+
+// tablice wielomianów bazowych dla bieżącej wartości divs
+
+std::vector<GLfloat> basis[4];
+
+// obiekty buforowe teselacji CPU
+
+GLuint vertex_buffer = 0, index_buffer = 0;
+
+// zapytania o czas GPU
+
+std::vector<GLuint> queries;
+
+// ułożenie fragmentów w kwadratowej siatce; punkty kontrolne z "falą"
+// zależną od numeru ramki; kolumna 7 siatki 4x8 jest kopią kolumny 3,
+// dzięki czemu genBezier, ewaluatory i teselacja CPU dają tę samą powierzchnię
+
+void AnimatePatches(int frame)
+{
+	for (int p = 0; p < patch_count; p++)
+	{
+		const double ox = 4.0 * (p % grid_side);
+		const double oy = 4.0 * (p / grid_side);
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				const double z = 0.5 * sin(0.1 * frame + 0.7 * i + 1.3 * j + 0.37 * p);
+				patches[p].anchors[i][j] = makePoint(ox + i - 1.5, oy + j - 1.5, z);
+			}
+			for (int j = 4; j < 8; j++)
+				patches[p].anchors[i][j] = patches[p].anchors[i][3];
+		}
+	}
+}
+
+// wielomiany bazowe w tej samej (odwróconej) kolejności co w Bernstein()
+
+void BuildBasis()
+{
+	// długość tablic zaokrąglona do wielokrotności 4 (ładowanie po 4 wartości)
+	const int size = (divs + 1 + 3) & ~3;
+	for (int i = 0; i < 4; i++)
+		basis[i].assign(size, 0.0f);
+	for (int k = 0; k <= divs; k++)
+	{
+		const float u = (float)k / divs;
+		basis[0][k] = u * u * u;
+		basis[1][k] = 3 * u * u * (1 - u);
+		basis[2][k] = 3 * u * (1 - u) * (1 - u);
+		basis[3][k] = (1 - u) * (1 - u) * (1 - u);
+	}
+}
+
+// teselacja wszystkich fragmentów do tablicy simd_vertices;
+// S(s,t) = suma_k b_k(t) suma_j b_j(s) P[k][j], jak w genBezier
+
+void TessellateSimd()
+{
+	const int row = divs + 1;
+	const int size = (int)basis[0].size();
+	std::vector<GLfloat> x(size), y(size), z(size);
+	GLfloat *out = &simd_vertices[0];
+
+	for (int p = 0; p < patch_count; p++)
+	{
+		for (int u = 0; u <= divs; u++)
+		{
+			// krzywe wierszy siatki dla parametru s = u / divs
+			GLfloat r[4][3];
+			for (int k = 0; k < 4; k++)
+			{
+				r[k][0] = r[k][1] = r[k][2] = 0.0f;
+				for (int j = 0; j < 4; j++)
+				{
+					const POINT_3D &a = patches[p].anchors[k][j];
+					r[k][0] += basis[j][u] * (GLfloat)a.x;
+					r[k][1] += basis[j][u] * (GLfloat)a.y;
+					r[k][2] += basis[j][u] * (GLfloat)a.z;
+				}
+			}
+
+			// cztery wierzchołki wzdłuż t jednocześnie
+#ifdef BENCH_SSE
+			for (int v = 0; v < size; v += 4)
+			{
+				__m128 vx = _mm_setzero_ps(), vy = _mm_setzero_ps(), vz = _mm_setzero_ps();
+				for (int k = 0; k < 4; k++)
+				{
+					const __m128 b = _mm_loadu_ps(&basis[k][v]);
+					vx = _mm_add_ps(vx, _mm_mul_ps(b, _mm_set1_ps(r[k][0])));
+					vy = _mm_add_ps(vy, _mm_mul_ps(b, _mm_set1_ps(r[k][1])));
+					vz = _mm_add_ps(vz, _mm_mul_ps(b, _mm_set1_ps(r[k][2])));
+				}
+				_mm_storeu_ps(&x[v], vx);
+				_mm_storeu_ps(&y[v], vy);
+				_mm_storeu_ps(&z[v], vz);
+			}
+#else
+			for (int v = 0; v < size; v++)
+			{
+				x[v] = y[v] = z[v] = 0.0f;
+				for (int k = 0; k < 4; k++)
+				{
+					x[v] += basis[k][v] * r[k][0];
+					y[v] += basis[k][v] * r[k][1];
+					z[v] += basis[k][v] * r[k][2];
+				}
+			}
+#endif
+			for (int v = 0; v < row; v++)
+			{
+				*out++ = x[v];
+				*out++ = y[v];
+				*out++ = z[v];
+				*out++ = (GLfloat)u / divs;
+				*out++ = (GLfloat)v / divs;
+			}
+		}
+	}
+}
+
+// indeksy trójkątów dla wszystkich fragmentów (niezmienne dla danego divs)
+
+void BuildIndices()
+{
+	const int row = divs + 1;
+	simd_indices.clear();
+	simd_indices.reserve(6 * divs * divs * patch_count);
+	for (int p = 0; p < patch_count; p++)
+	{
+		const GLuint base = p * row * row;
+		for (int u = 0; u < divs; u++)
+			for (int v = 0; v < divs; v++)
+			{
+				const GLuint a = base + u * row + v;
+				const GLuint b = a + row;
+				simd_indices.push_back(a);
+				simd_indices.push_back(b);
+				simd_indices.push_back(a + 1);
+				simd_indices.push_back(a + 1);
+				simd_indices.push_back(b);
+				simd_indices.push_back(b + 1);
+			}
+	}
+}
+
+// przesłanie wyniku teselacji do obiektu buforowego
+
+void UploadSimd(bool first)
+{
+	if (!buffer_objects)
+		return;
+	glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+	if (first)
+		glBufferData(GL_ARRAY_BUFFER, simd_vertices.size() * sizeof(GLfloat), &simd_vertices[0], GL_STREAM_DRAW);
+	else
+		glBufferSubData(GL_ARRAY_BUFFER, 0, simd_vertices.size() * sizeof(GLfloat), &simd_vertices[0]);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if (first)
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, simd_indices.size() * sizeof(GLuint), &simd_indices[0], GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+}
+
+// rysowanie wyniku teselacji CPU jednym wywołaniem glDrawElements
+
+void DrawSimd()
+{
+	const GLsizei stride = 5 * sizeof(GLfloat);
+	const GLfloat *base = NULL;
+	if (buffer_objects)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+	}
+	else
+		base = &simd_vertices[0];
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(3, GL_FLOAT, stride, base);
+	glTexCoordPointer(2, GL_FLOAT, stride, base + 3);
+	glDrawElements(GL_TRIANGLES, (GLsizei)simd_indices.size(), GL_UNSIGNED_INT,
+		buffer_objects ? NULL : &simd_indices[0]);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	if (buffer_objects)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+}
+
+// rysowanie fragmentów przy pomocy ewaluatorów; baza Bernsteina w OpenGL
+// ma odwrotną kolejność niż Bernstein(), stąd E[a][b] = P[3-b][3-a]
+
+void DrawEvaluators()
+{
+	static const GLdouble tex[2][2][2] = { { { 0, 0 },{ 0, 1 } },{ { 1, 0 },{ 1, 1 } } };
+	GLdouble net[4][4][3];
+
+	glMap2d(GL_MAP2_TEXTURE_COORD_2, 0, 1, 4, 2, 0, 1, 2, 2, &tex[0][0][0]);
+	glMapGrid2d(divs, 0.0, 1.0, divs, 0.0, 1.0);
+	for (int p = 0; p < patch_count; p++)
+	{
+		for (int a = 0; a < 4; a++)
+			for (int b = 0; b < 4; b++)
+			{
+				const POINT_3D &c = patches[p].anchors[3 - b][3 - a];
+				net[a][b][0] = c.x;
+				net[a][b][1] = c.y;
+				net[a][b][2] = c.z;
+			}
+		glMap2d(GL_MAP2_VERTEX_3, 0, 1, 12, 4, 0, 1, 3, 4, &net[0][0][0]);
+		glEvalMesh2(GL_FILL, 0, divs, 0, divs);
+	}
+}
+
+// rysowanie fragmentów z list wyświetlania
+
+void DrawLists()
+{
+	for (int p = 0; p < patch_count; p++)
+		glCallList(patches[p].dlBPatch);
+}
+
+// (ponowne) utworzenie list wyświetlania wszystkich fragmentów
+
+void BuildLists()
+{
+	for (int p = 0; p < patch_count; p++)
+	{
+		GLuint list = genBezier(patches[p], divs);
+		if (patches[p].dlBPatch != 0)
+			glDeleteLists(patches[p].dlBPatch, 1);
+		patches[p].dlBPatch = list;
+	}
+}
+
+// jedna ramka wybraną ścieżką; przy animacji punkty kontrolne są
+// zmieniane, a dane pochodne (listy, bufory) budowane od nowa
+
+void RenderFrame(int path, bool animated, int frame)
+{
+	if (animated)
+		AnimatePatches(frame);
+
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	switch (path)
+	{
+	case PATH_DISPLAY_LIST:
+		if (animated)
+			BuildLists();
+		DrawLists();
+		break;
+
+	case PATH_EVALUATOR:
+		DrawEvaluators();
+		break;
+
+	case PATH_SIMD_VBO:
+		if (animated)
+		{
+			TessellateSimd();
+			UploadSimd(false);
+		}
+		DrawSimd();
+		break;
+	}
+}
+
+// usunięcie list wyświetlania bieżących fragmentów
+
+void FreePatches()
+{
+	for (int p = 0; p < patch_count; p++)
+		if (patches[p].dlBPatch != 0)
+			glDeleteLists(patches[p].dlBPatch, 1);
+	patches.clear();
+	patch_count = 0;
+}
+
+// przygotowanie danych dla pary (divs, liczba fragmentów)
+
+void SetupPatches(int new_divs, int count)
+{
+	FreePatches();
+
+	divs = new_divs;
+	patch_count = count;
+	grid_side = (int)ceil(sqrt((double)count));
+	patches.assign(count, BEZIER_PATCH());
+	for (int p = 0; p < count; p++)
+	{
+		patches[p].dlBPatch = 0;
+		patches[p].texture = 0;
+	}
+	AnimatePatches(0);
+
+	BuildBasis();
+	BuildIndices();
+	simd_vertices.assign(5 * (divs + 1) * (divs + 1) * count, 0.0f);
+	TessellateSimd();
+	UploadSimd(true);
+	BuildLists();
+
+	// rzut prostokątny obejmujący całą siatkę fragmentów
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	glOrtho(-2.0, 4.0 * grid_side - 2.0, -2.0, 4.0 * grid_side - 2.0, -2.0, 2.0);
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+}
+
+// pomiar jednej ścieżki; wyniki w milisekundach na ramkę
+
+void Measure(int path, bool animated, double &cpu_ms, double &gpu_ms, double &wall_ms)
+{
+	for (int f = 0; f < warmup_frames; f++)
+		RenderFrame(path, animated, f);
+	glFinish();
+
+	double cpu = 0.0;
+	const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (int f = 0; f < frames; f++)
+	{
+		const std::chrono::high_resolution_clock::time_point frame_start = std::chrono::high_resolution_clock::now();
+		if (timer_query)
+			glBeginQuery(GL_TIME_ELAPSED, queries[f]);
+		RenderFrame(path, animated, warmup_frames + f);
+		if (timer_query)
+			glEndQuery(GL_TIME_ELAPSED);
+		cpu += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - frame_start).count();
+		glutSwapBuffers();
+	}
+	glFinish();
+	wall_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / frames;
+	cpu_ms = cpu / frames;
+
+	// odczyt zapytań dopiero po zakończeniu wszystkich ramek
+	gpu_ms = -1.0;
+	if (timer_query)
+	{
+		GLuint64 total = 0;
+		for (int f = 0; f < frames; f++)
+		{
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(queries[f], GL_QUERY_RESULT, &elapsed);
+			total += elapsed;
+		}
+		gpu_ms = total / 1.0e6 / frames;
+	}
+}
+
+// przebieg wszystkich pomiarów i wydruk tabeli wyników
+
+void RunBenchmark()
+{
+	ExtensionFunctionsSetup();
+	if (buffer_objects)
+	{
+		glGenBuffers(1, &vertex_buffer);
+		glGenBuffers(1, &index_buffer);
+	}
+	if (timer_query)
+	{
+		queries.resize(frames);
+		glGenQueries(frames, &queries[0]);
+	}
+
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_MAP2_VERTEX_3);
+	glEnable(GL_MAP2_TEXTURE_COORD_2);
+	glColor3f(0.0f, 0.4f, 0.8f);
+
+	printf("Renderer: %s\n", (const char*)glGetString(GL_RENDERER));
+	printf("Obiekty buforowe: %s, zapytania GL_TIME_ELAPSED: %s, ramek: %d\n\n",
+		buffer_objects ? "tak" : "nie", timer_query ? "tak" : "nie", frames);
+	printf("%-12s %-9s %5s %6s %12s %12s %12s %10s\n",
+		"sciezka", "siatka", "divs", "platy", "trojkaty", "CPU ms/kl", "GPU ms/kl", "Mtri/s");
+
+	for (int d = 0; d < (int)(sizeof(divs_values) / sizeof(divs_values[0])); d++)
+		for (int c = 0; c < (int)(sizeof(patch_values) / sizeof(patch_values[0])); c++)
+		{
+			SetupPatches(divs_values[d], patch_values[c]);
+			const double triangles = 2.0 * divs * divs * patch_count;
+			for (int animated = 0; animated < 2; animated++)
+				for (int path = 0; path < PATH_COUNT; path++)
+				{
+					double cpu_ms, gpu_ms, wall_ms;
+					Measure(path, animated != 0, cpu_ms, gpu_ms, wall_ms);
+					char gpu[32];
+					if (gpu_ms < 0.0)
+						sprintf(gpu, "n/d");
+					else
+						sprintf(gpu, "%.3f", gpu_ms);
+					printf("%-12s %-9s %5d %6d %12.0f %12.3f %12s %10.2f\n",
+						path_names[path], animated ? "animowana" : "statyczna", divs, patch_count,
+						triangles, cpu_ms, gpu, triangles / (wall_ms * 1.0e3));
+				}
+			fflush(stdout);
+		}
+
+	FreePatches();
+	if (buffer_objects)
+	{
+		glDeleteBuffers(1, &vertex_buffer);
+		glDeleteBuffers(1, &index_buffer);
+	}
+	if (timer_query)
+		glDeleteQueries(frames, &queries[0]);
+}
+
+// pomiary są wykonywane przy pierwszym rysowaniu okna
+
+void Display()
+{
+	RunBenchmark();
+	exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1 && atoi(argv[1]) > 0)
+		frames = atoi(argv[1]);
+
+	// inicjalizacja biblioteki GLUT
+	glutInit(&argc, argv);
+
+	// inicjalizacja bufora ramki
+	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
+
+	// rozmiary głównego okna programu
+	glutInitWindowSize(window_size, window_size);
+
+	// utworzenie głównego okna programu
+	glutCreateWindow("Bezier - test wydajnosci");
+
+	// dołączenie funkcji generującej scenę 3D
+	glutDisplayFunc(Display);
+
+	// wprowadzenie programu do obsługi pętli komunikatów
+	glutMainLoop();
+	return 0;
+}
@@ -0,0 +1,46 @@
+/*
+* (c) Copyright 2016, Vasyl Martsenyuk
+* Email: marceniuk@yahoo.com
+*/
+
+#ifndef __BEZIER__H__
+#define __BEZIER__H__
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+
+typedef struct point_3d { // struktura dla punktu 3D
+	double x, y, z;
+} POINT_3D;
+typedef struct bpatch { // struktura dla wielomiana fragmentu Beziera 3 stopnia
+	POINT_3D anchors[4][8]; // siatka 4x8 wedle zadania
+	GLuint dlBPatch; // lista dla fragmentu Beziera
+	GLuint texture; // tekstura dla fragmentu
+} BEZIER_PATCH;
+
+// addition of 2 points
+POINT_3D pointAdd(POINT_3D p, POINT_3D q);
+
+// multiplication of point by constant
+POINT_3D pointTimes(double c, POINT_3D p);
+
+// making new point
+POINT_3D makePoint(double a, double b, double c);
+
+// calculate polynomial of 3rd order based on array of 4 points
+// and variable u changed from 0 to 1
+POINT_3D Bernstein(float u, POINT_3D *p);
+
+// generates all slices of triangles of the patch and stores them in display list
+// patch - fragment Beziera
+// divs - liczba podziałów w każdym kierunku (2 * divs * divs trójkątów)
+GLuint genBezier(BEZIER_PATCH patch, int divs);
+
+// punkty powierzchni fragmentu w węzłach regularnej siatki size x size;
+// out[row * size + col] - wiersz odpowiada parametrowi py, a kolumna
+// parametrowi px z genBezier (row / (size - 1), col / (size - 1))
+void gridBezier(const BEZIER_PATCH &patch, int size, POINT_3D *out);
+
+#endif // __BEZIER__H__
@@ -9,7 +9,9 @@
 */
 
 #define _CRT_SECURE_NO_WARNINGS
+#ifdef _WIN32
 #include <windows.h> // plik nagłówkowy dla Windows
+#endif
 #include <math.h> // plik nagłówkowy dla biblioteki matematycznej
 #include <iostream>
 #include <stdio.h> // plik nagłówkowy dla we/wy standardowego
@@ -18,6 +20,13 @@
 #include "glext.h"
 #include <GL/glut.h> // plik nagłówkowy dla biblioteki Glut
 #include "targa.h"
+#include "bezier.h"
+#include "water.h"
+#include "redraw.h"
+#include "extensions.h"
+#include "profiler.h"
+#include "headless.h"
+#include <vector>
 #define _USE_MATH_DEFINES
 using namespace std;
 enum
@@ -48,14 +57,7 @@ int button_state = GLUT_UP;
 int button_x, button_y;
 // współczynnik skalowania
 GLfloat scale = 3.5;
-typedef struct point_3d { // struktura dla punktu 3D
-	double x, y, z;
-} POINT_3D;
-typedef struct bpatch { // struktura dla wielomiana fragmentu Beziera 3 stopnia
-	POINT_3D anchors[4][8]; // siatka 4x8 wedle zadania
-	GLuint dlBPatch; // lista dla fragmentu Beziera
-	GLuint texture; // tekstura dla fragmentu
-} BEZIER_PATCH;
+#ifdef _WIN32
 HDC hDC = NULL; // kontekst urządzenia
 HGLRC hRC = NULL; // kontekst renderingu
 HWND hWnd = NULL; // deskryptor okna
@@ -64,116 +66,87 @@ bool keys[256]; // tablica jednowymiarowa dla klawiatury
 bool active = TRUE; // flag of application activity
 bool fullscreen = TRUE; // flag of full-screen mode
 DEVMODE DMsaved; // zachować ustawienia przeszłego trybu
+#endif
 GLfloat rotz = 0.0f; // obroty współrzędnej Z
 BEZIER_PATCH mybezier; // fragment Beziera dla wykorzystania
-bool showCPoints = TRUE; // switcher of anchor points of net
+bool showCPoints = true; // switcher of anchor points of net
 int divs = 7; // number of interpolation (distribution of polygon)
+WATER_GRID water; // symulacja powierzchni morza
+int water_size = 512; // liczba węzłów siatki wody w każdym kierunku (argument programu)
+std::vector<POINT_3D> sea_base; // punkty fragmentu Beziera w węzłach siatki wody
+std::vector<GLfloat> sea_vertices; // wierzchołki morza w formacie GL_T2F_N3F_V3F
+std::vector<GLuint> sea_indices; // indeksy trójkątów siatki morza
+GLfloat sea_axis[2][3]; // kierunki kolumn i wierszy siatki na powierzchni fragmentu
+const GLfloat flow_texture = 0.01f; // przesunięcie tekstury na jednostkę prędkości przepływu
+int fps_cap = 60; // największa liczba ramek na sekundę (argument programu, 0 - bez ograniczenia)
+#ifdef _WIN32
 LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM); // deklaracja dla WndProc
-													  //functions for vector operations. It can be used any C++ class for 3D point
-													  // addition of 2 points
-POINT_3D pointAdd(POINT_3D p, POINT_3D q) {
-	p.x += q.x; p.y += q.y; p.z += q.z;
-	return p;
-}
-// multiplication of point by constant
-POINT_3D pointTimes(double c, POINT_3D p) {
-	p.x *= c; p.y *= c; p.z *= c;
-	return p;
-}
-// making new point
-POINT_3D makePoint(double a, double b, double c) {
-	POINT_3D p;
-	p.x = a; p.y = b;	p.z = c;
-
-	return p;
-}
-//function for calculation of 3rd order polynomial (each counterpart in Bezie curve equation
-//is one of so called
-// Bernstane polynomials); it necessary to transfer variable u and array containing 4 points p
-// and to calculate point on curve. Changing u with the same increments between 0 and 1 we get
-// good curve approximation
-// calculate polynomial of 3rd order based on array of 4 points
-// and variable u changed from 0 to 1
-POINT_3D Bernstein(float u, POINT_3D *p) {
-	POINT_3D a, b, c, d, r;
-	a = pointTimes(pow(u, 3), p[0]);
-	b = pointTimes(3 * pow(u, 2)*(1 - u), p[1]);
-	c = pointTimes(3 * u*pow((1 - u), 2), p[2]);
-	d = pointTimes(pow((1 - u), 3), p[3]);
-	r = pointAdd(pointAdd(a, b), pointAdd(c, d));
-
-	return r;
-}
-//this function generates all slices of triangles and stores them in display list.
-// we do it in order not to recalculate fragment during each frame.
-// Meanwhile we can use morphing of anchor points. We will get intereting effect of smoothed
-//low-cost morphing.
-//// (we only do morphing of 16 points but we should recalculate them). Array "last" is used to
-//store previous line
-//// of points (since for triangular slices both raws are needed).
-//// Also coordinates of texture are calculated with help of values of u and v in form of
-//procents(flat covering).
-// We don't do calculation of normals for lighting.
-// For this purpose we need 2 parameters.
-// The first paramater is the center of each triangle
-// and then to use bitwise calculus and calculation of tan of both axes x and y,
-// then to calculate vector product in order to get perpendicular for both axes and then
-// to normalize vector and to use it as normal.
-GLuint genBezier(BEZIER_PATCH patch, int divs) {
-	int u = 0, v;
-	float py, px, pyold;
-	GLuint drawlist = glGenLists(1);
-	POINT_3D temp[8];
-	POINT_3D *last = (POINT_3D*)malloc(sizeof(POINT_3D)*(divs + 1));
-	if (patch.dlBPatch != NULL)
-		glDeleteLists(patch.dlBPatch, 1);
-	temp[0] = patch.anchors[0][7];
-	temp[1] = patch.anchors[1][7];
-	temp[2] = patch.anchors[2][7];
-	temp[3] = patch.anchors[3][7];
-	for (v = 0; v <= divs; v++) {
-		px = ((float)v) / ((float)divs);
-		last[v] = Bernstein(px, temp);
-	}
-	glNewList(drawlist, GL_COMPILE);
-	glBindTexture(GL_TEXTURE_2D, patch.texture);
-	for (u = 1; u <= divs; u++) {
-		py = ((float)u) / ((float)divs);
-		pyold = ((float)u - 1.0f) / ((float)divs);
-		temp[0] = Bernstein(py, patch.anchors[0]);
-		temp[1] = Bernstein(py, patch.anchors[1]);
-		temp[2] = Bernstein(py, patch.anchors[2]);
-		temp[3] = Bernstein(py, patch.anchors[3]);
-		temp[4] = Bernstein(py, patch.anchors[4]);
-		temp[5] = Bernstein(py, patch.anchors[5]);
-		temp[6] = Bernstein(py, patch.anchors[6]);
-		temp[7] = Bernstein(py, patch.anchors[7]);
-
-		glBegin(GL_TRIANGLE_STRIP);
-		for (v = 0; v <= divs; v++) {
-			px = ((float)v) / ((float)divs);
-			glTexCoord2f(pyold, px);
-			glVertex3d(last[v].x, last[v].y, last[v].z);
-			last[v] = Bernstein(px, temp);
-			glTexCoord2f(py, px);
-			glVertex3d(last[v].x, last[v].y, last[v].z);
-		}
-		glEnd();
-	}
-	glEndList();
-	free(last);
-	return drawlist;
-}
+#endif
 void initBezier(void) {
 	for (int i = 0; i < 4; i++)
-		for (int p = 0; p < 9; p++) {
+		for (int p = 0; p < 8; p++) {
+			// falowanie powierzchni liczy symulacja wody (water.cpp),
+			// siatka punktów kontrolnych pozostaje płaska
 			mybezier.anchors[i][p] = makePoint(i - 1.5, p - 1.5, .1);
-			//mybezier.anchors[i][p].x = mybezier.anchors[i][p].x*sin(5 * t);
-			//mybezier.anchors[i][p].y = mybezier.anchors[i][p].y*sin(5 * t);
-			mybezier.anchors[i][p].z = mybezier.anchors[i][p].z*sin(1 * t++);
 		}
 	mybezier.dlBPatch = NULL;
 }
+// siatka morza: punkty fragmentu Beziera w węzłach siatki wody,
+// indeksy trójkątów oraz symulacja wody o rozmiarze fragmentu
+void initSea(void) {
+	const int n = water_size;
+	sea_base.resize(n * n);
+	gridBezier(mybezier, n, &sea_base[0]);
+	// kierunki kolumn i wierszy siatki (fragment jest płaski)
+	const POINT_3D *axis_end[2] = { &sea_base[n - 1], &sea_base[(n - 1) * n] };
+	GLfloat extent = 0.0f;
+	for (int a = 0; a < 2; a++) {
+		POINT_3D d = pointAdd(*axis_end[a], pointTimes(-1.0, sea_base[0]));
+		GLfloat length = (GLfloat)sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+		sea_axis[a][0] = (GLfloat)d.x / length;
+		sea_axis[a][1] = (GLfloat)d.y / length;
+		sea_axis[a][2] = (GLfloat)d.z / length;
+		extent = length;
+	}
+	sea_vertices.resize(8 * n * n);
+	sea_indices.clear();
+	sea_indices.reserve(6 * (n - 1) * (n - 1));
+	for (int row = 0; row < n - 1; row++)
+		for (int col = 0; col < n - 1; col++) {
+			GLuint i = row * n + col;
+			sea_indices.push_back(i);
+			sea_indices.push_back(i + n);
+			sea_indices.push_back(i + 1);
+			sea_indices.push_back(i + 1);
+			sea_indices.push_back(i + n);
+			sea_indices.push_back(i + n + 1);
+		}
+	waterFree(water);
+	waterInit(water, n, extent, 0);
+}
+// teselacja morza bezpośrednio z wyników symulacji: wysokość wzdłuż osi Z,
+// normalne przeniesione z układu siatki na powierzchnię fragmentu,
+// współrzędne tekstury przesunięte przez prąd i lokalny przepływ
+void updateSea(void) {
+	const int n = water_size;
+	const GLfloat *h = &water.height[0];
+	const GLfloat *normal = &water.normal[0];
+	const GLfloat *flow = &water.flow[0];
+	GLfloat *v = &sea_vertices[0];
+	for (int row = 0; row < n; row++)
+		for (int col = 0; col < n; col++, v += 8) {
+			const int i = row * n + col;
+			const GLfloat nx = normal[3 * i], ny = normal[3 * i + 1], nz = normal[3 * i + 2];
+			v[0] = (GLfloat)row / (n - 1) + water.scroll[1] + flow_texture * flow[2 * i + 1];
+			v[1] = (GLfloat)col / (n - 1) + water.scroll[0] + flow_texture * flow[2 * i];
+			v[2] = nx * sea_axis[0][0] + ny * sea_axis[1][0];
+			v[3] = nx * sea_axis[0][1] + ny * sea_axis[1][1];
+			v[4] = nx * sea_axis[0][2] + ny * sea_axis[1][2] + nz;
+			v[5] = (GLfloat)sea_base[i].x;
+			v[6] = (GLfloat)sea_base[i].y;
+			v[7] = (GLfloat)sea_base[i].z + h[i];
+		}
+}
 int InitGL(GLvoid)
 {
 	glEnable(GL_TEXTURE_2D);
@@ -184,6 +157,12 @@ int InitGL(GLvoid)
 	glDepthFunc(GL_LEQUAL);
 	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 	initBezier();
+	initSea();
+	updateSea();
+	// oświetlenie powierzchni morza (normalne z symulacji)
+	GLfloat light_position[4] = { 0.3f, -0.5f, 1.0f, 0.0f };
+	glLightfv(GL_LIGHT0, GL_POSITION, light_position);
+	glEnable(GL_LIGHT0);
 	// wczytanie tekstury Venus utworzonej ze zdjęć sondy Magellan
 	// plik: http://maps.jpl.nasa.gov/pix/ven0aaa2.tif
 	GLsizei width_texture, height_texture; // zmienne użyte przy obsłudze plików TARGA
@@ -198,17 +177,14 @@ int InitGL(GLvoid)
 		exit(0);
 	}
 	// dowiązanie stanu tekstury
-	glBindTexture(GL_TEXTURE_2D, (GLuint)Ptr_mybezier_texture);
+	glGenTextures(1, &mybezier.texture);
+	glBindTexture(GL_TEXTURE_2D, mybezier.texture);
 	// utworzenie tekstury wraz z mipmapami
 	gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGB, width_texture, height_texture, format, type,
 		Ptr_mybezier_texture);
-	///////////////////
-	mybezier.texture = (GLuint)Ptr_mybezier_texture;
-	///////////////////
-	mybezier.dlBPatch = genBezier(mybezier, 5);
 	// porządki
 	delete[](GLvoid*)Ptr_mybezier_texture;
-	return TRUE;
+	return true;
 }
 void DrawGLScene(GLvoid) {
 
@@ -225,9 +201,18 @@ void DrawGLScene(GLvoid) {
 	glRotatef(rotatez, 0.0, 0.0, 1.0);
 	// skalowanie obiektu - klawisze "+" i "-"
 	glScalef(scale, scale, scale);
-	glCallList(mybezier.dlBPatch);
-	BOOL showCPoint = TRUE;
-	cout << sin(8 * (t)) << endl;
+	// morze teselowane z symulacji wody
+	glEnable(GL_LIGHTING);
+	glBindTexture(GL_TEXTURE_2D, mybezier.texture);
+	glInterleavedArrays(GL_T2F_N3F_V3F, 0, &sea_vertices[0]);
+	glDrawElements(GL_TRIANGLES, (GLsizei)sea_indices.size(), GL_UNSIGNED_INT, &sea_indices[0]);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisable(GL_LIGHTING);
+	ProfilerTextureBind();
+	ProfilerDraw((int)sea_indices.size());
+	ProfilerStateChanges(2);
 	if (showCPoints)
 	{
 		glDisable(GL_TEXTURE_2D);
@@ -239,21 +224,25 @@ void DrawGLScene(GLvoid) {
 			for (j = 0; j < 8; j++)
 				glVertex3d(mybezier.anchors[i][j].x, mybezier.anchors[i][j].y, mybezier.anchors[i][j].z);
 			glEnd();
+			ProfilerDraw(8);
 		}
-		for (i = 0; i < 4; i++) {
+		for (i = 0; i < 8; i++) {
 			glBegin(GL_LINE_STRIP);
-			for (j = 0; j < 8; j++)
+			for (j = 0; j < 4; j++)
 				glVertex3d(mybezier.anchors[j][i].x, mybezier.anchors[j][i].y, mybezier.anchors[j][i].z);
 			glEnd();
+			ProfilerDraw(4);
 		}
 		glColor3f(1.0f, 1.0f, 1.0f);
 		glEnable(GL_TEXTURE_2D);
+		ProfilerStateChanges(2);
 	}
-	// wyświetlenie sceny
-	glutPostRedisplay();
+	// wykres czasów ramek (bez okna pomijany - zapisywane ramki nie zależą od pomiarów)
+	if (!Headless())
+		ProfilerOverlay(WindowWidth(), WindowHeight());
 	//return TRUE;
 	glFlush();
-	glutSwapBuffers();
+	WindowSwapBuffers();
 }
 void resize(int width, int height)
 {
@@ -263,7 +252,7 @@ void resize(int width, int height)
 	glFrustum(-5, 5, -5, 5, 2, 12);
 	gluLookAt(0, 0, 5, 0, 0, 0, 0, 1, 0);
 	glMatrixMode(GL_MODELVIEW);
-	DrawGLScene();
+	RedrawRequest();
 }
 // obsługa przycisków myszki
 void MouseButton(int button, int state, int x, int y)
@@ -289,7 +278,7 @@ void MouseMotion(int x, int y)
 		button_x = x;
 		rotatex -= 30 * (top - bottom) / glutGet(GLUT_WINDOW_HEIGHT) * (button_y - y);
 		button_y = y;
-		glutPostRedisplay();
+		RedrawRequest();
 	}
 }
 void Keyboard(unsigned char key, int x, int y)
@@ -302,28 +291,63 @@ void Keyboard(unsigned char key, int x, int y)
 		if (key == '-' && scale > 0.05)
 			scale -= 0.05;
 	// narysowanie sceny
-	DrawGLScene();
+	RedrawRequest();
 }
-void TimerFunction(int value) {
+// krok animacji przed każdą ramką - symulacja o czas, który upłynął
+// od poprzedniej ramki
+void Animate(float dt) {
 	t += 0.001;
-	InitGL();
-	glutDisplayFunc(DrawGLScene);
-	glutTimerFunc(100, TimerFunction, 1);
+	if (dt > 0.1f)
+		dt = 0.1f;
+	// losowe krople deszczu
+	if (rand() % 4 == 0)
+		waterDrop(water, (float)rand() / RAND_MAX, (float)rand() / RAND_MAX, 0.02f, 0.05f);
+	waterStep(water, dt);
+	updateSea();
+}
+// scenariusz kamery w trybie bez okna - obrót wokół osi Z i krok symulacji
+// morza o stały czas (jednej ramki przy 60 ramkach na sekundę)
+void HeadlessScript(int frame, int frames) {
+	rotatez = 360.0f * frame / frames;
+	Animate(1.0f / 60.0f);
 }
 int main(int argc, char *argv[])
 {
+	// tryb bez okna (opcja --headless) - kontekst w buforze pozaekranowym
+	const bool headless = HeadlessInit(argc, argv, 500, 500);
 	// inicjalizacja biblioteki GLUT
-	glutInit(&argc, argv);
-	// inicjalizacja bufora ramki
-	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
-	glutInitWindowPosition(50, 10);
-	// rozmiary głównego okna programu
-	glutInitWindowSize(500, 500);
-	// utworzenie głównego okna programu
-	glutCreateWindow("Krzywa Beziera");
-	// dołączenie funkcji generującej scenę 3D
-	glutDisplayFunc(DrawGLScene);
-	glutTimerFunc(10, TimerFunction, 1);
+	if (!headless)
+		glutInit(&argc, argv);
+	// rozmiar siatki symulacji wody
+	if (argc > 1 && atoi(argv[1]) >= 3)
+		water_size = atoi(argv[1]);
+	// ograniczenie liczby ramek na sekundę
+	if (argc > 2 && atoi(argv[2]) >= 0)
+		fps_cap = atoi(argv[2]);
+	if (!headless)
+	{
+		// inicjalizacja bufora ramki
+		glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
+		glutInitWindowPosition(50, 10);
+		// rozmiary głównego okna programu
+		glutInitWindowSize(500, 500);
+		// utworzenie głównego okna programu
+		glutCreateWindow("Krzywa Beziera");
+	}
+	InitGL();
+	// pomiar czasów ramek (zapytania o czas GPU), dane ramek w zaj9_profile.csv
+	ExtensionFunctionsSetup();
+	ProfilerInit("zaj9_profile.csv");
+	// bez okna - narysowanie ramek według scenariusza kamery
+	if (headless)
+	{
+		const int result = HeadlessRun(ProfilerWrap(DrawGLScene), resize, HeadlessScript);
+		waterFree(water);
+		return result;
+	}
+	// dołączenie funkcji generującej scenę 3D i animacji morza
+	RedrawInit(ProfilerWrap(DrawGLScene), fps_cap);
+	RedrawAnimation(Animate);
 	// dołączenie funkcji wywoływanej przy zmianie rozmiaru okna
 	glutReshapeFunc(resize);
 	//glutReshapeFunc(Reshape);
@@ -336,6 +360,7 @@ int main(int argc, char *argv[])
 	// wprowadzenie programu do obsługi pętli komunikatów
 	glutMainLoop();
 	// porządki
-	delete[](GLvoid*)mybezier.texture;
+	waterFree(water);
+	glDeleteTextures(1, &mybezier.texture);
 	return 0;
 }
@@ -0,0 +1,80 @@
+#ifndef __EXTENSIONS__H__
+#define __EXTENSIONS__H__
+
+#include <GL/glut.h>
+#include "glext.h"
+
+// wskaźniki na funkcje obiektów buforowych (OpenGL 1.5 / ARB_vertex_buffer_object)
+
+extern PFNGLGENBUFFERSPROC glGenBuffers;
+extern PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+extern PFNGLBINDBUFFERPROC glBindBuffer;
+extern PFNGLBUFFERDATAPROC glBufferData;
+extern PFNGLBUFFERSUBDATAPROC glBufferSubData;
+
+// wskaźniki na funkcje obiektów zapytań (OpenGL 1.5 / 3.3 / ARB_timer_query)
+
+extern PFNGLGENQUERIESPROC glGenQueries;
+extern PFNGLDELETEQUERIESPROC glDeleteQueries;
+extern PFNGLBEGINQUERYPROC glBeginQuery;
+extern PFNGLENDQUERYPROC glEndQuery;
+extern PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+extern PFNGLQUERYCOUNTERPROC glQueryCounter;
+
+// wskaźniki na funkcje programów cieniujących GLSL (OpenGL 2.0)
+
+extern PFNGLCREATESHADERPROC glCreateShader;
+extern PFNGLSHADERSOURCEPROC glShaderSource;
+extern PFNGLCOMPILESHADERPROC glCompileShader;
+extern PFNGLGETSHADERIVPROC glGetShaderiv;
+extern PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
+extern PFNGLDELETESHADERPROC glDeleteShader;
+extern PFNGLCREATEPROGRAMPROC glCreateProgram;
+extern PFNGLATTACHSHADERPROC glAttachShader;
+extern PFNGLLINKPROGRAMPROC glLinkProgram;
+extern PFNGLGETPROGRAMIVPROC glGetProgramiv;
+extern PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
+extern PFNGLUSEPROGRAMPROC glUseProgram;
+extern PFNGLDELETEPROGRAMPROC glDeleteProgram;
+extern PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
+extern PFNGLUNIFORM1FPROC glUniform1f;
+extern PFNGLUNIFORM2FPROC glUniform2f;
+extern PFNGLUNIFORM4FVPROC glUniform4fv;
+
+// wskaźniki na funkcje obiektów bufora ramki (OpenGL 3.0 / ARB_framebuffer_object
+// / EXT_framebuffer_object)
+
+extern PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+extern PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
+extern PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+extern PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D;
+extern PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
+extern PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers;
+extern PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers;
+extern PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer;
+extern PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage;
+extern PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
+
+// dostępność obiektów buforowych
+
+extern bool buffer_objects;
+
+// dostępność zapytań o czas wykonania poleceń (GL_TIME_ELAPSED i GL_TIMESTAMP)
+
+extern bool timer_query;
+
+// dostępność programów cieniujących GLSL
+
+extern bool shaders;
+
+// dostępność obiektów bufora ramki (rysowanie do tekstury)
+
+extern bool framebuffer_objects;
+
+// pobranie wskaźników na funkcje rozszerzeń; wywoływana po utworzeniu
+// kontekstu (okna); funkcje niedostępne mają wartość NULL
+
+void ExtensionFunctionsSetup();
+
+#endif // __EXTENSIONS__H__
@@ -0,0 +1,209 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "headless.h"
+#include "targa.h"
+#include "glext.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#if defined(HEADLESS_OSMESA)
+#include <GL/osmesa.h>
+#elif !defined(_WIN32)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+static bool headless = false;
+static int frames = 60;
+static int buffer_width = 0, buffer_height = 0;
+static std::string output = "frame";
+static int save_every = 1;
+
+#if defined(HEADLESS_OSMESA)
+
+static OSMesaContext context = NULL;
+static std::vector<GLubyte> color_buffer;
+
+static bool CreateContext()
+{
+	context = OSMesaCreateContextExt(OSMESA_RGBA, 24, 8, 0, NULL);
+	if (context == NULL)
+		return false;
+	color_buffer.resize(4 * buffer_width * buffer_height);
+	return OSMesaMakeCurrent(context, &color_buffer[0], GL_UNSIGNED_BYTE, buffer_width, buffer_height) == GL_TRUE;
+}
+
+static void DestroyContext()
+{
+	OSMesaDestroyContext(context);
+}
+
+#elif !defined(_WIN32)
+
+static EGLDisplay display = EGL_NO_DISPLAY;
+static EGLContext context = EGL_NO_CONTEXT;
+static EGLSurface surface = EGL_NO_SURFACE;
+
+static bool CreateContext()
+{
+	// bez serwera X - platforma "surfaceless" (Mesa), jeśli jest dostępna
+	const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (extensions && strstr(extensions, "EGL_MESA_platform_surfaceless") && eglGetPlatformDisplayEXT)
+		display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	else
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL))
+		return false;
+
+	// bufor RGB z buforem głębokości i szablonowym (jak GLUT_RGB | GLUT_DEPTH)
+	const EGLint config_attributes[] =
+	{
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+		EGL_DEPTH_SIZE, 24, EGL_STENCIL_SIZE, 8,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint count = 0;
+	if (!eglChooseConfig(display, config_attributes, &config, 1, &count) || count == 0)
+		return false;
+
+	const EGLint surface_attributes[] = { EGL_WIDTH, buffer_width, EGL_HEIGHT, buffer_height, EGL_NONE };
+	surface = eglCreatePbufferSurface(display, config, surface_attributes);
+	if (surface == EGL_NO_SURFACE || !eglBindAPI(EGL_OPENGL_API))
+		return false;
+	context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+	return context != EGL_NO_CONTEXT && eglMakeCurrent(display, surface, surface, context);
+}
+
+static void DestroyContext()
+{
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	eglDestroyContext(display, context);
+	eglDestroySurface(display, surface);
+	eglTerminate(display);
+}
+
+#else
+
+static bool CreateContext()
+{
+	printf("Tryb bez okna jest niedostepny w systemie Windows\n");
+	return false;
+}
+
+static void DestroyContext()
+{
+}
+
+#endif
+
+// wartość opcji postaci --nazwa=wartość lub NULL
+
+static const char *Option(const char *arg, const char *name)
+{
+	const size_t length = strlen(name);
+	return strncmp(arg, name, length) == 0 && arg[length] == '=' ? arg + length + 1 : NULL;
+}
+
+bool HeadlessInit(int &argc, char *argv[], int width, int height)
+{
+	buffer_width = width;
+	buffer_height = height;
+
+	// opcje trybu bez okna są usuwane z listy argumentów
+	int count = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		const char *value;
+		if (strcmp(argv[i], "--headless") == 0)
+			headless = true;
+		else if ((value = Option(argv[i], "--frames")) != NULL)
+			frames = atoi(value);
+		else if ((value = Option(argv[i], "--size")) != NULL)
+			sscanf(value, "%dx%d", &buffer_width, &buffer_height);
+		else if ((value = Option(argv[i], "--output")) != NULL)
+			output = value;
+		else if ((value = Option(argv[i], "--save-every")) != NULL)
+			save_every = atoi(value);
+		else
+			argv[count++] = argv[i];
+	}
+	argc = count;
+	argv[argc] = NULL;
+	if (!headless)
+		return false;
+
+	if (frames < 1 || buffer_width < 1 || buffer_height < 1)
+	{
+		printf("Bledne opcje trybu bez okna\n");
+		exit(1);
+	}
+	if (!CreateContext())
+	{
+		printf("Nie mozna utworzyc kontekstu OpenGL bez okna\n");
+		exit(1);
+	}
+	printf("Tryb bez okna: %dx%d, %s\n", buffer_width, buffer_height, (char*)glGetString(GL_RENDERER));
+	return true;
+}
+
+bool Headless()
+{
+	return headless;
+}
+
+int HeadlessRun(void(*display)(), void(*reshape)(int width, int height),
+	void(*script)(int frame, int frames))
+{
+	std::vector<GLubyte> pixels(3 * buffer_width * buffer_height);
+	char filename[1024];
+	int saved = 0;
+
+	reshape(buffer_width, buffer_height);
+	for (int frame = 0; frame < frames; frame++)
+	{
+		if (script)
+			script(frame, frames);
+		display();
+
+		// zapis zawartości bufora koloru (wiersze od dołu, jak w TGA)
+		if (save_every > 0 && frame % save_every == 0)
+		{
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(0, 0, buffer_width, buffer_height, GL_BGR, GL_UNSIGNED_BYTE, &pixels[0]);
+			snprintf(filename, sizeof(filename), "%s_%04d.tga", output.c_str(), frame);
+			if (!save_targa(filename, buffer_width, buffer_height, GL_BGR, GL_UNSIGNED_BYTE, &pixels[0]))
+			{
+				printf("Nie mozna zapisac pliku %s\n", filename);
+				DestroyContext();
+				return 1;
+			}
+			saved++;
+		}
+	}
+	glFinish();
+	printf("Narysowano %d ramek, zapisano %d plikow %s_*.tga\n", frames, saved, output.c_str());
+	DestroyContext();
+	return 0;
+}
+
+int WindowWidth()
+{
+	return headless ? buffer_width : glutGet(GLUT_WINDOW_WIDTH);
+}
+
+int WindowHeight()
+{
+	return headless ? buffer_height : glutGet(GLUT_WINDOW_HEIGHT);
+}
+
+void WindowSwapBuffers()
+{
+	if (!headless)
+		glutSwapBuffers();
+}
@@ -0,0 +1,46 @@
+#ifndef __HEADLESS__H__
+#define __HEADLESS__H__
+
+#include <GL/glut.h>
+
+// tryb bez okna: z opcją --headless program zamiast okna GLUT tworzy
+// kontekst OpenGL w buforze pozaekranowym (EGL pbuffer, bez serwera X -
+// platforma "surfaceless" Mesa; OSMesa po zdefiniowaniu HEADLESS_OSMESA),
+// rysuje zadaną liczbę ramek według scenariusza kamery i zapisuje je
+// w plikach TGA; wymaga biblioteki libEGL (lub libOSMesa), w systemie
+// Windows tryb jest niedostępny
+//
+// opcje (usuwane z argv, pozostałe argumenty programu bez zmian):
+// --headless          tryb bez okna
+// --frames=N          liczba ramek (domyślnie 60)
+// --size=SZERxWYS     rozmiary bufora ramki (domyślnie rozmiary okna)
+// --output=PREFIKS    prefiks nazw plików TGA (domyślnie "frame")
+// --save-every=N      zapis co N-tej ramki (domyślnie 1, 0 - bez zapisu)
+
+// odczyt opcji i utworzenie kontekstu w trybie bez okna; zwraca true,
+// gdy program ma działać bez okna (bez wywołań glutInit i glutCreateWindow);
+// width, height - rozmiary okna programu
+
+bool HeadlessInit(int &argc, char *argv[], int width, int height);
+
+// true - program działa w trybie bez okna
+
+bool Headless();
+
+// narysowanie ramek w trybie bez okna: reshape jest wywoływana raz
+// z rozmiarami bufora, przed każdą ramką script ustawia kamerę i stan
+// animacji dla ramki frame z frames (deterministycznie - bez zegara);
+// zwraca kod zakończenia programu
+
+int HeadlessRun(void(*display)(), void(*reshape)(int width, int height),
+	void(*script)(int frame, int frames));
+
+// rozmiary okna (w trybie bez okna - bufora ramki) i zamiana buforów;
+// zastępują glutGet(GLUT_WINDOW_WIDTH/HEIGHT) i glutSwapBuffers
+// w funkcjach wywoływanych w obu trybach
+
+int WindowWidth();
+int WindowHeight();
+void WindowSwapBuffers();
+
+#endif // __HEADLESS__H__
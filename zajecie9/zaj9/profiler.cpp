@@ -0,0 +1,343 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "profiler.h"
+#include "extensions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+// liczba obiektów zapytań - wynik zapytania jest odczytywany najwcześniej
+// QUERY_COUNT - 1 ramek po jego zakończeniu
+
+const int QUERY_COUNT = 4;
+
+// liczba ramek na wykresie, wymiary wykresu i skala (pikseli na ms)
+
+const int GRAPH_FRAMES = 120;
+const int GRAPH_WIDTH = 2 * GRAPH_FRAMES;
+const int GRAPH_HEIGHT = 64;
+const int GRAPH_MARGIN = 8;
+const GLfloat GRAPH_SCALE = GRAPH_HEIGHT / 40.0f;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static Clock::time_point start_time, frame_start;
+static bool started = false;
+static bool in_frame = false;
+static std::string csv_name;
+
+// dane wszystkich ramek (zapisywane przy zakończeniu programu)
+
+static std::vector<ProfilerFrame> frames;
+static ProfilerFrame current;
+static double last_gpu = -1.0;
+
+// pierścień obiektów zapytań; frame - numer mierzonej ramki (-1 - wolne)
+
+struct TimerQuery
+{
+	GLuint query = 0;
+	int frame = -1;
+};
+
+static TimerQuery queries[QUERY_COUNT];
+static int active_query = -1;
+
+// funkcja generująca scenę otoczona przez ProfilerWrap
+
+static void(*wrapped_display)() = NULL;
+
+static double Milliseconds(Clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// odczyt wyników zakończonych zapytań bez oczekiwania na GPU
+
+static void CollectQueries()
+{
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		TimerQuery &q = queries[i];
+		if (q.frame < 0)
+			continue;
+		GLint available = 0;
+		glGetQueryObjectiv(q.query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			continue;
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(q.query, GL_QUERY_RESULT, &elapsed);
+
+		// czas dłuższy niż od początku ramki do teraz jest błędem sterownika
+		// (zdarza się przy pierwszym zapytaniu) - pomijany
+		const double gpu = elapsed / 1.0e6;
+		if (gpu <= Milliseconds(Clock::now() - start_time) - frames[q.frame].time_ms)
+			last_gpu = frames[q.frame].gpu_ms = gpu;
+		q.frame = -1;
+	}
+}
+
+// percentyl (metoda najbliższej rangi) posortowanych wartości
+
+static double Percentile(const std::vector<double> &sorted, int p)
+{
+	if (sorted.empty())
+		return 0.0;
+	size_t rank = (sorted.size() * p + 99) / 100;
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void PrintPercentiles(const char *name, std::vector<double> &values)
+{
+	if (values.empty())
+		return;
+	std::sort(values.begin(), values.end());
+	printf("%s [ms]: p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n", name, Percentile(values, 50),
+		Percentile(values, 95), Percentile(values, 99), values.back());
+}
+
+// zapis danych ramek i podsumowanie (atexit - bez wywołań OpenGL, kontekst
+// może już nie istnieć)
+
+static void ProfilerExit()
+{
+	if (frames.empty())
+		return;
+
+	if (!csv_name.empty())
+	{
+		FILE *file = fopen(csv_name.c_str(), "w");
+		if (file)
+		{
+			fprintf(file, "frame,time_ms,cpu_ms,gpu_ms,draw_calls,vertices,texture_binds,state_changes\n");
+			for (size_t i = 0; i < frames.size(); i++)
+			{
+				const ProfilerFrame &f = frames[i];
+				fprintf(file, "%u,%.3f,%.3f,", (unsigned)i, f.time_ms, f.cpu_ms);
+				if (f.gpu_ms >= 0.0)
+					fprintf(file, "%.3f", f.gpu_ms);
+				fprintf(file, ",%d,%d,%d,%d\n", f.draw_calls, f.vertices, f.texture_binds, f.state_changes);
+			}
+			fclose(file);
+		}
+		else
+			printf("Nie mozna zapisac pliku %s\n", csv_name.c_str());
+	}
+
+	std::vector<double> cpu, gpu;
+	double draw_calls = 0.0, vertices = 0.0, texture_binds = 0.0, state_changes = 0.0;
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		const ProfilerFrame &f = frames[i];
+		cpu.push_back(f.cpu_ms);
+		if (f.gpu_ms >= 0.0)
+			gpu.push_back(f.gpu_ms);
+		draw_calls += f.draw_calls;
+		vertices += f.vertices;
+		texture_binds += f.texture_binds;
+		state_changes += f.state_changes;
+	}
+	const double n = (double)frames.size();
+	printf("Ramki: %u\n", (unsigned)frames.size());
+	PrintPercentiles("CPU", cpu);
+	PrintPercentiles("GPU", gpu);
+	printf("Srednio na ramke: wywolania %.1f  wierzcholki %.0f  tekstury %.1f  zmiany stanu %.1f\n",
+		draw_calls / n, vertices / n, texture_binds / n, state_changes / n);
+}
+
+void ProfilerInit(const char *csv_file)
+{
+	if (started)
+		return;
+	started = true;
+	start_time = Clock::now();
+	csv_name = csv_file ? csv_file : "";
+	if (timer_query)
+		for (int i = 0; i < QUERY_COUNT; i++)
+			glGenQueries(1, &queries[i].query);
+	atexit(ProfilerExit);
+}
+
+static void ProfiledDisplay()
+{
+	ProfilerFrameBegin();
+	wrapped_display();
+	ProfilerFrameEnd();
+}
+
+void(*ProfilerWrap(void(*display)()))()
+{
+	wrapped_display = display;
+	return ProfiledDisplay;
+}
+
+void ProfilerFrameBegin()
+{
+	if (!started || in_frame)
+		return;
+	in_frame = true;
+	frame_start = Clock::now();
+	current = ProfilerFrame();
+	current.time_ms = Milliseconds(frame_start - start_time);
+
+	// zapytanie dla tej ramki tylko wtedy, gdy obiekt z pierścienia jest wolny
+	active_query = -1;
+	if (timer_query)
+	{
+		CollectQueries();
+		const int slot = (int)(frames.size() % QUERY_COUNT);
+		if (queries[slot].frame < 0)
+		{
+			glBeginQuery(GL_TIME_ELAPSED, queries[slot].query);
+			active_query = slot;
+		}
+	}
+}
+
+void ProfilerFrameEnd()
+{
+	if (!in_frame)
+		return;
+	in_frame = false;
+	if (active_query >= 0)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		queries[active_query].frame = (int)frames.size();
+	}
+	current.cpu_ms = Milliseconds(Clock::now() - frame_start);
+	frames.push_back(current);
+}
+
+void ProfilerDraw(int vertices, int calls)
+{
+	current.draw_calls += calls;
+	current.vertices += vertices;
+}
+
+void ProfilerTextureBind(int count)
+{
+	current.texture_binds += count;
+}
+
+void ProfilerStateChanges(int count)
+{
+	current.state_changes += count;
+}
+
+// wierzchołek wykresu: położenie (x, y) i kolor RGBA
+
+static void Vertex(std::vector<GLfloat> &array, GLfloat x, GLfloat y, const GLfloat *color)
+{
+	array.push_back(x);
+	array.push_back(y);
+	array.insert(array.end(), color, color + 4);
+}
+
+static void Quad(std::vector<GLfloat> &array, GLfloat x0, GLfloat y0, GLfloat x1, GLfloat y1, const GLfloat *color)
+{
+	Vertex(array, x0, y0, color);
+	Vertex(array, x1, y0, color);
+	Vertex(array, x1, y1, color);
+	Vertex(array, x0, y1, color);
+}
+
+static void DrawArray(const std::vector<GLfloat> &array, GLenum mode)
+{
+	if (array.empty())
+		return;
+	const GLsizei stride = 6 * sizeof(GLfloat);
+	glVertexPointer(2, GL_FLOAT, stride, &array[0]);
+	glColorPointer(4, GL_FLOAT, stride, &array[2]);
+	glDrawArrays(mode, 0, (GLsizei)array.size() / 6);
+}
+
+void ProfilerOverlay(int width, int height)
+{
+	static const GLfloat background[] = { 0.0f, 0.0f, 0.0f, 0.6f };
+	static const GLfloat cpu_normal[] = { 0.2f, 0.8f, 0.2f, 1.0f };
+	static const GLfloat cpu_slow[] = { 0.9f, 0.2f, 0.1f, 1.0f };
+	static const GLfloat gpu_color[] = { 0.3f, 0.6f, 1.0f, 1.0f };
+	static const GLfloat reference[] = { 1.0f, 1.0f, 1.0f, 0.5f };
+	static std::vector<GLfloat> quads, lines;
+
+	const GLfloat x0 = (GLfloat)(width - GRAPH_WIDTH - GRAPH_MARGIN);
+	const GLfloat y0 = (GLfloat)GRAPH_MARGIN;
+	const GLfloat top = y0 + GRAPH_HEIGHT;
+
+	// tło, słupki czasu CPU (powyżej 16,7 ms - czerwone) i łamana czasu GPU
+	quads.clear();
+	lines.clear();
+	Quad(quads, x0, y0, x0 + GRAPH_WIDTH, top, background);
+	const int count = std::min((int)frames.size(), GRAPH_FRAMES);
+	const int first = (int)frames.size() - count;
+	for (int i = 0; i < count; i++)
+	{
+		const ProfilerFrame &f = frames[first + i];
+		const GLfloat x = x0 + GRAPH_WIDTH - 2.0f * (count - i);
+		const GLfloat h = std::min((GLfloat)f.cpu_ms * GRAPH_SCALE, (GLfloat)GRAPH_HEIGHT);
+		Quad(quads, x, y0, x + 1.0f, y0 + h, f.cpu_ms > 1000.0 / 60.0 ? cpu_slow : cpu_normal);
+		if (i > 0 && f.gpu_ms >= 0.0 && frames[first + i - 1].gpu_ms >= 0.0)
+		{
+			const GLfloat g0 = std::min((GLfloat)frames[first + i - 1].gpu_ms * GRAPH_SCALE, (GLfloat)GRAPH_HEIGHT);
+			const GLfloat g1 = std::min((GLfloat)f.gpu_ms * GRAPH_SCALE, (GLfloat)GRAPH_HEIGHT);
+			Vertex(lines, x - 1.5f, y0 + g0, gpu_color);
+			Vertex(lines, x + 0.5f, y0 + g1, gpu_color);
+		}
+	}
+	for (int i = 1; i <= 2; i++)
+	{
+		const GLfloat y = y0 + i * (1000.0f / 60.0f) * GRAPH_SCALE;
+		Vertex(lines, x0, y, reference);
+		Vertex(lines, x0 + GRAPH_WIDTH, y, reference);
+	}
+
+	glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT | GL_LINE_BIT);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_FOG);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_ALPHA_TEST);
+	glDisable(GL_CULL_FACE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glLineWidth(1.0f);
+
+	// współrzędne okna
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0.0, width, 0.0, height, -1.0, 1.0);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	if (buffer_objects)
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	DrawArray(quads, GL_QUADS);
+	DrawArray(lines, GL_LINES);
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopClientAttrib();
+	glPopAttrib();
+}
+
+const ProfilerFrame &ProfilerLastFrame()
+{
+	static const ProfilerFrame empty;
+	return frames.empty() ? empty : frames.back();
+}
+
+double ProfilerLastGpu()
+{
+	return last_gpu;
+}
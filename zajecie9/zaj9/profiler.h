@@ -0,0 +1,65 @@
+#ifndef __PROFILER__H__
+#define __PROFILER__H__
+
+#include <GL/glut.h>
+
+// pomiar wydajności ramek: czas CPU funkcji generującej scenę (zegar
+// wysokiej rozdzielczości), czas GPU (zapytania GL_TIME_ELAPSED w pierścieniu
+// kilku obiektów zapytań - wynik odczytywany jest kilka ramek później, gdy
+// jest już dostępny, więc pomiar nie wstrzymuje potoku OpenGL) oraz liczniki
+// wywołań rysujących, wierzchołków, dowiązań tekstur i zmian stanu;
+// przy zakończeniu programu zapisywany jest plik CSV z danymi każdej ramki
+// i wypisywane są percentyle p50/p95/p99 czasów ramek
+
+// dane jednej ramki; gpu_ms < 0 - czas GPU niedostępny
+
+struct ProfilerFrame
+{
+	double time_ms = 0.0; // początek ramki od uruchomienia pomiaru
+	double cpu_ms = 0.0;
+	double gpu_ms = -1.0;
+	int draw_calls = 0;
+	int vertices = 0;
+	int texture_binds = 0;
+	int state_changes = 0;
+};
+
+// rozpoczęcie pomiaru; wywoływana po ExtensionFunctionsSetup
+// csv_file - nazwa pliku z danymi ramek (NULL - bez pliku)
+
+void ProfilerInit(const char *csv_file);
+
+// funkcja generująca scenę otoczona pomiarem (do glutDisplayFunc lub RedrawInit)
+
+void(*ProfilerWrap(void(*display)()))();
+
+// początek i koniec ramki (gdy funkcja generująca scenę nie jest otoczona
+// przez ProfilerWrap)
+
+void ProfilerFrameBegin();
+void ProfilerFrameEnd();
+
+// liczniki bieżącej ramki: wywołania rysujące (glDrawArrays, glDrawElements,
+// glBegin/glEnd, glCallList) z łączną liczbą wierzchołków, dowiązania
+// tekstur, zmiany stanu OpenGL
+
+void ProfilerDraw(int vertices, int calls = 1);
+void ProfilerTextureBind(int count = 1);
+void ProfilerStateChanges(int count);
+
+// wykres czasów ostatnich ramek w prawym dolnym rogu okna (CPU - słupki,
+// GPU - linia, poziome linie 16,7 ms i 33,3 ms); wywoływana przed glFlush
+// lub glutSwapBuffers; nie zmienia stanu OpenGL
+
+void ProfilerOverlay(int width, int height);
+
+// dane ostatniej zakończonej ramki (czas GPU tej ramki może być jeszcze
+// niedostępny - zob. ProfilerLastGpu)
+
+const ProfilerFrame &ProfilerLastFrame();
+
+// ostatni odczytany czas GPU [ms] (-1 - brak)
+
+double ProfilerLastGpu();
+
+#endif // __PROFILER__H__
@@ -0,0 +1,42 @@
+#ifndef __REDRAW__H__
+#define __REDRAW__H__
+
+#include <GL/glut.h>
+
+// planowanie rysowania ramek: zmiana sceny (klawiatura, myszka, menu,
+// zmiana rozmiaru okna) tylko oznacza scenę do narysowania, a wiele takich
+// zgłoszeń przed najbliższą ramką daje jedno rysowanie; ramki nie są
+// rysowane częściej niż pozwala ograniczenie liczby ramek na sekundę,
+// a bez animacji i zgłoszeń program czeka na zdarzenia (nie zajmuje
+// procesora)
+
+// dołączenie funkcji generującej scenę (zamiast glutDisplayFunc)
+// fps_cap - największa liczba ramek na sekundę (0 - bez ograniczenia)
+
+void RedrawInit(void(*display)(), int fps_cap);
+
+// scena zmieniona - narysowanie w najbliższej ramce
+
+void RedrawRequest();
+
+// animacja: funkcja wywoływana przed każdą ramką z czasem [s], który
+// upłynął od poprzedniego kroku; dopóki animacja jest dołączona, kolejne
+// ramki są rysowane bez zgłoszeń; NULL - zatrzymanie animacji
+
+void RedrawAnimation(void(*step)(float dt));
+
+// zmiana ograniczenia liczby ramek na sekundę (0 - bez ograniczenia)
+
+void RedrawFpsCap(int fps_cap);
+
+// liczba zgłoszeń i narysowanych ramek (od uruchomienia programu)
+
+struct RedrawStats
+{
+	int requests = 0;
+	int frames = 0;
+};
+
+const RedrawStats &RedrawGetStats();
+
+#endif // __REDRAW__H__
@@ -4,7 +4,9 @@ http://www.januszg.hg.pl
 JanuszG@enter.net.pl
 */
 #define _CRT_SECURE_NO_WARNINGS
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include "targa.h"
 #include "glext.h"
 #include <stdio.h>
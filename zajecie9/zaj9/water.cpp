@@ -0,0 +1,307 @@
+// Symulacja powierzchni wody: dyskretne równanie falowe
+//   h(t+dt) = 2h(t) - h(t-dt) + (c dt / dx)^2 * (suma sąsiadów - 4h(t))
+// liczone wektorowo (SSE, 4 węzły naraz) i równolegle w pasach wierszy
+// przydzielonych wątkom roboczym. Po każdym kroku wyznaczane są wektory
+// normalne (różnice centralne) oraz prędkość przepływu z liniowego
+// modelu płytkiej wody du/dt = -g grad h.
+
+#include "water.h"
+#include <math.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define WATER_SSE
+#endif
+
+// prędkość fal w jednostkach sceny na sekundę
+const float wave_speed = 0.6f;
+
+// tłumienie fal - część energii pozostająca po sekundzie
+const float wave_damping = 0.6f;
+
+// maksymalna liczba Couranta (c dt / dx)^2 zapewniająca stabilność schematu
+const float courant_limit = 0.45f;
+
+// przyspieszenie w modelu przepływu i tłumienie prędkości na sekundę
+const float flow_gravity = 9.81f;
+const float flow_damping = 0.2f;
+
+// zadanie wykonywane przez wątki: pas wierszy <first, last)
+typedef void(*WATER_JOB)(WATER_GRID &water, int first, int last);
+
+struct water_pool {
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable start; // sygnał rozpoczęcia zadania
+	std::condition_variable done; // sygnał zakończenia zadania przez wszystkie wątki
+	WATER_JOB job;
+	WATER_GRID *water;
+	int generation; // numer kolejnego zadania
+	int pending; // liczba wątków pracujących nad bieżącym zadaniem
+	bool quit;
+	// parametry kroku wspólne dla wszystkich pasów
+	float courant, damping, flow_scale, flow_keep;
+};
+
+// podział wierszy na pasy; pas 0 liczy wątek główny
+
+static void Band(int rows, int bands, int band, int &first, int &last)
+{
+	first = rows * band / bands;
+	last = rows * (band + 1) / bands;
+}
+
+static void Worker(water_pool *pool, int band)
+{
+	int seen = 0;
+	for (;;)
+	{
+		WATER_JOB job;
+		WATER_GRID *water;
+		{
+			std::unique_lock<std::mutex> lock(pool->mutex);
+			pool->start.wait(lock, [&] { return pool->quit || pool->generation != seen; });
+			if (pool->quit)
+				return;
+			seen = pool->generation;
+			job = pool->job;
+			water = pool->water;
+		}
+		int first, last;
+		Band(water->size, (int)pool->threads.size() + 1, band, first, last);
+		job(*water, first, last);
+		{
+			std::lock_guard<std::mutex> lock(pool->mutex);
+			if (--pool->pending == 0)
+				pool->done.notify_one();
+		}
+	}
+}
+
+// wykonanie zadania na wszystkich pasach i oczekiwanie na jego zakończenie
+
+static void Run(WATER_GRID &water, WATER_JOB job)
+{
+	water_pool *pool = water.pool;
+	{
+		std::lock_guard<std::mutex> lock(pool->mutex);
+		pool->job = job;
+		pool->water = &water;
+		pool->pending = (int)pool->threads.size();
+		pool->generation++;
+	}
+	pool->start.notify_all();
+	int first, last;
+	Band(water.size, (int)pool->threads.size() + 1, 0, first, last);
+	job(water, first, last);
+	std::unique_lock<std::mutex> lock(pool->mutex);
+	pool->done.wait(lock, [&] { return pool->pending == 0; });
+}
+
+// krok równania falowego dla wierszy <first, last); wynik zapisywany
+// w miejsce wysokości z poprzedniego kroku (każdy węzeł czyta tylko
+// własną poprzednią wartość), brzegi pozostają zerowe
+
+static void WaveRows(WATER_GRID &water, int first, int last)
+{
+	const int n = water.size;
+	const float k = water.pool->courant;
+	const float keep = water.pool->damping;
+	const float *h = &water.height[0];
+	float *out = &water.previous[0];
+	if (first < 1)
+		first = 1;
+	if (last > n - 1)
+		last = n - 1;
+	for (int y = first; y < last; y++)
+	{
+		const float *row = h + y * n;
+		const float *up = row - n;
+		const float *down = row + n;
+		float *dst = out + y * n;
+		int x = 1;
+#ifdef WATER_SSE
+		const __m128 vk = _mm_set1_ps(k);
+		const __m128 vc = _mm_set1_ps(2.0f - 4.0f * k);
+		const __m128 vkeep = _mm_set1_ps(keep);
+		for (; x + 4 <= n - 1; x += 4)
+		{
+			__m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row + x - 1), _mm_loadu_ps(row + x + 1)),
+				_mm_add_ps(_mm_loadu_ps(up + x), _mm_loadu_ps(down + x)));
+			__m128 next = _mm_add_ps(_mm_mul_ps(vc, _mm_loadu_ps(row + x)), _mm_mul_ps(vk, sum));
+			next = _mm_sub_ps(next, _mm_loadu_ps(dst + x));
+			_mm_storeu_ps(dst + x, _mm_mul_ps(next, vkeep));
+		}
+#endif
+		for (; x < n - 1; x++)
+		{
+			const float sum = row[x - 1] + row[x + 1] + up[x] + down[x];
+			dst[x] = ((2.0f - 4.0f * k) * row[x] + k * sum - dst[x]) * keep;
+		}
+	}
+}
+
+// wektory normalne i prędkość przepływu dla jednego węzła (gx, gy - różnice
+// wysokości sąsiadów, dzielone przez podwójną odległość węzłów)
+
+static inline void NormalFlow(WATER_GRID &water, int i, float gx, float gy)
+{
+	const float scale = water.pool->flow_scale;
+	const float keep = water.pool->flow_keep;
+	const float length = 1.0f / sqrtf(gx * gx + gy * gy + 1.0f);
+	water.normal[3 * i + 0] = -gx * length;
+	water.normal[3 * i + 1] = -gy * length;
+	water.normal[3 * i + 2] = length;
+	water.flow[2 * i + 0] = water.flow[2 * i + 0] * keep - scale * gx;
+	water.flow[2 * i + 1] = water.flow[2 * i + 1] * keep - scale * gy;
+}
+
+static void NormalRows(WATER_GRID &water, int first, int last)
+{
+	const int n = water.size;
+	const float inv = 0.5f / water.cell;
+	const float *h = &water.height[0];
+	for (int y = first; y < last; y++)
+	{
+		const float *row = h + y * n;
+		const float *up = h + (y > 0 ? y - 1 : y) * n;
+		const float *down = h + (y < n - 1 ? y + 1 : y) * n;
+		// węzły brzegowe - różnice jednostronne
+		NormalFlow(water, y * n, (row[1] - row[0]) * inv, (down[0] - up[0]) * inv);
+		NormalFlow(water, y * n + n - 1, (row[n - 1] - row[n - 2]) * inv, (down[n - 1] - up[n - 1]) * inv);
+		int x = 1;
+#ifdef WATER_SSE
+		const __m128 vinv = _mm_set1_ps(inv);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 vscale = _mm_set1_ps(water.pool->flow_scale);
+		const __m128 vkeep = _mm_set1_ps(water.pool->flow_keep);
+		for (; x + 4 <= n - 1; x += 4)
+		{
+			const __m128 gx = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(row + x + 1), _mm_loadu_ps(row + x - 1)), vinv);
+			const __m128 gy = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(down + x), _mm_loadu_ps(up + x)), vinv);
+			const __m128 length = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)), one)));
+			const __m128 nx = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(gx, length));
+			const __m128 ny = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(gy, length));
+
+			// zapis przeplatany (x, y, z) i (x, y)
+			float sx[4], sy[4], sz[4];
+			_mm_storeu_ps(sx, nx);
+			_mm_storeu_ps(sy, ny);
+			_mm_storeu_ps(sz, length);
+			float *normal = &water.normal[3 * (y * n + x)];
+			float *flow = &water.flow[2 * (y * n + x)];
+			for (int j = 0; j < 4; j++)
+			{
+				normal[3 * j + 0] = sx[j];
+				normal[3 * j + 1] = sy[j];
+				normal[3 * j + 2] = sz[j];
+			}
+			// prędkości (x, y) dwóch węzłów mieszczą się w jednym rejestrze
+			const __m128 g01 = _mm_unpacklo_ps(gx, gy);
+			const __m128 g23 = _mm_unpackhi_ps(gx, gy);
+			_mm_storeu_ps(flow, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(flow), vkeep), _mm_mul_ps(vscale, g01)));
+			_mm_storeu_ps(flow + 4, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(flow + 4), vkeep), _mm_mul_ps(vscale, g23)));
+		}
+#endif
+		for (; x < n - 1; x++)
+			NormalFlow(water, y * n + x, (row[x + 1] - row[x - 1]) * inv, (down[x] - up[x]) * inv);
+	}
+}
+
+void waterInit(WATER_GRID &water, int size, float extent, int threads)
+{
+	if (size < 3)
+		size = 3;
+	water.size = size;
+	water.cell = extent / (size - 1);
+	water.height.assign(size * size, 0.0f);
+	water.previous.assign(size * size, 0.0f);
+	water.normal.assign(3 * size * size, 0.0f);
+	water.flow.assign(2 * size * size, 0.0f);
+	for (int i = 0; i < size * size; i++)
+		water.normal[3 * i + 2] = 1.0f;
+	water.current[0] = 0.05f;
+	water.current[1] = 0.02f;
+	water.scroll[0] = water.scroll[1] = 0.0f;
+
+	if (threads <= 0)
+		threads = (int)std::thread::hardware_concurrency();
+	if (threads < 1)
+		threads = 1;
+	if (threads > size)
+		threads = size;
+	water.pool = new water_pool;
+	water.pool->job = NULL;
+	water.pool->water = &water;
+	water.pool->generation = 0;
+	water.pool->pending = 0;
+	water.pool->quit = false;
+	for (int i = 1; i < threads; i++)
+		water.pool->threads.push_back(std::thread(Worker, water.pool, i));
+}
+
+void waterFree(WATER_GRID &water)
+{
+	if (water.pool == NULL)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(water.pool->mutex);
+		water.pool->quit = true;
+	}
+	water.pool->start.notify_all();
+	for (size_t i = 0; i < water.pool->threads.size(); i++)
+		water.pool->threads[i].join();
+	delete water.pool;
+	water.pool = NULL;
+}
+
+void waterDrop(WATER_GRID &water, float x, float y, float radius, float depth)
+{
+	const int n = water.size;
+	const float cx = x * (n - 1), cy = y * (n - 1), r = radius * (n - 1);
+	const int x0 = (int)floorf(cx - r), x1 = (int)ceilf(cx + r);
+	const int y0 = (int)floorf(cy - r), y1 = (int)ceilf(cy + r);
+	for (int j = y0 < 1 ? 1 : y0; j <= y1 && j < n - 1; j++)
+		for (int i = x0 < 1 ? 1 : x0; i <= x1 && i < n - 1; i++)
+		{
+			const float d = sqrtf((i - cx) * (i - cx) + (j - cy) * (j - cy)) / r;
+			if (d < 1.0f)
+			{
+				// zagłębienie w kształcie cosinusa - bez ostrych krawędzi
+				const float dh = -depth * 0.5f * (1.0f + cosf(3.14159265f * d));
+				water.height[j * n + i] += dh;
+				water.previous[j * n + i] += dh;
+			}
+		}
+}
+
+void waterStep(WATER_GRID &water, float dt)
+{
+	if (dt <= 0.0f)
+		return;
+
+	// podział kroku tak, aby liczba Couranta nie przekroczyła granicy stabilności
+	const float c = wave_speed * dt / water.cell;
+	int steps = (int)ceilf(c / sqrtf(courant_limit));
+	if (steps < 1)
+		steps = 1;
+	const float sub = dt / steps;
+	water.pool->courant = (wave_speed * sub / water.cell) * (wave_speed * sub / water.cell);
+	water.pool->damping = powf(wave_damping, sub);
+	for (int i = 0; i < steps; i++)
+	{
+		Run(water, WaveRows);
+		water.height.swap(water.previous);
+	}
+
+	// normalne i przepływ dla nowych wysokości
+	water.pool->flow_scale = flow_gravity * dt;
+	water.pool->flow_keep = powf(flow_damping, dt);
+	Run(water, NormalRows);
+
+	// przesunięcie tekstury przez stały prąd
+	water.scroll[0] = fmodf(water.scroll[0] + water.current[0] * dt, 1.0f);
+	water.scroll[1] = fmodf(water.scroll[1] + water.current[1] * dt, 1.0f);
+}
@@ -0,0 +1,47 @@
+#ifndef __WATER__H__
+#define __WATER__H__
+
+#include <vector>
+
+struct water_pool; // wątki robocze symulacji (water.cpp)
+
+// siatka symulacji powierzchni wody - równanie falowe rozwiązywane
+// metodą różnic skończonych na siatce size x size węzłów;
+// brzegi siatki są nieruchome (fale odbijają się od nich)
+
+typedef struct water_grid {
+	int size; // liczba węzłów w każdym kierunku
+	float cell; // odległość między sąsiednimi węzłami
+	std::vector<float> height; // wysokości w bieżącym kroku
+	std::vector<float> previous; // wysokości w poprzednim kroku
+	std::vector<float> normal; // wektory normalne (x, y, z) dla każdego węzła
+	std::vector<float> flow; // prędkość przepływu (x, y) dla każdego węzła
+	float current[2]; // stały prąd unoszący powierzchnię
+	float scroll[2]; // przesunięcie tekstury wywołane prądem
+	water_pool *pool; // wątki robocze
+} WATER_GRID;
+
+// inicjalizacja siatki
+// size - liczba węzłów w każdym kierunku
+// extent - rozmiar siatki w jednostkach sceny
+// threads - liczba wątków (0 - liczba rdzeni procesora)
+
+void waterInit(WATER_GRID &water, int size, float extent, int threads);
+
+// zwolnienie siatki i zakończenie wątków roboczych
+
+void waterFree(WATER_GRID &water);
+
+// zaburzenie powierzchni (np. kropla deszczu)
+// x, y - środek zaburzenia we współrzędnych siatki <0, 1>
+// radius - promień zaburzenia we współrzędnych siatki
+// depth - głębokość zagłębienia w jednostkach sceny
+
+void waterDrop(WATER_GRID &water, float x, float y, float radius, float depth);
+
+// jeden krok symulacji o czasie dt sekund; po kroku aktualne są
+// wysokości, wektory normalne i prędkości przepływu
+
+void waterStep(WATER_GRID &water, float dt);
+
+#endif // __WATER__H__